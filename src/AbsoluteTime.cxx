@@ -20,8 +20,12 @@ namespace timeSystem {
     m_time_system(&TimeSystem::getSystem(time_system_name)), m_moment(origin_mjd, elapsed_time) {
   }
 
+  AbsoluteTime::AbsoluteTime(const TimeSystem & time_system, long origin_mjd, const Duration & elapsed_time):
+    m_time_system(&time_system), m_moment(origin_mjd, elapsed_time) {
+  }
+
   AbsoluteTime::AbsoluteTime(const std::string & time_system_name, long mjd_day, double mjd_sec):
-    m_time_system(&TimeSystem::getSystem(time_system_name)), m_moment(mjd_day, Duration(mjd_sec, "Sec")) {
+    m_time_system(&TimeSystem::getSystem(time_system_name)), m_moment(mjd_day, Duration::from<Sec>(mjd_sec)) {
   }
 
   AbsoluteTime AbsoluteTime::operator +(const ElapsedTime & elapsed_time) const { return elapsed_time + *this; }
@@ -59,26 +63,37 @@ namespace timeSystem {
   }
 
   AbsoluteTime AbsoluteTime::computeAbsoluteTime(const std::string & time_system_name, const Duration & delta_t) const {
+    return computeAbsoluteTime(TimeSystem::getSystem(time_system_name), delta_t);
+  }
+
+  AbsoluteTime AbsoluteTime::computeAbsoluteTime(const TimeSystem & time_system, const Duration & delta_t) const {
     // Convert this time to a corresponding time in time_system.
-    const TimeSystem & time_system(TimeSystem::getSystem(time_system_name));
     moment_type moment = time_system.convertFrom(*m_time_system, m_moment);
 
     // Add delta_t in time_system.
     moment.second += delta_t;
 
     // Return this time expressed as a new absolute time in the input time system.
-    return AbsoluteTime(time_system_name, moment.first, moment.second);
+    return AbsoluteTime(time_system, moment.first, moment.second);
   }
 
   ElapsedTime AbsoluteTime::computeElapsedTime(const std::string & time_system_name, const AbsoluteTime & since) const {
-    const TimeSystem & time_system(TimeSystem::getSystem(time_system_name));
+    return computeElapsedTime(TimeSystem::getSystem(time_system_name), since);
+  }
+
+  ElapsedTime AbsoluteTime::computeElapsedTime(const TimeSystem & time_system, const AbsoluteTime & since) const {
     // Convert both times into the given time system.
     moment_type minuend = time_system.convertFrom(*m_time_system, m_moment);
     moment_type subtrahend = time_system.convertFrom(*(since.m_time_system), since.m_moment);
 
     // Subtract the subtahend from the minuend.
     Duration time_diff = time_system.computeTimeDifference(minuend, subtrahend);
-    return ElapsedTime(time_system_name, time_diff);
+    return ElapsedTime(time_system, time_diff);
+  }
+
+  double AbsoluteTime::computeElapsedSec(const TimeSystem & time_system, const moment_type & since) const {
+    // Convert the stored time into the given time system, and subtract the given moment in seconds.
+    return time_system.computeTimeDifferenceInSec(time_system.convertFrom(*m_time_system, m_moment), since);
   }
 
   std::string AbsoluteTime::describe() const {
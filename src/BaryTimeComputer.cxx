@@ -9,11 +9,17 @@
 #include "timeSystem/Duration.h"
 #include "timeSystem/ElapsedTime.h"
 #include "timeSystem/MjdFormat.h"
+#include "timeSystem/PerformanceMonitor.h"
 #include "timeSystem/SourcePosition.h"
+#include "timeSystem/TimeSystem.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <cmath>
-#include <set>
+#include <cstdlib>
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <vector>
@@ -21,14 +27,68 @@
 extern "C" {
 // Copied from bary.h.
 #define RADEG   57.2957795130823
-int initephem (int, int *, double *, double *, double *) ;
-const double *dpleph (double *, int, int) ;
+typedef struct JPLEphem JPLEphem ;
+JPLEphem *newephem_r (void) ;
+int initephem_r (JPLEphem *, int, int *, double *, double *, double *) ;
+int dpleph_r (JPLEphem *, double *, int, int, double *) ;
+int dpleph_block_r (JPLEphem *, long, double *, int, int, double *) ;
+int prefetchephem_r (JPLEphem *, double *, double *, double **, long *) ;
+long ephemtablesize_r (const JPLEphem *) ;
+long ephemswitches_r (const JPLEphem *) ;
+JPLEphem *cloneephem_r (const JPLEphem *) ;
+void freeephem_r (JPLEphem *) ;
 }
 
 namespace {
 
   using namespace timeSystem;
 
+  /** \class ThreadEphemerisCont
+      \brief Class to hold copies of JPL ephemeris states, one per original, to be used by one thread exclusively.
+  */
+  class ThreadEphemerisCont {
+    public:
+      /// \brief Destruct this ThreadEphemerisCont object, destroying all copies of JPL ephemeris states.
+      ~ThreadEphemerisCont();
+
+      /** \brief Return a copy of a given JPL ephemeris state, creating one on the first request, and re-creating one
+                 after the given state is updated.
+          \param master_ephem Initialized JPL ephemeris state to be copied.
+          \param master_version Number of updates of master_ephem so far.
+          \param master_mutex Mutex to lock while master_ephem is copied.
+      */
+      JPLEphem & getEphemeris(const JPLEphem & master_ephem, long master_version, std::mutex & master_mutex);
+
+    private:
+      typedef std::map<const JPLEphem *, std::pair<long, JPLEphem *> > container_type;
+      container_type m_ephem_cont;
+  };
+
+  ThreadEphemerisCont::~ThreadEphemerisCont() {
+    for (container_type::iterator itor = m_ephem_cont.begin(); itor != m_ephem_cont.end(); ++itor) freeephem_r(itor->second.second);
+  }
+
+  JPLEphem & ThreadEphemerisCont::getEphemeris(const JPLEphem & master_ephem, long master_version, std::mutex & master_mutex) {
+    container_type::iterator itor = m_ephem_cont.find(&master_ephem);
+    if (m_ephem_cont.end() == itor || master_version != itor->second.first) {
+      // Copy the given ephemeris state on the first request, or after it is updated by prefetching records.
+      JPLEphem * ephem = 0;
+      {
+        std::lock_guard<std::mutex> lock(master_mutex);
+        ephem = cloneephem_r(&master_ephem);
+      }
+      if (0 == ephem) throw std::runtime_error("Could not allocate memory for solar system ephemeris");
+      if (m_ephem_cont.end() == itor) {
+        container_type::mapped_type ephem_copy(master_version, ephem);
+        itor = m_ephem_cont.insert(container_type::value_type(&master_ephem, ephem_copy)).first;
+      } else {
+        freeephem_r(itor->second.second);
+        itor->second = container_type::mapped_type(master_version, ephem);
+      }
+    }
+    return *itor->second.second;
+  }
+
   /** \class JplComputer
       \brief Base class to read JPL solar system ephemeris data and compute geocentric and barycentric times.
              Actual tasks to read JPL solar system ephemeris data is deligated to the C functions
@@ -56,6 +116,77 @@ namespace {
       virtual void computeGeoTime(const SourcePosition & src_position, const std::vector<double> & obs_position,
         AbsoluteTime & abs_time) const;
 
+      /** \brief Compute a barycentric time for a given time, and update the time with a computed time.
+          \param src_position Position of the celestial object for which a barycentric time is computed.
+          \param obs_position Observatory position at the time for which a barycentric time is computed. The position must be
+                 given in the form of Cartesian coordinates in meters in the equatorial coordinate system with the origin at
+                 the center of the Earth.
+          \param abs_time Photon arrival time at the spacecraft. This argument is updated to a barycentric time for it.
+      */
+      virtual void computeBaryTime(const SourcePosition & src_position, const double obs_position[3], AbsoluteTime & abs_time) const;
+
+      /** \brief Compute a geocentric time for a given time, and update the time with a computed time.
+          \param src_position Position of the celestial object for which a geocentric time is computed.
+          \param obs_position Observatory position at the time for which a geocentric time is computed. The position must be
+                 given in the form of Cartesian coordinates in meters in the equatorial coordinate system with the origin at
+                 the center of the Earth.
+          \param abs_time Photon arrival time at the spacecraft. This argument is updated to a geocentric time for it.
+      */
+      virtual void computeGeoTime(const SourcePosition & src_position, const double obs_position[3], AbsoluteTime & abs_time) const;
+
+      /** \brief Compute time delays for barycentric corrections for a block of given times, and set them to the last argument.
+          \param src_position Position of the celestial object for which barycentric times are computed.
+          \param obs_position Observatory positions at the times for which barycentric times are computed, three elements
+                 (X, Y, and Z) per time, in the same order as tt_time. The positions must be given in the form of Cartesian
+                 coordinates in meters in the equatorial coordinate system with the origin at the center of the Earth.
+          \param tt_time Photon arrival times at the spacecraft, given as Julian Dates in TT system.
+          \param delay Time delays in seconds to be added to the arrival times in TDB system, in the same order as tt_time.
+      */
+      virtual void computeBaryDelay(const SourcePosition & src_position, const std::vector<double> & obs_position,
+        const std::vector<Jd> & tt_time, std::vector<double> & delay) const;
+
+      /** \brief Compute time delays for geocentric corrections for a block of given times, and set them to the last argument.
+          \param src_position Position of the celestial object for which geocentric times are computed.
+          \param obs_position Observatory positions at the times for which geocentric times are computed, three elements
+                 (X, Y, and Z) per time, in the same order as tt_time. The positions must be given in the form of Cartesian
+                 coordinates in meters in the equatorial coordinate system with the origin at the center of the Earth.
+          \param tt_time Photon arrival times at the spacecraft, given as Julian Dates in TT system.
+          \param delay Time delays in seconds to be added to the arrival times in TT system, in the same order as tt_time.
+      */
+      virtual void computeGeoDelay(const SourcePosition & src_position, const std::vector<double> & obs_position,
+        const std::vector<Jd> & tt_time, std::vector<double> & delay) const;
+
+      /** \brief Compute time delays for barycentric corrections for a block of given times, for each of given sources at once,
+                 and set them to the last argument.
+          \param src_position Positions of the celestial objects for which barycentric times are computed.
+          \param obs_position Observatory positions at the times for which barycentric times are computed, three elements
+                 (X, Y, and Z) per time, in the same order as tt_time. The positions must be given in the form of Cartesian
+                 coordinates in meters in the equatorial coordinate system with the origin at the center of the Earth.
+          \param tt_time Photon arrival times at the spacecraft, given as Julian Dates in TT system.
+          \param delay Time delays in seconds to be added to the arrival times in TDB system, source by source.
+      */
+      virtual void computeBaryDelay(const std::vector<SourcePosition> & src_position, const std::vector<double> & obs_position,
+        const std::vector<Jd> & tt_time, std::vector<double> & delay) const;
+
+      /** \brief Compute time delays for geocentric corrections for a block of given times, for each of given sources at once,
+                 and set them to the last argument.
+          \param src_position Positions of the celestial objects for which geocentric times are computed.
+          \param obs_position Observatory positions at the times for which geocentric times are computed, three elements
+                 (X, Y, and Z) per time, in the same order as tt_time. The positions must be given in the form of Cartesian
+                 coordinates in meters in the equatorial coordinate system with the origin at the center of the Earth.
+          \param tt_time Photon arrival times at the spacecraft, given as Julian Dates in TT system.
+          \param delay Time delays in seconds to be added to the arrival times in TT system, source by source.
+      */
+      virtual void computeGeoDelay(const std::vector<SourcePosition> & src_position, const std::vector<double> & obs_position,
+        const std::vector<Jd> & tt_time, std::vector<double> & delay) const;
+
+      /** \brief Read records of JPL ephemeris that cover a given time span into memory at once, unless they are already
+                 in memory, and throw an exception if any part of the span is outside the range of JPL ephemeris.
+          \param tt_start Start of the time span, given as a Julian Date in TT system.
+          \param tt_stop End of the time span, given as a Julian Date in TT system.
+      */
+      virtual void prefetchEphemeris(const Jd & tt_start, const Jd & tt_stop) const;
+
     protected:
       /** \brief Construct a JplComputer object.
           \param pl_ephem Name of the JPL planetary ephemeris, such as "JPL DE405".
@@ -63,6 +194,9 @@ namespace {
       */
       JplComputer(const std::string & pl_ephem, int eph_num);
 
+      /// \brief Destruct this JplComputer object.
+      virtual ~JplComputer();
+
       /// \brief Initialize this JplComputer object.
       virtual void initializeComputer();
 
@@ -70,25 +204,118 @@ namespace {
       int m_ephnum;
       double m_speed_of_light;
       double m_solar_mass;
-      static const JplComputer * m_initialized_computer;
+      JPLEphem * m_ephem;
+      mutable std::mutex m_ephem_mutex;
+      mutable std::atomic<long> m_ephem_version;
+      mutable std::vector<double *> m_retired_table;
+
+      /** \brief Helper method to return the state of JPL ephemeris to be used by the calling thread exclusively.
+                 On the first call in a thread, the state initialized by initializeComputer method is copied for the thread,
+                 so that JPL ephemeris can be read in parallel without locking. The state is copied again after records
+                 are read into memory by prefetchEphemeris method.
+      */
+      JPLEphem & getThreadEphemeris() const;
 
       /** \brief Helper method to compute (and return) a time delay for a geocentric or a barycentric correction.
           \param src_position Position of the celestial object for which a geo/barycentric time is computed.
           \param obs_position Observatory position at the time for which a geo/barycentric time is computed. The position must be
                  given in the form of Cartesian coordinates in meters in the equatorial coordinate system with the origin at
                  the center of the Earth.
-          \param abs_time Photon arrival time at the spacecraft. This argument is updated to a geo/barycentric time for it.
+          \param abs_time Photon arrival time at the spacecraft.
           \param barycentric If true, a time delay for a barycentric correction is computed. If false, one for a geocentric
                  correction is computed.
       */
-      double computeTimeDelay(const SourcePosition & src_position, const std::vector<double> & obs_position,
-        AbsoluteTime & abs_time, bool barycentric) const;
+      double computeTimeDelay(const SourcePosition & src_position, const double obs_position[3], const AbsoluteTime & abs_time,
+        bool barycentric) const;
+
+      /** \brief Helper method to compute time delays for geocentric or barycentric corrections for a block of given times.
+          \param src_position Position of the celestial object for which geo/barycentric times are computed.
+          \param obs_position Observatory positions at the times for which geo/barycentric times are computed, three elements
+                 (X, Y, and Z) per time, in the same order as tt_time. The positions must be given in the form of Cartesian
+                 coordinates in meters in the equatorial coordinate system with the origin at the center of the Earth.
+          \param tt_time Photon arrival times at the spacecraft, given as Julian Dates in TT system.
+          \param barycentric If true, time delays for barycentric corrections are computed. If false, ones for geocentric
+                 corrections are computed.
+          \param delay Computed time delays in seconds, in the same order as tt_time.
+      */
+      void computeTimeDelay(const SourcePosition & src_position, const std::vector<double> & obs_position,
+        const std::vector<Jd> & tt_time, bool barycentric, std::vector<double> & delay) const;
+
+      /** \brief Helper method to compute time delays for geocentric or barycentric corrections for a block of given times,
+                 for each of given sources. Solar system ephemeris is read only once per time for all the sources.
+          \param src_position Positions of the celestial objects for which geo/barycentric times are computed.
+          \param obs_position Observatory positions at the times for which geo/barycentric times are computed, three elements
+                 (X, Y, and Z) per time, in the same order as tt_time. The positions must be given in the form of Cartesian
+                 coordinates in meters in the equatorial coordinate system with the origin at the center of the Earth.
+          \param tt_time Photon arrival times at the spacecraft, given as Julian Dates in TT system.
+          \param barycentric If true, time delays for barycentric corrections are computed. If false, ones for geocentric
+                 corrections are computed.
+          \param delay Computed time delays in seconds, for the first source in the same order as tt_time, followed by those
+                 for the second source, and so on.
+      */
+      void computeTimeDelay(const std::vector<SourcePosition> & src_position, const std::vector<double> & obs_position,
+        const std::vector<Jd> & tt_time, bool barycentric, std::vector<double> & delay) const;
+
+      /** \brief Helper method to read solar system ephemeris of the Earth and the Sun for a given time.
+          \param ephem State of JPL ephemeris to read from.
+          \param tt_time Time for which solar system ephemeris is read, given as a Julian Date in TT system.
+          \param ephemeris Positions and velocities of the Earth and the Sun with respect to the solar system barycenter,
+                 in light-seconds and light-seconds per second, are set to this argument. The first three elements are
+                 for the Earth position, the next three for the Earth velocity, and the next three for the Sun position.
+      */
+      void readEphemeris(JPLEphem & ephem, const Jd & tt_time, double ephemeris[12]) const;
+
+      /** \brief Helper method to read solar system ephemeris of the Earth and the Sun for a block of given times at once.
+          \param ephem State of JPL ephemeris to read from.
+          \param tt_time Times for which solar system ephemeris is read, given as Julian Dates in TT system.
+          \param ephemeris Positions and velocities of the Earth and the Sun as in the other readEphemeris method are set to
+                 this argument, twelve elements per time in the same order as tt_time.
+      */
+      void readEphemeris(JPLEphem & ephem, const std::vector<Jd> & tt_time, std::vector<double> & ephemeris) const;
+
+      /** \brief Helper method to compute (and return) a time delay for a geocentric or a barycentric correction, using
+                 only fixed-size work arrays on the stack.
+          \param src_position Position of the celestial object for which a geo/barycentric time is computed.
+          \param obs_position Observatory position at the time for which a geo/barycentric time is computed. The position must be
+                 given in the form of Cartesian coordinates in meters in the equatorial coordinate system with the origin at
+                 the center of the Earth.
+          \param ephemeris Solar system ephemeris read by readEphemeris method at the time. Ignored (and may be null) if
+                 neither a barycentric correction is computed, nor the distance to the source is known.
+          \param barycentric If true, a time delay for a barycentric correction is computed. If false, one for a geocentric
+                 correction is computed.
+      */
+      double computeTimeDelay(const SourcePosition & src_position, const double obs_position[3], const double * ephemeris,
+        bool barycentric) const;
+
+      /** \brief Helper method to compute time delays for geocentric or barycentric corrections for a block of given times,
+                 for each of given sources at an infinite distance. Inputs are rearranged into a structure of arrays (one array per
+                 Cartesian component), and each term of the delays is computed in a loop over the times that compilers
+                 can vectorize with the SIMD instructions available on the target, falling back to scalar code otherwise.
+                 The loops evaluate the same floating-point operations in the same order as the per-time computation, so the
+                 delays agree with it bit for bit, unless the compiler contracts multiply-adds (e.g., -ffp-contract=fast on
+                 a target with FMA), in which case they differ by no more than 4 ULP of each delay. The terms that do not
+                 depend on the source are computed only once for all the sources.
+          \param src_direction Unit vectors pointing to the sources.
+          \param obs_position Observatory positions at the times for which geo/barycentric times are computed, three elements
+                 (X, Y, and Z) per time. The positions must be given in the form of Cartesian coordinates in meters in the
+                 equatorial coordinate system with the origin at the center of the Earth.
+          \param ephemeris Solar system ephemeris read by readEphemeris method at the times, twelve elements per time.
+                 Ignored (and may be empty) if geocentric corrections are computed.
+          \param num_time The number of times.
+          \param barycentric If true, time delays for barycentric corrections are computed. If false, ones for geocentric
+                 corrections are computed.
+          \param delay Computed time delays in seconds, for the first source in the same order as the times, followed by
+                 those for the second source, and so on.
+      */
+      void computePlanarTimeDelay(const std::vector<const double *> & src_direction, const std::vector<double> & obs_position,
+        const std::vector<double> & ephemeris, std::vector<double>::size_type num_time, bool barycentric,
+        std::vector<double> & delay) const;
 
       /** \brief Helper method to compute an inner product of a pair of three-vectors.
           \param vect_x One of the three vector to compute an inner product for.
           \param vect_y The other of the three vector to compute an inner product for.
       */
-      double computeInnerProduct(const std::vector<double> & vect_x, const std::vector<double> & vect_y) const;
+      double computeInnerProduct(const double vect_x[3], const double vect_y[3]) const;
   };
 
   /** \class JplDe200Computer
@@ -109,43 +336,88 @@ namespace {
       JplDe405Computer(): JplComputer("JPL DE405", 405) {}
   };
 
-  const JplComputer * JplComputer::m_initialized_computer(0);
-
   JplComputer::JplComputer(const std::string & pl_ephem, int eph_num): BaryTimeComputer(pl_ephem), m_ephnum(eph_num),
-    m_speed_of_light(0.), m_solar_mass(0.) {}
+    m_speed_of_light(0.), m_solar_mass(0.), m_ephem(0), m_ephem_mutex(), m_ephem_version(0), m_retired_table() {}
+
+  JplComputer::~JplComputer() {
+    freeephem_r(m_ephem);
+    for (std::vector<double *>::iterator itor = m_retired_table.begin(); itor != m_retired_table.end(); ++itor) std::free(*itor);
+  }
 
   void JplComputer::initializeComputer() {
-    // Check whether initialized or not.
-    if (m_initialized_computer) {
-      if (this != m_initialized_computer) {
-        // Alrady initialized with a different planetary ephemeris (currently JPL DE200 and DE405 cannot coexist).
-        // TODO: Allow JPL DE200 and DE405 to coexist.
-        std::ostringstream os;
-        os << "Requested planetary ephemeris \"" << getPlanetaryEphemerisName() << "\" cannot coexist with \"" <<
-          m_initialized_computer->getPlanetaryEphemerisName() << "\" that is already in use";
-        throw std::runtime_error(os.str());
-      }
+    // Create an ephemeris state owned by this object.
+    // Note: Each JplComputer object has its own ephemeris state, so that different planetary ephemerides can coexist.
+    if (0 == m_ephem) m_ephem = newephem_r();
+    if (0 == m_ephem) throw std::runtime_error("Could not allocate memory for solar system ephemeris");
+
+    // Call initephem_r C-function.
+    int denum = 0;
+    double radsol = 0.;
+    int status = initephem_r(m_ephem, m_ephnum, &denum, &m_speed_of_light, &radsol, &m_solar_mass);
+
+    // Check initialization status.
+    if (status) {
+      std::ostringstream os;
+      os << "Error while initializing ephemeris (status = " << status << ")";
+      throw std::runtime_error(os.str());
+    }
+    PerformanceMonitor::addCount(PerformanceMonitor::EPHEMERIS_BYTES_PRELOADED, ephemtablesize_r(m_ephem));
+  }
 
-    } else {
-      // Call initephem C-function.
-      int denum = 0;
-      double radsol = 0.;
-      int status = initephem(m_ephnum, &denum, &m_speed_of_light, &radsol, &m_solar_mass);
-
-      // Check initialization status.
-      if (status) {
-        std::ostringstream os;
-        os << "Error while initializing ephemeris (status = " << status << ")";
-        throw std::runtime_error(os.str());
-      }
-        
-      // Store the pointer to this object to indicate a sucessful initialization.
-      m_initialized_computer = this;
+  void JplComputer::prefetchEphemeris(const Jd & tt_start, const Jd & tt_stop) const {
+    std::lock_guard<std::mutex> lock(m_ephem_mutex);
+
+    // Read the records for the given time span, if not in memory yet.
+    double jd_start[2] = { static_cast<double>(tt_start.m_int), tt_start.m_frac };
+    double jd_stop[2] = { static_cast<double>(tt_stop.m_int), tt_stop.m_frac };
+    double * old_table = 0;
+    long num_byte = 0;
+    int status = prefetchephem_r(m_ephem, jd_start, jd_stop, &old_table, &num_byte);
+    if (status) {
+      std::ostringstream os;
+      os << "Error while prefetching ephemeris (status = " << status << ")";
+      throw std::runtime_error(os.str());
     }
+
+    // Keep the records replaced by the new ones, which may still be used by copies held by threads.
+    if (old_table) m_retired_table.push_back(old_table);
+
+    // Let threads copy the updated ephemeris state.
+    if (num_byte > 0) {
+      PerformanceMonitor::addCount(PerformanceMonitor::EPHEMERIS_BYTES_PRELOADED, num_byte);
+      ++m_ephem_version;
+    }
+  }
+
+  JPLEphem & JplComputer::getThreadEphemeris() const {
+    static thread_local ThreadEphemerisCont s_ephem_cont;
+    return s_ephem_cont.getEphemeris(*m_ephem, m_ephem_version.load(), m_ephem_mutex);
   }
 
   void JplComputer::computeBaryTime(const SourcePosition & src_position, const std::vector<double> & obs_position,
     AbsoluteTime & abs_time) const {
+    // Check the size of obs_position.
+    if (obs_position.size() < 3) {
+      throw std::runtime_error("Space craft position was given in a wrong format");
+    }
+
+    // Compute a barycentric time.
+    computeBaryTime(src_position, &obs_position[0], abs_time);
+  }
+
+  void JplComputer::computeGeoTime(const SourcePosition & src_position, const std::vector<double> & obs_position,
+    AbsoluteTime & abs_time) const {
+    // Check the size of obs_position.
+    if (obs_position.size() < 3) {
+      throw std::runtime_error("Space craft position was given in a wrong format");
+    }
+
+    // Compute a geocentric time.
+    computeGeoTime(src_position, &obs_position[0], abs_time);
+  }
+
+  void JplComputer::computeBaryTime(const SourcePosition & src_position, const double obs_position[3], AbsoluteTime & abs_time)
+    const {
     // Compute a time delay for the barycentric correction.
     double delay = computeTimeDelay(src_position, obs_position, abs_time, true);
 
@@ -157,70 +429,203 @@ namespace {
     //       On the contrary, if "TT" is given, TT-to-TDB conversion would take place after the time difference is added.
     //       In that case, the time difference, TDB - TT, would be computed at a time different from the given absolute time,
     //       and may be significantly different from that at the given absolute time.
-    abs_time += ElapsedTime("TDB", Duration(delay, "Sec"));
+    static const TimeSystem & s_tdb_system(TimeSystem::getSystem("TDB"));
+    abs_time += ElapsedTime(s_tdb_system, Duration::from<Sec>(delay));
   }
 
-  void JplComputer::computeGeoTime(const SourcePosition & src_position, const std::vector<double> & obs_position,
-    AbsoluteTime & abs_time) const {
+  void JplComputer::computeGeoTime(const SourcePosition & src_position, const double obs_position[3], AbsoluteTime & abs_time)
+    const {
     // Compute a time delay for the geocentric correction.
     double delay = computeTimeDelay(src_position, obs_position, abs_time, false);
 
     // Compute a geocenteric time for the give arrival time.
-    abs_time += ElapsedTime("TT", Duration(delay, "Sec"));
+    static const TimeSystem & s_tt_system(TimeSystem::getSystem("TT"));
+    abs_time += ElapsedTime(s_tt_system, Duration::from<Sec>(delay));
   }
 
-  double JplComputer::computeTimeDelay(const SourcePosition & src_position, const std::vector<double> & obs_position,
-    AbsoluteTime & abs_time, bool barycentric) const {
+  void JplComputer::computeBaryDelay(const SourcePosition & src_position, const std::vector<double> & obs_position,
+    const std::vector<Jd> & tt_time, std::vector<double> & delay) const {
+    computeTimeDelay(src_position, obs_position, tt_time, true, delay);
+  }
+
+  void JplComputer::computeGeoDelay(const SourcePosition & src_position, const std::vector<double> & obs_position,
+    const std::vector<Jd> & tt_time, std::vector<double> & delay) const {
+    computeTimeDelay(src_position, obs_position, tt_time, false, delay);
+  }
+
+  void JplComputer::computeBaryDelay(const std::vector<SourcePosition> & src_position, const std::vector<double> & obs_position,
+    const std::vector<Jd> & tt_time, std::vector<double> & delay) const {
+    computeTimeDelay(src_position, obs_position, tt_time, true, delay);
+  }
+
+  void JplComputer::computeGeoDelay(const std::vector<SourcePosition> & src_position, const std::vector<double> & obs_position,
+    const std::vector<Jd> & tt_time, std::vector<double> & delay) const {
+    computeTimeDelay(src_position, obs_position, tt_time, false, delay);
+  }
+
+  double JplComputer::computeTimeDelay(const SourcePosition & src_position, const double obs_position[3],
+    const AbsoluteTime & abs_time, bool barycentric) const {
+    // Read solar system ephemeris for the given time, when necessary.
+    double ephemeris[12];
+    if (barycentric || src_position.hasDistance()) {
+      static const TimeSystem & s_tt_system(TimeSystem::getSystem("TT"));
+      Jd jd_rep(0, 0.);
+      abs_time.get(s_tt_system, jd_rep);
+      readEphemeris(getThreadEphemeris(), jd_rep, ephemeris);
+    }
+
+    // Compute the time delay, and return it.
+    return computeTimeDelay(src_position, obs_position, ephemeris, barycentric);
+  }
+
+  void JplComputer::computeTimeDelay(const SourcePosition & src_position, const std::vector<double> & obs_position,
+    const std::vector<Jd> & tt_time, bool barycentric, std::vector<double> & delay) const {
     // Check the size of obs_position.
-    if (obs_position.size() < 3) {
+    std::vector<Jd>::size_type num_time = tt_time.size();
+    if (obs_position.size() < 3 * num_time) {
       throw std::runtime_error("Space craft position was given in a wrong format");
     }
 
+    // Use the structure-of-arrays computation for a source at an infinite distance.
+    if (!src_position.hasDistance()) {
+      std::vector<double> ephemeris;
+      if (barycentric && num_time > 0) readEphemeris(getThreadEphemeris(), tt_time, ephemeris);
+      computePlanarTimeDelay(std::vector<const double *>(1, &src_position.getDirection()[0]), obs_position, ephemeris, num_time,
+        barycentric, delay);
+      return;
+    }
+
     // Prepare the return value.
-    double delay = 0.;
+    delay.assign(num_time, 0.);
 
-    // Read solar system ephemeris when necessary.
-    const double * rce = 0;
-    const double * vce = 0;
-    const double * rcs = 0;
-    if (barycentric || src_position.hasDistance()) {
-      // Set given time to a variable to pass to dpleph C-function.
-      Jd jd_rep(0, 0.);
-      abs_time.get("TT", jd_rep);
-      double jdt[2] = { static_cast<double>(jd_rep.m_int), jd_rep.m_frac };
-
-      // Read solar system ephemeris for the given time.
-      const int iearth = 3;
-      const int isun = 11;
-      const double * eposn = 0;
-      eposn = dpleph(jdt, iearth, isun);
-      if (NULL == eposn) {
-        std::ostringstream os;
-        os << "Could not find solar system ephemeris for " << abs_time.represent("TT", MjdFmt);
-        throw std::runtime_error(os.str());
+    // Read solar system ephemeris for all the given times at once.
+    // Note: The source distance is known here, so that solar system ephemeris is always needed.
+    std::vector<double> ephemeris;
+    readEphemeris(getThreadEphemeris(), tt_time, ephemeris);
+
+    // Loop over the given times.
+    for (std::vector<Jd>::size_type time_index = 0; time_index < num_time; ++time_index) {
+      delay[time_index] = computeTimeDelay(src_position, &obs_position[3 * time_index], &ephemeris[12 * time_index],
+        barycentric);
+    }
+  }
+
+  void JplComputer::computeTimeDelay(const std::vector<SourcePosition> & src_position, const std::vector<double> & obs_position,
+    const std::vector<Jd> & tt_time, bool barycentric, std::vector<double> & delay) const {
+    // Check the size of obs_position.
+    std::vector<Jd>::size_type num_time = tt_time.size();
+    if (obs_position.size() < 3 * num_time) {
+      throw std::runtime_error("Space craft position was given in a wrong format");
+    }
+
+    // Prepare the return value.
+    delay.assign(src_position.size() * num_time, 0.);
+    if (0 == num_time) return;
+
+    // Sort out sources at an infinite distance, to which the structure-of-arrays computation applies.
+    std::vector<const double *> planar_direction;
+    std::vector<std::vector<SourcePosition>::size_type> planar_index;
+    bool need_ephemeris = barycentric;
+    for (std::vector<SourcePosition>::size_type src_index = 0; src_index < src_position.size(); ++src_index) {
+      if (src_position[src_index].hasDistance()) {
+        need_ephemeris = true;
+      } else {
+        planar_direction.push_back(&src_position[src_index].getDirection()[0]);
+        planar_index.push_back(src_index);
       }
+    }
 
-      // Set pointer values for convenience.
-      rce = eposn;     // SSBC-to-Earth vector.
-      vce = eposn + 3; // Earth velocity with respect to SSBC.
-      rcs = eposn + 6; // SSBC-to-Sun vector.
+    // Read solar system ephemeris for all the given times only once for all the sources.
+    std::vector<double> ephemeris;
+    if (need_ephemeris) readEphemeris(getThreadEphemeris(), tt_time, ephemeris);
+
+    // Compute the time delays for the sources at an infinite distance, and move them to their places.
+    if (!planar_direction.empty()) {
+      std::vector<double> planar_delay;
+      computePlanarTimeDelay(planar_direction, obs_position, ephemeris, num_time, barycentric, planar_delay);
+      for (std::vector<double>::size_type ii = 0; ii < planar_index.size(); ++ii) {
+        std::copy(planar_delay.begin() + ii * num_time, planar_delay.begin() + (ii + 1) * num_time,
+          delay.begin() + planar_index[ii] * num_time);
+      }
     }
 
+    // Compute the time delays for the sources at a known distance, one time after another.
+    for (std::vector<SourcePosition>::size_type src_index = 0; src_index < src_position.size(); ++src_index) {
+      if (!src_position[src_index].hasDistance()) continue;
+      for (std::vector<Jd>::size_type time_index = 0; time_index < num_time; ++time_index) {
+        delay[src_index * num_time + time_index] = computeTimeDelay(src_position[src_index], &obs_position[3 * time_index],
+          &ephemeris[12 * time_index], barycentric);
+      }
+    }
+  }
+
+  void JplComputer::readEphemeris(JPLEphem & ephem, const Jd & tt_time, double ephemeris[12]) const {
+    // Set given time to a variable to pass to dpleph_r C-function.
+    double jdt[2] = { static_cast<double>(tt_time.m_int), tt_time.m_frac };
+
+    // Read solar system ephemeris for the given time.
+    const int iearth = 3;
+    const int isun = 11;
+    PerformanceMonitor::StageTimer timer(PerformanceMonitor::EPHEMERIS_INTERPOLATION);
+    long num_switch = ephemswitches_r(&ephem);
+    int status = dpleph_r(&ephem, jdt, iearth, isun, ephemeris);
+    PerformanceMonitor::addCount(PerformanceMonitor::EPHEMERIS_RECORD_SWITCH, ephemswitches_r(&ephem) - num_switch);
+    if (status) {
+      std::ostringstream os;
+      os << "Could not find solar system ephemeris for " << AbsoluteTime("TT", tt_time).represent("TT", MjdFmt);
+      throw std::runtime_error(os.str());
+    }
+  }
+
+  void JplComputer::readEphemeris(JPLEphem & ephem, const std::vector<Jd> & tt_time, std::vector<double> & ephemeris) const {
+    // Set given times to an array to pass to dpleph_block_r C-function.
+    std::vector<Jd>::size_type num_time = tt_time.size();
+    ephemeris.assign(12 * num_time, 0.);
+    if (0 == num_time) return;
+    std::vector<double> jdt(2 * num_time);
+    for (std::vector<Jd>::size_type ii = 0; ii < num_time; ++ii) {
+      jdt[2 * ii] = static_cast<double>(tt_time[ii].m_int);
+      jdt[2 * ii + 1] = tt_time[ii].m_frac;
+    }
+
+    // Read solar system ephemeris for all the given times in one pass.
+    const int iearth = 3;
+    const int isun = 11;
+    PerformanceMonitor::StageTimer timer(PerformanceMonitor::EPHEMERIS_INTERPOLATION);
+    long num_switch = ephemswitches_r(&ephem);
+    int status = dpleph_block_r(&ephem, static_cast<long>(num_time), &jdt[0], iearth, isun, &ephemeris[0]);
+    PerformanceMonitor::addCount(PerformanceMonitor::EPHEMERIS_RECORD_SWITCH, ephemswitches_r(&ephem) - num_switch);
+    if (status) {
+      // Read them one by one to report the time for which ephemeris is not available.
+      for (std::vector<Jd>::size_type ii = 0; ii < num_time; ++ii) readEphemeris(ephem, tt_time[ii], &ephemeris[12 * ii]);
+    }
+  }
+
+  double JplComputer::computeTimeDelay(const SourcePosition & src_position, const double obs_position[3],
+    const double * ephemeris, bool barycentric) const {
+    double this_delay = 0.;
+
+    // Set pointer values for convenience.
+    const double * rce = ephemeris;     // SSBC-to-Earth vector.
+    const double * vce = ephemeris + 3; // Earth velocity with respect to SSBC.
+    const double * rcs = ephemeris + 6; // SSBC-to-Sun vector.
+    const double * src_direction = &src_position.getDirection()[0];
+
     // Compute the vector pointing from the geo/barycenter to the spacecraft.
-    std::vector<double> origin_to_observer(3);
+    double origin_to_observer[3];
     for (int idx = 0; idx < 3; ++idx) origin_to_observer[idx] = obs_position[idx]/m_speed_of_light;
     if (barycentric) for (int idx = 0; idx < 3; ++idx) origin_to_observer[idx] += rce[idx];
 
     // Compute the Roemer delay and the direction of the line of sight.
-    std::vector<double> line_of_sight(3);
+    double line_of_sight[3];
     if (src_position.hasDistance()) {
       // Compute the vector pointing from the geo/barycenter to the source.
-      std::vector<double> origin_to_source = src_position.getDirection();
-      for (int idx = 0; idx < 3; ++idx) origin_to_source[idx] *= src_position.getDistance();
+      double origin_to_source[3];
+      for (int idx = 0; idx < 3; ++idx) origin_to_source[idx] = src_direction[idx] * src_position.getDistance();
       if (!barycentric) for (int idx = 0; idx < 3; ++idx) origin_to_source[idx] -= rce[idx];
 
       // Compute the vector pointing from the spacecraft to the source.
-      std::vector<double> observer_to_source(3);
+      double observer_to_source[3];
       for (int idx = 0; idx < 3; ++idx) {
         observer_to_source[idx] = origin_to_source[idx] - origin_to_observer[idx];
       }
@@ -240,38 +645,144 @@ namespace {
       sum_length += std::sqrt(computeInnerProduct(observer_to_source, observer_to_source));
       if (sum_length == 0.) throw std::runtime_error("Distance to the source is computed as zero (0) in the barycentric correction");
       for (int idx = 0; idx < 3; ++idx) {
-        delay += (origin_to_source[idx] + observer_to_source[idx]) * origin_to_observer[idx] / sum_length;
+        this_delay += (origin_to_source[idx] + observer_to_source[idx]) * origin_to_observer[idx] / sum_length;
       }
 
     } else {
       // Take the original source direction as the line of sight, assuming the wavefront is planar.
-      line_of_sight = src_position.getDirection();
+      for (int idx = 0; idx < 3; ++idx) line_of_sight[idx] = src_direction[idx];
 
       // Compute the Roemer delay, assuming the wavefront is planar.
-      delay += computeInnerProduct(line_of_sight, origin_to_observer);
+      this_delay += computeInnerProduct(line_of_sight, origin_to_observer);
     }
 
     // Compute additional time delays for the barycentric correction.
     if (barycentric) {
       // Compute the Einstein delay.
-      std::vector<double> earth_velocity(vce, vce + 3);
-      delay += computeInnerProduct(obs_position, earth_velocity)/m_speed_of_light;
+      this_delay += computeInnerProduct(obs_position, vce)/m_speed_of_light;
 
       // Compute the vector pointing from the Sun to the spacecraft (to be used for the Shapiro delay).
-      std::vector<double> sun_to_observer(3); // Sun-to-S/C vector.
+      double sun_to_observer[3];
       for (int idx = 0; idx < 3; ++idx) sun_to_observer[idx] = origin_to_observer[idx] - rcs[idx];
 
       // Compute the Shapiro delay.
       double sundis = std::sqrt(computeInnerProduct(sun_to_observer, sun_to_observer));
       double cth = computeInnerProduct(line_of_sight, sun_to_observer) / sundis;
-      delay += 2. * m_solar_mass * std::log(1. + cth);
+      this_delay += 2. * m_solar_mass * std::log(1. + cth);
     }
 
     // Return the computed time delay.
-    return delay;
+    return this_delay;
+  }
+
+  void JplComputer::computePlanarTimeDelay(const std::vector<const double *> & src_direction, const std::vector<double> & obs_position,
+    const std::vector<double> & ephemeris, std::vector<double>::size_type num_time, bool barycentric,
+    std::vector<double> & delay) const {
+    typedef std::vector<double>::size_type size_type;
+    const size_type num_src = src_direction.size();
+    delay.assign(num_src * num_time, 0.);
+    if (0 == num_time) return;
+
+    // Rearrange the spacecraft positions into one array per component.
+    std::vector<double> obs_x(num_time);
+    std::vector<double> obs_y(num_time);
+    std::vector<double> obs_z(num_time);
+    for (size_type ii = 0; ii < num_time; ++ii) {
+      obs_x[ii] = obs_position[3 * ii];
+      obs_y[ii] = obs_position[3 * ii + 1];
+      obs_z[ii] = obs_position[3 * ii + 2];
+    }
+
+    // Compute the vector pointing from the geocenter to the spacecraft.
+    std::vector<double> oto_x(num_time);
+    std::vector<double> oto_y(num_time);
+    std::vector<double> oto_z(num_time);
+    const double speed_of_light = m_speed_of_light;
+    for (size_type ii = 0; ii < num_time; ++ii) {
+      oto_x[ii] = obs_x[ii] / speed_of_light;
+      oto_y[ii] = obs_y[ii] / speed_of_light;
+      oto_z[ii] = obs_z[ii] / speed_of_light;
+    }
+
+    // Compute the time delays for the geocentric correction (the Roemer delay with respect to the geocenter).
+    if (!barycentric) {
+      for (size_type src_index = 0; src_index < num_src; ++src_index) {
+        const double los_x = src_direction[src_index][0];
+        const double los_y = src_direction[src_index][1];
+        const double los_z = src_direction[src_index][2];
+        double * src_delay = &delay[src_index * num_time];
+        for (size_type ii = 0; ii < num_time; ++ii) src_delay[ii] = los_x * oto_x[ii] + los_y * oto_y[ii] + los_z * oto_z[ii];
+      }
+      return;
+    }
+
+    // Rearrange solar system ephemeris into one array per component.
+    std::vector<double> rce_x(num_time);
+    std::vector<double> rce_y(num_time);
+    std::vector<double> rce_z(num_time);
+    std::vector<double> vce_x(num_time);
+    std::vector<double> vce_y(num_time);
+    std::vector<double> vce_z(num_time);
+    std::vector<double> rcs_x(num_time);
+    std::vector<double> rcs_y(num_time);
+    std::vector<double> rcs_z(num_time);
+    for (size_type ii = 0; ii < num_time; ++ii) {
+      const double * this_ephemeris = &ephemeris[12 * ii];
+      rce_x[ii] = this_ephemeris[0];
+      rce_y[ii] = this_ephemeris[1];
+      rce_z[ii] = this_ephemeris[2];
+      vce_x[ii] = this_ephemeris[3];
+      vce_y[ii] = this_ephemeris[4];
+      vce_z[ii] = this_ephemeris[5];
+      rcs_x[ii] = this_ephemeris[6];
+      rcs_y[ii] = this_ephemeris[7];
+      rcs_z[ii] = this_ephemeris[8];
+    }
+
+    // Compute the vector pointing from the barycenter to the spacecraft.
+    for (size_type ii = 0; ii < num_time; ++ii) {
+      oto_x[ii] += rce_x[ii];
+      oto_y[ii] += rce_y[ii];
+      oto_z[ii] += rce_z[ii];
+    }
+
+    // Compute the Einstein delay, which does not depend on the source.
+    std::vector<double> einstein(num_time);
+    for (size_type ii = 0; ii < num_time; ++ii) {
+      einstein[ii] = (obs_x[ii] * vce_x[ii] + obs_y[ii] * vce_y[ii] + obs_z[ii] * vce_z[ii]) / speed_of_light;
+    }
+
+    // Compute the vector pointing from the Sun to the spacecraft (to be used for the Shapiro delay), and its length,
+    // reusing the arrays for the SSBC-to-Sun vector.
+    std::vector<double> sundis(num_time);
+    for (size_type ii = 0; ii < num_time; ++ii) {
+      rcs_x[ii] = oto_x[ii] - rcs_x[ii];
+      rcs_y[ii] = oto_y[ii] - rcs_y[ii];
+      rcs_z[ii] = oto_z[ii] - rcs_z[ii];
+    }
+    for (size_type ii = 0; ii < num_time; ++ii) sundis[ii] = std::sqrt(rcs_x[ii] * rcs_x[ii] + rcs_y[ii] * rcs_y[ii] + rcs_z[ii] * rcs_z[ii]);
+
+    // Compute the source-dependent terms for each source.
+    const double solar_mass = m_solar_mass;
+    for (size_type src_index = 0; src_index < num_src; ++src_index) {
+      const double los_x = src_direction[src_index][0];
+      const double los_y = src_direction[src_index][1];
+      const double los_z = src_direction[src_index][2];
+      double * src_delay = &delay[src_index * num_time];
+
+      // Compute the Roemer delay, assuming the wavefront is planar, and add the Einstein delay.
+      for (size_type ii = 0; ii < num_time; ++ii) src_delay[ii] = los_x * oto_x[ii] + los_y * oto_y[ii] + los_z * oto_z[ii];
+      for (size_type ii = 0; ii < num_time; ++ii) src_delay[ii] += einstein[ii];
+
+      // Compute the Shapiro delay.
+      for (size_type ii = 0; ii < num_time; ++ii) {
+        double cth = (los_x * rcs_x[ii] + los_y * rcs_y[ii] + los_z * rcs_z[ii]) / sundis[ii];
+        src_delay[ii] += 2. * solar_mass * std::log(1. + cth);
+      }
+    }
   }
 
-  double JplComputer::computeInnerProduct(const std::vector<double> & vect_x, const std::vector<double> & vect_y) const {
+  double JplComputer::computeInnerProduct(const double vect_x[3], const double vect_y[3]) const {
     return vect_x[0]*vect_y[0] + vect_x[1]*vect_y[1] + vect_x[2]*vect_y[2];
   }
 
@@ -279,7 +790,7 @@ namespace {
 
 namespace timeSystem {
 
-  BaryTimeComputer::BaryTimeComputer(const std::string & pl_ephem): m_pl_ephem(pl_ephem) {
+  BaryTimeComputer::BaryTimeComputer(const std::string & pl_ephem): m_pl_ephem(pl_ephem), m_initialized(false) {
     std::string uc_pl_ephem = pl_ephem;
     for (std::string::iterator itor = uc_pl_ephem.begin(); itor != uc_pl_ephem.end(); ++itor) *itor = std::toupper(*itor);
     getContainer()[uc_pl_ephem] = this;
@@ -288,30 +799,36 @@ namespace timeSystem {
   BaryTimeComputer::~BaryTimeComputer() {}
 
   const BaryTimeComputer & BaryTimeComputer::getComputer(const std::string & pl_ephem) {
-    // Create instances of BaryTimeComputer's.
-    static JplDe200Computer s_jpl_de200;
-    static JplDe405Computer s_jpl_de405;
+    // Create instances of BaryTimeComputer's, which register themselves, only once.
+    // Note: The registry is never modified after this initialization, which is done only once even if this method is called
+    //       in multiple threads at the same time, so that it can be read without locks.
+    static const container_type & s_container([]() -> const container_type & {
+      static JplDe200Computer s_jpl_de200;
+      static JplDe405Computer s_jpl_de405;
+      return getContainer();
+    }());
 
     // Make the given planeraty ephemeris name case-insensitive.
     std::string pl_ephem_uc(pl_ephem);
     for (std::string::iterator itor = pl_ephem_uc.begin(); itor != pl_ephem_uc.end(); ++itor) *itor = std::toupper(*itor);
 
     // Find a requested BaryTimeComputer object.
-    const container_type & container(getContainer());
-    container_type::const_iterator cont_itor = container.find(pl_ephem_uc);
-    if (container.end() == cont_itor) {
+    container_type::const_iterator cont_itor = s_container.find(pl_ephem_uc);
+    if (s_container.end() == cont_itor) {
       throw std::runtime_error("BaryTimeComputer::getComputer could not find a barycentric time computer for planetary ephemeris "
         + pl_ephem);
     }
     BaryTimeComputer & computer(*cont_itor->second);
 
-    // Check whether the chosen computer has already been initialized.
-    static std::set<const BaryTimeComputer *> s_initialized;
-    std::set<const BaryTimeComputer *>::iterator init_itor = s_initialized.find(&computer);
-    if (s_initialized.end() == init_itor) {
-      // Initialize the computer on the first request.
-      computer.initializeComputer();
-      s_initialized.insert(&computer);
+    // Initialize the chosen computer on the first request.
+    // Note: A lock is held only until the computer is initialized, so that only one thread initializes it.
+    if (!computer.m_initialized.load(std::memory_order_acquire)) {
+      static std::mutex s_init_mutex;
+      std::lock_guard<std::mutex> lock(s_init_mutex);
+      if (!computer.m_initialized.load(std::memory_order_relaxed)) {
+        computer.initializeComputer();
+        computer.m_initialized.store(true, std::memory_order_release);
+      }
     }
 
     // Return the barycentric time computer.
@@ -333,6 +850,118 @@ namespace timeSystem {
     computeGeoTime(SourcePosition(ra, dec), obs_position, abs_time);
   }
 
+  void BaryTimeComputer::computeBaryTime(const SourcePosition & src_position, const std::vector<double> & obs_position,
+    std::vector<AbsoluteTime> & abs_time) const {
+    // Convert the given times to Julian Dates in TT system.
+    std::vector<Jd> tt_time(abs_time.size(), Jd(0, 0.));
+    for (std::vector<AbsoluteTime>::size_type idx = 0; idx < abs_time.size(); ++idx) abs_time[idx].get("TT", tt_time[idx]);
+
+    // Compute time delays for the barycentric correction.
+    std::vector<double> delay;
+    computeBaryDelay(src_position, obs_position, tt_time, delay);
+
+    // Compute barycentric times for the given arrival times.
+    // Note: Time system used below must be TDB, for the same reason as explained in JplComputer::computeBaryTime method.
+    for (std::vector<AbsoluteTime>::size_type idx = 0; idx < abs_time.size(); ++idx) {
+      abs_time[idx] += ElapsedTime("TDB", Duration::from<Sec>(delay[idx]));
+    }
+  }
+
+  void BaryTimeComputer::computeGeoTime(const SourcePosition & src_position, const std::vector<double> & obs_position,
+    std::vector<AbsoluteTime> & abs_time) const {
+    // Convert the given times to Julian Dates in TT system.
+    std::vector<Jd> tt_time(abs_time.size(), Jd(0, 0.));
+    for (std::vector<AbsoluteTime>::size_type idx = 0; idx < abs_time.size(); ++idx) abs_time[idx].get("TT", tt_time[idx]);
+
+    // Compute time delays for the geocentric correction.
+    std::vector<double> delay;
+    computeGeoDelay(src_position, obs_position, tt_time, delay);
+
+    // Compute geocentric times for the given arrival times.
+    for (std::vector<AbsoluteTime>::size_type idx = 0; idx < abs_time.size(); ++idx) {
+      abs_time[idx] += ElapsedTime("TT", Duration::from<Sec>(delay[idx]));
+    }
+  }
+
+  void BaryTimeComputer::computeInverseBaryTime(const SourcePosition & src_position,
+    const IObservatoryPositionComputer & obs_computer, std::vector<AbsoluteTime> & abs_time) const {
+    // Solve D(x) = x for each barycentric time T, where D(x) is the time delay in seconds for the barycentric correction of
+    // the arrival time T - x in TDB system. Newton's method gives x' = x + (D(x) - x) / (1 + s), where s is the derivative of
+    // the time delay with respect to the arrival time, estimated from the previous iteration if any.
+    // Note: The time delay changes by about 1.e-4 seconds per second at most, so that even an iteration with s = 0 reduces
+    //       the error of x by a factor of about 1.e-4.
+    // Note: Time system used below must be TDB, for the same reason as explained in JplComputer::computeBaryTime method.
+    static const double s_tolerance = 1.e-9;
+    static const int s_max_iteration = 10;
+    std::size_t num_time = abs_time.size();
+    std::vector<double> estimate(num_time, 0.);
+    std::vector<double> slope(num_time, 0.);
+    std::vector<double> prev_estimate(num_time, 0.);
+    std::vector<double> prev_delay(num_time, 0.);
+    std::vector<bool> has_prev(num_time, false);
+    auto solve = [&](std::vector<std::size_t> & active_index) {
+      std::vector<AbsoluteTime> trial_time;
+      std::vector<double> obs_position;
+      std::vector<Jd> tt_time;
+      std::vector<double> delay;
+      std::vector<std::size_t> next_index;
+      for (int iteration = 0; !active_index.empty(); ++iteration) {
+        if (iteration >= s_max_iteration) {
+          std::ostringstream os;
+          os << "Inverse barycentric correction did not converge in " << s_max_iteration << " iterations for " <<
+            abs_time[active_index.front()];
+          throw std::runtime_error(os.str());
+        }
+
+        // Compute time delays at the trial arrival times, all at once.
+        trial_time.clear();
+        tt_time.assign(active_index.size(), Jd(0, 0.));
+        for (std::size_t idx = 0; idx < active_index.size(); ++idx) {
+          std::size_t time_index = active_index[idx];
+          trial_time.push_back(abs_time[time_index] - ElapsedTime("TDB", Duration::from<Sec>(estimate[time_index])));
+          trial_time.back().get("TT", tt_time[idx]);
+        }
+        obs_computer.computeObsPosition(trial_time, obs_position);
+        computeBaryDelay(src_position, obs_position, tt_time, delay);
+
+        // Update the estimates, and keep iterating for those not yet converged.
+        next_index.clear();
+        for (std::size_t idx = 0; idx < active_index.size(); ++idx) {
+          std::size_t time_index = active_index[idx];
+          double & this_estimate = estimate[time_index];
+          if (has_prev[time_index] && this_estimate != prev_estimate[time_index]) {
+            slope[time_index] = -(delay[idx] - prev_delay[time_index]) / (this_estimate - prev_estimate[time_index]);
+          }
+          prev_estimate[time_index] = this_estimate;
+          prev_delay[time_index] = delay[idx];
+          has_prev[time_index] = true;
+          double step = (delay[idx] - this_estimate) / (1. + slope[time_index]);
+          this_estimate += step;
+          if (std::fabs(step) > s_tolerance) next_index.push_back(time_index);
+        }
+        active_index.swap(next_index);
+      }
+    };
+
+    // Solve for the first time alone, and then for the others at once, starting from the solution for the first time.
+    if (0 == num_time) return;
+    std::vector<std::size_t> active_index(1, 0);
+    solve(active_index);
+    for (std::size_t time_index = 1; time_index < num_time; ++time_index) {
+      estimate[time_index] = estimate[0];
+      slope[time_index] = slope[0];
+      active_index.push_back(time_index);
+    }
+    solve(active_index);
+
+    // Compute arrival times for the given barycentric times.
+    for (std::size_t time_index = 0; time_index < num_time; ++time_index) {
+      abs_time[time_index] -= ElapsedTime("TDB", Duration::from<Sec>(estimate[time_index]));
+    }
+  }
+
+  void BaryTimeComputer::prefetchEphemeris(const Jd & /* tt_start */, const Jd & /* tt_stop */) const {}
+
   BaryTimeComputer::container_type & BaryTimeComputer::getContainer() {
     static container_type s_container;
     return s_container;
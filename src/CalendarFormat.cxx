@@ -6,6 +6,8 @@
 #include "timeSystem/CalendarFormat.h"
 
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
 #include <iomanip>
 #include <limits>
 #include <sstream>
@@ -315,11 +317,32 @@ namespace {
       \brief Helper function to help CalendarFormat, IsoWeekFormat, and OrdinalFormat classes parse a date-and-time string.
              Note that this function does NOT cover all possible combinations of date and time representations defined by
              the ISO 8601 standard. It interprets only the extended format, and requires all values (i.e., it does not
-             allow omission of any value in the given string.
+             allow omission of any value in the given string. A string in the canonical form, such as one created by
+             formatIso8601Format function, is interpreted in a single pass without memory allocation.
   */
-  typedef std::vector<long> array_type;
+  typedef long array_type[5];
   enum DateType { CalendarDate, IsoWeekDate, OrdinalDate, UnsupportedDate };
-  DateType parseIso8601Format(const std::string & time_string, array_type & integer_value, double & double_value);
+  DateType parseIso8601Format(const char * time_string, std::size_t length, array_type & integer_value, double & double_value);
+
+  /** \function formatIso8601Format
+      \brief Helper function to help CalendarFormat, IsoWeekFormat, and OrdinalFormat classes create a date-and-time string
+             in a given character buffer without memory allocation. The string is laid out as given by field_layout, followed
+             by seconds with a given number of digits after a decimal point. Each digit in field_layout stands for the next
+             element of field_value, zero-padded to the width given by the digit, and other characters are copied as is.
+             The function returns the length of the created string, or zero (0) if it cannot be created in the buffer
+             as laid out, in which case the string must be created by the other formatIso8601Format function.
+  */
+  std::size_t formatIso8601Format(const char * field_layout, const long * field_value, double second, std::streamsize precision,
+    char * buffer, std::size_t buffer_size);
+
+  /** \function formatIso8601Format
+      \brief Helper function to help CalendarFormat, IsoWeekFormat, and OrdinalFormat classes create a date-and-time string,
+             and return it. The arguments are interpreted in the same way as the other formatIso8601Format function.
+  */
+  std::string formatIso8601Format(const char * field_layout, const long * field_value, double second, std::streamsize precision);
+
+  /// \brief Size of a character buffer to create a date-and-time string in without memory allocation.
+  const std::size_t s_format_buffer_size = 128;
 
   /** \function checkHourMinSec
       \brief Helper function to help CalendarFormat, IsoWeekFormat, and OrdinalFormat classes check the time part.
@@ -351,6 +374,40 @@ namespace {
           \param precision Number of digits after a decimal point in the time part of a given time.
       */
       virtual std::string format(const Calendar & time_rep, std::streamsize precision = std::numeric_limits<double>::digits10) const;
+
+      /** \brief Interpret character strings stored in a caller-provided buffer as calendar dates, and set them to a caller-provided
+                 array.
+          \param buffer Buffer holding character strings to interpret, one after another.
+          \param width Number of characters occupied by each character string in the buffer.
+          \param num_string Number of character strings to interpret.
+          \param time_rep Array of at least num_string calendar dates, to which the interpreted ones are set.
+      */
+      virtual void parseArray(const char * buffer, std::size_t width, std::size_t num_string, Calendar * time_rep) const;
+
+      /** \brief Create character strings representing given times in a calendar date format, and store them in a caller-provided
+                 buffer.
+          \param time_rep Array of calendar dates to format into character strings.
+          \param num_rep Number of calendar dates to format into character strings.
+          \param buffer Buffer of at least num_rep * width characters, to which character strings are stored one after another.
+          \param width Number of characters occupied by each character string in the buffer.
+          \param precision Number of digits after a decimal point in the time part of a given time.
+      */
+      virtual void formatArray(const Calendar * time_rep, std::size_t num_rep, char * buffer, std::size_t width,
+        std::streamsize precision = std::numeric_limits<double>::digits10) const;
+
+    private:
+      /** \brief Interpret a given time string as a calendar date, and return it.
+          \param time_string Pointer to the first character of the character string to interpret.
+          \param length Number of characters of the character string to interpret.
+      */
+      Calendar parseTimeString(const char * time_string, std::size_t length) const;
+
+      /** \brief Check validity of a given calendar date, and set its fields to the second argument in the order of
+                 the layout to format it in. Throw an exception if any problem exists.
+          \param time_rep Calendar date to check.
+          \param field_value Fields of a calendar date, to be formatted by formatIso8601Format function.
+      */
+      void getField(const Calendar & time_rep, long * field_value) const;
   };
 
   /** \class IsoWeekFormat
@@ -379,7 +436,40 @@ namespace {
       */
       virtual std::string format(const IsoWeek & time_rep, std::streamsize precision = std::numeric_limits<double>::digits10) const;
 
+      /** \brief Interpret character strings stored in a caller-provided buffer as ISO week dates, and set them to a caller-provided
+                 array.
+          \param buffer Buffer holding character strings to interpret, one after another.
+          \param width Number of characters occupied by each character string in the buffer.
+          \param num_string Number of character strings to interpret.
+          \param time_rep Array of at least num_string ISO week dates, to which the interpreted ones are set.
+      */
+      virtual void parseArray(const char * buffer, std::size_t width, std::size_t num_string, IsoWeek * time_rep) const;
+
+      /** \brief Create character strings representing given times in an ISO week date format, and store them in a caller-provided
+                 buffer.
+          \param time_rep Array of ISO week dates to format into character strings.
+          \param num_rep Number of ISO week dates to format into character strings.
+          \param buffer Buffer of at least num_rep * width characters, to which character strings are stored one after another.
+          \param width Number of characters occupied by each character string in the buffer.
+          \param precision Number of digits after a decimal point in the time part of a given time.
+      */
+      virtual void formatArray(const IsoWeek * time_rep, std::size_t num_rep, char * buffer, std::size_t width,
+        std::streamsize precision = std::numeric_limits<double>::digits10) const;
+
     private:
+      /** \brief Interpret a given time string as an ISO week date, and return it.
+          \param time_string Pointer to the first character of the character string to interpret.
+          \param length Number of characters of the character string to interpret.
+      */
+      IsoWeek parseTimeString(const char * time_string, std::size_t length) const;
+
+      /** \brief Check validity of a given ISO week date, and set its fields to the second argument in the order of
+                 the layout to format it in. Throw an exception if any problem exists.
+          \param time_rep ISO week date to check.
+          \param field_value Fields of an ISO week date, to be formatted by formatIso8601Format function.
+      */
+      void getField(const IsoWeek & time_rep, long * field_value) const;
+
       /** \brief Check validity of an ISO year, an ISO week number, and an ISO weekday number, and throw an exception
                  if any problem exists.
           \param iso_year ISO year to be tested.
@@ -414,9 +504,43 @@ namespace {
           \param precision Number of digits after a decimal point in the time part of a given time.
       */
       virtual std::string format(const Ordinal & time_rep, std::streamsize precision = std::numeric_limits<double>::digits10) const;
+
+      /** \brief Interpret character strings stored in a caller-provided buffer as ordinal dates, and set them to a caller-provided
+                 array.
+          \param buffer Buffer holding character strings to interpret, one after another.
+          \param width Number of characters occupied by each character string in the buffer.
+          \param num_string Number of character strings to interpret.
+          \param time_rep Array of at least num_string ordinal dates, to which the interpreted ones are set.
+      */
+      virtual void parseArray(const char * buffer, std::size_t width, std::size_t num_string, Ordinal * time_rep) const;
+
+      /** \brief Create character strings representing given times in an ordinal date format, and store them in a caller-provided
+                 buffer.
+          \param time_rep Array of ordinal dates to format into character strings.
+          \param num_rep Number of ordinal dates to format into character strings.
+          \param buffer Buffer of at least num_rep * width characters, to which character strings are stored one after another.
+          \param width Number of characters occupied by each character string in the buffer.
+          \param precision Number of digits after a decimal point in the time part of a given time.
+      */
+      virtual void formatArray(const Ordinal * time_rep, std::size_t num_rep, char * buffer, std::size_t width,
+        std::streamsize precision = std::numeric_limits<double>::digits10) const;
+
+    private:
+      /** \brief Interpret a given time string as an ordinal date, and return it.
+          \param time_string Pointer to the first character of the character string to interpret.
+          \param length Number of characters of the character string to interpret.
+      */
+      Ordinal parseTimeString(const char * time_string, std::size_t length) const;
+
+      /** \brief Check validity of a given ordinal date, and set its fields to the second argument in the order of
+                 the layout to format it in. Throw an exception if any problem exists.
+          \param time_rep Ordinal date to check.
+          \param field_value Fields of an ordinal date, to be formatted by formatIso8601Format function.
+      */
+      void getField(const Ordinal & time_rep, long * field_value) const;
   };
 
-  DateType parseIso8601Format(const std::string & time_string, array_type & integer_value, double & double_value) {
+  DateType parseIso8601Stream(const std::string & time_string, array_type & integer_value, double & double_value) {
     // Separate date part and time part.
     std::string::size_type pos_sep = time_string.find('T');
     std::string date_part;
@@ -467,16 +591,14 @@ namespace {
     std::string sec_field = field_list.back();
     field_list.pop_back();
 
-    // Clear the contents of the given container for integer values.
-    integer_value.clear();
-
     // Convert year, month, day, hour, and minute fields into long variables.
-    for (std::vector<std::string>::const_iterator itor = field_list.begin(); itor != field_list.end(); ++itor) {
+    long * value_ptr = integer_value;
+    for (std::vector<std::string>::const_iterator itor = field_list.begin(); itor != field_list.end(); ++itor, ++value_ptr) {
       std::istringstream iss(*itor);
       long long_variable = 0;
       iss >> long_variable;
       if (iss.fail() || !iss.eof()) throw std::runtime_error("Cannot interpret \"" + *itor + "\" in parsing \"" + time_string + "\"");
-      integer_value.push_back(long_variable);
+      *value_ptr = long_variable;
     }
 
     // Convert second field into long variables.
@@ -494,6 +616,167 @@ namespace {
     return date_type;
   }
 
+  /** \brief Helper function for parseIso8601Canonical function, which reads a given number of decimal digits as a non-negative
+             integer, and return a logical true if successful, and a logical false otherwise.
+      \param ptr Pointer to the first character to read, to be moved past the digits read.
+      \param end Pointer to one past the last character that can be read.
+      \param num_digit Number of digits to read, or zero (0) to read all the digits up to the first non-digit character.
+      \param value Integer read from the digits.
+  */
+  bool readDigit(const char * & ptr, const char * end, int num_digit, long & value) {
+    // Read up to nine (9) digits, so that the integer does not overflow.
+    static const int s_max_digit = 9;
+    int max_digit = (num_digit > 0 ? num_digit : s_max_digit);
+    int digit_count = 0;
+    value = 0;
+    for (; ptr != end && digit_count < max_digit && '0' <= *ptr && *ptr <= '9'; ++ptr, ++digit_count) value = value * 10 + (*ptr - '0');
+    return digit_count > 0 && (num_digit > 0 ? digit_count == num_digit : ptr == end || *ptr < '0' || *ptr > '9');
+  }
+
+  /** \brief Helper function for parseIso8601Canonical function, which skips a given character, and return a logical true
+             if the given character is found, and a logical false otherwise.
+      \param ptr Pointer to the character to check, to be moved past it if it is the given character.
+      \param end Pointer to one past the last character that can be read.
+      \param expected Character to skip.
+  */
+  bool skipChar(const char * & ptr, const char * end, char expected) {
+    if (ptr == end || *ptr != expected) return false;
+    ++ptr;
+    return true;
+  }
+
+  /** \brief Helper function for parseIso8601Format function, which interprets a date-and-time string in the canonical form,
+             i.e., with a four-digit year, all the date fields with the number of digits defined by ISO 8601, and the time
+             fields with decimal digits only. The function returns a logical false for a string not in this form, in which case
+             none of its integer or double value is set. Seconds are computed with the same rounding as the standard library,
+             and a logical false is returned if this cannot be guaranteed for a given string.
+      \param time_string Pointer to the first character of the character string to interpret.
+      \param length Number of characters of the character string to interpret.
+      \param date_type Date type of the interpreted string.
+      \param integer_value Integer values of the interpreted string, i.e., all but seconds.
+      \param double_value Seconds of the interpreted string.
+  */
+  bool parseIso8601Canonical(const char * time_string, std::size_t length, DateType & date_type, array_type & integer_value,
+    double & double_value) {
+    const char * ptr = time_string;
+    const char * end = time_string + length;
+    long * value_ptr = integer_value;
+
+    // Read the date part: a four-digit year, followed by an ISO week date, a calendar date, or an ordinal date.
+    if (!readDigit(ptr, end, 4, *value_ptr++) || !skipChar(ptr, end, '-')) return false;
+    if (skipChar(ptr, end, 'W')) {
+      date_type = IsoWeekDate;
+      if (!readDigit(ptr, end, 2, *value_ptr++) || !skipChar(ptr, end, '-') || !readDigit(ptr, end, 1, *value_ptr++)) return false;
+    } else {
+      long leading_value = 0;
+      long trailing_value = 0;
+      if (!readDigit(ptr, end, 2, leading_value)) return false;
+      if (skipChar(ptr, end, '-')) {
+        date_type = CalendarDate;
+        *value_ptr++ = leading_value;
+        if (!readDigit(ptr, end, 2, *value_ptr++)) return false;
+      } else {
+        date_type = OrdinalDate;
+        if (!readDigit(ptr, end, 1, trailing_value)) return false;
+        *value_ptr++ = leading_value * 10 + trailing_value;
+      }
+    }
+
+    // Read hours and minutes of the time part.
+    if (!skipChar(ptr, end, 'T') || !readDigit(ptr, end, 0, *value_ptr++) || !skipChar(ptr, end, ':') ||
+      !readDigit(ptr, end, 0, *value_ptr++) || !skipChar(ptr, end, ':')) return false;
+
+    // Read seconds as an integer mantissa and the number of digits after a decimal point.
+    // Note: Up to 15 digits are accepted, so that the mantissa and the power of ten are both represented exactly
+    //       in double precision, and the division below gives the correctly rounded value, same as the standard library.
+    static const int s_max_digit = std::numeric_limits<double>::digits10;
+    std::uint64_t mantissa = 0;
+    int num_digit = 0;
+    int num_frac_digit = 0;
+    bool point_found = false;
+    for (; ptr != end; ++ptr) {
+      if ('0' <= *ptr && *ptr <= '9') {
+        if (++num_digit > s_max_digit) return false;
+        mantissa = mantissa * 10 + (*ptr - '0');
+        if (point_found) ++num_frac_digit;
+      } else if ('.' == *ptr && !point_found) {
+        point_found = true;
+      } else {
+        return false;
+      }
+    }
+    if (0 == num_digit) return false;
+    static const double s_power_of_ten[] = { 1.e0, 1.e1, 1.e2, 1.e3, 1.e4, 1.e5, 1.e6, 1.e7, 1.e8, 1.e9, 1.e10, 1.e11, 1.e12,
+      1.e13, 1.e14, 1.e15 };
+    double_value = static_cast<double>(mantissa) / s_power_of_ten[num_frac_digit];
+    return true;
+  }
+
+  DateType parseIso8601Format(const char * time_string, std::size_t length, array_type & integer_value, double & double_value) {
+    // Interpret the given string in a single pass if it is in the canonical form.
+    DateType date_type(UnsupportedDate);
+    if (parseIso8601Canonical(time_string, length, date_type, integer_value, double_value)) return date_type;
+
+    // Fall back on splitting the string into fields, to interpret non-canonical forms and to report errors.
+    return parseIso8601Stream(std::string(time_string, length), integer_value, double_value);
+  }
+
+  std::size_t formatIso8601Format(const char * field_layout, const long * field_value, double second, std::streamsize precision,
+    char * buffer, std::size_t buffer_size) {
+    // Give up an unusual number of digits, to be handled by a string stream.
+    if (precision < 0 || precision > static_cast<std::streamsize>(buffer_size)) return 0;
+
+    // Write the fields as laid out.
+    char * ptr = buffer;
+    char * end = buffer + buffer_size;
+    for (const char * layout_ptr = field_layout; '\0' != *layout_ptr; ++layout_ptr) {
+      if ('1' <= *layout_ptr && *layout_ptr <= '9') {
+        // Write the next field with leading zeros, giving up a field that does not fit in the width.
+        int width = *layout_ptr - '0';
+        long value = *field_value++;
+        if (value < 0 || end - ptr < width) return 0;
+        for (char * digit_ptr = ptr + width - 1; digit_ptr >= ptr; --digit_ptr, value /= 10) *digit_ptr = static_cast<char>('0' + value % 10);
+        if (0 != value) return 0;
+        ptr += width;
+      } else {
+        if (ptr == end) return 0;
+        *ptr++ = *layout_ptr;
+      }
+    }
+
+    // Write seconds, with a leading zero if the integer part has only one digit.
+    // Note: A fixed-point conversion by snprintf gives the same result as a string stream in std::ios::fixed mode.
+    if (second < 10.) {
+      if (ptr == end) return 0;
+      *ptr++ = '0';
+    }
+    int sec_length = std::snprintf(ptr, end - ptr, "%.*f", static_cast<int>(precision), second);
+    if (sec_length < 0 || sec_length >= end - ptr) return 0;
+
+    // Give up a decimal point other than a period ('.'), which could be written depending on the C locale.
+    if (precision > 0 && std::isfinite(second) && '.' != ptr[sec_length - precision - 1]) return 0;
+    return ptr + sec_length - buffer;
+  }
+
+  std::string formatIso8601Format(const char * field_layout, const long * field_value, double second, std::streamsize precision) {
+    // Create the string in a character buffer if possible.
+    char buffer[s_format_buffer_size];
+    std::size_t length = formatIso8601Format(field_layout, field_value, second, precision, buffer, sizeof(buffer));
+    if (length > 0) return std::string(buffer, length);
+
+    // Fall back on a string stream.
+    std::ostringstream os;
+    os << std::setfill('0');
+    for (const char * layout_ptr = field_layout; '\0' != *layout_ptr; ++layout_ptr) {
+      if ('1' <= *layout_ptr && *layout_ptr <= '9') os << std::setw(*layout_ptr - '0') << *field_value++;
+      else os << *layout_ptr;
+    }
+    os.setf(std::ios::fixed);
+    if (second < 10.) os << '0';
+    os << std::setprecision(precision) << second;
+    return os.str();
+  }
+
   void checkHourMinSec(long hour, long min, double sec) {
     // Check the time part of the given time representation.
     if (hour < 0 || hour > 23) {
@@ -542,13 +825,53 @@ namespace {
   }
 
   Calendar CalendarFormat::parse(const std::string & time_string) const {
+    return parseTimeString(time_string.data(), time_string.size());
+  }
+
+  std::string CalendarFormat::format(const Calendar & time_rep, std::streamsize precision) const {
+    // Check the given time representation, and format it into a string.
+    long field_value[5];
+    getField(time_rep, field_value);
+    return formatIso8601Format("4-2-2T2:2:", field_value, time_rep.m_sec, precision);
+  }
+
+  void CalendarFormat::parseArray(const char * buffer, std::size_t width, std::size_t num_string, Calendar * time_rep) const {
+    for (std::size_t ii = 0; ii < num_string; ++ii) {
+      const char * time_string = buffer + ii * width;
+      time_rep[ii] = parseTimeString(time_string, getStringLength(time_string, width));
+    }
+  }
+
+  void CalendarFormat::formatArray(const Calendar * time_rep, std::size_t num_rep, char * buffer, std::size_t width,
+    std::streamsize precision) const {
+    long field_value[5];
+    char format_buffer[s_format_buffer_size];
+    for (std::size_t ii = 0; ii < num_rep; ++ii) {
+      // Check the time representation, and format it into the local buffer if possible.
+      getField(time_rep[ii], field_value);
+      std::size_t length = formatIso8601Format("4-2-2T2:2:", field_value, time_rep[ii].m_sec, precision, format_buffer,
+        sizeof(format_buffer));
+
+      // Store the result in the given buffer, falling back on a string stream if necessary.
+      if (length > 0) {
+        storeString(format_buffer, length, buffer + ii * width, width);
+      } else {
+        std::string time_string = formatIso8601Format("4-2-2T2:2:", field_value, time_rep[ii].m_sec, precision);
+        storeString(time_string.data(), time_string.size(), buffer + ii * width, width);
+      }
+    }
+  }
+
+  Calendar CalendarFormat::parseTimeString(const char * time_string, std::size_t length) const {
     // Split the given string to integer and double values.
     array_type int_array;
     double dbl_value;
-    DateType date_type = parseIso8601Format(time_string, int_array, dbl_value);
+    DateType date_type = parseIso8601Format(time_string, length, int_array, dbl_value);
 
     // Check date_type and throw an exception if it is not CalendarDate.
-    if (date_type != CalendarDate) throw std::runtime_error("Unable to recognize as a calendar date format: " + time_string);
+    if (date_type != CalendarDate) {
+      throw std::runtime_error("Unable to recognize as a calendar date format: " + std::string(time_string, length));
+    }
 
     // Check the date part of the given time representation.
     const GregorianCalendar & calendar(GregorianCalendar::getCalendar());
@@ -561,7 +884,7 @@ namespace {
     return Calendar(int_array[0], int_array[1], int_array[2], int_array[3], int_array[4], dbl_value);
   }
 
-  std::string CalendarFormat::format(const Calendar & time_rep, std::streamsize precision) const {
+  void CalendarFormat::getField(const Calendar & time_rep, long * field_value) const {
     // Check the date part of the given time representation.
     const GregorianCalendar & calendar(GregorianCalendar::getCalendar());
     calendar.checkCalendarDate(time_rep.m_year, time_rep.m_mon, time_rep.m_day);
@@ -569,14 +892,12 @@ namespace {
     // Check the time part of the given time representation.
     checkHourMinSec(time_rep.m_hour, time_rep.m_min, time_rep.m_sec);
 
-    // Format the time into a string.
-    std::ostringstream os;
-    os << std::setfill('0') << std::setw(4) << time_rep.m_year << "-" << std::setw(2) << time_rep.m_mon << "-" <<
-      std::setw(2) << time_rep.m_day << "T" << std::setw(2) << time_rep.m_hour << ":" << std::setw(2) << time_rep.m_min << ":";
-    os.setf(std::ios::fixed);
-    if (time_rep.m_sec < 10.) os << '0';
-    os << std::setprecision(precision) << time_rep.m_sec;
-    return os.str();
+    // Set the fields in the order of the layout.
+    field_value[0] = time_rep.m_year;
+    field_value[1] = time_rep.m_mon;
+    field_value[2] = time_rep.m_day;
+    field_value[3] = time_rep.m_hour;
+    field_value[4] = time_rep.m_min;
   }
 
   IsoWeek IsoWeekFormat::convert(const datetime_type & datetime) const {
@@ -647,13 +968,53 @@ namespace {
   }
 
   IsoWeek IsoWeekFormat::parse(const std::string & time_string) const {
+    return parseTimeString(time_string.data(), time_string.size());
+  }
+
+  std::string IsoWeekFormat::format(const IsoWeek & time_rep, std::streamsize precision) const {
+    // Check the given time representation, and format it into a string.
+    long field_value[5];
+    getField(time_rep, field_value);
+    return formatIso8601Format("4-W2-1T2:2:", field_value, time_rep.m_sec, precision);
+  }
+
+  void IsoWeekFormat::parseArray(const char * buffer, std::size_t width, std::size_t num_string, IsoWeek * time_rep) const {
+    for (std::size_t ii = 0; ii < num_string; ++ii) {
+      const char * time_string = buffer + ii * width;
+      time_rep[ii] = parseTimeString(time_string, getStringLength(time_string, width));
+    }
+  }
+
+  void IsoWeekFormat::formatArray(const IsoWeek * time_rep, std::size_t num_rep, char * buffer, std::size_t width,
+    std::streamsize precision) const {
+    long field_value[5];
+    char format_buffer[s_format_buffer_size];
+    for (std::size_t ii = 0; ii < num_rep; ++ii) {
+      // Check the time representation, and format it into the local buffer if possible.
+      getField(time_rep[ii], field_value);
+      std::size_t length = formatIso8601Format("4-W2-1T2:2:", field_value, time_rep[ii].m_sec, precision, format_buffer,
+        sizeof(format_buffer));
+
+      // Store the result in the given buffer, falling back on a string stream if necessary.
+      if (length > 0) {
+        storeString(format_buffer, length, buffer + ii * width, width);
+      } else {
+        std::string time_string = formatIso8601Format("4-W2-1T2:2:", field_value, time_rep[ii].m_sec, precision);
+        storeString(time_string.data(), time_string.size(), buffer + ii * width, width);
+      }
+    }
+  }
+
+  IsoWeek IsoWeekFormat::parseTimeString(const char * time_string, std::size_t length) const {
     // Split the given string to integer and double values.
     array_type int_array;
     double dbl_value;
-    DateType date_type = parseIso8601Format(time_string, int_array, dbl_value);
+    DateType date_type = parseIso8601Format(time_string, length, int_array, dbl_value);
 
     // Check date_type and throw an exception if it is not IsoWeekDate.
-    if (date_type != IsoWeekDate) throw std::runtime_error("Unable to recognize as an ISO week date format: " + time_string);
+    if (date_type != IsoWeekDate) {
+      throw std::runtime_error("Unable to recognize as an ISO week date format: " + std::string(time_string, length));
+    }
 
     // Check the date part of the given time representation.
     checkWeekDate(int_array[0], int_array[1], int_array[2]);
@@ -665,21 +1026,19 @@ namespace {
     return IsoWeek(int_array[0], int_array[1], int_array[2], int_array[3], int_array[4], dbl_value);
   }
 
-  std::string IsoWeekFormat::format(const IsoWeek & time_rep, std::streamsize precision) const {
+  void IsoWeekFormat::getField(const IsoWeek & time_rep, long * field_value) const {
     // Check the date part of the given time representation.
     checkWeekDate(time_rep.m_year, time_rep.m_week, time_rep.m_day);
 
     // Check the time part of the given time representation.
     checkHourMinSec(time_rep.m_hour, time_rep.m_min, time_rep.m_sec);
 
-    // Format the time into a string.
-    std::ostringstream os;
-    os << std::setfill('0') << std::setw(4) << time_rep.m_year << "-W" << std::setw(2) << time_rep.m_week << "-" <<
-      std::setw(1) << time_rep.m_day << "T" << std::setw(2) << time_rep.m_hour << ":" << std::setw(2) << time_rep.m_min << ":";
-    os.setf(std::ios::fixed);
-    if (time_rep.m_sec < 10.) os << '0';
-    os << std::setprecision(precision) << time_rep.m_sec;
-    return os.str();
+    // Set the fields in the order of the layout.
+    field_value[0] = time_rep.m_year;
+    field_value[1] = time_rep.m_week;
+    field_value[2] = time_rep.m_day;
+    field_value[3] = time_rep.m_hour;
+    field_value[4] = time_rep.m_min;
   }
 
   void IsoWeekFormat::checkWeekDate(long iso_year, long week_number, long weekday_number) const {
@@ -758,13 +1117,53 @@ namespace {
   }
 
   Ordinal OrdinalFormat::parse(const std::string & time_string) const {
+    return parseTimeString(time_string.data(), time_string.size());
+  }
+
+  std::string OrdinalFormat::format(const Ordinal & time_rep, std::streamsize precision) const {
+    // Check the given time representation, and format it into a string.
+    long field_value[5];
+    getField(time_rep, field_value);
+    return formatIso8601Format("4-3T2:2:", field_value, time_rep.m_sec, precision);
+  }
+
+  void OrdinalFormat::parseArray(const char * buffer, std::size_t width, std::size_t num_string, Ordinal * time_rep) const {
+    for (std::size_t ii = 0; ii < num_string; ++ii) {
+      const char * time_string = buffer + ii * width;
+      time_rep[ii] = parseTimeString(time_string, getStringLength(time_string, width));
+    }
+  }
+
+  void OrdinalFormat::formatArray(const Ordinal * time_rep, std::size_t num_rep, char * buffer, std::size_t width,
+    std::streamsize precision) const {
+    long field_value[5];
+    char format_buffer[s_format_buffer_size];
+    for (std::size_t ii = 0; ii < num_rep; ++ii) {
+      // Check the time representation, and format it into the local buffer if possible.
+      getField(time_rep[ii], field_value);
+      std::size_t length = formatIso8601Format("4-3T2:2:", field_value, time_rep[ii].m_sec, precision, format_buffer,
+        sizeof(format_buffer));
+
+      // Store the result in the given buffer, falling back on a string stream if necessary.
+      if (length > 0) {
+        storeString(format_buffer, length, buffer + ii * width, width);
+      } else {
+        std::string time_string = formatIso8601Format("4-3T2:2:", field_value, time_rep[ii].m_sec, precision);
+        storeString(time_string.data(), time_string.size(), buffer + ii * width, width);
+      }
+    }
+  }
+
+  Ordinal OrdinalFormat::parseTimeString(const char * time_string, std::size_t length) const {
     // Split the given string to integer and double values.
     array_type int_array;
     double dbl_value;
-    DateType date_type = parseIso8601Format(time_string, int_array, dbl_value);
+    DateType date_type = parseIso8601Format(time_string, length, int_array, dbl_value);
 
     // Check date_type and throw an exception if it is not OrdinalDate.
-    if (date_type != OrdinalDate) throw std::runtime_error("Unable to recognize as an ordinal date format: " + time_string);
+    if (date_type != OrdinalDate) {
+      throw std::runtime_error("Unable to recognize as an ordinal date format: " + std::string(time_string, length));
+    }
 
     // Check the date part of the given time representation.
     const GregorianCalendar & calendar(GregorianCalendar::getCalendar());
@@ -777,7 +1176,7 @@ namespace {
     return Ordinal(int_array[0], int_array[1], int_array[2], int_array[3], dbl_value);
   }
 
-  std::string OrdinalFormat::format(const Ordinal & time_rep, std::streamsize precision) const {
+  void OrdinalFormat::getField(const Ordinal & time_rep, long * field_value) const {
     // Check the date part of the given time representation.
     const GregorianCalendar & calendar(GregorianCalendar::getCalendar());
     calendar.checkOrdinalDate(time_rep.m_year, time_rep.m_day);
@@ -785,14 +1184,11 @@ namespace {
     // Check the time part of the given time representation.
     checkHourMinSec(time_rep.m_hour, time_rep.m_min, time_rep.m_sec);
 
-    // Format the time into a string.
-    std::ostringstream os;
-    os << std::setfill('0') << std::setw(4) << time_rep.m_year << "-" << std::setw(3) << time_rep.m_day << "T" <<
-      std::setw(2) << time_rep.m_hour << ":" << std::setw(2) << time_rep.m_min << ":";
-    os.setf(std::ios::fixed);
-    if (time_rep.m_sec < 10.) os << '0';
-    os << std::setprecision(precision) << time_rep.m_sec;
-    return os.str();
+    // Set the fields in the order of the layout.
+    field_value[0] = time_rep.m_year;
+    field_value[1] = time_rep.m_day;
+    field_value[2] = time_rep.m_hour;
+    field_value[3] = time_rep.m_min;
   }
 
 }
@@ -0,0 +1,101 @@
+/** \file CorrectionService.cxx
+    \brief Implementation of CorrectionService class.
+    \authors Masaharu Hirayama, GSSC
+             James Peachey, HEASARC/GSSC
+*/
+#include "timeSystem/CorrectionService.h"
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "timeSystem/AbsoluteTime.h"
+#include "timeSystem/GlastTimeHandler.h"
+#include "timeSystem/SourcePosition.h"
+#include "timeSystem/TimeSystem.h"
+
+#include <sys/stat.h>
+
+namespace timeSystem {
+
+  CorrectionService::CorrectionService(GlastScTimeHandler & handler, const std::string & sc_file_name,
+    const std::string & sc_extension_name, const std::string & solar_eph, double ang_tolerance, bool compute_bary):
+    m_handler(handler), m_sc_file_name(sc_file_name), m_sc_extension_name(sc_extension_name), m_solar_eph(solar_eph),
+    m_ang_tolerance(ang_tolerance), m_compute_bary(compute_bary), m_time_system(TimeSystem::getSystem(compute_bary ? "TDB" : "TT")),
+    m_sc_file_time(0), m_sc_file_size(-1) {
+    loadScFile(true);
+  }
+
+  long CorrectionService::serve(std::istream & is, std::ostream & os) {
+    long num_request = 0;
+    std::string line;
+    while (std::getline(is, line)) {
+      // Skip an empty line, and quit on request.
+      std::string::size_type first = line.find_first_not_of(" \t\r");
+      if (std::string::npos == first) continue;
+      std::string::size_type last = line.find_last_not_of(" \t\r");
+      if ("QUIT" == line.substr(first, last - first + 1)) break;
+
+      // Reply to the request, and send the reply immediately.
+      os << reply(line) << std::endl;
+      ++num_request;
+    }
+    return num_request;
+  }
+
+  void CorrectionService::loadScFile(bool force_load) {
+    // Check whether the spacecraft file (or the file that lists spacecraft files) is updated.
+    // Note: The file is loaded anyway if its status cannot be obtained, such as for a file name with a FITS filter.
+    std::string file_name(!m_sc_file_name.empty() && '@' == m_sc_file_name[0] ? m_sc_file_name.substr(1) : m_sc_file_name);
+    struct stat file_stat;
+    bool has_stat = (0 == stat(file_name.c_str(), &file_stat));
+    if (has_stat && !force_load && file_stat.st_mtime == m_sc_file_time && file_stat.st_size == m_sc_file_size) return;
+
+    // Load the spacecraft file, and remember its status.
+    // Note: Always require for solar system ephemeris to match between successive arrival time conversions.
+    static const bool match_solar_eph = true;
+    m_handler.initTimeCorrection(m_sc_file_name, m_sc_extension_name, m_solar_eph, match_solar_eph, m_ang_tolerance);
+    m_sc_file_time = has_stat ? file_stat.st_mtime : 0;
+    m_sc_file_size = has_stat ? static_cast<long long>(file_stat.st_size) : -1;
+  }
+
+  std::string CorrectionService::reply(const std::string & request) {
+    try {
+      // Parse the request.
+      std::istringstream iss(request);
+      double ra = 0.;
+      double dec = 0.;
+      if (!(iss >> ra >> dec)) throw std::runtime_error("Request does not start with Right Ascension and Declination");
+      std::vector<double> glast_time;
+      double this_time = 0.;
+      while (iss >> this_time) glast_time.push_back(this_time);
+      if (!iss.eof()) throw std::runtime_error("Request contains a non-numeric time");
+
+      // Compute the corrected times, with the spacecraft file reloaded if updated.
+      loadScFile(false);
+      std::vector<AbsoluteTime> abs_time;
+      m_handler.computeCorrectedTime(glast_time, std::vector<SourcePosition>(1, SourcePosition(ra, dec)), m_compute_bary,
+        abs_time);
+      std::vector<double> corrected_time;
+      m_handler.computeGlastTime(abs_time, m_time_system, corrected_time);
+
+      // Write the corrected times in full precision.
+      std::ostringstream oss;
+      oss.precision(std::numeric_limits<double>::digits10 + 2);
+      for (std::vector<double>::const_iterator itor = corrected_time.begin(); itor != corrected_time.end(); ++itor) {
+        if (itor != corrected_time.begin()) oss << ' ';
+        oss << *itor;
+      }
+      return oss.str();
+
+    } catch (const std::exception & x) {
+      // Reply the error, replacing line breaks in the message so that the reply is a single line.
+      std::string message(x.what());
+      std::replace(message.begin(), message.end(), '\n', ' ');
+      return "ERROR " + message;
+    }
+  }
+
+}
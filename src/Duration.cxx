@@ -28,10 +28,10 @@ namespace {
       Note: The four units defined below (day, hour, minute, and second) are "safe to use" precision-wise.
       Smaller units (millisecond, microsecond, ...) are not really a distinct unit from seconds.
       Larger units (Week, Year, Decade, Century, ...) would compromise the precision realized by this approach.
-      The reason is that internally, Duration stores times as a whole number of days + a fractional number
-      of seconds. The act of converting, say .5 years (~ 15768000 seconds) to days plus seconds would
+      The reason is that internally, Duration stores times as a whole number of days + a whole number
+      of picoseconds. The act of converting, say .5 years (~ 15768000 seconds) to days plus seconds would
       yield an intermediate result accurate only to 100 ns, whereas 182.5 days (~ .5 year) would be stored
-      accurate to within 100 picoseconds.
+      accurate to within a picosecond.
   */
   class TimeUnit {
     public:
@@ -133,20 +133,24 @@ namespace {
   }
 
   const TimeUnit & TimeUnit::getUnit(const std::string & time_unit_name) {
-    // Create TimeUnit objects.
-    static const TimeUnitDay s_day;
-    static const TimeUnitHour s_hour;
-    static const TimeUnitMin s_min;
-    static const TimeUnitSec s_sec;
+    // Create TimeUnit objects, which register themselves, only once.
+    // Note: The registry is never modified after this initialization, which is done only once even if this method is called
+    //       in multiple threads at the same time, so that it can be read without locks.
+    static const container_type & s_container([]() -> const container_type & {
+      static const TimeUnitDay s_day;
+      static const TimeUnitHour s_hour;
+      static const TimeUnitMin s_min;
+      static const TimeUnitSec s_sec;
+      return getContainer();
+    }());
 
     // Make the unit name case-insensitive.
     std::string time_unit_name_uc(time_unit_name);
     for (std::string::iterator itor = time_unit_name_uc.begin(); itor != time_unit_name_uc.end(); ++itor) *itor = std::toupper(*itor);
 
     // Find a requested TimeUnit object and return it.
-    TimeUnit::container_type & container(getContainer());
-    container_type::iterator cont_itor = container.find(time_unit_name_uc);
-    if (container.end() == cont_itor) throw std::runtime_error("No such time unit implemented: " + time_unit_name);
+    container_type::const_iterator cont_itor = s_container.find(time_unit_name_uc);
+    if (s_container.end() == cont_itor) throw std::runtime_error("No such time unit implemented: " + time_unit_name);
     return *cont_itor->second;
   }
 
@@ -158,24 +162,15 @@ namespace {
 
 namespace timeSystem {
 
-  Duration::Duration(): m_duration(0, 0.) {}
+  Duration::Duration(): m_duration(0, 0) {}
 
   Duration::Duration(long day, double sec) {
     set(day, sec);
   }
 
   Duration::Duration(long time_value_int, double time_value_frac, const std::string & time_unit_name) {
-    // Check the fractional part.
-    const IntFracUtility & utility(IntFracUtility::getUtility());
-    utility.check(time_value_int, time_value_frac);
-
-    // Convert units.
     const TimeUnit & unit(TimeUnit::getUnit(time_unit_name));
-    long day = time_value_int / unit.getUnitPerDay();
-    double sec = (time_value_int % unit.getUnitPerDay() + time_value_frac) * unit.getSecPerUnit();
-
-    // Set the result to the data member.
-    set(day, sec);
+    set(time_value_int, time_value_frac, unit.getUnitPerDay(), unit.getSecPerUnit());
   }
 
   Duration::Duration(double time_value, const std::string & time_unit_name) {
@@ -188,44 +183,83 @@ namespace timeSystem {
   }
 
   const Duration & Duration::zero() {
-    static const Duration s_zero_duration(duration_type(0, 0.));
+    static const Duration s_zero_duration(duration_type(0, 0));
     return s_zero_duration;
   }
 
   void Duration::get(const std::string & time_unit_name, long & time_value_int, double & time_value_frac) const {
     const TimeUnit & unit(TimeUnit::getUnit(time_unit_name));
+    get(unit.getUnitPerDay(), unit.getSecPerUnit(), unit.getUnitString().c_str(), time_value_int, time_value_frac);
+  }
+
+  void Duration::get(const std::string & time_unit_name, double & time_value) const {
+    time_value = get(time_unit_name);
+  }
 
-    // Let the sec part have the same sign as the day part.
+  double Duration::get(const std::string & time_unit_name) const {
+    const TimeUnit & unit(TimeUnit::getUnit(time_unit_name));
+    return get(unit.getUnitPerDay(), unit.getSecPerUnit());
+  }
+
+  double Duration::computeSec(long day) const {
+    // Compute the total number of days, checking for overflow in expressing them in seconds.
+    long long total_day = static_cast<long long>(m_duration.first) + day;
+    if (total_day > std::numeric_limits<long long>::max() / SecPerDay() ||
+        total_day < std::numeric_limits<long long>::min() / SecPerDay()) {
+      std::ostringstream os;
+      os << "Integer overflow in expressing time duration of " << *this << " plus " << day << " days in seconds";
+      throw std::runtime_error(os.str());
+    }
+
+    // Sum the whole numbers of seconds exactly, and add the fractional part with a single rounding.
+    // Note: The picoseconds portion is always in the range [0, getPicosecPerDay()), so is its fractional part.
+    long long whole_sec = total_day * SecPerDay() + m_duration.second / getPicosecPerSec();
+    long long frac_picosec = m_duration.second % getPicosecPerSec();
+    return static_cast<double>(whole_sec) + static_cast<double>(frac_picosec) / static_cast<double>(getPicosecPerSec());
+  }
+
+  void Duration::set(long time_value_int, double time_value_frac, long unit_per_day, long sec_per_unit) {
+    // Check the fractional part.
+    const IntFracUtility & utility(IntFracUtility::getUtility());
+    utility.check(time_value_int, time_value_frac);
+
+    // Convert units.
+    long day = time_value_int / unit_per_day;
+    double sec = (time_value_int % unit_per_day + time_value_frac) * sec_per_unit;
+
+    // Set the result to the data member.
+    set(day, sec);
+  }
+
+  void Duration::get(long unit_per_day, long sec_per_unit, const char * unit_string, long & time_value_int,
+    double & time_value_frac) const {
+    // Let the picoseconds part have the same sign as the day part.
     long signed_day = m_duration.first;
-    double signed_sec = m_duration.second;
+    long long signed_picosec = m_duration.second;
     if (signed_day < 0) {
       signed_day++; // Note: this operation never causes integer over/underflow.
-      signed_sec -= SecPerDay();
+      signed_picosec -= getPicosecPerDay();
     }
 
-    // Convert the seconds portion to a given time unit.
-    double signed_time = signed_sec / unit.getSecPerUnit();
-
-    // Compute the integer and the fractional parts of a time value coming from the seconds portion.
-    const IntFracUtility & utility(IntFracUtility::getUtility());
-    long int_part_from_sec = 0;
-    double frac_part = 0.;
-    utility.split(signed_time, int_part_from_sec, frac_part);
+    // Compute the integer and the fractional parts of a time value coming from the picoseconds portion.
+    const long long picosec_per_unit = sec_per_unit * getPicosecPerSec();
+    long int_part_from_sec = static_cast<long>(signed_picosec / picosec_per_unit);
+    double frac_part = static_cast<double>(signed_picosec % picosec_per_unit) / static_cast<double>(picosec_per_unit);
 
     // Compute the integer part coming from the days portion.
-    if (signed_day > std::numeric_limits<long>::max() / unit.getUnitPerDay()) {
+    if (signed_day > std::numeric_limits<long>::max() / unit_per_day) {
       // Throw an exception for a value too large after multiplication.
       std::ostringstream os;
-      os << "Integer overflow in expressing time duration of " << *this << " in " << unit.getUnitString();
+      os << "Integer overflow in expressing time duration of " << *this << " in " << unit_string;
       throw std::runtime_error(os.str());
 
-    } else if (signed_day < std::numeric_limits<long>::min() / unit.getUnitPerDay()) {
+    } else if (signed_day < std::numeric_limits<long>::min() / unit_per_day) {
       // Throw an exception for a value too small after multiplication.
       std::ostringstream os;
-      os << "Integer underflow in expressing time duration of " << *this << " in " << unit.getUnitString();
+      os << "Integer underflow in expressing time duration of " << *this << " in " << unit_string;
       throw std::runtime_error(os.str());
     }
-    long int_part_from_day = signed_day * unit.getUnitPerDay();
+    long int_part_from_day = signed_day * unit_per_day;
 
     // Add the integer part coming from the days portion.
     long int_part = add(int_part_from_day, int_part_from_sec);
@@ -235,15 +269,6 @@ namespace timeSystem {
     time_value_frac = frac_part;
   }
 
-  void Duration::get(const std::string & time_unit_name, double & time_value) const {
-    time_value = get(time_unit_name);
-  }
-
-  double Duration::get(const std::string & time_unit_name) const {
-    const TimeUnit & unit(TimeUnit::getUnit(time_unit_name));
-    return std::floor(static_cast<double>(m_duration.first) * unit.getUnitPerDay()) + m_duration.second / unit.getSecPerUnit();
-  }
-
   Duration Duration::operator +(const Duration & other) const {
     return Duration(add(m_duration, other.m_duration));
   }
@@ -267,14 +292,12 @@ namespace timeSystem {
   }
 
   double Duration::operator /(const Duration & other) const {
-    std::string time_unit_name("Day");
-
     // If both times are less than a day, use seconds to preserve precision. This is not safe if either Duration
     // is longer than one day, because get method does integer math when the units are seconds, and days converted
     // to seconds can overflow in this case.
-    if (0 == m_duration.first && 0 == other.m_duration.first) time_unit_name = "Sec";
+    if (0 == m_duration.first && 0 == other.m_duration.first) return get<Sec>() / other.get<Sec>();
 
-    return get(time_unit_name) / other.get(time_unit_name);
+    return get<Day>() / other.get<Day>();
   }
 
   bool Duration::operator !=(const Duration & other) const {
@@ -312,7 +335,7 @@ namespace timeSystem {
   std::string Duration::describe() const {
     std::ostringstream os;
     os.precision(std::numeric_limits<double>::digits10);
-    os << "Duration(" << m_duration.first << ", " << m_duration.second << ")";
+    os << "Duration(" << m_duration.first << ", " << convertToSec(m_duration.second) << ")";
     return os.str();
   }
 
@@ -332,12 +355,25 @@ namespace timeSystem {
     else if (frac_day < -.5) int_day = add(int_day, -1);
     frac_day = 0.;
 
+    // Convert the seconds portion into picoseconds, splitting off whole seconds first to preserve precision.
+    // Note: The seconds portion may fall slightly outside [0, SecPerDay()) due to rounding errors, or by a large amount
+    //       when the given number of seconds is too large to have a meaningful fractional part. In either case, it is
+    //       clipped to the range before conversion, and rounding up to a whole day is carried over to the days portion.
+    double_sec = std::min(std::max(double_sec, 0.), static_cast<double>(SecPerDay()));
+    double whole_sec = std::floor(double_sec);
+    long long picosec = static_cast<long long>(whole_sec) * getPicosecPerSec() +
+      static_cast<long long>(std::floor((double_sec - whole_sec) * getPicosecPerSec() + .5));
+    if (picosec >= getPicosecPerDay()) {
+      picosec -= getPicosecPerDay();
+      int_day = add(int_day, 1);
+    }
+
     // Add the given number of days to the days portion from the given seconds.
     int_day = add(day, int_day);
 
     // Set the result to the internal variable.
     m_duration.first = int_day;
-    m_duration.second = double_sec;
+    m_duration.second = picosec;
   }
 
   long Duration::add(long int1, long int2) const {
@@ -360,12 +396,12 @@ namespace timeSystem {
   }
 
   Duration::duration_type Duration::add(Duration::duration_type t1, Duration::duration_type t2) const {
-    // Sum the two seconds portions.
-    double total_sec = t1.second + t2.second;
+    // Sum the two picoseconds portions.
+    long long total_picosec = t1.second + t2.second;
 
     // Check for carry-over, and sum the days portions.
     long total_day = 0;
-    if (total_sec >= SecPerDay()) {
+    if (total_picosec >= getPicosecPerDay()) {
       // Add the days portions, with careful attention to the order of addition.
       if (t1.first != std::numeric_limits<long>::max()) {
         // Safe to increment the days portion of t1.
@@ -381,10 +417,8 @@ namespace timeSystem {
 
       }
 
-      // Re-compute the seconds portion, noting the following points:
-      // 1. Do not reuse sum variable from above, in order to preserve maximum precision.
-      // 2. Prevent small negative values, which sometimes occur when performing floating point subtraction.
-      total_sec = std::max(0., (t1.second - SecPerDay()) + t2.second);
+      // Remove the carried-over day from the picoseconds portion.
+      total_picosec -= getPicosecPerDay();
 
     } else {
       // Add the days portions.
@@ -393,7 +427,7 @@ namespace timeSystem {
     }
 
     // Return the sum.
-    return duration_type(total_day, total_sec);
+    return duration_type(total_day, total_picosec);
   }
 
   Duration::duration_type Duration::negate(Duration::duration_type t1) const {
@@ -411,8 +445,19 @@ namespace timeSystem {
       throw std::runtime_error(os.str());
     }
 
+    // Return the negative of this object as it is, if the picoseconds portion is zero.
+    if (0 == t1.second) {
+      if (std::numeric_limits<long>::min() == t1.first) {
+        // Throw an exception for a value too large after negation.
+        std::ostringstream os;
+        os << "Integer overflow in negating time duration of " << *this;
+        throw std::runtime_error(os.str());
+      }
+      return duration_type(-t1.first, 0);
+    }
+
     // Compute and return the negative of this object.
-    return duration_type(-t1.first - 1, SecPerDay() - t1.second);
+    return duration_type(-t1.first - 1, getPicosecPerDay() - t1.second);
   }
 
   std::ostream & operator <<(std::ostream & os, const Duration & time_duration) {
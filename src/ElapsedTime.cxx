@@ -12,11 +12,14 @@ namespace timeSystem {
   ElapsedTime::ElapsedTime(const std::string & time_system_name, const Duration & time_duration):
     m_time_system(&TimeSystem::getSystem(time_system_name)), m_duration(time_duration) {}
 
+  ElapsedTime::ElapsedTime(const TimeSystem & time_system, const Duration & time_duration):
+    m_time_system(&time_system), m_duration(time_duration) {}
+
   ElapsedTime::ElapsedTime(const TimeSystem * time_system, const Duration & time_duration):
     m_time_system(time_system), m_duration(time_duration) {}
 
   AbsoluteTime ElapsedTime::operator +(const AbsoluteTime & absolute_time) const {
-    return absolute_time.computeAbsoluteTime(m_time_system->getName(), m_duration);
+    return absolute_time.computeAbsoluteTime(*m_time_system, m_duration);
   }
 
   ElapsedTime ElapsedTime::operator -() const { return ElapsedTime(m_time_system, -m_duration); }
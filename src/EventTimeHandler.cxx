@@ -113,6 +113,26 @@ namespace timeSystem {
     setSourcePosition(SourcePosition(ra, dec));
   }
 
+  void EventTimeHandler::readTimes(const std::string & /*column_name*/, tip::Index_t /*first_row*/, tip::Index_t /*num_rows*/,
+    double * /*time_value*/) const {
+    throw std::runtime_error("Column-wise reading of times is not supported by this event time handler");
+  }
+
+  void EventTimeHandler::writeTimes(const std::string & /*column_name*/, tip::Index_t /*first_row*/, tip::Index_t /*num_rows*/,
+    const double * /*time_value*/) {
+    throw std::runtime_error("Column-wise writing of times is not supported by this event time handler");
+  }
+
+  void EventTimeHandler::getGeoTimes(const std::string & /*column_name*/, tip::Index_t /*first_row*/, tip::Index_t /*num_rows*/,
+    double * /*time_value*/) const {
+    throw std::runtime_error("Column-wise computation of geocentric times is not supported by this event time handler");
+  }
+
+  void EventTimeHandler::getBaryTimes(const std::string & /*column_name*/, tip::Index_t /*first_row*/, tip::Index_t /*num_rows*/,
+    double * /*time_value*/) const {
+    throw std::runtime_error("Column-wise computation of barycentric times is not supported by this event time handler");
+  }
+
   void EventTimeHandler::setFirstRecord() {
     if (m_table) m_record_itor = m_table->begin();
   }
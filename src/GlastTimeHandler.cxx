@@ -9,24 +9,68 @@
 #include "timeSystem/BaryTimeComputer.h"
 #include "timeSystem/CalendarFormat.h"
 #include "timeSystem/ElapsedTime.h"
-#include "timeSystem/TimeInterval.h"
+#include "timeSystem/PerformanceMonitor.h"
 
 #include "tip/IFileSvc.h"
 #include "tip/TipException.h"
 
+#include <algorithm>
 #include <cctype>
 #include <cmath>
+#include <fstream>
 #include <iomanip>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <vector>
 
+namespace {
+
+  /// \brief Mutex to serialize opening and closing spacecraft files by glastscorbit C-functions, which share a static table
+  /// of opened spacecraft files. Loaded spacecraft files are searched without it, with cursors owned by each search.
+  std::mutex s_glastscorbit_mutex;
+
+  /// \brief The maximum number of times to split a segment of time in halves in interpolation of time delays.
+  const int s_max_depth = 20;
+
+  /** \brief Return a value interpolated by a quadratic polynomial that passes given values at the beginning, the middle,
+             and the end of a segment.
+      \param begin_value Value at the beginning of the segment.
+      \param middle_value Value at the middle of the segment.
+      \param end_value Value at the end of the segment.
+      \param fraction Position in the segment to interpolate at, with zero (0) for the beginning and one (1) for the end.
+  */
+  inline double interpolateQuadratic(double begin_value, double middle_value, double end_value, double fraction) {
+    return begin_value * (2. * fraction - 1.) * (fraction - 1.) + middle_value * 4. * fraction * (1. - fraction)
+      + end_value * fraction * (2. * fraction - 1.);
+  }
+
+  /** \brief Read a text file that lists file names, one per line, and return the file names. Blank lines are skipped.
+      \param list_file Name of the text file to read.
+  */
+  std::vector<std::string> readFileList(const std::string & list_file) {
+    std::ifstream ifs(list_file.c_str());
+    if (!ifs.good()) throw std::runtime_error("Cannot open file " + list_file + " for reading");
+    std::vector<std::string> file_cont;
+    std::string line;
+    while (std::getline(ifs, line)) {
+      std::string::size_type first = line.find_first_not_of(" \t\r");
+      if (std::string::npos == first) continue;
+      std::string::size_type last = line.find_last_not_of(" \t\r");
+      file_cont.push_back(line.substr(first, last - first + 1));
+    }
+    return file_cont;
+  }
+
+}
+
 namespace timeSystem {
 
   GlastTimeHandler::GlastTimeHandler(const std::string & file_name, const std::string & extension_name, bool read_only):
-    EventTimeHandler(file_name, extension_name, read_only), m_time_system(0), m_mjd_ref(0, 0.) {
+    EventTimeHandler(file_name, extension_name, read_only), m_time_system(0), m_mjd_ref(0, 0.), m_moment_ref(0, Duration(0, 0.)),
+    m_fits_name(file_name + "[" + extension_name + "]"), m_read_only(read_only), m_fits_ptr(0) {
     // Get time system name from TIMESYS keyword. If not found, assume TT system.
     const tip::Header & header(getHeader());
     std::string time_system_name;
@@ -41,20 +85,65 @@ namespace timeSystem {
 
     // Get MJDREF value.
     m_mjd_ref = readMjdRef(header, Mjd(51910, 64.184 / SecPerDay()));
+
+    // Pre-compute the moment of MJDREF in the time system of this file, for conversions between METs and AbsoluteTime's.
+    m_moment_ref = m_time_system->computeMoment(TimeFormatFactory<Mjd>::getFormat().convert(m_mjd_ref));
   }
 
-  GlastTimeHandler::~GlastTimeHandler() {}
+  GlastTimeHandler::~GlastTimeHandler() {
+    // Close the cfitsio pointer for column-wise access, if opened (ignore errors).
+    if (m_fits_ptr) {
+      int status = 0;
+      fits_close_file(m_fits_ptr, &status);
+      m_fits_ptr = 0;
+    }
+  }
+
+  GlastTimeHandler::HeaderKeyword::HeaderKeyword(const tip::Header & header): m_telescope(), m_instrument(), m_time_ref("LOCAL"),
+    m_time_sys("TT") {
+    // Get TELESCOP and INSTRUME keyword values, leaving them empty if missing.
+    if (header.find("TELESCOP") != header.end()) header["TELESCOP"].get(m_telescope);
+    if (header.find("INSTRUME") != header.end()) header["INSTRUME"].get(m_instrument);
+
+    // Get TIMEREF and TIMESYS keyword values to check whether times in this table are already barycentered.
+    if (header.find("TIMEREF") != header.end()) header["TIMEREF"].get(m_time_ref);
+    if (header.find("TIMESYS") != header.end()) header["TIMESYS"].get(m_time_sys);
+
+    // Convert all the values to upper case.
+    for (std::string::iterator itor = m_telescope.begin(); itor != m_telescope.end(); ++itor) *itor = std::toupper(*itor);
+    for (std::string::iterator itor = m_instrument.begin(); itor != m_instrument.end(); ++itor) *itor = std::toupper(*itor);
+    for (std::string::iterator itor = m_time_ref.begin(); itor != m_time_ref.end(); ++itor) *itor = std::toupper(*itor);
+    for (std::string::iterator itor = m_time_sys.begin(); itor != m_time_sys.end(); ++itor) *itor = std::toupper(*itor);
+  }
+
+  bool GlastTimeHandler::HeaderKeyword::match(const std::string & time_ref_value, const std::string & time_sys_value) const {
+    // Convert the given values to upper case.
+    std::string time_ref_arg(time_ref_value);
+    for (std::string::iterator itor = time_ref_arg.begin(); itor != time_ref_arg.end(); ++itor) *itor = std::toupper(*itor);
+    std::string time_sys_arg(time_sys_value);
+    for (std::string::iterator itor = time_sys_arg.begin(); itor != time_sys_arg.end(); ++itor) *itor = std::toupper(*itor);
+
+    // Return whether the header is of a Fermi LAT file with the given time reference and time system.
+    return ((m_telescope == "FERMI" || m_telescope == "GLAST") && m_instrument == "LAT" && m_time_ref == time_ref_arg &&
+      m_time_sys == time_sys_arg);
+  }
 
   EventTimeHandler * GlastTimeHandler::createInstance(const std::string & file_name, const std::string & extension_name,
     bool read_only) {
+    // Read the header keywords once, and select a handler class with them.
+    return createInstance(file_name, extension_name, readHeaderKeyword(file_name, extension_name), read_only);
+  }
+
+  EventTimeHandler * GlastTimeHandler::createInstance(const std::string & file_name, const std::string & extension_name,
+    const HeaderKeyword & header_keyword, bool read_only) {
     // Try GlastScTimeHandler first.
-    EventTimeHandler * handler = GlastScTimeHandler::createInstance(file_name, extension_name, read_only);
+    EventTimeHandler * handler = GlastScTimeHandler::createInstance(file_name, extension_name, header_keyword, read_only);
 
     // Try GlastGeoTimeHandler next.
-    if (0 == handler) handler = GlastGeoTimeHandler::createInstance(file_name, extension_name, read_only);
+    if (0 == handler) handler = GlastGeoTimeHandler::createInstance(file_name, extension_name, header_keyword, read_only);
 
     // Try GlastBaryTimeHandler next.
-    if (0 == handler) handler = GlastBaryTimeHandler::createInstance(file_name, extension_name, read_only);
+    if (0 == handler) handler = GlastBaryTimeHandler::createInstance(file_name, extension_name, header_keyword, read_only);
 
     // Return the handler (or zero if those classes above cannot handle it).
     return handler;
@@ -92,50 +181,105 @@ namespace timeSystem {
     return computeAbsoluteTime(time_double, time_system_rat);
   }
 
-  bool GlastTimeHandler::checkHeaderKeyword(const std::string & file_name, const std::string & extension_name,
-    const std::string & time_ref_value, const std::string & time_sys_value) {
-    // Get the table and the header.
-    std::unique_ptr<const tip::Extension> table(tip::IFileSvc::instance().readExtension(file_name, extension_name));
-    const tip::Header & header(table->getHeader());
+  void GlastTimeHandler::readTimes(const std::string & column_name, tip::Index_t first_row, tip::Index_t num_rows,
+    double * time_value) const {
+    // Do nothing for an empty block.
+    if (num_rows <= 0) return;
+
+    // Read the column for the given rows at a time.
+    // Note: cfitsio counts rows from 1 (one), while tip does from 0 (zero).
+    PerformanceMonitor::StageTimer timer(PerformanceMonitor::FILE_READ);
+    int column_number = 0;
+    fitsfile * fits_ptr = getFitsPointer(column_name, column_number);
+    int status = 0;
+    fits_read_col(fits_ptr, TDOUBLE, column_number, first_row + 1, 1, num_rows, 0, time_value, 0, &status);
+    if (status) {
+      std::ostringstream os;
+      os << "Error occurred while reading column " << column_name << " of " << m_fits_name << " from row " << first_row;
+      throw tip::TipException(status, os.str());
+    }
+  }
+
+  void GlastTimeHandler::writeTimes(const std::string & column_name, tip::Index_t first_row, tip::Index_t num_rows,
+    const double * time_value) {
+    // Do nothing for an empty block.
+    if (num_rows <= 0) return;
+
+    // Write the column for the given rows at a time.
+    // Note: cfitsio counts rows from 1 (one), while tip does from 0 (zero).
+    PerformanceMonitor::StageTimer timer(PerformanceMonitor::FILE_WRITE);
+    int column_number = 0;
+    fitsfile * fits_ptr = getFitsPointer(column_name, column_number);
+    int status = 0;
+    fits_write_col(fits_ptr, TDOUBLE, column_number, first_row + 1, 1, num_rows, const_cast<double *>(time_value), &status);
+    if (status) {
+      std::ostringstream os;
+      os << "Error occurred while writing column " << column_name << " of " << m_fits_name << " from row " << first_row;
+      throw tip::TipException(status, os.str());
+    }
+  }
 
-    // Check whether required keywords exist or not.
-    if (header.find("TELESCOP") == header.end() || header.find("INSTRUME") == header.end()) return false;
+  void GlastTimeHandler::readGlastTimeColumn(const std::string & column_name, tip::Index_t first_row, tip::Index_t num_rows,
+    std::vector<double> & glast_time) const {
+    // Prepare the return value.
+    glast_time.resize(num_rows > 0 ? num_rows : 0);
+    if (glast_time.empty()) return;
 
-    // Get TELESCOP keyword value.
-    std::string telescope;
-    header["TELESCOP"].get(telescope);
-    for (std::string::iterator itor = telescope.begin(); itor != telescope.end(); ++itor) *itor = std::toupper(*itor);
+    // Read the column for the given rows at a time.
+    readTimes(column_name, first_row, num_rows, &glast_time[0]);
+  }
 
-    // Get INSTRUME keyword value.
-    std::string instrument;
-    header["INSTRUME"].get(instrument);
-    for (std::string::iterator itor = instrument.begin(); itor != instrument.end(); ++itor) *itor = std::toupper(*itor);
+  void GlastTimeHandler::writeGlastTimeColumn(const std::string & column_name, tip::Index_t first_row,
+    const std::vector<double> & glast_time) {
+    // Do nothing for an empty block.
+    if (glast_time.empty()) return;
 
-    // Get TIMEREF keyword value to check whether times in this table are already barycentered.
-    std::string time_ref;
-    if (header.find("TIMEREF") != header.end()) {
-      header["TIMEREF"].get(time_ref);
-    } else {
-      time_ref = "LOCAL";
-    }
-    for (std::string::iterator itor = time_ref.begin(); itor != time_ref.end(); ++itor) *itor = std::toupper(*itor);
-    std::string time_ref_arg(time_ref_value);
-    for (std::string::iterator itor = time_ref_arg.begin(); itor != time_ref_arg.end(); ++itor) *itor = std::toupper(*itor);
+    // Write the column for the given rows at a time.
+    writeTimes(column_name, first_row, glast_time.size(), &glast_time[0]);
+  }
 
-    // Get TIMESYS keyword value to check whether times in this table are already barycentered.
-    std::string time_sys;
-    if (header.find("TIMESYS") != header.end()) {
-      header["TIMESYS"].get(time_sys);
-    } else {
-      time_sys = "TT";
+  void GlastTimeHandler::writeTimeColumn(const std::string & column_name, tip::Index_t first_row,
+    const std::vector<AbsoluteTime> & abs_time) {
+    // Convert AbsoluteTime's to GLAST times.
+    std::vector<double> glast_time;
+    computeGlastTime(abs_time, glast_time);
+
+    // Write the GLAST times to the specified column.
+    writeGlastTimeColumn(column_name, first_row, glast_time);
+  }
+
+  fitsfile * GlastTimeHandler::getFitsPointer(const std::string & column_name, int & column_number) const {
+    int status = 0;
+
+    // Open the FITS table on the first request.
+    // Note: cfitsio shares internal buffers with the file opened by tip, so that both views of the file stay consistent.
+    if (0 == m_fits_ptr) {
+      fits_open_file(&m_fits_ptr, m_fits_name.c_str(), (m_read_only ? READONLY : READWRITE), &status);
+      if (status) {
+        m_fits_ptr = 0;
+        throw tip::TipException(status, "Error occurred while opening " + m_fits_name + " for column-wise access");
+      }
     }
-    for (std::string::iterator itor = time_sys.begin(); itor != time_sys.end(); ++itor) *itor = std::toupper(*itor);
-    std::string time_sys_arg(time_sys_value);
-    for (std::string::iterator itor = time_sys_arg.begin(); itor != time_sys_arg.end(); ++itor) *itor = std::toupper(*itor);
 
+    // Look up the column number.
+    fits_get_colnum(m_fits_ptr, CASEINSEN, const_cast<char *>(column_name.c_str()), &column_number, &status);
+    if (status) throw tip::TipException(status, "Could not find column " + column_name + " in " + m_fits_name);
+
+    // Return the pointer.
+    return m_fits_ptr;
+  }
+
+  GlastTimeHandler::HeaderKeyword GlastTimeHandler::readHeaderKeyword(const std::string & file_name,
+    const std::string & extension_name) {
+    // Get the table and the header, and read the header keywords from it.
+    std::unique_ptr<const tip::Extension> table(tip::IFileSvc::instance().readExtension(file_name, extension_name));
+    return HeaderKeyword(table->getHeader());
+  }
+
+  bool GlastTimeHandler::checkHeaderKeyword(const std::string & file_name, const std::string & extension_name,
+    const std::string & time_ref_value, const std::string & time_sys_value) {
     // Return whether this class can handle the file or not.
-    return ((telescope == "FERMI" || telescope == "GLAST") && instrument == "LAT" && time_ref == time_ref_arg &&
-      time_sys == time_sys_arg);
+    return readHeaderKeyword(file_name, extension_name).match(time_ref_value, time_sys_value);
   }
 
   double GlastTimeHandler::readGlastTime(const std::string & field_name, bool from_header) const {
@@ -163,6 +307,7 @@ namespace timeSystem {
 
     } else {
       // Read it from the current record.
+      PerformanceMonitor::StageTimer timer(PerformanceMonitor::FILE_READ);
       const tip::TableRecord & record(getCurrentRecord());
       record[field_name].get(field_value);
     }
@@ -192,6 +337,7 @@ namespace timeSystem {
 
     } else {
       // Write the time to the current record.
+      PerformanceMonitor::StageTimer timer(PerformanceMonitor::FILE_WRITE);
       tip::TableRecord & record(getCurrentRecord());
       record[field_name].set(glast_time);
     }
@@ -199,28 +345,78 @@ namespace timeSystem {
 
   AbsoluteTime GlastTimeHandler::computeAbsoluteTime(double glast_time) const {
     // Convert GLAST time to AbsoluteTime, and return it.
-    return computeAbsoluteTime(glast_time, m_time_system->getName());
+    return AbsoluteTime(*m_time_system, m_moment_ref.first, m_moment_ref.second + Duration::from<Sec>(glast_time));
   }
 
   AbsoluteTime GlastTimeHandler::computeAbsoluteTime(double glast_time, const std::string & time_system_name) const {
     // Convert GLAST time to AbsoluteTime, and return it.
-    return AbsoluteTime(time_system_name, m_mjd_ref) + ElapsedTime(time_system_name, Duration(glast_time, "Sec"));
+    return AbsoluteTime(time_system_name, m_mjd_ref) + ElapsedTime(time_system_name, Duration::from<Sec>(glast_time));
   }
 
   double GlastTimeHandler::computeGlastTime(const AbsoluteTime & abs_time) const {
     // Convert AbsoluteTime to GLAST time, and return it.
-    const std::string time_system_name = m_time_system->getName();
-    return (abs_time - AbsoluteTime(time_system_name, m_mjd_ref)).computeDuration(time_system_name, "Sec");
+    return abs_time.computeElapsedSec(*m_time_system, m_moment_ref);
+  }
+
+  void GlastTimeHandler::computeGlastTime(const std::vector<AbsoluteTime> & abs_time, std::vector<double> & glast_time) const {
+    PerformanceMonitor::StageTimer timer(PerformanceMonitor::TIME_CONVERSION);
+    glast_time.resize(abs_time.size());
+    for (std::vector<AbsoluteTime>::size_type idx = 0; idx < abs_time.size(); ++idx) glast_time[idx] = computeGlastTime(abs_time[idx]);
+  }
+
+  void GlastTimeHandler::computeGlastTime(const std::vector<AbsoluteTime> & abs_time, const TimeSystem & time_system,
+    std::vector<double> & glast_time) const {
+    PerformanceMonitor::StageTimer timer(PerformanceMonitor::TIME_CONVERSION);
+    // Note: MJDREF in the given time system is represented by the same moment as in the time system of the opened table.
+    glast_time.resize(abs_time.size());
+    for (std::vector<AbsoluteTime>::size_type idx = 0; idx < abs_time.size(); ++idx) {
+      glast_time[idx] = abs_time[idx].computeElapsedSec(time_system, m_moment_ref);
+    }
+  }
+
+  const TimeSystem & GlastTimeHandler::getTimeSystem() const {
+    return *m_time_system;
+  }
+
+  bool GlastTimeHandler::hasSameMjdRef(const GlastTimeHandler & other) const {
+    return m_mjd_ref.m_int == other.m_mjd_ref.m_int && m_mjd_ref.m_frac == other.m_mjd_ref.m_frac;
+  }
+
+  Jd GlastTimeHandler::computeTtJd(double glast_time) const {
+    // Compute the Julian Date through an AbsoluteTime object unless the MET is measured in TT system.
+    static const TimeSystem & s_tt_system(TimeSystem::getSystem("TT"));
+    if (&s_tt_system != m_time_system) {
+      Jd jd_rep(0, 0.);
+      computeAbsoluteTime(glast_time).get(s_tt_system, jd_rep);
+      return jd_rep;
+    }
+
+    // Split the MET into the number of days and the remainder, in order to keep precision of the fractional part.
+    const double sec_per_day = SecPerDay();
+    double num_day = std::floor(glast_time / sec_per_day);
+    double jd_frac = m_mjd_ref.m_frac + .5 + (glast_time - num_day * sec_per_day) / sec_per_day;
+    long jd_int = m_mjd_ref.m_int + 2400000 + static_cast<long>(num_day);
+
+    // Normalize the fractional part into the range of [0, 1).
+    double frac_carry = std::floor(jd_frac);
+    jd_int += static_cast<long>(frac_carry);
+    jd_frac -= frac_carry;
+
+    // Return the Julian Date.
+    return Jd(jd_int, jd_frac);
   }
 
   GlastScTimeHandler::GlastScTimeHandler(const std::string & file_name, const std::string & extension_name, bool read_only):
-    GlastTimeHandler(file_name, extension_name, read_only), m_sc_file(), m_sc_table(), m_sc_ptr(0), m_pos_bary(0., 0.),
-    m_computer(0) {}
+    GlastTimeHandler(file_name, extension_name, read_only), m_sc_file(), m_sc_table(), m_sc_entry(), m_pos_bary(0., 0.),
+    m_computer(0), m_delay_tolerance(0.), m_max_delay_error(0.) {}
 
   GlastScTimeHandler::~GlastScTimeHandler() {
     // Clean up the spacecraft file access.
-    int close_status = glastscorbit_close(m_sc_ptr);
-    m_sc_ptr = 0;
+    int close_status = 0;
+    {
+      std::lock_guard<std::mutex> lock(s_glastscorbit_mutex);
+      close_status = closeScFile();
+    }
     if (close_status) {
       std::ostringstream os;
       os << "Error occurred while closing spacecraft file " << m_sc_file;
@@ -229,13 +425,38 @@ namespace timeSystem {
     }
   }
 
+  GlastScTimeHandler::ScFileHolder::ScFileHolder(const std::string & sc_file_name, const std::string & sc_extension_name):
+    m_sc_ptr(0) {
+    // Leave a list of spacecraft files to GlastScTimeHandler objects, which load the listed files only as needed.
+    if (!sc_file_name.empty() && '@' == sc_file_name[0]) return;
+
+    std::lock_guard<std::mutex> lock(s_glastscorbit_mutex);
+    m_sc_ptr = glastscorbit_open(const_cast<char *>(sc_file_name.c_str()), const_cast<char *>(sc_extension_name.c_str()));
+    if (m_sc_ptr && glastscorbit_getstatus(m_sc_ptr)) {
+      glastscorbit_close(m_sc_ptr);
+      m_sc_ptr = 0;
+    }
+  }
+
+  GlastScTimeHandler::ScFileHolder::~ScFileHolder() {
+    if (m_sc_ptr) {
+      std::lock_guard<std::mutex> lock(s_glastscorbit_mutex);
+      glastscorbit_close(m_sc_ptr);
+    }
+  }
+
   EventTimeHandler * GlastScTimeHandler::createInstance(const std::string & file_name, const std::string & extension_name,
     bool read_only) {
+    return createInstance(file_name, extension_name, readHeaderKeyword(file_name, extension_name), read_only);
+  }
+
+  EventTimeHandler * GlastScTimeHandler::createInstance(const std::string & file_name, const std::string & extension_name,
+    const HeaderKeyword & header_keyword, bool read_only) {
     // Create an object to hold a return value and set a default return value.
     EventTimeHandler * handler(0);
 
     // Check header keywords to identify an event file with barycentric corrections NOT applied.
-    if (checkHeaderKeyword(file_name, extension_name, "LOCAL", "TT")) {
+    if (isSupported(header_keyword)) {
       handler = new GlastScTimeHandler(file_name, extension_name, read_only);
     }
 
@@ -243,28 +464,69 @@ namespace timeSystem {
     return handler;
   }
 
+  bool GlastScTimeHandler::isSupported(const HeaderKeyword & header_keyword) {
+    return header_keyword.match("LOCAL", "TT");
+  }
+
   void GlastScTimeHandler::initTimeCorrection(const std::string & sc_file_name, const std::string & sc_extension_name,
      const std::string & solar_eph, bool /*match_solar_eph*/, double /*angular_tolerance*/) {
-    // Check header keywords.
-    if (!checkHeaderKeyword(sc_file_name, sc_extension_name, "LOCAL", "TT")) {
-      throw std::runtime_error("Unsupported spacecraft file \"" + sc_file_name + "[" + sc_extension_name + "]\"");
-    }
+    std::vector<ScFileEntry> sc_entry;
+    bool is_list = !sc_file_name.empty() && '@' == sc_file_name[0];
+    if (!is_list) {
+      // Check header keywords.
+      if (!checkHeaderKeyword(sc_file_name, sc_extension_name, "LOCAL", "TT")) {
+        throw std::runtime_error("Unsupported spacecraft file \"" + sc_file_name + "[" + sc_extension_name + "]\"");
+      }
 
-    // Set the given spacecraft file name and the extention name to the internal variables.
-    m_sc_file = sc_file_name;
-    m_sc_table = sc_extension_name;
+      // Use the given spacecraft file for all times.
+      ScFileEntry entry = { sc_file_name, -std::numeric_limits<double>::max(), 0, 0 };
+      sc_entry.push_back(entry);
 
-    // Close the previously opened spacecraft file (ignore errors).
-    glastscorbit_close(m_sc_ptr);
+    } else {
+      // Index the listed spacecraft files by their start times, reading only their headers.
+      std::vector<std::string> file_cont = readFileList(sc_file_name.substr(1));
+      if (file_cont.empty()) throw std::runtime_error("No spacecraft file is listed in " + sc_file_name.substr(1));
+      std::vector<long> num_rows;
+      for (std::vector<std::string>::const_iterator itor = file_cont.begin(); itor != file_cont.end(); ++itor) {
+        std::unique_ptr<const tip::Extension> table(tip::IFileSvc::instance().readExtension(*itor, sc_extension_name));
+        const tip::Header & header(table->getHeader());
+        if (!HeaderKeyword(header).match("LOCAL", "TT")) {
+          throw std::runtime_error("Unsupported spacecraft file \"" + *itor + "[" + sc_extension_name + "]\"");
+        }
+        ScFileEntry entry = { *itor, 0., 0, 0 };
+        header["TSTART"].get(entry.m_start_time);
+        sc_entry.push_back(entry);
+        long this_num_rows = 0;
+        header["NAXIS2"].get(this_num_rows);
+        num_rows.push_back(this_num_rows);
+      }
 
-    // Open the given spacecraft file.
-    m_sc_ptr = glastscorbit_open(const_cast<char *>(m_sc_file.c_str()), const_cast<char *>(m_sc_table.c_str()));
-    int open_status = glastscorbit_getstatus(m_sc_ptr);
-    if (open_status) {
-      std::ostringstream os;
-      os << "Error occurred while opening spacecraft file " << m_sc_file;
-      if (!m_sc_table.empty()) os << "[" << m_sc_table << "]";
-      throw tip::TipException(open_status, os.str());
+      // Sort the files by their start times, and number the intervals of all the files in the same order.
+      // Note: The interval between the last row of a file and the first row of the next file is also counted.
+      std::vector<std::size_t> file_order(sc_entry.size());
+      for (std::size_t ii = 0; ii < file_order.size(); ++ii) file_order[ii] = ii;
+      std::stable_sort(file_order.begin(), file_order.end(), [&](std::size_t index1, std::size_t index2) {
+        return sc_entry[index1].m_start_time < sc_entry[index2].m_start_time;
+      });
+      std::vector<ScFileEntry> sorted_entry;
+      long first_interval = 0;
+      for (std::vector<std::size_t>::const_iterator itor = file_order.begin(); itor != file_order.end(); ++itor) {
+        sorted_entry.push_back(sc_entry[*itor]);
+        sorted_entry.back().m_first_interval = first_interval;
+        first_interval += num_rows[*itor];
+      }
+      sc_entry.swap(sorted_entry);
+    }
+
+    // Close the previously opened spacecraft files (ignore errors), and set the given spacecraft files to the internal variables.
+    // Then open the given spacecraft file, unless a list of spacecraft files is given.
+    {
+      std::lock_guard<std::mutex> lock(s_glastscorbit_mutex);
+      closeScFile();
+      m_sc_file = sc_file_name;
+      m_sc_table = sc_extension_name;
+      m_sc_entry.swap(sc_entry);
+      if (!is_list) loadScFile(0);
     }
 
     // Initializing clock and orbit are not necessary for GLAST.
@@ -275,12 +537,218 @@ namespace timeSystem {
 
     // Get a barycentric time computer for the given solar system ephemeris.
     m_computer = &BaryTimeComputer::getComputer(solar_eph);
+
+    // Make solar system ephemeris for the time span of the events available in memory before any of them is corrected.
+    const tip::Header & header(getHeader());
+    if (header.find("TSTART") != header.end() && header.find("TSTOP") != header.end()) {
+      double tstart = 0.;
+      double tstop = 0.;
+      header["TSTART"].get(tstart);
+      header["TSTOP"].get(tstop);
+      m_computer->prefetchEphemeris(computeTtJd(tstart), computeTtJd(tstop));
+    }
   }
 
   void GlastScTimeHandler::setSourcePosition(const SourcePosition & src_position) {
     m_pos_bary = src_position;
   }
 
+  void GlastScTimeHandler::setDelayTolerance(double delay_tolerance) {
+    m_delay_tolerance = delay_tolerance;
+    m_max_delay_error.store(0., std::memory_order_relaxed);
+  }
+
+  double GlastScTimeHandler::getMaxDelayError() const {
+    return m_max_delay_error.load(std::memory_order_relaxed);
+  }
+
+  int GlastScTimeHandler::closeScFile() {
+    int close_status = 0;
+    for (std::vector<ScFileEntry>::iterator itor = m_sc_entry.begin(); itor != m_sc_entry.end(); ++itor) {
+      if (itor->m_sc_ptr) {
+        int this_status = glastscorbit_close(itor->m_sc_ptr);
+        if (0 == close_status) close_status = this_status;
+        itor->m_sc_ptr = 0;
+      }
+    }
+    return close_status;
+  }
+
+  GlastScFile * GlastScTimeHandler::loadScFile(std::size_t entry_index) const {
+    // Return the spacecraft file pointer if the file is already loaded.
+    ScFileEntry & entry(m_sc_entry[entry_index]);
+    if (entry.m_sc_ptr) return entry.m_sc_ptr;
+
+    // Open the spacecraft file.
+    GlastScFile * sc_ptr = glastscorbit_open(const_cast<char *>(entry.m_file_name.c_str()), const_cast<char *>(m_sc_table.c_str()));
+    int open_status = glastscorbit_getstatus(sc_ptr);
+    if (open_status) {
+      glastscorbit_close(sc_ptr);
+      std::ostringstream os;
+      os << "Error occurred while opening spacecraft file " << entry.m_file_name;
+      if (!m_sc_table.empty()) os << "[" << m_sc_table << "]";
+      throw tip::TipException(open_status, os.str());
+    }
+    entry.m_sc_ptr = sc_ptr;
+    return sc_ptr;
+  }
+
+  void GlastScTimeHandler::prepareScFile(const std::vector<double> & glast_time) const {
+    // Do nothing if a single spacecraft file is given, because it is loaded by initTimeCorrection method.
+    if (m_sc_entry.size() <= 1 || glast_time.empty()) return;
+
+    // Load the files selected for the given range of times, and the ones next to them, which searchScFile may also search.
+    std::pair<std::vector<double>::const_iterator, std::vector<double>::const_iterator> time_range =
+      std::minmax_element(glast_time.begin(), glast_time.end());
+    ScCursor sc_cursor = { 0, std::vector<GlastScCursor>() };
+    std::size_t first_index = selectScFile(*time_range.first, sc_cursor);
+    std::size_t last_index = selectScFile(*time_range.second, sc_cursor);
+    if (first_index > 0) --first_index;
+    if (last_index + 1 < m_sc_entry.size()) ++last_index;
+    std::lock_guard<std::mutex> lock(s_glastscorbit_mutex);
+    for (std::size_t entry_index = first_index; entry_index <= last_index; ++entry_index) loadScFile(entry_index);
+  }
+
+  void GlastScTimeHandler::initScCursor(ScCursor & sc_cursor) const {
+    sc_cursor.m_entry_index = 0;
+    sc_cursor.m_file_cursor.resize(m_sc_entry.size());
+    for (std::vector<GlastScCursor>::iterator itor = sc_cursor.m_file_cursor.begin(); itor != sc_cursor.m_file_cursor.end();
+      ++itor) glastscorbit_initcursor(&*itor);
+  }
+
+  void GlastScTimeHandler::recordScCursorStatistics(const ScCursor & sc_cursor) const {
+    // Add the numbers of spacecraft file searches to the process-wide counters.
+    if (!PerformanceMonitor::isEnabled()) return;
+    for (std::vector<GlastScCursor>::const_iterator itor = sc_cursor.m_file_cursor.begin();
+      itor != sc_cursor.m_file_cursor.end(); ++itor) {
+      PerformanceMonitor::addCount(PerformanceMonitor::SC_FILE_HIT, itor->num_hit);
+      PerformanceMonitor::addCount(PerformanceMonitor::SC_FILE_RUN_HIT, itor->num_run_hit);
+      PerformanceMonitor::addCount(PerformanceMonitor::SC_FILE_MISS, itor->num_miss);
+    }
+  }
+
+  std::size_t GlastScTimeHandler::selectScFile(double glast_time, ScCursor & sc_cursor) const {
+    // Select the last file that starts at or before the given time, trying the file selected last time first.
+    // Note: The first file is selected for a time before it, in order to leave the check of coverage to glastscorbit C-functions.
+    std::size_t num_entry = m_sc_entry.size();
+    std::size_t entry_index = sc_cursor.m_entry_index;
+    if (!(m_sc_entry[entry_index].m_start_time <= glast_time &&
+          (entry_index + 1 == num_entry || glast_time < m_sc_entry[entry_index + 1].m_start_time))) {
+      std::vector<ScFileEntry>::const_iterator itor = std::upper_bound(m_sc_entry.begin() + 1, m_sc_entry.end(), glast_time,
+        [](double this_time, const ScFileEntry & entry) { return this_time < entry.m_start_time; });
+      entry_index = itor - m_sc_entry.begin() - 1;
+    }
+    sc_cursor.m_entry_index = entry_index;
+    return entry_index;
+  }
+
+  int GlastScTimeHandler::searchScFile(double glast_time, ScCursor & sc_cursor, std::size_t & entry_index,
+    long & interval) const {
+    // Check initialization status.
+    if (m_sc_entry.empty()) return BAD_FILEPTR;
+
+    // Search the file selected for the given time.
+    std::size_t this_index = selectScFile(glast_time, sc_cursor);
+    GlastScFile * sc_ptr = m_sc_entry[this_index].m_sc_ptr;
+    int search_status = glastscorbit_getinterval_r(sc_ptr, &sc_cursor.m_file_cursor[this_index], glast_time, &interval);
+    if (TIME_OUT_BOUNDS != search_status) {
+      entry_index = this_index;
+      return search_status;
+    }
+
+    // Search the previous file if the given time is before the first row of the selected file, or the next file otherwise.
+    double sctime = 0.;
+    double scposn[3];
+    if (glastscorbit_getrow(sc_ptr, 0, &sctime, scposn)) return TIME_OUT_BOUNDS;
+    std::size_t other_index = this_index;
+    if (glast_time < sctime) {
+      if (0 == this_index) return TIME_OUT_BOUNDS;
+      --other_index;
+    } else {
+      if (this_index + 1 == m_sc_entry.size()) return TIME_OUT_BOUNDS;
+      ++other_index;
+    }
+    search_status = glastscorbit_getinterval_r(m_sc_entry[other_index].m_sc_ptr, &sc_cursor.m_file_cursor[other_index],
+      glast_time, &interval);
+    if (TIME_OUT_BOUNDS != search_status) {
+      entry_index = other_index;
+      return search_status;
+    }
+
+    // Accept the time if it is after the last row of the earlier file, and before the first row of the later file.
+    std::size_t prev_index = std::min(this_index, other_index);
+    GlastScFile * prev_ptr = m_sc_entry[prev_index].m_sc_ptr;
+    long num_rows = 0;
+    double sctime_prev = 0.;
+    double sctime_next = 0.;
+    if (glastscorbit_getnumrows(prev_ptr, &num_rows) || glastscorbit_getrow(prev_ptr, num_rows - 1, &sctime_prev, scposn) ||
+        glastscorbit_getrow(m_sc_entry[prev_index + 1].m_sc_ptr, 0, &sctime_next, scposn)) return TIME_OUT_BOUNDS;
+    if (!(sctime_prev < glast_time && glast_time < sctime_next)) return TIME_OUT_BOUNDS;
+    entry_index = prev_index;
+    interval = -1;
+    return 0;
+  }
+
+  int GlastScTimeHandler::calcScPosition(double glast_time, ScCursor & sc_cursor, double sc_position[]) const {
+    // Compute the spacecraft position from the file selected for the given time, which covers the time in most cases.
+    if (m_sc_entry.empty()) return BAD_FILEPTR;
+    std::size_t this_index = selectScFile(glast_time, sc_cursor);
+    int calc_status = glastscorbit_calcpos_r(m_sc_entry[this_index].m_sc_ptr, &sc_cursor.m_file_cursor[this_index], glast_time,
+      sc_position);
+    if (TIME_OUT_BOUNDS != calc_status || 1 == m_sc_entry.size()) return calc_status;
+
+    // Find the spacecraft file that contains the given time, including a gap between two listed files.
+    std::size_t entry_index = 0;
+    long interval = 0;
+    calc_status = searchScFile(glast_time, sc_cursor, entry_index, interval);
+    if (calc_status) return calc_status;
+
+    // Compute the spacecraft position from the file found above.
+    if (interval >= 0) {
+      return glastscorbit_calcpos_r(m_sc_entry[entry_index].m_sc_ptr, &sc_cursor.m_file_cursor[entry_index], glast_time,
+        sc_position);
+    }
+
+    // Interpolate between the last row of the file and the first row of the next file.
+    GlastScFile * prev_ptr = m_sc_entry[entry_index].m_sc_ptr;
+    GlastScFile * next_ptr = m_sc_entry[entry_index + 1].m_sc_ptr;
+    long num_rows = 0;
+    double sctime1 = 0.;
+    double sctime2 = 0.;
+    double scposn1[3];
+    double scposn2[3];
+    glastscorbit_getnumrows(prev_ptr, &num_rows);
+    glastscorbit_getrow(prev_ptr, num_rows - 1, &sctime1, scposn1);
+    glastscorbit_getrow(next_ptr, 0, &sctime2, scposn2);
+    glastscorbit_interpolate(glast_time, sctime1, scposn1, sctime2, scposn2, sc_position);
+    return 0;
+  }
+
+  int GlastScTimeHandler::searchScInterval(double glast_time, ScCursor & sc_cursor, long & interval, double & begin_time,
+    double & end_time) const {
+    // Find the spacecraft file and the interval in it that contain the given time.
+    std::size_t entry_index = 0;
+    long this_interval = 0;
+    int search_status = searchScFile(glast_time, sc_cursor, entry_index, this_interval);
+    if (search_status) return search_status;
+
+    // Number the interval among the intervals of all the files, and get the times of the rows that bound it.
+    GlastScFile * sc_ptr = m_sc_entry[entry_index].m_sc_ptr;
+    double scposn[3];
+    if (this_interval >= 0) {
+      interval = m_sc_entry[entry_index].m_first_interval + this_interval;
+      search_status = glastscorbit_getrow(sc_ptr, this_interval, &begin_time, scposn);
+      if (0 == search_status) search_status = glastscorbit_getrow(sc_ptr, this_interval + 1, &end_time, scposn);
+    } else {
+      interval = m_sc_entry[entry_index + 1].m_first_interval - 1;
+      long num_rows = 0;
+      search_status = glastscorbit_getnumrows(sc_ptr, &num_rows);
+      if (0 == search_status) search_status = glastscorbit_getrow(sc_ptr, num_rows - 1, &begin_time, scposn);
+      if (0 == search_status) search_status = glastscorbit_getrow(m_sc_entry[entry_index + 1].m_sc_ptr, 0, &end_time, scposn);
+    }
+    return search_status;
+  }
+
   AbsoluteTime GlastScTimeHandler::getGeoTime(const std::string & field_name, bool from_header) const {
     return getCorrectedTime(field_name, from_header, false);
   }
@@ -289,44 +757,351 @@ namespace timeSystem {
     return getCorrectedTime(field_name, from_header, true);
   }
 
-  AbsoluteTime GlastScTimeHandler::getCorrectedTime(const std::string & field_name, bool from_header, bool compute_bary) const {
+  void GlastScTimeHandler::getGeoTimes(const std::string & column_name, tip::Index_t first_row, tip::Index_t num_rows,
+    double * time_value) const {
+    getCorrectedTimes(column_name, first_row, num_rows, false, time_value);
+  }
+
+  void GlastScTimeHandler::getBaryTimes(const std::string & column_name, tip::Index_t first_row, tip::Index_t num_rows,
+    double * time_value) const {
+    getCorrectedTimes(column_name, first_row, num_rows, true, time_value);
+  }
+
+  void GlastScTimeHandler::computeCorrectedTime(const std::vector<double> & glast_time, bool compute_bary,
+    std::vector<AbsoluteTime> & abs_time) const {
+    computeCorrectedTime(glast_time, std::vector<SourcePosition>(1, m_pos_bary), compute_bary, abs_time);
+  }
+
+  void GlastScTimeHandler::computeCorrectedTime(const std::vector<double> & glast_time,
+    const std::vector<SourcePosition> & src_position, bool compute_bary, std::vector<AbsoluteTime> & abs_time) const {
     // Check initialization status.
     if (!m_computer) throw std::runtime_error("Arrival time corrections not initialized");
 
-    // Read the field value as a GLAST time.
-    double glast_time = readGlastTime(field_name, from_header);
+    // Compute time delays for geocentric or barycentric corrections for all the sources at a time, interpolating them if requested.
+    std::vector<double>::size_type num_time = glast_time.size();
+    std::vector<double> delay;
+    if (m_delay_tolerance > 0.) interpolateTimeDelay(glast_time, src_position, compute_bary, delay);
+    else computeTimeDelay(glast_time, src_position, compute_bary, delay);
+
+    // Add the time delays to the given times.
+    // Note: Time delays for barycentric corrections must be added in TDB system, as explained in BaryTimeComputer.
+    static const TimeSystem & s_tdb_system(TimeSystem::getSystem("TDB"));
+    static const TimeSystem & s_tt_system(TimeSystem::getSystem("TT"));
+    const TimeSystem & time_system(compute_bary ? s_tdb_system : s_tt_system);
+    PerformanceMonitor::StageTimer timer(PerformanceMonitor::TIME_CONVERSION);
+    abs_time.clear();
+    abs_time.reserve(src_position.size() * num_time);
+    if (1 == src_position.size()) {
+      for (std::vector<double>::size_type time_index = 0; time_index < num_time; ++time_index) {
+        abs_time.push_back(computeAbsoluteTime(glast_time[time_index]) + ElapsedTime(time_system, Duration::from<Sec>(delay[time_index])));
+      }
+    } else {
+      // Convert the given times to absolute times only once for all the sources.
+      std::vector<AbsoluteTime> arrival_time;
+      arrival_time.reserve(num_time);
+      for (std::vector<double>::size_type time_index = 0; time_index < num_time; ++time_index) {
+        arrival_time.push_back(computeAbsoluteTime(glast_time[time_index]));
+      }
+      std::vector<double>::const_iterator delay_itor = delay.begin();
+      for (std::vector<SourcePosition>::size_type src_index = 0; src_index < src_position.size(); ++src_index) {
+        for (std::vector<double>::size_type time_index = 0; time_index < num_time; ++time_index, ++delay_itor) {
+          abs_time.push_back(arrival_time[time_index] + ElapsedTime(time_system, Duration::from<Sec>(*delay_itor)));
+        }
+      }
+    }
+  }
 
-    // Convert GLAST time to AbsoluteTime.
-    AbsoluteTime abs_time = computeAbsoluteTime(glast_time);
+  void GlastScTimeHandler::computeCorrectedGlastTime(const std::vector<double> & glast_time,
+    const std::vector<SourcePosition> & src_position, bool compute_bary, std::vector<double> & corrected_time) const {
+    // Check initialization status.
+    if (!m_computer) throw std::runtime_error("Arrival time corrections not initialized");
 
-    // Compute spacecraft position at the given time.
-    double sc_position_array[3];
-    int calc_status = glastscorbit_calcpos(m_sc_ptr, glast_time, sc_position_array);
-    if (calc_status) {
-      // Create the common part of the error message.
-      std::ostringstream os;
-      os << "Cannot get Fermi spacecraft position for " << std::setprecision(std::numeric_limits<double>::digits10) <<
-        glast_time << " Fermi MET (TT):";
-
-      // Throw an appropriate exception depending on the type of error.
-      if (TIME_OUT_BOUNDS == calc_status) {
-        os << " the time is not covered by spacecraft file " << m_sc_file;
-        if (!m_sc_table.empty()) os << "[" << m_sc_table << "]";
-        throw std::runtime_error(os.str());
+    // Compute corrected times through AbsoluteTime objects unless the METs are measured in TT system.
+    static const TimeSystem & s_tdb_system(TimeSystem::getSystem("TDB"));
+    static const TimeSystem & s_tt_system(TimeSystem::getSystem("TT"));
+    if (&s_tt_system != &getTimeSystem()) {
+      std::vector<AbsoluteTime> abs_time;
+      computeCorrectedTime(glast_time, src_position, compute_bary, abs_time);
+      computeGlastTime(abs_time, compute_bary ? s_tdb_system : s_tt_system, corrected_time);
+      return;
+    }
+
+    // Compute Julian Dates in TT system at the given times, and the time differences between TDB and TT for them.
+    // Note: The MJDREF in TDB system is represented by the same numbers as in TT system, so that a MET in TDB system is
+    //       the MET in TT system plus the time difference between TDB and TT, plus the time delay (added in TDB system).
+    std::vector<double>::size_type num_time = glast_time.size();
+    std::vector<Jd> tt_time(num_time, Jd(0, 0.));
+    std::vector<double> time_offset(num_time, 0.);
+    {
+      PerformanceMonitor::StageTimer timer(PerformanceMonitor::TIME_CONVERSION);
+      for (std::vector<double>::size_type time_index = 0; time_index < num_time; ++time_index) {
+        const Jd & jd_rep(tt_time[time_index] = computeTtJd(glast_time[time_index]));
+        if (compute_bary) {
+          // Note: A Julian Date starts at noon, half a day later than an MJD with the same fractional part.
+          double mjd_frac = jd_rep.m_frac - .5;
+          long mjd_int = jd_rep.m_int - 2400000;
+          if (mjd_frac < 0.) {
+            mjd_frac += 1.;
+            --mjd_int;
+          }
+          time_offset[time_index] = TimeSystem::computeTdbMinusTtInSec(datetime_type(mjd_int, mjd_frac * SecPerDay()));
+        }
+      }
+    }
+
+    // Compute time delays for geocentric or barycentric corrections for all the sources at a time.
+    std::vector<double> delay;
+    if (m_delay_tolerance > 0.) interpolateTimeDelay(glast_time, src_position, compute_bary, delay);
+    else computeTimeDelay(glast_time, tt_time, src_position, compute_bary, delay);
+
+    // Add the time differences and the time delays to the given times.
+    PerformanceMonitor::StageTimer timer(PerformanceMonitor::TIME_CONVERSION);
+    corrected_time.resize(delay.size());
+    std::vector<double>::const_iterator delay_itor = delay.begin();
+    std::vector<double>::iterator corrected_itor = corrected_time.begin();
+    for (std::vector<SourcePosition>::size_type src_index = 0; src_index < src_position.size(); ++src_index) {
+      for (std::vector<double>::size_type time_index = 0; time_index < num_time; ++time_index, ++delay_itor, ++corrected_itor) {
+        *corrected_itor = glast_time[time_index] + (time_offset[time_index] + *delay_itor);
+      }
+    }
+  }
+
+  void GlastScTimeHandler::throwScPositionError(double glast_time, int calc_status) const {
+    // Create the common part of the error message.
+    std::ostringstream os;
+    os << "Cannot get Fermi spacecraft position for " << std::setprecision(std::numeric_limits<double>::digits10) <<
+      glast_time << " Fermi MET (TT):";
+
+    // Throw an appropriate exception depending on the type of error.
+    if (TIME_OUT_BOUNDS == calc_status) {
+      os << " the time is not covered by spacecraft file " << m_sc_file;
+      if (!m_sc_table.empty()) os << "[" << m_sc_table << "]";
+      throw std::runtime_error(os.str());
+    } else {
+      os << " error occurred while reading spacecraft file " << m_sc_file;
+      if (!m_sc_table.empty()) os << "[" << m_sc_table << "]";
+      throw tip::TipException(calc_status, os.str());
+    }
+  }
+
+  void GlastScTimeHandler::computeTimeDelay(const std::vector<double> & glast_time,
+    const std::vector<SourcePosition> & src_position, bool compute_bary, std::vector<double> & delay) const {
+    // Compute Julian Dates in TT system at the given times.
+    std::vector<double>::size_type num_time = glast_time.size();
+    std::vector<Jd> tt_time(num_time, Jd(0, 0.));
+    {
+      PerformanceMonitor::StageTimer timer(PerformanceMonitor::TIME_CONVERSION);
+      for (std::vector<double>::size_type time_index = 0; time_index < num_time; ++time_index) {
+        tt_time[time_index] = computeTtJd(glast_time[time_index]);
+      }
+    }
+
+    // Compute time delays at the given times.
+    computeTimeDelay(glast_time, tt_time, src_position, compute_bary, delay);
+  }
+
+  void GlastScTimeHandler::computeTimeDelay(const std::vector<double> & glast_time, const std::vector<Jd> & tt_time,
+    const std::vector<SourcePosition> & src_position, bool compute_bary, std::vector<double> & delay) const {
+    // Compute spacecraft positions at the given times.
+    std::vector<double>::size_type num_time = glast_time.size();
+    std::vector<double> sc_position(3 * num_time);
+    {
+      PerformanceMonitor::StageTimer timer(PerformanceMonitor::ORBIT_INTERPOLATION);
+      ScCursor sc_cursor;
+      initScCursor(sc_cursor);
+      prepareScFile(glast_time);
+      for (std::vector<double>::size_type time_index = 0; time_index < num_time; ++time_index) {
+        int calc_status = calcScPosition(glast_time[time_index], sc_cursor, &sc_position[3 * time_index]);
+        if (calc_status) throwScPositionError(glast_time[time_index], calc_status);
+      }
+      recordScCursorStatistics(sc_cursor);
+    }
+
+    // Compute time delays for geocentric or barycentric corrections for all the sources at a time.
+    PerformanceMonitor::StageTimer timer(PerformanceMonitor::TIME_DELAY);
+    if (compute_bary) m_computer->computeBaryDelay(src_position, sc_position, tt_time, delay);
+    else m_computer->computeGeoDelay(src_position, sc_position, tt_time, delay);
+  }
+
+  void GlastScTimeHandler::interpolateTimeDelay(const std::vector<double> & glast_time,
+    const std::vector<SourcePosition> & src_position, bool compute_bary, std::vector<double> & delay) const {
+    // Find the interval of the spacecraft data that contains each of the given times.
+    std::vector<double>::size_type num_time = glast_time.size();
+    std::vector<long> sc_interval(num_time, 0);
+    std::vector<std::pair<double, double> > sc_bound(num_time);
+    {
+      PerformanceMonitor::StageTimer timer(PerformanceMonitor::ORBIT_INTERPOLATION);
+      ScCursor sc_cursor;
+      initScCursor(sc_cursor);
+      prepareScFile(glast_time);
+      for (std::vector<double>::size_type time_index = 0; time_index < num_time; ++time_index) {
+        int search_status = searchScInterval(glast_time[time_index], sc_cursor, sc_interval[time_index],
+          sc_bound[time_index].first, sc_bound[time_index].second);
+        if (search_status) throwScPositionError(glast_time[time_index], search_status);
+      }
+      recordScCursorStatistics(sc_cursor);
+    }
+
+    // Sort the given times by the interval, and by time within each interval.
+    std::vector<std::size_t> time_order(num_time);
+    for (std::size_t time_index = 0; time_index < num_time; ++time_index) time_order[time_index] = time_index;
+    std::sort(time_order.begin(), time_order.end(), [&](std::size_t index1, std::size_t index2) {
+      return sc_interval[index1] < sc_interval[index2] ||
+        (sc_interval[index1] == sc_interval[index2] && glast_time[index1] < glast_time[index2]);
+    });
+
+    // Interpolate time delays within each interval, collecting times for which time delays must be computed exactly.
+    delay.assign(src_position.size() * num_time, 0.);
+    std::vector<std::size_t> exact_index;
+    std::vector<double> node_time(3);
+    std::vector<double> node_delay;
+    for (std::size_t first_index = 0; first_index < num_time; ) {
+      std::size_t last_index = first_index + 1;
+      while (last_index < num_time && sc_interval[time_order[last_index]] == sc_interval[time_order[first_index]]) ++last_index;
+
+      // Compute time delays exactly at the beginning, the middle, and the end of the interval, and interpolate between them.
+      // Note: The nodes are placed in the interval itself, not between the first and the last times given in it, so that
+      //       interpolated time delays do not depend on how times are split into calls of this method.
+      double begin_time = sc_bound[time_order[first_index]].first;
+      double end_time = sc_bound[time_order[first_index]].second;
+      if (!(begin_time < end_time)) {
+        for (std::size_t order_index = first_index; order_index < last_index; ++order_index) exact_index.push_back(time_order[order_index]);
       } else {
-        os << " error occurred while reading spacecraft file " << m_sc_file;
-        if (!m_sc_table.empty()) os << "[" << m_sc_table << "]";
-        throw tip::TipException(calc_status, os.str());
+        node_time[0] = begin_time;
+        node_time[1] = begin_time + .5 * (end_time - begin_time);
+        node_time[2] = end_time;
+        computeTimeDelay(node_time, src_position, compute_bary, node_delay);
+        PerformanceMonitor::addCount(PerformanceMonitor::DELAY_NODE, 3);
+        interpolateSegment(glast_time, src_position, compute_bary, time_order, first_index, last_index, begin_time, end_time,
+          node_delay, 0, exact_index, delay);
+      }
+      first_index = last_index;
+    }
+
+    // Compute time delays exactly for the rest of the given times.
+    if (!exact_index.empty()) {
+      std::vector<double> exact_time(exact_index.size());
+      for (std::size_t ii = 0; ii < exact_index.size(); ++ii) exact_time[ii] = glast_time[exact_index[ii]];
+      std::vector<double> exact_delay;
+      computeTimeDelay(exact_time, src_position, compute_bary, exact_delay);
+      for (std::vector<SourcePosition>::size_type src_index = 0; src_index < src_position.size(); ++src_index) {
+        for (std::size_t ii = 0; ii < exact_index.size(); ++ii) {
+          delay[src_index * num_time + exact_index[ii]] = exact_delay[src_index * exact_index.size() + ii];
+        }
+      }
+    }
+  }
+
+  void GlastScTimeHandler::interpolateSegment(const std::vector<double> & glast_time,
+    const std::vector<SourcePosition> & src_position, bool compute_bary, const std::vector<std::size_t> & time_order,
+    std::size_t first_index, std::size_t last_index, double begin_time, double end_time, const std::vector<double> & node_delay,
+    int depth, std::vector<std::size_t> & exact_index, std::vector<double> & delay) const {
+    // Compute time delays exactly at a quarter and three quarters of the segment, to check the interpolation.
+    double middle_time = begin_time + .5 * (end_time - begin_time);
+    std::vector<double> check_time(2);
+    check_time[0] = begin_time + .25 * (end_time - begin_time);
+    check_time[1] = begin_time + .75 * (end_time - begin_time);
+    std::vector<double> check_delay;
+    computeTimeDelay(check_time, src_position, compute_bary, check_delay);
+    PerformanceMonitor::addCount(PerformanceMonitor::DELAY_NODE, 2);
+
+    // Prepare nodes for each half of the segment, i.e., the beginning, the middle, and the end of each half, and estimate
+    // the interpolation error as the difference between the exact time delays and the interpolated ones at the quarter points.
+    std::vector<SourcePosition>::size_type num_src = src_position.size();
+    std::vector<double> left_delay(3 * num_src);
+    std::vector<double> right_delay(3 * num_src);
+    double max_error = 0.;
+    for (std::vector<SourcePosition>::size_type src_index = 0; src_index < num_src; ++src_index) {
+      const double * this_node = &node_delay[3 * src_index];
+      double * this_left = &left_delay[3 * src_index];
+      double * this_right = &right_delay[3 * src_index];
+      this_left[0] = this_node[0];
+      this_left[1] = check_delay[2 * src_index];
+      this_left[2] = this_right[0] = this_node[1];
+      this_right[1] = check_delay[2 * src_index + 1];
+      this_right[2] = this_node[2];
+      max_error = std::max(max_error, std::fabs(this_left[1] - interpolateQuadratic(this_node[0], this_node[1], this_node[2], .25)));
+      max_error = std::max(max_error, std::fabs(this_right[1] - interpolateQuadratic(this_node[0], this_node[1], this_node[2], .75)));
+    }
+
+    // Find the first time in the right half of the segment.
+    std::vector<std::size_t>::const_iterator middle_itor = std::lower_bound(time_order.begin() + first_index,
+      time_order.begin() + last_index, middle_time,
+      [&](std::size_t time_index, double this_time) { return glast_time[time_index] < this_time; });
+    std::size_t middle_index = middle_itor - time_order.begin();
+
+    if (max_error <= m_delay_tolerance) {
+      // Interpolate time delays in each half of the segment.
+      // Note: The error estimated for the whole segment is an upper bound of the error of interpolation in each half.
+      double half_width = middle_time - begin_time;
+      for (std::size_t order_index = first_index; order_index < last_index; ++order_index) {
+        std::size_t time_index = time_order[order_index];
+        bool is_left = order_index < middle_index;
+        const std::vector<double> & half_delay(is_left ? left_delay : right_delay);
+        double fraction = (glast_time[time_index] - (is_left ? begin_time : middle_time)) / (is_left ? half_width : end_time - middle_time);
+        for (std::vector<SourcePosition>::size_type src_index = 0; src_index < num_src; ++src_index) {
+          const double * this_node = &half_delay[3 * src_index];
+          delay[src_index * glast_time.size() + time_index] = interpolateQuadratic(this_node[0], this_node[1], this_node[2], fraction);
+        }
+      }
+      PerformanceMonitor::addCount(PerformanceMonitor::DELAY_INTERPOLATED, (last_index - first_index) * num_src);
+
+      // Record the estimated error.
+      double recorded_error = m_max_delay_error.load(std::memory_order_relaxed);
+      while (recorded_error < max_error && !m_max_delay_error.compare_exchange_weak(recorded_error, max_error)) {}
+
+    } else if (depth >= s_max_depth) {
+      // Give up interpolation, and compute time delays exactly for all the times in this segment.
+      for (std::size_t order_index = first_index; order_index < last_index; ++order_index) exact_index.push_back(time_order[order_index]);
+
+    } else {
+      // Split the segment into halves, and try each of them that contains any of the given times.
+      if (first_index < middle_index) {
+        interpolateSegment(glast_time, src_position, compute_bary, time_order, first_index, middle_index, begin_time, middle_time,
+          left_delay, depth + 1, exact_index, delay);
+      }
+      if (middle_index < last_index) {
+        interpolateSegment(glast_time, src_position, compute_bary, time_order, middle_index, last_index, middle_time, end_time,
+          right_delay, depth + 1, exact_index, delay);
       }
     }
-    std::vector<double> sc_position(sc_position_array, sc_position_array + 3);
+  }
 
-    // Perform geocentric or barycentric correction on abs_time.
-    if (compute_bary) m_computer->computeBaryTime(m_pos_bary, sc_position, abs_time);
-    else m_computer->computeGeoTime(m_pos_bary, sc_position, abs_time);
+  AbsoluteTime GlastScTimeHandler::getCorrectedTime(const std::string & field_name, bool from_header, bool compute_bary) const {
+    // Check initialization status.
+    if (!m_computer) throw std::runtime_error("Arrival time corrections not initialized");
+
+    // Read the field value as a GLAST time.
+    std::vector<double> glast_time(1, readGlastTime(field_name, from_header));
+
+    // Perform geocentric or barycentric correction on the GLAST time.
+    std::vector<AbsoluteTime> abs_time;
+    computeCorrectedTime(glast_time, compute_bary, abs_time);
 
     // Return the requested time.
-    return abs_time;
+    return abs_time[0];
+  }
+
+  void GlastScTimeHandler::getCorrectedTimes(const std::string & column_name, tip::Index_t first_row, tip::Index_t num_rows,
+    bool compute_bary, double * time_value) const {
+    // Check initialization status.
+    if (!m_computer) throw std::runtime_error("Arrival time corrections not initialized");
+
+    // Read the column values as GLAST times.
+    std::vector<double> glast_time;
+    readGlastTimeColumn(column_name, first_row, num_rows, glast_time);
+    if (glast_time.empty()) return;
+
+    // Perform geocentric or barycentric corrections on the GLAST times.
+    std::vector<AbsoluteTime> abs_time;
+    computeCorrectedTime(glast_time, compute_bary, abs_time);
+
+    // Express the corrected times as GLAST times in the time system of the corrections.
+    static const TimeSystem & s_tdb_system(TimeSystem::getSystem("TDB"));
+    static const TimeSystem & s_tt_system(TimeSystem::getSystem("TT"));
+    std::vector<double> corrected_time;
+    computeGlastTime(abs_time, compute_bary ? s_tdb_system : s_tt_system, corrected_time);
+    std::copy(corrected_time.begin(), corrected_time.end(), time_value);
   }
 
   GlastGeoTimeHandler::GlastGeoTimeHandler(const std::string & file_name, const std::string & extension_name, bool read_only):
@@ -336,11 +1111,16 @@ namespace timeSystem {
 
   EventTimeHandler * GlastGeoTimeHandler::createInstance(const std::string & file_name, const std::string & extension_name,
     bool read_only) {
+    return createInstance(file_name, extension_name, readHeaderKeyword(file_name, extension_name), read_only);
+  }
+
+  EventTimeHandler * GlastGeoTimeHandler::createInstance(const std::string & file_name, const std::string & extension_name,
+    const HeaderKeyword & header_keyword, bool read_only) {
     // Create an object to hold a return value and set a default return value.
     EventTimeHandler * handler(0);
 
     // Check header keywords to identify an event file with barycentric corrections applied.
-    if (checkHeaderKeyword(file_name, extension_name, "GEOCENTRIC", "TT")) {
+    if (isSupported(header_keyword)) {
       handler = new GlastGeoTimeHandler(file_name, extension_name, read_only);
     }
 
@@ -348,6 +1128,10 @@ namespace timeSystem {
     return handler;
   }
 
+  bool GlastGeoTimeHandler::isSupported(const HeaderKeyword & header_keyword) {
+    return header_keyword.match("GEOCENTRIC", "TT");
+  }
+
   void GlastGeoTimeHandler::initTimeCorrection(const std::string & /*sc_file_name*/, const std::string & /*sc_extension_name*/,
      const std::string & /*solar_eph*/, bool /*match_solar_eph*/, double /*angular_tolerance*/) {}
 
@@ -362,6 +1146,17 @@ namespace timeSystem {
       m_file_name);
   }
 
+  void GlastGeoTimeHandler::getGeoTimes(const std::string & column_name, tip::Index_t first_row, tip::Index_t num_rows,
+    double * time_value) const {
+    readTimes(column_name, first_row, num_rows, time_value);
+  }
+
+  void GlastGeoTimeHandler::getBaryTimes(const std::string & /*column_name*/, tip::Index_t /*first_row*/,
+    tip::Index_t /*num_rows*/, double * /*time_value*/) const {
+    throw std::runtime_error("Computation of barycentic times is not supported for extension \"" + m_ext_name + "\" of file \"" +
+      m_file_name);
+  }
+
   GlastBaryTimeHandler::GlastBaryTimeHandler(const std::string & file_name, const std::string & extension_name, bool read_only):
     GlastTimeHandler(file_name, extension_name, read_only), m_file_name(file_name), m_ext_name(extension_name), m_pos_nom(0., 0.),
     m_max_vect_diff(0.), m_pl_ephem() {}
@@ -370,11 +1165,16 @@ namespace timeSystem {
 
   EventTimeHandler * GlastBaryTimeHandler::createInstance(const std::string & file_name, const std::string & extension_name,
     bool read_only) {
+    return createInstance(file_name, extension_name, readHeaderKeyword(file_name, extension_name), read_only);
+  }
+
+  EventTimeHandler * GlastBaryTimeHandler::createInstance(const std::string & file_name, const std::string & extension_name,
+    const HeaderKeyword & header_keyword, bool read_only) {
     // Create an object to hold a return value and set a default return value.
     EventTimeHandler * handler(0);
 
     // Check header keywords to identify an event file with barycentric corrections applied.
-    if (checkHeaderKeyword(file_name, extension_name, "SOLARSYSTEM", "TDB")) {
+    if (isSupported(header_keyword)) {
       handler = new GlastBaryTimeHandler(file_name, extension_name, read_only);
     }
 
@@ -382,6 +1182,10 @@ namespace timeSystem {
     return handler;
   }
 
+  bool GlastBaryTimeHandler::isSupported(const HeaderKeyword & header_keyword) {
+    return header_keyword.match("SOLARSYSTEM", "TDB");
+  }
+
   void GlastBaryTimeHandler::initTimeCorrection(const std::string & /*sc_file_name*/, const std::string & /*sc_extension_name*/,
      const std::string & solar_eph, bool match_solar_eph, double angular_tolerance) {
     // Get table header.
@@ -468,4 +1272,15 @@ namespace timeSystem {
     return readTime(field_name, from_header);
   }
 
+  void GlastBaryTimeHandler::getGeoTimes(const std::string & /*column_name*/, tip::Index_t /*first_row*/,
+    tip::Index_t /*num_rows*/, double * /*time_value*/) const {
+    throw std::runtime_error("Computation of geocentic times is not supported for extension \"" + m_ext_name + "\" of file \"" +
+      m_file_name);
+  }
+
+  void GlastBaryTimeHandler::getBaryTimes(const std::string & column_name, tip::Index_t first_row, tip::Index_t num_rows,
+    double * time_value) const {
+    readTimes(column_name, first_row, num_rows, time_value);
+  }
+
 }
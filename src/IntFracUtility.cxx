@@ -7,6 +7,9 @@
 
 #include <cctype>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <limits>
@@ -15,6 +18,9 @@
 
 namespace {
 
+  /// \brief Size of a character buffer to create a character string in without memory allocation.
+  const std::size_t s_format_buffer_size = 128;
+
   /** \brief Helper function for IntFracUtility::parse method to convert a character string to a numeric type.
              The function throws a given exception if an error occurs, and false otherwise.  Note that it is
              considered a conversion error if a non-whitespace character is left unused after a numeric conversion.
@@ -33,29 +39,79 @@ namespace {
     if (iss.fail() || !iss.eof()) throw except;
   }
 
-}
-
-namespace timeSystem {
+  /** \brief Helper function for IntFracUtility::parse method to interpret a character string of a decimal number without
+             an exponent part, optionally surrounded by white spaces, and split it into an integer part and a fractional part.
+             The function returns a logical true if successful, and a logical false if the character string is not in this form
+             or if the results could differ from those computed via string streams, i.e., if the integer part does not fit
+             in a long variable, or if the fractional part has too many digits to compute with an exact rounding.
+             Note that the fractional part is not checked for the boundary.
+      \param value_string Pointer to the first character of the character string to interpret.
+      \param length Number of characters of the character string to interpret.
+      \param int_part Integer part of the interpreted number.
+      \param frac_part Fractional part of the interpreted number.
+  */
+  bool parseDecimal(const char * value_string, std::size_t length, long & int_part, double & frac_part) {
+    const char * ptr = value_string;
+    const char * end = value_string + length;
+
+    // Skip leading white spaces, and read a sign.
+    for (; ptr != end && 0 != std::isspace(static_cast<unsigned char>(*ptr)); ++ptr) {}
+    bool negative = false;
+    if (ptr != end && ('+' == *ptr || '-' == *ptr)) negative = ('-' == *ptr++);
+
+    // Read the integer part, skipping leading zeros.
+    // Note: Up to the number of digits that any long variable can hold are accepted.
+    static const int s_max_int_digit = std::numeric_limits<long>::digits10;
+    long int_value = 0;
+    int num_int_digit = 0;
+    int num_digit = 0;
+    for (; ptr != end && '0' <= *ptr && *ptr <= '9'; ++ptr, ++num_digit) {
+      if (0 == int_value && '0' == *ptr) continue;
+      if (++num_int_digit > s_max_int_digit) return false;
+      int_value = int_value * 10 + (*ptr - '0');
+    }
 
-  IntFracUtility::IntFracUtility() {}
+    // Read the fractional part as an integer mantissa and the number of digits after a decimal point.
+    // Note: The mantissa and the power of ten must be represented exactly in double precision, so that the division below
+    //       gives the correctly rounded value, i.e., the same value as converted from the digits by string streams.
+    static const std::uint64_t s_max_mantissa = std::uint64_t(1) << std::numeric_limits<double>::digits;
+    static const double s_power_of_ten[] = { 1.e0, 1.e1, 1.e2, 1.e3, 1.e4, 1.e5, 1.e6, 1.e7, 1.e8, 1.e9, 1.e10, 1.e11, 1.e12,
+      1.e13, 1.e14, 1.e15, 1.e16, 1.e17, 1.e18, 1.e19, 1.e20, 1.e21, 1.e22 };
+    static const int s_max_frac_digit = sizeof(s_power_of_ten) / sizeof(s_power_of_ten[0]) - 1;
+    std::uint64_t mantissa = 0;
+    int num_frac_digit = 0;
+    if (ptr != end && '.' == *ptr) {
+      for (++ptr; ptr != end && '0' <= *ptr && *ptr <= '9'; ++ptr, ++num_digit) {
+        if (++num_frac_digit > s_max_frac_digit) return false;
+        mantissa = mantissa * 10 + (*ptr - '0');
+        if (mantissa > s_max_mantissa) return false;
+      }
+    }
 
-  IntFracUtility & IntFracUtility::getUtility() {
-    static IntFracUtility s_utility;
-    return s_utility;
-  }
+    // Skip trailing white spaces, and check that nothing else follows the number.
+    for (; ptr != end && 0 != std::isspace(static_cast<unsigned char>(*ptr)); ++ptr) {}
+    if (ptr != end || 0 == num_digit) return false;
 
-  void IntFracUtility::check(long int_part, double frac_part) const {
-    if ((int_part == 0 && (frac_part <= -1. || frac_part >= +1.)) ||
-        (int_part >  0 && (frac_part <   0. || frac_part >= +1.)) ||
-        (int_part <  0 && (frac_part <= -1. || frac_part >   0.))) {
-      std::ostringstream os;
-      os.precision(std::numeric_limits<double>::digits10);
-      os << "Fractional part out of bounds: " << frac_part;
-      throw std::runtime_error(os.str());
+    // Set the results, in the same way as computed from the character string by IntFracUtility::parse method.
+    // Note: The fractional part is computed if the integer part is zero (0), or if the fractional part has a digit.
+    int_part = (negative ? -int_value : int_value);
+    if (0 == int_value || num_frac_digit > 0) {
+      frac_part = static_cast<double>(mantissa) / s_power_of_ten[num_frac_digit];
+      if (negative) frac_part = -frac_part;
+    } else {
+      frac_part = 0.;
     }
+    return true;
   }
 
-  void IntFracUtility::parse(const std::string & value_string, long & int_part, double & frac_part) const {
+  /** \brief Helper function for IntFracUtility::parse method to split a character string representing a floating-point number
+             into an integer part and a fractional part via string streams. The function throws an exception if an error occurs.
+             Note that the fractional part is not checked for the boundary.
+      \param value_string Character string to split.
+      \param int_part Integer part of the number.
+      \param frac_part Fractional part of the number.
+  */
+  void splitNumber(const std::string & value_string, long & int_part, double & frac_part) {
     // Read the number into a temporary double variable for three purposes:
     // 1) To check the format as a floating-point number expression
     // 2) To check that nothing but a literal number is in the given string (except for white spaces)
@@ -64,17 +120,15 @@ namespace timeSystem {
     std::exception except = std::runtime_error("Error in interpreting \"" + value_string + "\" as a floating-point number");
     convertStringToNumber(value_string, value_dbl, except);
 
-    // Compute the integer part and the fractional part, and store them in temporary variables.
-    long int_part_tmp = 0;
-    double frac_part_tmp = 0.;
+    // Compute the integer part and the fractional part.
     double value_abs = std::fabs(value_dbl);
     if (value_abs < 0.5) {
       // No integer part in the significand.
       // Note: the condition for this if-branch must be somewhat loose (i.e., not "value_abs < 1."), because
       //       the variable under test (value_abs) holds only an approximate value that the given character
       //       string represents, and the conditional statement may be evaluated incorrectly due to rounding errors.
-      int_part_tmp = 0;
-      frac_part_tmp = value_dbl;
+      int_part = 0;
+      frac_part = value_dbl;
 
     } else {
       // Collect the sign and all the decimal digits in the significand, skipping white spaces.
@@ -102,8 +156,8 @@ namespace timeSystem {
       // Analyze the remaining digits.
       if (0 == all_digits.size()) {
         // All decimal digits in the significand are zeros.
-        int_part_tmp = 0;
-        frac_part_tmp = 0.;
+        int_part = 0;
+        frac_part = 0.;
 
       } else {
         // Get the significand as a number in range [0.1, 1.).
@@ -124,24 +178,78 @@ namespace timeSystem {
         std::exception except_frac = std::runtime_error("Error in computing the fractional part of \"" + value_string + "\"");
         if (num_digit_int <= 0) {
           // No integer part in the significand.
-          int_part_tmp = 0;
-          frac_part_tmp = value_dbl;
+          int_part = 0;
+          frac_part = value_dbl;
 
         } else if (num_digit_int < static_cast<int>(all_digits.size())) {
           // Significand contains both parts.
           std::string int_part_string = sign_string + all_digits.substr(0, num_digit_int);
-          convertStringToNumber(int_part_string, int_part_tmp, except_int);
+          convertStringToNumber(int_part_string, int_part, except_int);
           std::string frac_part_string = sign_string + "0." + all_digits.substr(num_digit_int);
-          convertStringToNumber(frac_part_string, frac_part_tmp, except_frac);
+          convertStringToNumber(frac_part_string, frac_part, except_frac);
 
         } else {
           // No fractional part in the significand.
           std::string int_part_string = sign_string + all_digits + std::string(num_digit_int - all_digits.size(), '0');
-          convertStringToNumber(int_part_string, int_part_tmp, except_int);
-          frac_part_tmp = 0.;
+          convertStringToNumber(int_part_string, int_part, except_int);
+          frac_part = 0.;
         }
       }
     }
+  }
+
+  /** \brief Helper function for IntFracUtility::format method to write a floating-point number in a fixed-point notation
+             into a caller-provided buffer, and return the number of characters written. The characters are the same as
+             those written by string streams in the fixed-point notation. Zero (0) is returned if the characters do not fit
+             in the buffer, or if a decimal point is not written as expected.
+      \param value Floating-point number to write.
+      \param precision Number of digits after a decimal point.
+      \param buffer Buffer to write the characters in.
+      \param buffer_size Number of characters that the buffer can hold.
+  */
+  std::size_t writeFixed(double value, std::streamsize precision, char * buffer, std::size_t buffer_size) {
+    // Write the number, leaving room for a null character.
+    int length = std::snprintf(buffer, buffer_size, "%.*f", static_cast<int>(precision), value);
+    if (length < 0 || static_cast<std::size_t>(length) >= buffer_size) return 0;
+
+    // Check the decimal point, which could be other than a period ('.') depending on the C locale.
+    if (precision > 0 && std::isfinite(value) && '.' != buffer[length - precision - 1]) return 0;
+    return length;
+  }
+
+}
+
+namespace timeSystem {
+
+  IntFracUtility::IntFracUtility() {}
+
+  IntFracUtility & IntFracUtility::getUtility() {
+    static IntFracUtility s_utility;
+    return s_utility;
+  }
+
+  void IntFracUtility::check(long int_part, double frac_part) const {
+    if ((int_part == 0 && (frac_part <= -1. || frac_part >= +1.)) ||
+        (int_part >  0 && (frac_part <   0. || frac_part >= +1.)) ||
+        (int_part <  0 && (frac_part <= -1. || frac_part >   0.))) {
+      std::ostringstream os;
+      os.precision(std::numeric_limits<double>::digits10);
+      os << "Fractional part out of bounds: " << frac_part;
+      throw std::runtime_error(os.str());
+    }
+  }
+
+  void IntFracUtility::parse(const std::string & value_string, long & int_part, double & frac_part) const {
+    parse(value_string.data(), value_string.size(), int_part, frac_part);
+  }
+
+  void IntFracUtility::parse(const char * value_string, std::size_t length, long & int_part, double & frac_part) const {
+    // Interpret a decimal number without memory allocation if possible, or via string streams otherwise.
+    long int_part_tmp = 0;
+    double frac_part_tmp = 0.;
+    if (!parseDecimal(value_string, length, int_part_tmp, frac_part_tmp)) {
+      splitNumber(std::string(value_string, length), int_part_tmp, frac_part_tmp);
+    }
 
     // Check the fractional part for the boundary, and trim the results.
     // Note: the fractional part computed above could be out of bounds due to a rounding error in string-to-double
@@ -151,7 +259,7 @@ namespace timeSystem {
       if (int_part_tmp < std::numeric_limits<long>::max()) {
         ++int_part_tmp;
       } else {
-        throw std::runtime_error("Integer overflow in computing the integer part of \"" + value_string + "\"");
+        throw std::runtime_error("Integer overflow in computing the integer part of \"" + std::string(value_string, length) + "\"");
       }
 
     } else if (frac_part_tmp <= -1.) {
@@ -159,7 +267,7 @@ namespace timeSystem {
       if (int_part_tmp > std::numeric_limits<long>::min()) {
         --int_part_tmp;
       } else {
-        throw std::runtime_error("Integer underflow in computing the integer part of \"" + value_string + "\"");
+        throw std::runtime_error("Integer underflow in computing the integer part of \"" + std::string(value_string, length) + "\"");
       }
     }
 
@@ -167,7 +275,8 @@ namespace timeSystem {
     try {
       check(int_part_tmp, frac_part_tmp);
     } catch (const std::exception & x) {
-      throw std::runtime_error("Error in splitting \"" + value_string + "\" into an integer part and a fractional part: " + x.what());
+      throw std::runtime_error("Error in splitting \"" + std::string(value_string, length) +
+        "\" into an integer part and a fractional part: " + x.what());
     }
 
     // Set the results.
@@ -176,6 +285,11 @@ namespace timeSystem {
   }
 
   std::string IntFracUtility::format(long int_part, double frac_part, std::streamsize precision) const {
+    // Create the string in a character buffer if possible.
+    char buffer[s_format_buffer_size];
+    std::size_t length = format(int_part, frac_part, precision, buffer, sizeof(buffer));
+    if (length > 0) return std::string(buffer, length);
+
     // Check the fractional part.
     const IntFracUtility & utility(IntFracUtility::getUtility());
     utility.check(int_part, frac_part);
@@ -217,6 +331,40 @@ namespace timeSystem {
     return os.str();
   }
 
+  std::size_t IntFracUtility::format(long int_part, double frac_part, std::streamsize precision, char * buffer,
+    std::size_t buffer_size) const {
+    // Check the fractional part.
+    check(int_part, frac_part);
+
+    // Leave an unusual number of digits to string streams.
+    if (precision < 0 || precision > static_cast<std::streamsize>(buffer_size)) return 0;
+
+    // Write fractional part only.
+    if (int_part == 0) return writeFixed(frac_part, precision, buffer, buffer_size);
+
+    // Write integer part first.
+    int int_length = std::snprintf(buffer, buffer_size, "%ld", int_part);
+    if (int_length < 0 || static_cast<std::size_t>(int_length) >= buffer_size) return 0;
+
+    // Write fractional part right after the integer part.
+    char * frac_ptr = buffer + int_length;
+    std::size_t frac_length = writeFixed(frac_part, precision, frac_ptr, buffer_size - int_length);
+    if (0 == frac_length) return 0;
+
+    // Find a decimal point ('.'), and leave the integer part only if not found.
+    char * point_ptr = static_cast<char *>(std::memchr(frac_ptr, '.', frac_length));
+    if (0 == point_ptr) return int_length;
+
+    // Truncate trailing 0s, and a decimal point ('.') at the end.
+    char * end_ptr = frac_ptr + frac_length;
+    while ('0' == *(end_ptr - 1)) --end_ptr;
+    if (point_ptr + 1 == end_ptr) --end_ptr;
+
+    // Move the characters from the decimal point, to replace the digits before it.
+    std::memmove(frac_ptr, point_ptr, end_ptr - point_ptr);
+    return int_length + (end_ptr - point_ptr);
+  }
+
   void IntFracUtility::split(double value_double, long & int_part, double & frac_part) const {
     // Split the input value into integer part and fractional part.
     double int_part_dbl = 0.;
@@ -7,7 +7,9 @@
 
 #include "timeSystem/IntFracUtility.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iomanip>
 #include <limits>
 #include <sstream>
@@ -22,6 +24,33 @@ namespace {
   const double JdMinusMjdFrac() { static const double s_value = .5; return s_value; }
   const double JdMinusMjdDouble() { static const double s_value = JdMinusMjdInt() + JdMinusMjdFrac(); return s_value; }
 
+  /// \brief Size of a character buffer to create a character string in without memory allocation.
+  const std::size_t s_format_buffer_size = 128;
+
+  /** \brief Helper function for MjdFormat and JdFormat classes to create a character string that represents a given pair of
+             an integer part and a fractional part, followed by a given unit, in a caller-provided buffer, and return the length
+             of it. Zero (0) is returned if the character string cannot be created in the buffer.
+      \param int_part Integer part of a number to format into a character string.
+      \param frac_part Fractional part of a number to format into a character string.
+      \param precision Number of digits after a decimal point in a resultant character string.
+      \param unit_string Unit to write after the number, including a leading white space.
+      \param buffer Buffer to store the resultant character string in.
+      \param buffer_size Number of characters that the buffer can hold.
+  */
+  std::size_t formatIntFrac(long int_part, double frac_part, std::streamsize precision, const char * unit_string, char * buffer,
+    std::size_t buffer_size) {
+    // Write the number.
+    const IntFracUtility & utility(IntFracUtility::getUtility());
+    std::size_t length = utility.format(int_part, frac_part, precision, buffer, buffer_size);
+    if (0 == length) return 0;
+
+    // Write the unit after the number.
+    std::size_t unit_length = std::strlen(unit_string);
+    if (length + unit_length > buffer_size) return 0;
+    std::copy(unit_string, unit_string + unit_length, buffer + length);
+    return length + unit_length;
+  }
+
   /** \class MjdFormat
       \brief Class to convert time representations in MJD format, holding an integer and a fractional part separately.
   */
@@ -47,6 +76,25 @@ namespace {
           \param precision Number of digits after a decimal point in a resultant character string.
       */
       virtual std::string format(const Mjd & time_rep, std::streamsize precision = std::numeric_limits<double>::digits10) const;
+
+      /** \brief Interpret character strings stored in a caller-provided buffer as an MJD numbers, and set them to a caller-provided
+                 array.
+          \param buffer Buffer holding character strings to interpret, one after another.
+          \param width Number of characters occupied by each character string in the buffer.
+          \param num_string Number of character strings to interpret.
+          \param time_rep Array of at least num_string MJD numbers, to which the interpreted ones are set.
+      */
+      virtual void parseArray(const char * buffer, std::size_t width, std::size_t num_string, Mjd * time_rep) const;
+
+      /** \brief Create character strings that represent given MJD numbers, and store them in a caller-provided buffer.
+          \param time_rep Array of MJD numbers to format into character strings.
+          \param num_rep Number of MJD numbers to format into character strings.
+          \param buffer Buffer of at least num_rep * width characters, to which character strings are stored one after another.
+          \param width Number of characters occupied by each character string in the buffer.
+          \param precision Number of digits after a decimal point in a resultant character string.
+      */
+      virtual void formatArray(const Mjd * time_rep, std::size_t num_rep, char * buffer, std::size_t width,
+        std::streamsize precision = std::numeric_limits<double>::digits10) const;
   };
 
   /** \class Mjd1Format
@@ -101,6 +149,25 @@ namespace {
           \param precision Number of digits after a decimal point in a resultant character string.
       */
       virtual std::string format(const Jd & time_rep, std::streamsize precision = std::numeric_limits<double>::digits10) const;
+
+      /** \brief Interpret character strings stored in a caller-provided buffer as a JD numbers, and set them to a caller-provided
+                 array.
+          \param buffer Buffer holding character strings to interpret, one after another.
+          \param width Number of characters occupied by each character string in the buffer.
+          \param num_string Number of character strings to interpret.
+          \param time_rep Array of at least num_string JD numbers, to which the interpreted ones are set.
+      */
+      virtual void parseArray(const char * buffer, std::size_t width, std::size_t num_string, Jd * time_rep) const;
+
+      /** \brief Create character strings that represent given JD numbers, and store them in a caller-provided buffer.
+          \param time_rep Array of JD numbers to format into character strings.
+          \param num_rep Number of JD numbers to format into character strings.
+          \param buffer Buffer of at least num_rep * width characters, to which character strings are stored one after another.
+          \param width Number of characters occupied by each character string in the buffer.
+          \param precision Number of digits after a decimal point in a resultant character string.
+      */
+      virtual void formatArray(const Jd * time_rep, std::size_t num_rep, char * buffer, std::size_t width,
+        std::streamsize precision = std::numeric_limits<double>::digits10) const;
   };
 
   /** \class Jd1Format
@@ -164,11 +231,40 @@ namespace {
   }
 
   std::string MjdFormat::format(const Mjd & time_rep, std::streamsize precision) const {
+    // Create the string in a character buffer if possible.
+    char buffer[s_format_buffer_size];
+    std::size_t length = formatIntFrac(time_rep.m_int, time_rep.m_frac, precision, " MJD", buffer, sizeof(buffer));
+    if (length > 0) return std::string(buffer, length);
+
     // Convert the pair of an integer and a fractional parts of MJD into a string, and return it.
     const IntFracUtility & utility(IntFracUtility::getUtility());
     return utility.format(time_rep.m_int, time_rep.m_frac, precision) + " MJD";
   }
 
+  void MjdFormat::parseArray(const char * buffer, std::size_t width, std::size_t num_string, Mjd * time_rep) const {
+    const IntFracUtility & utility(IntFracUtility::getUtility());
+    for (std::size_t ii = 0; ii < num_string; ++ii) {
+      const char * time_string = buffer + ii * width;
+      utility.parse(time_string, getStringLength(time_string, width), time_rep[ii].m_int, time_rep[ii].m_frac);
+    }
+  }
+
+  void MjdFormat::formatArray(const Mjd * time_rep, std::size_t num_rep, char * buffer, std::size_t width,
+    std::streamsize precision) const {
+    char format_buffer[s_format_buffer_size];
+    for (std::size_t ii = 0; ii < num_rep; ++ii) {
+      // Format the number into the local buffer if possible, or into a string otherwise, and store the result.
+      std::size_t length = formatIntFrac(time_rep[ii].m_int, time_rep[ii].m_frac, precision, " MJD", format_buffer,
+        sizeof(format_buffer));
+      if (length > 0) {
+        storeString(format_buffer, length, buffer + ii * width, width);
+      } else {
+        std::string time_string = format(time_rep[ii], precision);
+        storeString(time_string.data(), time_string.size(), buffer + ii * width, width);
+      }
+    }
+  }
+
   Mjd1 Mjd1Format::convert(const datetime_type & datetime) const {
     const TimeFormat<Mjd> & mjd_format(TimeFormatFactory<Mjd>::getFormat());
     Mjd mjd_rep = mjd_format.convert(datetime);
@@ -245,11 +341,40 @@ namespace {
   }
 
   std::string JdFormat::format(const Jd & time_rep, std::streamsize precision) const {
+    // Create the string in a character buffer if possible.
+    char buffer[s_format_buffer_size];
+    std::size_t length = formatIntFrac(time_rep.m_int, time_rep.m_frac, precision, " JD", buffer, sizeof(buffer));
+    if (length > 0) return std::string(buffer, length);
+
     // Convert the pair of an integer and a fractional parts of JD into a string, and return it.
     const IntFracUtility & utility(IntFracUtility::getUtility());
     return utility.format(time_rep.m_int, time_rep.m_frac, precision) + " JD";
   }
 
+  void JdFormat::parseArray(const char * buffer, std::size_t width, std::size_t num_string, Jd * time_rep) const {
+    const IntFracUtility & utility(IntFracUtility::getUtility());
+    for (std::size_t ii = 0; ii < num_string; ++ii) {
+      const char * time_string = buffer + ii * width;
+      utility.parse(time_string, getStringLength(time_string, width), time_rep[ii].m_int, time_rep[ii].m_frac);
+    }
+  }
+
+  void JdFormat::formatArray(const Jd * time_rep, std::size_t num_rep, char * buffer, std::size_t width,
+    std::streamsize precision) const {
+    char format_buffer[s_format_buffer_size];
+    for (std::size_t ii = 0; ii < num_rep; ++ii) {
+      // Format the number into the local buffer if possible, or into a string otherwise, and store the result.
+      std::size_t length = formatIntFrac(time_rep[ii].m_int, time_rep[ii].m_frac, precision, " JD", format_buffer,
+        sizeof(format_buffer));
+      if (length > 0) {
+        storeString(format_buffer, length, buffer + ii * width, width);
+      } else {
+        std::string time_string = format(time_rep[ii], precision);
+        storeString(time_string.data(), time_string.size(), buffer + ii * width, width);
+      }
+    }
+  }
+
   Jd1 Jd1Format::convert(const datetime_type & datetime) const {
     const TimeFormat<Jd> & jd_format(TimeFormatFactory<Jd>::getFormat());
     Jd jd_rep = jd_format.convert(datetime);
@@ -0,0 +1,109 @@
+/** \file PerformanceMonitor.cxx
+    \brief Implementation of PerformanceMonitor class.
+    \authors Masaharu Hirayama, GSSC
+             James Peachey, HEASARC/GSSC
+*/
+#include "timeSystem/PerformanceMonitor.h"
+
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace {
+
+  using namespace timeSystem;
+
+  /// \brief Names of the stages, used as keys in a JSON summary.
+  const char * s_stage_name[PerformanceMonitor::NUM_STAGE] = {
+    "file_read", "orbit_interpolation", "time_delay", "ephemeris_interpolation", "time_conversion", "file_write"
+  };
+
+  /// \brief Descriptions of the stages, used in a human-readable summary.
+  const char * s_stage_desc[PerformanceMonitor::NUM_STAGE] = {
+    "FITS file reading", "Spacecraft orbit interpolation", "Time delay computation", "  of which ephemeris interpolation",
+    "Time system conversion", "FITS file writing"
+  };
+
+  /// \brief Names of the counters, used as keys in a JSON summary.
+  const char * s_counter_name[PerformanceMonitor::NUM_COUNTER] = {
+    "rows_processed", "ephemeris_record_switches", "scfile_cursor_hits", "scfile_run_table_hits", "scfile_cursor_misses",
+    "tdb_to_tt_iterations", "delay_interpolation_nodes", "delays_interpolated", "ephemeris_bytes_preloaded", "rows_reordered"
+  };
+
+  /// \brief Descriptions of the counters, used in a human-readable summary.
+  const char * s_counter_desc[PerformanceMonitor::NUM_COUNTER] = {
+    "Rows processed", "Ephemeris record switches", "Spacecraft file cursor hits", "Spacecraft file run table hits",
+    "Spacecraft file cursor misses", "TDB-to-TT iterations", "Delay interpolation nodes", "Time delays interpolated",
+    "Ephemeris bytes preloaded", "Rows corrected in sorted order"
+  };
+
+}
+
+namespace timeSystem {
+
+  std::atomic<bool> PerformanceMonitor::s_enabled(false);
+
+  std::atomic<long long> PerformanceMonitor::s_time[PerformanceMonitor::NUM_STAGE];
+
+  std::atomic<long long> PerformanceMonitor::s_count[PerformanceMonitor::NUM_COUNTER];
+
+  void PerformanceMonitor::reset() {
+    for (int ii = 0; ii < NUM_STAGE; ++ii) s_time[ii].store(0, std::memory_order_relaxed);
+    for (int ii = 0; ii < NUM_COUNTER; ++ii) s_count[ii].store(0, std::memory_order_relaxed);
+  }
+
+  void PerformanceMonitor::addTime(StageType stage, long long nanosec) {
+    s_time[stage].fetch_add(nanosec, std::memory_order_relaxed);
+  }
+
+  long long PerformanceMonitor::getTime(StageType stage) {
+    return s_time[stage].load(std::memory_order_relaxed);
+  }
+
+  long long PerformanceMonitor::getCount(CounterType counter) {
+    return s_count[counter].load(std::memory_order_relaxed);
+  }
+
+  void PerformanceMonitor::report(std::ostream & os) {
+    std::ios::fmtflags flag_save = os.flags();
+    std::streamsize prec_save = os.precision();
+    os << std::fixed << std::setprecision(6);
+    os << "Cumulative time per stage (seconds):" << std::endl;
+    for (int ii = 0; ii < NUM_STAGE; ++ii) {
+      os << "  " << std::left << std::setw(36) << s_stage_desc[ii] << std::right << std::setw(16) << getTime(StageType(ii)) * 1.e-9
+        << std::endl;
+    }
+    os << "Counters:" << std::endl;
+    for (int ii = 0; ii < NUM_COUNTER; ++ii) {
+      os << "  " << std::left << std::setw(36) << s_counter_desc[ii] << std::right << std::setw(16) << getCount(CounterType(ii))
+        << std::endl;
+    }
+    os.flags(flag_save);
+    os.precision(prec_save);
+  }
+
+  void PerformanceMonitor::writeJson(std::ostream & os) {
+    std::ios::fmtflags flag_save = os.flags();
+    std::streamsize prec_save = os.precision();
+    os << std::fixed << std::setprecision(9);
+    os << "{" << std::endl << "  \"stage_seconds\": {" << std::endl;
+    for (int ii = 0; ii < NUM_STAGE; ++ii) {
+      os << "    \"" << s_stage_name[ii] << "\": " << getTime(StageType(ii)) * 1.e-9 << (ii + 1 < NUM_STAGE ? "," : "") << std::endl;
+    }
+    os << "  }," << std::endl << "  \"counters\": {" << std::endl;
+    for (int ii = 0; ii < NUM_COUNTER; ++ii) {
+      os << "    \"" << s_counter_name[ii] << "\": " << getCount(CounterType(ii)) << (ii + 1 < NUM_COUNTER ? "," : "") << std::endl;
+    }
+    os << "  }" << std::endl << "}" << std::endl;
+    os.flags(flag_save);
+    os.precision(prec_save);
+  }
+
+  void PerformanceMonitor::writeJson(const std::string & file_name) {
+    std::ofstream ofs(file_name.c_str());
+    if (!ofs.good()) throw std::runtime_error("Cannot open file " + file_name + " for writing");
+    writeJson(ofs);
+    if (!ofs.good()) throw std::runtime_error("Error occurred while writing file " + file_name);
+  }
+
+}
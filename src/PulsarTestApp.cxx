@@ -13,7 +13,11 @@
 #include <iostream>
 #include <list>
 #include <memory>
+#include <sstream>
 #include <stdexcept>
+#include <vector>
+
+#include <fitsio.h>
 
 #include "facilities/commonUtilities.h"
 
@@ -88,7 +92,7 @@ namespace timeSystem {
   }
 
   PulsarApplicationTester::PulsarApplicationTester(const std::string & app_name, PulsarTestApp & test_app):
-    m_app_name(app_name), m_test_app(&test_app) {}
+    m_app_name(app_name), m_test_app(&test_app), m_max_mismatch(10) {}
 
   PulsarApplicationTester::~PulsarApplicationTester() throw() {}
 
@@ -100,6 +104,10 @@ namespace timeSystem {
     return m_test_app->err();
   }
 
+  void PulsarApplicationTester::setMaxMismatch(long max_mismatch) {
+    m_max_mismatch = max_mismatch;
+  }
+
   bool PulsarApplicationTester::equivalent(const std::string & string_value, const std::string & string_reference,
     double tolerance_abs, double tolerance_rel) const {
     // Prepare variables for comparison.
@@ -153,6 +161,11 @@ namespace timeSystem {
     return !mismatch_found;
   }
 
+  PulsarApplicationTester::ColumnComparisonType PulsarApplicationTester::getColumnComparison(
+    const std::string & /* column_name */, double & /* tolerance_abs */, double & /* tolerance_rel */) const {
+    return CELL_COMPARISON;
+  }
+
   bool PulsarApplicationTester::verify(const std::string & /* keyword_name */, const tip::KeyRecord & /* out_keyword */,
     const tip::KeyRecord & /* ref_keyword */, std::ostream & /* error_stream */) const {
     throw std::runtime_error("Verification method for header keyword not implemented.");
@@ -340,16 +353,30 @@ namespace timeSystem {
 
             // Compare tables if DATASUM's do not match.
             if (!datasum_matched) {
+              // Compare numeric columns at a time, and collect the other columns to compare cell by cell.
+              std::list<std::string> cell_column;
+              for (std::list<std::string>::const_iterator col_itor = common_column.begin(); col_itor != common_column.end();
+                ++col_itor) {
+                double tolerance_abs = 0.;
+                double tolerance_rel = 0.;
+                ColumnComparisonType comparison = getColumnComparison(*col_itor, tolerance_abs, tolerance_rel);
+                if (CELL_COMPARISON == comparison || (NUMERIC_COMPARISON == comparison &&
+                  !checkNumericColumn(out_file, ref_file, ext_number, *col_itor, tolerance_abs, tolerance_rel))) {
+                  cell_column.push_back(*col_itor);
+                }
+              }
+
               // Compare each row.
               tip::Table::ConstIterator out_itor = out_table->begin();
               tip::Table::ConstIterator ref_itor = ref_table->begin();
               tip::Index_t row_index = 1;
-              for (; out_itor != out_table->end() && ref_itor != ref_table->end(); ++out_itor, ++ref_itor, ++row_index) {
+              for (; !cell_column.empty() && out_itor != out_table->end() && ref_itor != ref_table->end();
+                ++out_itor, ++ref_itor, ++row_index) {
                 tip::ConstTableRecord & out_record = *out_itor;
                 tip::ConstTableRecord & ref_record = *ref_itor;
 
                 // Compare all columns.
-                for (std::list<std::string>::const_iterator col_itor = common_column.begin(); col_itor != common_column.end();
+                for (std::list<std::string>::const_iterator col_itor = cell_column.begin(); col_itor != cell_column.end();
                   ++col_itor) {
                   const std::string & col_name = *col_itor;
                   const tip::TableCell & out_cell = out_record[col_name];
@@ -369,6 +396,71 @@ namespace timeSystem {
     }
   }
 
+  bool PulsarApplicationTester::checkNumericColumn(const std::string & out_file, const std::string & ref_file, int ext_number,
+    const std::string & column_name, double tolerance_abs, double tolerance_rel) {
+    // Read the whole column from both files.
+    std::vector<double> value_cont[2];
+    long repeat_cont[2] = { 0, 0 };
+    for (int ii = 0; ii < 2; ++ii) {
+      const std::string & file_name(ii == 0 ? out_file : ref_file);
+      fitsfile * fits_ptr = 0;
+      int status = 0;
+      int column_number = 0;
+      int type_code = 0;
+      long width = 0;
+      long num_row = 0;
+      fits_open_file(&fits_ptr, const_cast<char *>(file_name.c_str()), READONLY, &status);
+      fits_movabs_hdu(fits_ptr, ext_number + 1, 0, &status);
+      fits_get_colnum(fits_ptr, CASEINSEN, const_cast<char *>(column_name.c_str()), &column_number, &status);
+      fits_get_coltype(fits_ptr, column_number, &type_code, &repeat_cont[ii], &width, &status);
+      fits_get_num_rows(fits_ptr, &num_row, &status);
+
+      // Leave columns of non-numeric types and variable-length arrays for comparison cell by cell.
+      bool numeric = (0 == status && TSTRING != type_code && TLOGICAL != type_code && TBIT != type_code && type_code > 0);
+      if (numeric && num_row > 0 && repeat_cont[ii] > 0) {
+        value_cont[ii].resize(num_row * repeat_cont[ii]);
+        fits_read_col(fits_ptr, TDOUBLE, column_number, 1, 1, value_cont[ii].size(), 0, &value_cont[ii][0], 0, &status);
+      }
+      int close_status = 0;
+      if (fits_ptr) fits_close_file(fits_ptr, &close_status);
+      if (!numeric || status) return false;
+    }
+    if (repeat_cont[0] != repeat_cont[1]) {
+      err() << "Column \"" << column_name << "\" in HDU " << ext_number << " in file " << out_file << " has " <<
+        repeat_cont[0] << " element(s) per row, not " << repeat_cont[1] << " as in reference file " << ref_file << std::endl;
+      return true;
+    }
+
+    // Compare the columns as floating-point numbers.
+    // Note: NaN's are considered equivalent to each other.
+    const std::vector<double> & out_value(value_cont[0]);
+    const std::vector<double> & ref_value(value_cont[1]);
+    long repeat = repeat_cont[1];
+    long num_mismatch = 0;
+    for (std::vector<double>::size_type index = 0; index < out_value.size() && index < ref_value.size(); ++index) {
+      double out_number = out_value[index];
+      double ref_number = ref_value[index];
+      bool out_nan = (out_number != out_number);
+      bool ref_nan = (ref_number != ref_number);
+      bool verified = (out_nan || ref_nan) ? (out_nan && ref_nan) :
+        (std::fabs(out_number - ref_number) <= tolerance_abs + tolerance_rel * std::fabs(ref_number));
+      if (!verified && ++num_mismatch <= m_max_mismatch) {
+        std::ostringstream os_row;
+        os_row << "Row #" << index / repeat + 1;
+        if (repeat > 1) os_row << " element #" << index % repeat + 1;
+        err() << os_row.str() << " of column \"" << column_name << "\" in HDU " << ext_number << " in file " << out_file <<
+          " differs from reference file " << ref_file << ": Value " << out_number << " not equivalent to reference " <<
+          ref_number << " with absolute tolerance of " << tolerance_abs << " and relative tolerance of " << tolerance_rel <<
+          "." << std::endl;
+      }
+    }
+    if (num_mismatch > m_max_mismatch) {
+      err() << "Column \"" << column_name << "\" in HDU " << ext_number << " in file " << out_file << " has " <<
+        num_mismatch - m_max_mismatch << " more mismatch(es) with reference file " << ref_file << "." << std::endl;
+    }
+    return true;
+  }
+
   void PulsarApplicationTester::checkOutputText(const std::string & out_file, const std::string & ref_file) {
     // Check file existence.
     if (!tip::IFileSvc::instance().fileExists(out_file)) {
@@ -5,15 +5,30 @@
 */
 #include "timeSystem/TimeCorrectorApp.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cmath>
+#include <condition_variable>
 #include <cstdio>
 #include <cstring>
+#include <cstdint>
 #include <ctime>
+#include <deque>
+#include <exception>
 #include <fstream>
+#include <functional>
+#include <iomanip>
 #include <iostream>
+#include <limits>
 #include <list>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
 #include <stdexcept>
+#include <thread>
+#include <vector>
 
 #include "facilities/commonUtilities.h"
 
@@ -23,52 +38,133 @@
 #include "st_app/StAppFactory.h"
 
 #include "timeSystem/AbsoluteTime.h"
+#include "timeSystem/CorrectionService.h"
 #include "timeSystem/EventTimeHandler.h"
 #include "timeSystem/GlastTimeHandler.h"
+#include "timeSystem/PerformanceMonitor.h"
 #include "timeSystem/SourcePosition.h"
+#include "timeSystem/TimeSystem.h"
 
 #include "tip/FileSummary.h"
 #include "tip/Header.h"
 #include "tip/IFileSvc.h"
+#include "tip/TipException.h"
 #include "tip/TipFile.h"
 
+#include <fitsio.h>
+
 static const std::string s_cvs_id = "$Name:  $";
 
 namespace {
 
   using namespace timeSystem;
 
+  typedef TimeCorrectorApp::CorrectionTarget CorrectionTarget;
+
+  /** \brief Return a list of file names given by a parameter value. If the value starts with '@', the rest of the value is
+             taken as the name of a text file that lists file names, one per line. Otherwise, the value itself is a file name.
+      \param par_value Parameter value to interpret.
+  */
+  std::vector<std::string> expandFileList(const std::string & par_value) {
+    std::vector<std::string> file_cont;
+    if (par_value.empty() || '@' != par_value[0]) {
+      file_cont.push_back(par_value);
+      return file_cont;
+    }
+
+    // Read the file names from the list file, skipping blank lines.
+    std::string list_file = par_value.substr(1);
+    std::ifstream ifs(list_file.c_str());
+    if (!ifs.good()) throw std::runtime_error("Cannot open file " + list_file + " for reading");
+    std::string line;
+    while (std::getline(ifs, line)) {
+      std::string::size_type first = line.find_first_not_of(" \t\r");
+      if (std::string::npos == first) continue;
+      std::string::size_type last = line.find_last_not_of(" \t\r");
+      file_cont.push_back(line.substr(first, last - first + 1));
+    }
+    return file_cont;
+  }
+
+  /** \brief Read a source list file, and return its contents. Each line of the file gives Right Ascension and Declination
+             in degrees, and the name of the output file, separated by white spaces. Blank lines and lines starting with '#'
+             are skipped.
+      \param file_name Name of the source list file.
+  */
+  std::vector<CorrectionTarget> readTargetList(const std::string & file_name) {
+    std::ifstream ifs(file_name.c_str());
+    if (!ifs.good()) throw std::runtime_error("Cannot open file " + file_name + " for reading");
+    std::vector<CorrectionTarget> target_cont;
+    std::string line;
+    for (int line_number = 1; std::getline(ifs, line); ++line_number) {
+      std::string::size_type first = line.find_first_not_of(" \t\r");
+      if (std::string::npos == first || '#' == line[first]) continue;
+      std::istringstream iss(line);
+      double ra = 0.;
+      double dec = 0.;
+      std::string out_file;
+      std::string extra;
+      if (!(iss >> ra >> dec >> out_file) || (iss >> extra)) {
+        std::ostringstream oss;
+        oss << "Line " << line_number << " of source list file " << file_name << " is not in the form of \"RA Dec outfile\"";
+        throw std::runtime_error(oss.str());
+      }
+      target_cont.push_back(CorrectionTarget(ra, dec, out_file));
+    }
+    if (target_cont.empty()) throw std::runtime_error("No source found in source list file " + file_name);
+    return target_cont;
+  }
+
   /** \class IHandlerPairFactory
-      \brief Type-neutral base class for creation of a pair of EventTimeHandler objects.
+      \brief Type-neutral base class for creation of a pair of EventTimeHandler objects, or of an EventTimeHandler object
+             paired with more than one EventTimeHandler object of the second kind.
   */
   class IHandlerPairFactory {
     public:
       /// \brief Destruct this IHandlerPairFactory object.
       virtual ~IHandlerPairFactory() {}
 
-      /** \brief Create a pair of EventTimeHandler objects.
+      /** \brief Create an EventTimeHandler object for the first file, and one for each of the second files. Return a logical
+                 true if all of them are created, and a logical false otherwise, in which case none of them is created.
           \param first_file_name Name of a file to be opened by the first EventTimeHandler class.
-          \param second_file_name Name of a file to be opened by the second EventTimeHandler class.
+          \param first_keyword Header keyword values of the extension to be opened in the first file.
+          \param second_file_name Names of files to be opened by the second EventTimeHandler class.
+          \param second_keyword Header keyword values of the extension to be opened in each of the second files.
           \param extension_number Extension number to be opened, with 0 (zero) for a primary HDU.
                  Both the first and the second files are opened with this extension number.
+          \param first_handler EventTimeHandler object created for the first file.
+          \param second_handler EventTimeHandler objects created for the second files, in the same order as second_file_name.
       */
-      std::pair<EventTimeHandler *, EventTimeHandler *> create(const std::string & first_file_name,
-        const std::string & second_file_name, int extension_number) const;
+      bool create(const std::string & first_file_name, const GlastTimeHandler::HeaderKeyword & first_keyword,
+        const std::vector<std::string> & second_file_name, const std::vector<GlastTimeHandler::HeaderKeyword> & second_keyword,
+        int extension_number, std::unique_ptr<EventTimeHandler> & first_handler,
+        std::vector<std::unique_ptr<EventTimeHandler> > & second_handler) const;
 
       /** \brief Create one EventTimeHandler object. Actual creation must be done in a derived class.
                  This method is called to create a pair of EventTimeHandler objects.
           \param file_name Name of a file to be opened.
           \param extension_number Extension number to be opened, with 0 (zero) for a primary HDU.
+          \param header_keyword Header keyword values of the extension to be opened.
           \param as_first_file Set to true if file should be opened with the first EventTimeHandler class.
                                Set to false otherwise.
       */
-      virtual EventTimeHandler * create(const std::string & file_name, int extension_number, bool as_first_file = true) const = 0;
+      virtual EventTimeHandler * create(const std::string & file_name, int extension_number,
+        const GlastTimeHandler::HeaderKeyword & header_keyword, bool as_first_file = true) const = 0;
+
+      /** \brief Return a logical true if an extension with given header keyword values can be opened, without opening it.
+          \param header_keyword Header keyword values of the extension to check.
+          \param as_first_file Set to true to check with the first EventTimeHandler class. Set to false otherwise.
+      */
+      virtual bool isSupported(const GlastTimeHandler::HeaderKeyword & header_keyword, bool as_first_file = true) const = 0;
 
     protected:
       /// \brief Construct an IHandlerPairFactory object.
       IHandlerPairFactory() {}
   };
 
+  /// \brief Type of a container of factories, which are tried in order until one of them creates event time handlers.
+  typedef std::list<IHandlerPairFactory *> factory_cont_type;
+
   /** \class HandlerPairFactory
       \brief Concrete class for creation of a pair of EventTimeHandler objects.
   */
@@ -84,38 +180,51 @@ namespace {
       /** \brief Create one EventTimeHandler object of a given type.
           \param file_name Name of a file to be opened.
           \param extension_number Extension number to be opened, with 0 (zero) for a primary HDU.
+          \param header_keyword Header keyword values of the extension to be opened.
           \param as_first_file Set to true if file should be opened with the first EventTimeHandler class.
                                Set to false otherwise.
       */
-      virtual EventTimeHandler * create(const std::string & file_name, int extension_number, bool as_first_file = true) const;
-  };
+      virtual EventTimeHandler * create(const std::string & file_name, int extension_number,
+        const GlastTimeHandler::HeaderKeyword & header_keyword, bool as_first_file = true) const;
 
-  std::pair<EventTimeHandler *, EventTimeHandler *> IHandlerPairFactory::create(const std::string & first_file_name,
-    const std::string & second_file_name, int extension_number) const {
-    // Prepare variables to hold the return value.
-    EventTimeHandler * first_handler(0);
-    EventTimeHandler * second_handler(0);
+      /** \brief Return a logical true if an extension with given header keyword values can be opened, without opening it.
+          \param header_keyword Header keyword values of the extension to check.
+          \param as_first_file Set to true to check with the first EventTimeHandler class. Set to false otherwise.
+      */
+      virtual bool isSupported(const GlastTimeHandler::HeaderKeyword & header_keyword, bool as_first_file = true) const {
+        return as_first_file ? FirstHandlerType::isSupported(header_keyword) : SecondHandlerType::isSupported(header_keyword);
+      }
+  };
 
+  bool IHandlerPairFactory::create(const std::string & first_file_name, const GlastTimeHandler::HeaderKeyword & first_keyword,
+    const std::vector<std::string> & second_file_name, const std::vector<GlastTimeHandler::HeaderKeyword> & second_keyword,
+    int extension_number, std::unique_ptr<EventTimeHandler> & first_handler,
+    std::vector<std::unique_ptr<EventTimeHandler> > & second_handler) const {
     // Try to create an event time handler for the first file.
-    first_handler = create(first_file_name, extension_number, true);
-    if (0 != first_handler) {
-      // Try to create an event time handler for the second file.
-      second_handler = create(second_file_name, extension_number, false);
-
-      // Destroy the handler for the first file if no handler is created for the second.
-      if (0 == second_handler) {
-        delete first_handler;
-        first_handler = 0;
+    first_handler.reset(create(first_file_name, extension_number, first_keyword, true));
+    second_handler.clear();
+    if (0 != first_handler.get()) {
+      // Try to create an event time handler for each of the second files.
+      for (std::vector<std::string>::size_type file_index = 0; file_index < second_file_name.size(); ++file_index) {
+        second_handler.push_back(std::unique_ptr<EventTimeHandler>(create(second_file_name[file_index], extension_number,
+          second_keyword[file_index], false)));
+
+        // Destroy all the handlers if any handler is not created for the second files.
+        if (0 == second_handler.back().get()) {
+          second_handler.clear();
+          first_handler.reset(nullptr);
+          break;
+        }
       }
     }
 
-    // Return the pair of handlers.
-    return std::make_pair(first_handler, second_handler);
+    // Return whether the handlers are created.
+    return 0 != first_handler.get();
   }
 
   template <typename FirstHandlerType, typename SecondHandlerType>
   EventTimeHandler * HandlerPairFactory<FirstHandlerType, SecondHandlerType>::create(const std::string & file_name,
-    int extension_number, bool as_first_file) const {
+    int extension_number, const GlastTimeHandler::HeaderKeyword & header_keyword, bool as_first_file) const {
     // Prepare a variable to hold the return value.
     EventTimeHandler * handler(0);
 
@@ -126,8 +235,8 @@ namespace {
 
     try {
       // Try to create an event time handler.
-      if (as_first_file) handler = FirstHandlerType::createInstance(file_name, ext_name, true);
-      else handler = SecondHandlerType::createInstance(file_name, ext_name, false);
+      if (as_first_file) handler = FirstHandlerType::createInstance(file_name, ext_name, header_keyword, true);
+      else handler = SecondHandlerType::createInstance(file_name, ext_name, header_keyword, false);
 
     } catch (...) {
       // Return 0 (null pointer) for error(s) of any kind.
@@ -138,27 +247,1035 @@ namespace {
     return handler;
   }
 
+  /** \class MonitorSession
+      \brief Class to enable collection of performance statistics during the lifetime of an object of this class.
+  */
+  class MonitorSession {
+    public:
+      /** \brief Construct a MonitorSession object, resetting all the times and counters, and enabling collection if requested.
+          \param enabled Set to true to enable collection. Set to false to leave it disabled.
+      */
+      explicit MonitorSession(bool enabled) {
+        PerformanceMonitor::reset();
+        PerformanceMonitor::enable(enabled);
+      }
+
+      /// \brief Destruct this MonitorSession object, disabling collection.
+      ~MonitorSession() { PerformanceMonitor::enable(false); }
+  };
+
+  /** \class WorkerPool
+      \brief Class to run tasks in worker threads that are created once for the lifetime of an object of this class, rather
+             than once for each set of tasks. The calling thread also runs tasks while it waits for the workers.
+  */
+  class WorkerPool {
+    public:
+      /** \brief Construct a WorkerPool object, starting a given number of worker threads.
+          \param num_worker The number of worker threads to start.
+      */
+      explicit WorkerPool(std::size_t num_worker);
+
+      /// \brief Destruct this WorkerPool object, stopping and joining all the worker threads.
+      ~WorkerPool();
+
+      /** \brief Run a given task for each of task indices from zero (0) to one less than a given number, and wait until all
+                 of them finish. An exception thrown by each task is stored in the element of the last argument at its index.
+          \param num_task The number of tasks to run.
+          \param task Task to run, which receives a task index as an argument.
+          \param error_cont Exceptions thrown by the tasks, in the order of the task indices. Null for tasks without an error.
+      */
+      void run(std::size_t num_task, const std::function<void(std::size_t)> & task, std::vector<std::exception_ptr> & error_cont);
+
+    private:
+      std::mutex m_run_mutex; // Mutex to run one set of tasks at a time.
+      std::mutex m_mutex;
+      std::condition_variable m_task_cond;
+      std::condition_variable m_done_cond;
+      std::vector<std::thread> m_thread_cont;
+      const std::function<void(std::size_t)> * m_task;
+      std::vector<std::exception_ptr> * m_error_cont;
+      std::size_t m_num_task;
+      std::size_t m_next_task;
+      std::size_t m_num_done;
+      bool m_stopped;
+
+      /** \brief Helper method to run tasks of the current set one after another, until none is left to start. The caller must
+                 hold the lock on m_mutex with a given lock object, which is released while each task runs.
+          \param lock Lock object that holds the lock on m_mutex.
+      */
+      void runTask(std::unique_lock<std::mutex> & lock);
+  };
+
+  WorkerPool::WorkerPool(std::size_t num_worker): m_run_mutex(), m_mutex(), m_task_cond(), m_done_cond(), m_thread_cont(),
+    m_task(0), m_error_cont(0), m_num_task(0), m_next_task(0), m_num_done(0), m_stopped(false) {
+    m_thread_cont.reserve(num_worker);
+    for (std::size_t thread_index = 0; thread_index < num_worker; ++thread_index) {
+      m_thread_cont.push_back(std::thread([this]() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+          m_task_cond.wait(lock, [this]() { return m_stopped || m_next_task < m_num_task; });
+          if (m_stopped) return;
+          runTask(lock);
+        }
+      }));
+    }
+  }
+
+  WorkerPool::~WorkerPool() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stopped = true;
+    }
+    m_task_cond.notify_all();
+    for (std::vector<std::thread>::iterator itor = m_thread_cont.begin(); itor != m_thread_cont.end(); ++itor) itor->join();
+  }
+
+  void WorkerPool::run(std::size_t num_task, const std::function<void(std::size_t)> & task,
+    std::vector<std::exception_ptr> & error_cont) {
+    std::lock_guard<std::mutex> run_lock(m_run_mutex);
+    error_cont.assign(num_task, std::exception_ptr());
+
+    // Hand the tasks to the workers, run tasks in this thread as well, and wait for the rest of them.
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_task = &task;
+    m_error_cont = &error_cont;
+    m_num_task = num_task;
+    m_next_task = 0;
+    m_num_done = 0;
+    m_task_cond.notify_all();
+    runTask(lock);
+    m_done_cond.wait(lock, [this]() { return m_num_done == m_num_task; });
+    m_task = 0;
+    m_error_cont = 0;
+    m_num_task = 0;
+    m_next_task = 0;
+  }
+
+  void WorkerPool::runTask(std::unique_lock<std::mutex> & lock) {
+    while (m_next_task < m_num_task) {
+      std::size_t task_index = m_next_task++;
+      lock.unlock();
+      std::exception_ptr error;
+      try {
+        (*m_task)(task_index);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      lock.lock();
+      (*m_error_cont)[task_index] = error;
+      if (++m_num_done == m_num_task) m_done_cond.notify_all();
+    }
+  }
+
+  /** \class BlockCorrector
+      \brief Class to perform arrival time corrections on a block of rows at a time, splitting the block into row ranges
+             and processing them in parallel with worker threads, which are created once for the lifetime of an object of this
+             class. Times can be corrected for more than one source at a time,
+             computing spacecraft positions and solar system ephemeris only once for all the sources.
+  */
+  class BlockCorrector {
+    public:
+      /** \brief Construct a BlockCorrector object.
+          \param input_handler Event time handler to compute geocentric or barycentric times with.
+          \param output_handler Event time handlers to compute times to be written to the output files with, one per source.
+          \param src_position Positions of the sources to be used for arrival time corrections, in the same order as
+                 output_handler.
+          \param compute_bary Set to true to compute barycentric times. Set to false to compute geocentric times.
+          \param num_thread The number of worker threads to use.
+      */
+      BlockCorrector(const GlastScTimeHandler & input_handler, const std::vector<GlastTimeHandler *> & output_handler,
+        const std::vector<SourcePosition> & src_position, bool compute_bary, int num_thread);
+
+      /** \brief Compute corrected times for a given block of times, and set them to the last argument.
+          \param glast_time Fermi (formerly GLAST) METs to be corrected.
+          \param corrected_time Corrected times to be written to the output files, one container per source, each in the same
+                 order as glast_time.
+      */
+      void correct(const std::vector<double> & glast_time, std::vector<std::vector<double> > & corrected_time) const;
+
+      /** \brief Compute corrected times for a given block of times for the first source, and set them to the last argument.
+          \param glast_time Fermi (formerly GLAST) METs to be corrected.
+          \param corrected_time Corrected times to be written to the first output file, in the same order as glast_time.
+      */
+      void correct(const std::vector<double> & glast_time, std::vector<double> & corrected_time) const;
+
+    private:
+      const GlastScTimeHandler & m_input_handler;
+      std::vector<GlastTimeHandler *> m_output_handler;
+      std::vector<SourcePosition> m_src_position;
+      bool m_compute_bary;
+      int m_num_thread;
+      bool m_direct_met;
+      std::unique_ptr<WorkerPool> m_pool; // Created only if more than one thread is used.
+
+      /** \brief Helper method to compute corrected times for a given range of a block of times.
+          \param glast_time Fermi (formerly GLAST) METs to be corrected.
+          \param first_index Index of the first element of the range.
+          \param last_index Index of one past the last element of the range.
+          \param corrected_time Corrected times to be written to the output files. Only elements in the range are set.
+      */
+      void correctRange(const std::vector<double> & glast_time, std::size_t first_index, std::size_t last_index,
+        std::vector<std::vector<double> > & corrected_time) const;
+  };
+
+  BlockCorrector::BlockCorrector(const GlastScTimeHandler & input_handler, const std::vector<GlastTimeHandler *> & output_handler,
+    const std::vector<SourcePosition> & src_position, bool compute_bary, int num_thread): m_input_handler(input_handler),
+    m_output_handler(output_handler), m_src_position(src_position), m_compute_bary(compute_bary),
+    m_num_thread(num_thread < 1 ? 1 : num_thread), m_direct_met(!output_handler.empty()), m_pool() {
+    // Start the worker threads, which process row ranges along with the thread that calls correct method.
+    if (m_num_thread > 1) m_pool.reset(new WorkerPool(m_num_thread - 1));
+
+    // Compute output METs directly from input METs if all the output files measure METs in the time system of the
+    // correction from the same MJDREF as the input file, without creating AbsoluteTime objects.
+    const TimeSystem & corrected_system(TimeSystem::getSystem(m_compute_bary ? "TDB" : "TT"));
+    for (std::vector<GlastTimeHandler *>::const_iterator itor = m_output_handler.begin(); itor != m_output_handler.end(); ++itor) {
+      if (&(*itor)->getTimeSystem() != &corrected_system || !(*itor)->hasSameMjdRef(m_input_handler)) m_direct_met = false;
+    }
+  }
+
+  void BlockCorrector::correct(const std::vector<double> & glast_time, std::vector<double> & corrected_time) const {
+    std::vector<std::vector<double> > corrected_time_cont;
+    correct(glast_time, corrected_time_cont);
+    corrected_time.swap(corrected_time_cont.front());
+  }
+
+  void BlockCorrector::correct(const std::vector<double> & glast_time, std::vector<std::vector<double> > & corrected_time) const {
+    // Correct the times in sorted order if they are not sorted, so that the spacecraft file and solar system ephemeris are
+    // searched in time order, and each worker thread processes a contiguous time span. The corrected times are then
+    // scattered back to the given order.
+    // Note: Times that cannot be compared, i.e., NaN's, are left in the given order, to be reported as errors.
+    std::size_t num_time = glast_time.size();
+    bool sorted = true;
+    bool comparable = true;
+    for (std::size_t time_index = 0; time_index < num_time && comparable; ++time_index) {
+      comparable = (glast_time[time_index] == glast_time[time_index]);
+      if (time_index > 0 && glast_time[time_index] < glast_time[time_index - 1]) sorted = false;
+    }
+    if (!sorted && comparable) {
+      PerformanceMonitor::addCount(PerformanceMonitor::ROW_REORDERED, num_time);
+      std::vector<std::size_t> time_order(num_time);
+      for (std::size_t time_index = 0; time_index < num_time; ++time_index) time_order[time_index] = time_index;
+      std::stable_sort(time_order.begin(), time_order.end(), [&](std::size_t index1, std::size_t index2) {
+        return glast_time[index1] < glast_time[index2];
+      });
+      std::vector<double> sorted_time(num_time);
+      for (std::size_t time_index = 0; time_index < num_time; ++time_index) {
+        sorted_time[time_index] = glast_time[time_order[time_index]];
+      }
+      std::vector<std::vector<double> > sorted_corrected_time;
+      correct(sorted_time, sorted_corrected_time);
+      corrected_time.resize(sorted_corrected_time.size());
+      for (std::size_t src_index = 0; src_index < sorted_corrected_time.size(); ++src_index) {
+        corrected_time[src_index].resize(num_time);
+        for (std::size_t time_index = 0; time_index < num_time; ++time_index) {
+          corrected_time[src_index][time_order[time_index]] = sorted_corrected_time[src_index][time_index];
+        }
+      }
+      return;
+    }
+
+    // Prepare the return value.
+    corrected_time.resize(m_output_handler.size());
+    for (std::vector<std::vector<double> >::iterator itor = corrected_time.begin(); itor != corrected_time.end(); ++itor) {
+      itor->resize(glast_time.size());
+    }
+
+    // Compute the number of row ranges.
+    std::size_t num_range = std::min(static_cast<std::size_t>(m_num_thread), glast_time.size());
+    if (num_range <= 1) {
+      // Process the whole block in this thread.
+      correctRange(glast_time, 0, glast_time.size(), corrected_time);
+
+    } else {
+      // Process the ranges in the worker threads.
+      // Note: Each range is written to its own part of corrected_time, so that the result is identical to a serial processing.
+      std::vector<std::exception_ptr> error_cont;
+      m_pool->run(num_range, [this, &glast_time, num_range, &corrected_time](std::size_t range_index) {
+        std::size_t first_index = glast_time.size() * range_index / num_range;
+        std::size_t last_index = glast_time.size() * (range_index + 1) / num_range;
+        correctRange(glast_time, first_index, last_index, corrected_time);
+      }, error_cont);
+
+      // Re-throw the error that occurred in the earliest range, if any, as a serial processing would.
+      for (std::vector<std::exception_ptr>::const_iterator itor = error_cont.begin(); itor != error_cont.end(); ++itor) {
+        if (*itor) std::rethrow_exception(*itor);
+      }
+    }
+  }
+
+  void BlockCorrector::correctRange(const std::vector<double> & glast_time, std::size_t first_index, std::size_t last_index,
+    std::vector<std::vector<double> > & corrected_time) const {
+    // Compute geocentric or barycentric times for the range directly as output METs, for all the sources at a time.
+    std::vector<double> range_time(glast_time.begin() + first_index, glast_time.begin() + last_index);
+    std::size_t num_time = range_time.size();
+    if (m_direct_met) {
+      std::vector<double> met_time;
+      m_input_handler.computeCorrectedGlastTime(range_time, m_src_position, m_compute_bary, met_time);
+      for (std::size_t src_index = 0; src_index < m_output_handler.size(); ++src_index) {
+        std::copy(met_time.begin() + src_index * num_time, met_time.begin() + (src_index + 1) * num_time,
+          corrected_time[src_index].begin() + first_index);
+      }
+      return;
+    }
+
+    // Compute geocentric or barycentric times for the range, for all the sources at a time.
+    std::vector<AbsoluteTime> abs_time;
+    m_input_handler.computeCorrectedTime(range_time, m_src_position, m_compute_bary, abs_time);
+
+    // Convert the corrected times to ones to be written to the output files.
+    std::vector<AbsoluteTime> src_abs_time;
+    for (std::size_t src_index = 0; src_index < m_output_handler.size(); ++src_index) {
+      src_abs_time.assign(abs_time.begin() + src_index * num_time, abs_time.begin() + (src_index + 1) * num_time);
+      m_output_handler[src_index]->computeGlastTime(src_abs_time, range_time);
+      std::copy(range_time.begin(), range_time.end(), corrected_time[src_index].begin() + first_index);
+    }
+  }
+
+  /** \class RowBlock
+      \brief Class to hold a contiguous block of rows of a binary table, as they are stored in a FITS file.
+  */
+  struct RowBlock {
+    /// \brief Construct a RowBlock object for an empty block.
+    RowBlock(): m_first_row(0), m_num_rows(0), m_buffer() {}
+
+    long m_first_row; // Index of the first row in the block, with 0 (zero) for the first row of the table.
+    long m_num_rows; // The number of rows in the block.
+    std::vector<unsigned char> m_buffer; // Bytes of the rows in the block.
+  };
+
+  /** \class BlockQueue
+      \brief Class to pass blocks of rows from one thread to another in the order in which they are pushed, holding at most
+             a given number of blocks at a time. A thread pushing a block to a full queue, or popping a block from an empty
+             queue, waits until the other thread pops or pushes a block, or until the queue is closed.
+  */
+  class BlockQueue {
+    public:
+      /** \brief Construct a BlockQueue object.
+          \param max_size The maximum number of blocks to hold at a time.
+      */
+      explicit BlockQueue(std::size_t max_size): m_mutex(), m_cond(), m_queue(), m_max_size(max_size < 1 ? 1 : max_size),
+        m_closed(false), m_aborted(false) {}
+
+      /** \brief Push a given block to this queue, waiting for a room if the queue is full. Return a logical true if the block
+                 is pushed, or a logical false if the queue is aborted.
+          \param block Block of rows to push. Its contents are moved to the queue.
+      */
+      bool push(RowBlock & block) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cond.wait(lock, [this]() { return m_aborted || m_queue.size() < m_max_size; });
+        if (m_aborted) return false;
+        m_queue.push_back(RowBlock());
+        m_queue.back().m_first_row = block.m_first_row;
+        m_queue.back().m_num_rows = block.m_num_rows;
+        m_queue.back().m_buffer.swap(block.m_buffer);
+        m_cond.notify_all();
+        return true;
+      }
+
+      /** \brief Pop the oldest block from this queue, waiting for one if the queue is empty. Return a logical true if a block
+                 is popped, or a logical false if the queue is closed and no block is left, or if the queue is aborted.
+          \param block Block of rows to which the popped block is moved.
+      */
+      bool pop(RowBlock & block) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cond.wait(lock, [this]() { return m_aborted || m_closed || !m_queue.empty(); });
+        if (m_aborted || m_queue.empty()) return false;
+        block.m_first_row = m_queue.front().m_first_row;
+        block.m_num_rows = m_queue.front().m_num_rows;
+        block.m_buffer.swap(m_queue.front().m_buffer);
+        m_queue.pop_front();
+        m_cond.notify_all();
+        return true;
+      }
+
+      /// \brief Close this queue, letting pop method return a logical false once all the blocks are popped.
+      void close() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        m_cond.notify_all();
+      }
+
+      /// \brief Abort this queue, discarding all the blocks in it, and letting both push and pop methods return a logical false.
+      void abort() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_aborted = true;
+        m_queue.clear();
+        m_cond.notify_all();
+      }
+
+    private:
+      std::mutex m_mutex;
+      std::condition_variable m_cond;
+      std::deque<RowBlock> m_queue;
+      std::size_t m_max_size;
+      bool m_closed;
+      bool m_aborted;
+  };
+
+  /** \class StreamCopier
+      \brief Class to write an output file in a single pass over an input file, copying each HDU as it is corrected.
+             Rows of a binary table are copied through a buffer, in which time columns are replaced with corrected times,
+             so that neither the input nor the output file is read or written more than once.
+  */
+  class StreamCopier {
+    public:
+      /** \brief Construct a StreamCopier object, opening an input file and creating an empty output file.
+          \param input_file_name Name of the file to copy from.
+          \param output_file_name Name of the file to create. An existing file of the name is overwritten.
+      */
+      StreamCopier(const std::string & input_file_name, const std::string & output_file_name);
+
+      /// \brief Destruct this StreamCopier object, closing both of the files.
+      ~StreamCopier();
+
+      /** \brief Copy the header of a given HDU of the input file to a new HDU appended to the output file.
+          \param ext_number Extension number to be copied, with 0 (zero) for a primary HDU.
+      */
+      void copyHeader(int ext_number);
+
+      /// \brief Copy the data unit of the current HDU of the input file to that of the output file as is.
+      void copyData();
+
+      /** \brief Return a logical true if the current HDU is a binary table whose rows can be copied with the given time
+                 columns replaced, i.e., the table has no heap, and the time columns are scalar double-precision columns
+                 without scaling. Return a logical false otherwise.
+          \param column_list Names of the time columns to be replaced.
+      */
+      bool canCopyTable(const std::list<std::string> & column_list);
+
+      /** \brief Copy the rows of the current HDU of the input file to the output file block by block, replacing the given
+                 time columns with times corrected by a given BlockCorrector object. If requested, blocks are read in a reader
+                 thread and written in a writer thread, while times are corrected in this thread, so that reading, correcting,
+                 and writing of different blocks overlap. Blocks are written in the order of rows in either case.
+          \param column_list Names of the time columns to be corrected.
+          \param corrector BlockCorrector object to compute corrected times with.
+          \param block_size The number of rows to copy at a time.
+          \param queue_depth The maximum number of blocks to be queued between the reader thread and this thread, and between
+                 this thread and the writer thread. Set to zero (0) to read, correct, and write blocks one after another in
+                 this thread.
+      */
+      void copyTable(const std::list<std::string> & column_list, const BlockCorrector & corrector, long block_size,
+        int queue_depth);
+
+    private:
+      std::string m_input_file_name;
+      std::string m_output_file_name;
+      fitsfile * m_input_fptr;
+      fitsfile * m_output_fptr;
+      long m_row_size;
+      std::vector<long> m_column_offset;
+
+      /** \brief Read a given block of rows of the current HDU of the input file.
+          \param block Block of rows to read, whose first row and number of rows must be set.
+      */
+      void readBlock(RowBlock & block);
+
+      /** \brief Replace the given time columns in a given block of rows with times corrected by a given BlockCorrector object.
+          \param column_list Names of the time columns to be corrected.
+          \param corrector BlockCorrector object to compute corrected times with.
+          \param block Block of rows in which time columns are replaced.
+      */
+      void correctBlock(const std::list<std::string> & column_list, const BlockCorrector & corrector, RowBlock & block) const;
+
+      /** \brief Write a given block of rows to the current HDU of the output file.
+          \param block Block of rows to write.
+      */
+      void writeBlock(const RowBlock & block);
+
+      /** \brief Throw an exception if a given cfitsio status is not zero.
+          \param status Status returned by a cfitsio function.
+          \param message Error message to be given to the exception.
+      */
+      void checkStatus(int status, const std::string & message) const;
+  };
+
+  StreamCopier::StreamCopier(const std::string & input_file_name, const std::string & output_file_name):
+    m_input_file_name(input_file_name), m_output_file_name(output_file_name), m_input_fptr(0), m_output_fptr(0), m_row_size(0),
+    m_column_offset() {
+    int status = 0;
+    fits_open_file(&m_input_fptr, m_input_file_name.c_str(), READONLY, &status);
+    checkStatus(status, "Error occurred while opening file " + m_input_file_name);
+
+    // Remove an existing output file, as TipFile::copyFile does, and create an empty one.
+    std::remove(m_output_file_name.c_str());
+    fits_create_file(&m_output_fptr, m_output_file_name.c_str(), &status);
+    if (status) {
+      int close_status = 0;
+      fits_close_file(m_input_fptr, &close_status);
+      m_input_fptr = 0;
+      m_output_fptr = 0;
+    }
+    checkStatus(status, "Error occurred while creating file " + m_output_file_name);
+  }
+
+  StreamCopier::~StreamCopier() {
+    // Close the files, ignoring errors.
+    int status = 0;
+    if (m_output_fptr) fits_close_file(m_output_fptr, &status);
+    status = 0;
+    if (m_input_fptr) fits_close_file(m_input_fptr, &status);
+  }
+
+  void StreamCopier::copyHeader(int ext_number) {
+    PerformanceMonitor::StageTimer timer(PerformanceMonitor::FILE_WRITE);
+    std::ostringstream oss;
+    oss << "Error occurred while copying the header of HDU " << ext_number << " of " << m_input_file_name << " to " <<
+      m_output_file_name;
+    int status = 0;
+    fits_movabs_hdu(m_input_fptr, ext_number + 1, 0, &status);
+    fits_copy_header(m_input_fptr, m_output_fptr, &status);
+    checkStatus(status, oss.str());
+  }
+
+  void StreamCopier::copyData() {
+    PerformanceMonitor::StageTimer timer(PerformanceMonitor::FILE_WRITE);
+    int status = 0;
+    fits_copy_data(m_input_fptr, m_output_fptr, &status);
+    checkStatus(status, "Error occurred while copying data from " + m_input_file_name + " to " + m_output_file_name);
+  }
+
+  bool StreamCopier::canCopyTable(const std::list<std::string> & column_list) {
+    // Require a binary table without a heap.
+    int status = 0;
+    int hdu_type = 0;
+    fits_get_hdu_type(m_input_fptr, &hdu_type, &status);
+    long pcount = 0;
+    fits_read_key(m_input_fptr, TLONG, "PCOUNT", &pcount, 0, &status);
+    fits_read_key(m_input_fptr, TLONG, "NAXIS1", &m_row_size, 0, &status);
+    int num_column = 0;
+    fits_get_num_cols(m_input_fptr, &num_column, &status);
+    if (status || BINARY_TBL != hdu_type || 0 != pcount) return false;
+
+    // Compute the offset of each column in a row.
+    std::vector<long> column_offset(num_column + 1, 0);
+    for (int col_index = 0; col_index < num_column; ++col_index) {
+      std::ostringstream oss;
+      oss << "TFORM" << col_index + 1;
+      char tform[FLEN_VALUE];
+      int type_code = 0;
+      long repeat = 0;
+      long width = 0;
+      fits_read_key(m_input_fptr, TSTRING, oss.str().c_str(), tform, 0, &status);
+      fits_binary_tform(tform, &type_code, &repeat, &width, &status);
+      if (status || type_code < 0) return false;
+      long column_size = repeat * width;
+      if (TSTRING == type_code) column_size = repeat;
+      else if (TBIT == type_code) column_size = (repeat + 7) / 8;
+      column_offset[col_index + 1] = column_offset[col_index] + column_size;
+    }
+    if (column_offset[num_column] != m_row_size) return false;
+
+    // Require the time columns to be scalar double-precision columns without scaling.
+    m_column_offset.clear();
+    for (std::list<std::string>::const_iterator name_itor = column_list.begin(); name_itor != column_list.end(); ++name_itor) {
+      int column_number = 0;
+      char data_type[FLEN_VALUE];
+      long repeat = 0;
+      double scale = 1.;
+      double zero = 0.;
+      fits_get_colnum(m_input_fptr, CASEINSEN, const_cast<char *>(name_itor->c_str()), &column_number, &status);
+      fits_get_bcolparms(m_input_fptr, column_number, 0, 0, data_type, &repeat, &scale, &zero, 0, 0, &status);
+      if (status || std::string("D") != data_type || 1 != repeat || 1. != scale || 0. != zero) return false;
+      m_column_offset.push_back(column_offset[column_number - 1]);
+    }
+    return true;
+  }
+
+  void StreamCopier::copyTable(const std::list<std::string> & column_list, const BlockCorrector & corrector, long block_size,
+    int queue_depth) {
+    int status = 0;
+    long num_rows = 0;
+    fits_get_num_rows(m_input_fptr, &num_rows, &status);
+    checkStatus(status, "Error occurred while reading the number of rows in " + m_input_file_name);
+
+    // Loop over blocks of FITS rows in this thread, unless pipelining is requested.
+    if (queue_depth <= 0) {
+      RowBlock block;
+      for (long first_row = 0; first_row < num_rows; first_row += block_size) {
+        block.m_first_row = first_row;
+        block.m_num_rows = std::min(block_size, num_rows - first_row);
+        readBlock(block);
+        correctBlock(column_list, corrector, block);
+        writeBlock(block);
+      }
+      return;
+    }
+
+    // Read blocks of FITS rows in a reader thread, and write them in a writer thread.
+    // Note: Each of the input and the output files is accessed by one thread only, but pipelining still requires
+    //       a thread-safe build of cfitsio, which the caller must check.
+    BlockQueue read_queue(queue_depth);
+    BlockQueue write_queue(queue_depth);
+    std::exception_ptr read_error(nullptr);
+    std::exception_ptr correct_error(nullptr);
+    std::exception_ptr write_error(nullptr);
+    std::thread reader([&]() {
+      try {
+        RowBlock block;
+        for (long first_row = 0; first_row < num_rows; first_row += block_size) {
+          block.m_first_row = first_row;
+          block.m_num_rows = std::min(block_size, num_rows - first_row);
+          readBlock(block);
+          if (!read_queue.push(block)) break;
+        }
+      } catch (...) {
+        read_error = std::current_exception();
+      }
+      read_queue.close();
+    });
+    std::thread writer([&]() {
+      try {
+        RowBlock block;
+        while (write_queue.pop(block)) writeBlock(block);
+      } catch (...) {
+        write_error = std::current_exception();
+        write_queue.abort();
+      }
+    });
+
+    // Correct times in blocks in this thread, as they are read.
+    try {
+      RowBlock block;
+      while (read_queue.pop(block)) {
+        correctBlock(column_list, corrector, block);
+        if (!write_queue.push(block)) break;
+      }
+    } catch (...) {
+      correct_error = std::current_exception();
+    }
+    read_queue.abort();
+    write_queue.close();
+    reader.join();
+    writer.join();
+
+    // Re-throw the error that occurred in the earliest stage, if any.
+    if (read_error) std::rethrow_exception(read_error);
+    if (correct_error) std::rethrow_exception(correct_error);
+    if (write_error) std::rethrow_exception(write_error);
+  }
+
+  void StreamCopier::readBlock(RowBlock & block) {
+    // Read the rows of the block at a time.
+    // Note: cfitsio counts rows from 1 (one).
+    int status = 0;
+    block.m_buffer.resize(static_cast<std::size_t>(block.m_num_rows) * m_row_size);
+    if (block.m_buffer.empty()) return;
+    {
+      PerformanceMonitor::StageTimer timer(PerformanceMonitor::FILE_READ);
+      fits_read_tblbytes(m_input_fptr, block.m_first_row + 1, 1, block.m_buffer.size(), &block.m_buffer[0], &status);
+    }
+    std::ostringstream oss;
+    oss << "Error occurred while reading rows of " << m_input_file_name << " from row " << block.m_first_row;
+    checkStatus(status, oss.str());
+  }
+
+  void StreamCopier::correctBlock(const std::list<std::string> & column_list, const BlockCorrector & corrector,
+    RowBlock & block) const {
+    PerformanceMonitor::addCount(PerformanceMonitor::ROW_PROCESSED, block.m_num_rows);
+
+    // Replace each time column with corrected times.
+    // Note: FITS binary tables hold double-precision numbers in the big-endian IEEE 754 format.
+    std::vector<double> glast_time;
+    std::vector<double> corrected_time;
+    std::vector<long>::const_iterator offset_itor = m_column_offset.begin();
+    for (std::list<std::string>::const_iterator name_itor = column_list.begin(); name_itor != column_list.end();
+      ++name_itor, ++offset_itor) {
+      glast_time.resize(block.m_num_rows);
+      for (long row_index = 0; row_index < block.m_num_rows; ++row_index) {
+        const unsigned char * byte_ptr = &block.m_buffer[row_index * m_row_size + *offset_itor];
+        std::uint64_t bits = 0;
+        for (int ii = 0; ii < 8; ++ii) bits = (bits << 8) | byte_ptr[ii];
+        std::memcpy(&glast_time[row_index], &bits, sizeof(double));
+      }
+      corrector.correct(glast_time, corrected_time);
+      for (long row_index = 0; row_index < block.m_num_rows; ++row_index) {
+        unsigned char * byte_ptr = &block.m_buffer[row_index * m_row_size + *offset_itor];
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &corrected_time[row_index], sizeof(double));
+        for (int ii = 7; ii >= 0; --ii, bits >>= 8) byte_ptr[ii] = static_cast<unsigned char>(bits & 0xff);
+      }
+    }
+  }
+
+  void StreamCopier::writeBlock(const RowBlock & block) {
+    // Write the rows of the block at a time.
+    if (block.m_buffer.empty()) return;
+    int status = 0;
+    {
+      PerformanceMonitor::StageTimer timer(PerformanceMonitor::FILE_WRITE);
+      fits_write_tblbytes(m_output_fptr, block.m_first_row + 1, 1, block.m_buffer.size(),
+        const_cast<unsigned char *>(&block.m_buffer[0]), &status);
+    }
+    std::ostringstream oss;
+    oss << "Error occurred while writing rows of " << m_output_file_name << " from row " << block.m_first_row;
+    checkStatus(status, oss.str());
+  }
+
+  void StreamCopier::checkStatus(int status, const std::string & message) const {
+    if (status) throw tip::TipException(status, message);
+  }
+
+  /** \class FitsFileCloser
+      \brief Class to close a FITS file opened with cfitsio when an object of this class is destructed, ignoring errors.
+  */
+  class FitsFileCloser {
+    public:
+      /** \brief Construct a FitsFileCloser object.
+          \param fptr cfitsio pointer to the FITS file to close, or 0 (null pointer) for no file.
+      */
+      explicit FitsFileCloser(fitsfile * fptr): m_fptr(fptr) {}
+
+      /// \brief Destruct this FitsFileCloser object, closing the FITS file.
+      ~FitsFileCloser() {
+        int status = 0;
+        if (m_fptr) fits_close_file(m_fptr, &status);
+      }
+
+    private:
+      fitsfile * m_fptr;
+
+      FitsFileCloser(const FitsFileCloser &);
+      FitsFileCloser & operator =(const FitsFileCloser &);
+  };
+
+  /** \brief Return a fingerprint of given bytes, by continuing the 64-bit FNV-1a hash of a given fingerprint with them.
+      \param byte_ptr Pointer to the first byte to fingerprint.
+      \param num_byte The number of bytes to fingerprint.
+      \param fingerprint Fingerprint to continue, or 14695981039346656037 (the FNV offset basis) to start a new one.
+  */
+  std::uint64_t fingerprintBytes(const unsigned char * byte_ptr, std::size_t num_byte, std::uint64_t fingerprint) {
+    for (std::size_t byte_index = 0; byte_index < num_byte; ++byte_index) {
+      fingerprint ^= byte_ptr[byte_index];
+      fingerprint *= 1099511628211ULL;
+    }
+    return fingerprint;
+  }
+
+  /** \brief Return a fingerprint of the values of given columns in given rows of the current HDU of a FITS file, by
+             continuing a given fingerprint with the values, row by row, in the big-endian IEEE 754 format. Columns that do
+             not exist in the HDU are skipped.
+      \param fptr cfitsio pointer to the FITS file to read.
+      \param column_list Names of the columns to fingerprint.
+      \param first_row Index of the first row to fingerprint, with 0 (zero) for the first row of the table.
+      \param num_rows The number of rows to fingerprint.
+      \param fingerprint Fingerprint to continue.
+      \param status cfitsio status, which is set to non-zero if an error occurs.
+  */
+  std::uint64_t fingerprintRows(fitsfile * fptr, const std::list<std::string> & column_list, long first_row, long num_rows,
+    std::uint64_t fingerprint, int & status) {
+    // Find the columns to fingerprint.
+    std::vector<int> column_number;
+    for (std::list<std::string>::const_iterator name_itor = column_list.begin(); name_itor != column_list.end(); ++name_itor) {
+      int this_column = 0;
+      int column_status = 0;
+      fits_get_colnum(fptr, CASEINSEN, const_cast<char *>(name_itor->c_str()), &this_column, &column_status);
+      if (0 == column_status) column_number.push_back(this_column);
+    }
+    fits_clear_errmsg();
+
+    // Fingerprint the values block by block.
+    static const long block_size = 10000;
+    std::vector<std::vector<double> > value_cont(column_number.size());
+    for (long block_first = first_row; block_first < first_row + num_rows && 0 == status; block_first += block_size) {
+      long num_block_rows = std::min(block_size, first_row + num_rows - block_first);
+      for (std::size_t col_index = 0; col_index < column_number.size(); ++col_index) {
+        value_cont[col_index].resize(num_block_rows);
+        fits_read_col(fptr, TDOUBLE, column_number[col_index], block_first + 1, 1, num_block_rows, 0, &value_cont[col_index][0],
+          0, &status);
+      }
+      for (long row_index = 0; row_index < num_block_rows && 0 == status; ++row_index) {
+        for (std::size_t col_index = 0; col_index < column_number.size(); ++col_index) {
+          std::uint64_t bits = 0;
+          std::memcpy(&bits, &value_cont[col_index][row_index], sizeof(double));
+          unsigned char byte_cont[8];
+          for (int ii = 7; ii >= 0; --ii, bits >>= 8) byte_cont[ii] = static_cast<unsigned char>(bits & 0xff);
+          fingerprint = fingerprintBytes(byte_cont, sizeof(byte_cont), fingerprint);
+        }
+      }
+    }
+    return fingerprint;
+  }
+
+  /** \brief Return a given fingerprint as a character string of 16 hexadecimal digits.
+      \param fingerprint Fingerprint to format.
+  */
+  std::string formatFingerprint(std::uint64_t fingerprint) {
+    std::ostringstream oss;
+    oss << std::hex << std::setw(16) << std::setfill('0') << fingerprint;
+    return oss.str();
+  }
+
+  /** \brief Return the number of rows of the current HDU of a FITS file, or 0 (zero) if the HDU is not a table.
+      \param fptr cfitsio pointer to the FITS file to read.
+      \param status cfitsio status, which is set to non-zero if an error occurs.
+  */
+  long getNumTableRows(fitsfile * fptr, int & status) {
+    int hdu_type = 0;
+    long num_rows = 0;
+    fits_get_hdu_type(fptr, &hdu_type, &status);
+    if (BINARY_TBL == hdu_type || ASCII_TBL == hdu_type) fits_get_num_rows(fptr, &num_rows, &status);
+    return num_rows;
+  }
+
+  /** \class IncrementalRecord
+      \brief Class which holds, for each HDU of an input file, the number of rows that have been corrected in incremental
+             mode, and the fingerprint of those rows. The fingerprint of an HDU starts with the name of the spacecraft file
+             used for the corrections, and continues with the time columns of the corrected rows, so that the rows appended
+             to the input file since the last run can be corrected alone, only if the corrected rows remain unchanged.
+             The record is kept in TCNROWS and TCINSUM header keywords of the output file.
+  */
+  struct IncrementalRecord {
+    /** \brief Construct an IncrementalRecord object for a given number of HDUs, none of whose rows have been corrected.
+        \param num_hdu The number of HDUs of the input file.
+        \param sc_file_name Name of the spacecraft file used for the corrections.
+    */
+    IncrementalRecord(std::size_t num_hdu, const std::string & sc_file_name): m_num_rows(num_hdu, 0),
+      m_fingerprint(num_hdu, fingerprintBytes(reinterpret_cast<const unsigned char *>(sc_file_name.data()), sc_file_name.size(),
+      14695981039346656037ULL)) {}
+
+    std::vector<long> m_num_rows;
+    std::vector<std::uint64_t> m_fingerprint;
+  };
+
+  /** \brief Read an incremental record from the headers of an existing output file, and return a logical true if the output
+             file can be extended with the rows appended to a given input file since the record was written, i.e., the output
+             file records corrections made with the same parameters, it holds as many rows as recorded, and the input file
+             still starts with the recorded rows. Return a logical false otherwise, leaving the record as it is.
+      \param in_file_name Name of the input file.
+      \param out_file_name Name of the existing output file.
+      \param column_list Names of the time columns to be corrected, one list per HDU.
+      \param target Source position and output file name to be used for the corrections.
+      \param time_sys Value of TIMESYS header keyword of the output file.
+      \param time_ref Value of TIMEREF header keyword of the output file.
+      \param pl_ephem Value of PLEPHEM header keyword of the output file.
+      \param ang_tolerance Angular tolerance in degrees, within which the source position must match RA_NOM and DEC_NOM.
+      \param record Incremental record, whose fingerprints must be started with the name of the spacecraft file to be used.
+  */
+  bool readIncrementalRecord(const std::string & in_file_name, const std::string & out_file_name,
+    const std::vector<const std::list<std::string> *> & column_list, const CorrectionTarget & target, const std::string & time_sys,
+    const std::string & time_ref, const std::string & pl_ephem, double ang_tolerance, IncrementalRecord & record) {
+    // Open the input file and the existing output file, if any.
+    int status = 0;
+    fitsfile * in_fptr = 0;
+    fitsfile * out_fptr = 0;
+    fits_open_file(&in_fptr, in_file_name.c_str(), READONLY, &status);
+    FitsFileCloser in_closer(in_fptr);
+    fits_open_file(&out_fptr, out_file_name.c_str(), READONLY, &status);
+    FitsFileCloser out_closer(out_fptr);
+    int num_in_hdu = 0;
+    int num_out_hdu = 0;
+    fits_get_num_hdus(in_fptr, &num_in_hdu, &status);
+    fits_get_num_hdus(out_fptr, &num_out_hdu, &status);
+    if (status || num_in_hdu != num_out_hdu || static_cast<std::size_t>(num_in_hdu) != column_list.size()) {
+      fits_clear_errmsg();
+      return false;
+    }
+
+    // Check the record of each HDU.
+    IncrementalRecord new_record(record);
+    for (int hdu_index = 0; hdu_index < num_in_hdu; ++hdu_index) {
+      // Read the record and the parameters of the last corrections.
+      fits_movabs_hdu(in_fptr, hdu_index + 1, 0, &status);
+      fits_movabs_hdu(out_fptr, hdu_index + 1, 0, &status);
+      long num_rows = 0;
+      char fingerprint[FLEN_VALUE];
+      char out_time_sys[FLEN_VALUE];
+      char out_time_ref[FLEN_VALUE];
+      char out_pl_ephem[FLEN_VALUE];
+      double out_ra = 0.;
+      double out_dec = 0.;
+      fits_read_key(out_fptr, TLONG, "TCNROWS", &num_rows, 0, &status);
+      fits_read_key(out_fptr, TSTRING, "TCINSUM", fingerprint, 0, &status);
+      fits_read_key(out_fptr, TSTRING, "TIMESYS", out_time_sys, 0, &status);
+      fits_read_key(out_fptr, TSTRING, "TIMEREF", out_time_ref, 0, &status);
+      fits_read_key(out_fptr, TSTRING, "PLEPHEM", out_pl_ephem, 0, &status);
+      fits_read_key(out_fptr, TDOUBLE, "RA_NOM", &out_ra, 0, &status);
+      fits_read_key(out_fptr, TDOUBLE, "DEC_NOM", &out_dec, 0, &status);
+      if (status || time_sys != out_time_sys || time_ref != out_time_ref || pl_ephem != out_pl_ephem ||
+        std::fabs(out_ra - target.m_ra) > ang_tolerance || std::fabs(out_dec - target.m_dec) > ang_tolerance) {
+        fits_clear_errmsg();
+        return false;
+      }
+
+      // Require the output file to hold the recorded rows, and the input file to hold them and possibly more.
+      long num_out_rows = getNumTableRows(out_fptr, status);
+      long num_in_rows = getNumTableRows(in_fptr, status);
+      if (status || num_out_rows != num_rows || num_in_rows < num_rows) {
+        fits_clear_errmsg();
+        return false;
+      }
+
+      // Require the recorded rows of the input file to remain unchanged.
+      new_record.m_fingerprint[hdu_index] = fingerprintRows(in_fptr, *column_list[hdu_index], 0, num_rows,
+        new_record.m_fingerprint[hdu_index], status);
+      if (status || formatFingerprint(new_record.m_fingerprint[hdu_index]) != fingerprint) {
+        fits_clear_errmsg();
+        return false;
+      }
+      new_record.m_num_rows[hdu_index] = num_rows;
+    }
+
+    // Return the record.
+    record = new_record;
+    return true;
+  }
+
+  /** \brief Append the rows of a given input file that follow given numbers of rows to the corresponding HDUs of a given
+             output file, which must have the same table structure as the input file.
+      \param in_file_name Name of the input file to copy from.
+      \param out_file_name Name of the output file to append to.
+      \param first_row Index of the first row to append, with 0 (zero) for the first row of the table, one per HDU.
+  */
+  void appendRows(const std::string & in_file_name, const std::string & out_file_name, const std::vector<long> & first_row) {
+    PerformanceMonitor::StageTimer timer(PerformanceMonitor::FILE_WRITE);
+    int status = 0;
+    fitsfile * in_fptr = 0;
+    fitsfile * out_fptr = 0;
+    fits_open_file(&in_fptr, in_file_name.c_str(), READONLY, &status);
+    FitsFileCloser in_closer(in_fptr);
+    fits_open_file(&out_fptr, out_file_name.c_str(), READWRITE, &status);
+    FitsFileCloser out_closer(out_fptr);
+    for (std::size_t hdu_index = 0; hdu_index < first_row.size() && 0 == status; ++hdu_index) {
+      fits_movabs_hdu(in_fptr, hdu_index + 1, 0, &status);
+      fits_movabs_hdu(out_fptr, hdu_index + 1, 0, &status);
+      long num_rows = getNumTableRows(in_fptr, status);
+      if (0 == status && num_rows > first_row[hdu_index]) {
+        fits_copy_rows(in_fptr, out_fptr, first_row[hdu_index] + 1, num_rows - first_row[hdu_index], &status);
+      }
+    }
+    if (status) throw tip::TipException(status, "Error occurred while appending rows of " + in_file_name + " to " + out_file_name);
+  }
+
+  /** \brief Erase the HISTORY blocks written by a given program from all the HDUs of a given file, so that a block written
+             again replaces the old one. A block starts with a HISTORY record that tells the file was created or modified
+             by the program, and continues with the HISTORY records that follow it, until a record of a different type, or
+             a HISTORY record that starts another block.
+      \param file_name Name of the file to modify.
+      \param program_name Name of the program whose HISTORY blocks are to be erased.
+  */
+  void eraseHistoryBlock(const std::string & file_name, const std::string & program_name) {
+    const std::string history_name("HISTORY ");
+    const std::string block_start("File created or modified by ");
+    int status = 0;
+    fitsfile * fptr = 0;
+    fits_open_file(&fptr, file_name.c_str(), READWRITE, &status);
+    FitsFileCloser closer(fptr);
+    int num_hdus = 0;
+    fits_get_num_hdus(fptr, &num_hdus, &status);
+    for (int hdu_index = 0; hdu_index < num_hdus && 0 == status; ++hdu_index) {
+      fits_movabs_hdu(fptr, hdu_index + 1, 0, &status);
+      int num_keys = 0;
+      fits_get_hdrspace(fptr, &num_keys, 0, &status);
+      bool in_block = false;
+      for (int key_number = 1; key_number <= num_keys && 0 == status; ) {
+        char card[FLEN_CARD];
+        fits_read_record(fptr, key_number, card, &status);
+        std::string card_string(card);
+        bool is_history = (0 == card_string.compare(0, history_name.size(), history_name));
+        std::string::size_type text_pos = card_string.find_first_not_of(' ', history_name.size());
+        bool is_block_start = is_history && std::string::npos != text_pos &&
+          0 == card_string.compare(text_pos, block_start.size(), block_start);
+        if (is_block_start) {
+          in_block = (0 == card_string.compare(text_pos + block_start.size(), program_name.size() + 1, program_name + " "));
+        } else if (!is_history) {
+          in_block = false;
+        }
+        if (in_block) {
+          fits_delete_record(fptr, key_number, &status);
+          --num_keys;
+        } else {
+          ++key_number;
+        }
+      }
+    }
+    if (status) throw tip::TipException(status, "Error occurred while erasing HISTORY keywords of " + file_name);
+  }
+
 }
 
 namespace timeSystem {
 
-  TimeCorrectorApp::TimeCorrectorApp() {
+  TimeCorrectorApp::TimeCorrectorApp(): m_os("TimeCorrectorApp", "", 2) {
     setName("gtbary");
     setVersion(s_cvs_id);
   }
 
   TimeCorrectorApp::~TimeCorrectorApp() throw() {}
 
+  /** \class TimeCorrectorApp::CorrectionSetting
+      \brief Class which holds the settings of arrival time corrections common to all the input files, and records the
+             maximum estimated error of interpolated time delays over all of them, which may be corrected concurrently.
+  */
+  struct TimeCorrectorApp::CorrectionSetting {
+    /// \brief Construct a CorrectionSetting object.
+    CorrectionSetting(): m_creator_name(), m_date_keyword_value(), m_sc_file_name(), m_sc_extension_name(), m_ang_tolerance(0.),
+      m_solar_eph(), m_pl_ephem(), m_ref_frame(), m_t_correct(), m_t_correct_uc(), m_target_time_sys(), m_target_time_ref(),
+      m_factory_cont(0), m_keyword_list(), m_column_gti(), m_column_other(), m_block_size(0), m_num_thread(1), m_queue_depth(0),
+      m_delay_tolerance(0.), m_clobber(true), m_streaming(true), m_incremental(false), m_delay_error_mutex(),
+      m_max_delay_error(0.) {}
+
+    /** \brief Record the maximum estimated error of time delays interpolated by a given event time handler.
+        \param handler Event time handler that interpolated time delays.
+    */
+    void recordDelayError(const GlastScTimeHandler & handler) const {
+      std::lock_guard<std::mutex> lock(m_delay_error_mutex);
+      m_max_delay_error = std::max(m_max_delay_error, handler.getMaxDelayError());
+    }
+
+    /// \brief Return the maximum estimated error of interpolated time delays recorded so far.
+    double getMaxDelayError() const {
+      std::lock_guard<std::mutex> lock(m_delay_error_mutex);
+      return m_max_delay_error;
+    }
+
+    std::string m_creator_name;        // Value of CREATOR header keyword.
+    std::string m_date_keyword_value;  // Value of DATE header keyword, and time stamp of HISTORY header keywords.
+    std::string m_sc_file_name;
+    std::string m_sc_extension_name;
+    double m_ang_tolerance;
+    std::string m_solar_eph;           // Solar system ephemeris as given by solareph parameter.
+    std::string m_pl_ephem;            // Value of PLEPHEM header keyword.
+    std::string m_ref_frame;           // Value of RADECSYS header keyword.
+    std::string m_t_correct;           // Arrival time correction as given by tcorrect parameter.
+    std::string m_t_correct_uc;        // Arrival time correction in upper case.
+    std::string m_target_time_sys;     // Value of TIMESYS header keyword of the output files.
+    std::string m_target_time_ref;     // Value of TIMEREF header keyword of the output files.
+    const factory_cont_type * m_factory_cont;
+    std::list<std::string> m_keyword_list; // Header keywords to convert.
+    std::list<std::string> m_column_gti;   // Columns to convert in GTI extensions.
+    std::list<std::string> m_column_other; // Columns to convert in the other extensions.
+    int m_block_size;
+    int m_num_thread;
+    int m_queue_depth;
+    double m_delay_tolerance;
+    bool m_clobber;
+    bool m_streaming;
+    bool m_incremental;
+
+  private:
+    mutable std::mutex m_delay_error_mutex;
+    mutable double m_max_delay_error;
+  };
+
   void TimeCorrectorApp::run() {
     st_app::AppParGroup & pars = getParGroup();
     pars.Prompt();
     pars.Save();
+    m_os.setMethod("run()");
+
+    // Collect performance statistics if they are to be reported, either at a high chatter level or to a file.
+    int chatter = pars["chatter"];
+    std::string stat_file = pars["statfile"];
+    std::string stat_file_uc(stat_file);
+    for (std::string::iterator itor = stat_file_uc.begin(); itor != stat_file_uc.end(); ++itor) *itor = std::toupper(*itor);
+    bool write_stat_file = !("NONE" == stat_file_uc || stat_file_uc.empty());
+    bool report_stat = (chatter >= 4);
+    MonitorSession monitor_session(report_stat || write_stat_file);
 
     // Prepare for event file reading/writing, based on given time correction mode.
     std::string t_correct = pars["tcorrect"];
     std::string t_correct_uc(t_correct);
     for (std::string::iterator itor = t_correct_uc.begin(); itor != t_correct_uc.end(); ++itor) *itor = std::toupper(*itor);
-    typedef std::list<IHandlerPairFactory *> factory_cont_type;
     factory_cont_type factory_cont;
     std::string target_time_ref;
     std::string target_time_sys;
@@ -166,71 +1283,61 @@ namespace timeSystem {
       target_time_ref = "SOLARSYSTEM";
       target_time_sys = "TDB";
       factory_cont.push_back(new HandlerPairFactory<GlastScTimeHandler, GlastBaryTimeHandler>());
+      factory_cont.push_back(new HandlerPairFactory<GlastBaryTimeHandler, GlastBaryTimeHandler>());
     } else if ("GEO" == t_correct_uc) {
       target_time_ref = "GEOCENTRIC";
       target_time_sys = "TT";
       factory_cont.push_back(new HandlerPairFactory<GlastScTimeHandler, GlastGeoTimeHandler>());
+      factory_cont.push_back(new HandlerPairFactory<GlastGeoTimeHandler, GlastGeoTimeHandler>());
     } else {
       throw std::runtime_error("Unsupported arrival time correction: " + t_correct);
     }
 
-    // Check existence of the input FITS file.
-    std::string inFile_s = pars["evfile"];
-    if (!tip::IFileSvc::instance().fileExists(inFile_s)) {
-      throw std::runtime_error("File not found: " + inFile_s);
-    }
-
-    // Get file summary of the input FITS file.
-    tip::FileSummary file_summary;
-    tip::IFileSvc::instance().getFileSummary(inFile_s, file_summary);
-
-    // Loop over all extensions of the input file, including primary HDU, to check whether input file is supported or not.
-    int ext_number = 0;
-    for (tip::FileSummary::const_iterator ext_itor = file_summary.begin(); ext_itor != file_summary.end(); ++ext_itor, ++ext_number) {
-      bool supported = false;
-      for (factory_cont_type::const_iterator fact_itor = factory_cont.begin(); fact_itor != factory_cont.end(); ++fact_itor) {
-        std::unique_ptr<EventTimeHandler> input_handler((*fact_itor)->create(inFile_s, ext_number));
-        if (0 != input_handler.get()) supported = true;
-      }
-      if (!supported) {
+    // Get the names of the input files, reading them from a list file in batch mode.
+    std::string ev_file = pars["evfile"];
+    std::vector<std::string> in_file_cont = expandFileList(ev_file);
+    if (in_file_cont.empty()) throw std::runtime_error("No input file name found in \"" + ev_file + "\"");
+
+    // Get the source positions and the output file names for each input file, either from a source list file in multi-source
+    // mode, or from ra, dec, and outfile parameters otherwise.
+    std::string src_file = pars["srcfile"];
+    std::string src_file_uc(src_file);
+    for (std::string::iterator itor = src_file_uc.begin(); itor != src_file_uc.end(); ++itor) *itor = std::toupper(*itor);
+    std::vector<std::vector<CorrectionTarget> > target_cont;
+    std::vector<std::string> out_file_cont;
+    if ("NONE" == src_file_uc || src_file_uc.empty()) {
+      std::string out_file = pars["outfile"];
+      out_file_cont = expandFileList(out_file);
+      if (in_file_cont.size() != out_file_cont.size()) {
         std::ostringstream oss;
-        oss << "Unsupported timing extension: HDU "  << ext_number;
-        if (0 == ext_number) oss << " (primary HDU)";
-        else oss << " (EXTNAME=" << ext_itor->getExtId() << ")";
-        oss << " of input file \"" << inFile_s << "\"";
+        oss << "Number of input files (" << in_file_cont.size() << ") does not match number of output files (" <<
+          out_file_cont.size() << ")";
         throw std::runtime_error(oss.str());
       }
-    }
+      double ra = pars["ra"];
+      double dec = pars["dec"];
+      for (std::vector<std::string>::const_iterator itor = out_file_cont.begin(); itor != out_file_cont.end(); ++itor) {
+        target_cont.push_back(std::vector<CorrectionTarget>(1, CorrectionTarget(ra, dec, *itor)));
+      }
 
-    // Check whether output file name already exists or not, if clobber parameter is set to no.
-    std::string outFile_s = pars["outfile"];
-    bool clobber = pars["clobber"];
-    if (!clobber) {
-      bool file_readable = false;
-      try {
-        std::ifstream is(outFile_s.c_str());
-        if (is.good()) file_readable = true;
-      } catch (const std::exception &) {}
-      if (file_readable) throw std::runtime_error("File " + outFile_s + " exists, but clobber not set");
+    } else {
+      if (1 != in_file_cont.size()) throw std::runtime_error("Source list file " + src_file + " given for more than one input file");
+      target_cont.push_back(readTargetList(src_file));
+      for (std::vector<CorrectionTarget>::const_iterator itor = target_cont[0].begin(); itor != target_cont[0].end(); ++itor) {
+        out_file_cont.push_back(itor->m_out_file);
+      }
     }
+    std::set<std::string> out_file_set(out_file_cont.begin(), out_file_cont.end());
+    if (out_file_set.size() != out_file_cont.size()) throw std::runtime_error("Same output file name given more than once");
 
-    // Confirm that outfile is writable.
-    bool file_writable = false;
-    try {
-      std::ofstream os(outFile_s.c_str(), std::ios::out | std::ios::app);
-      if (os.good()) file_writable = true;
-    } catch (const std::exception &) {}
-    if (!file_writable)
-      throw std::runtime_error("Cannot open file " + outFile_s + " for writing");
+    // Get whether to overwrite existing output files.
+    bool clobber = pars["clobber"];
 
-    // Create temporary output file name.
-    std::string tmpOutFile_s = tmpFileName(outFile_s);
+    // Determine whether to write the output file in a single pass over the input file.
+    bool streaming = pars["streaming"];
 
-    // Open the input file.
-    tip::TipFile inTipFile = tip::IFileSvc::instance().openFile(inFile_s);
-  
-    // Copy the input to the temporary output file.
-    inTipFile.copyFile(tmpOutFile_s, true);
+    // Determine whether to correct only the rows appended to the input file since the output file was last written.
+    bool incremental = pars["incremental"];
 
     // Set reference frame for the given solar system ephemeris.
     std::string solar_eph = pars["solareph"];
@@ -252,10 +1359,6 @@ namespace timeSystem {
     std::string leap_sec_file = pars["leapsecfile"];
     TimeSystem::setDefaultLeapSecFileName(leap_sec_file);
 
-    // Get RA and Dec.
-    double ra = pars["ra"];
-    double dec = pars["dec"];
-
     // Set creator name.
     std::string creator_name(getName() + " " + getVersion());
 
@@ -267,35 +1370,257 @@ namespace timeSystem {
     std::strftime(gm_time_char, sizeof(gm_time_char), "%Y-%m-%dT%H:%M:%S", gm_time_struct);
     std::string date_keyword_value(gm_time_char);
 
-    // Modify the output file so that an appropriate EventTimeHandler object will be created from it.
-    for (tip::FileSummary::size_type ext_index = 0; ext_index < file_summary.size(); ++ext_index) {
-      // Open the extension of the output file.
+    // Get spacecraft file name, spacecraft data extension name, and angular tolerance.
+    std::string orbitFile_s = pars["scfile"];
+    std::string sc_extension = pars["sctable"];
+    double ang_tolerance = pars["angtol"];
+
+    // Serve arrival time corrections requested through the standard input in service mode, instead of correcting files.
+    // Note: The first input file is used only for its header, which determines how METs are interpreted.
+    bool service = pars["service"];
+    if (service) {
+      std::unique_ptr<EventTimeHandler> handler(GlastScTimeHandler::createInstance(in_file_cont[0], "1"));
+      if (0 == handler.get()) throw std::runtime_error("Unsupported event file \"" + in_file_cont[0] + "\" for service mode");
+      // Note: GlastScTimeHandler::createInstance method creates a GlastScTimeHandler object only.
+      CorrectionService correction_service(static_cast<GlastScTimeHandler &>(*handler), orbitFile_s, sc_extension, solar_eph,
+        ang_tolerance, "BARY" == t_correct_uc);
+      long num_request = correction_service.serve(std::cin, std::cout);
+      m_os.info(3) << "Served " << num_request << " request(s) of arrival time corrections" << std::endl;
+      return;
+    }
+
+    // List header keyword names to convert.
+    std::list<std::string> keyword_list;
+    keyword_list.push_back("TSTART");
+    keyword_list.push_back("TSTOP");
+    keyword_list.push_back("DATE-OBS");
+    keyword_list.push_back("DATE-END");
+
+    // List column names to convert.
+    std::list<std::string> column_gti;
+    column_gti.push_back("START");
+    column_gti.push_back("STOP");
+    std::list<std::string> column_other;
+    std::string time_field = pars["timefield"];
+    column_other.push_back(time_field);
+
+    // Get the number of rows to correct at a time, and the number of threads to use.
+    int block_size = pars["blocksize"];
+    int num_thread = pars["nthreads"];
+
+    // Get the number of row blocks to queue between reading, correcting, and writing threads (zero for no pipelining),
+    // which requires a reentrant build of cfitsio.
+    int queue_depth = pars["queuedepth"];
+    if (queue_depth > 0 && !fits_is_reentrant()) {
+      m_os.info(2) << "Reading, correcting, and writing rows one block after another, because cfitsio is not built reentrant" <<
+        std::endl;
+      queue_depth = 0;
+    }
+
+    // Get the number of files to correct concurrently in batch mode, which requires a reentrant build of cfitsio.
+    int num_worker = pars["nworkers"];
+    if (num_worker > 1 && !fits_is_reentrant()) {
+      m_os.info(2) << "Correcting input files one after another, because cfitsio is not built reentrant" << std::endl;
+      num_worker = 1;
+    }
+
+    // Get the tolerance of interpolated time delays for approximate arrival time corrections (zero for exact corrections).
+    double delay_tolerance = pars["delaytol"];
+
+    // Collect the settings common to all the input files.
+    CorrectionSetting setting;
+    setting.m_creator_name = creator_name;
+    setting.m_date_keyword_value = date_keyword_value;
+    setting.m_sc_file_name = orbitFile_s;
+    setting.m_sc_extension_name = sc_extension;
+    setting.m_ang_tolerance = ang_tolerance;
+    setting.m_solar_eph = solar_eph;
+    setting.m_pl_ephem = pl_ephem;
+    setting.m_ref_frame = refFrame;
+    setting.m_t_correct = t_correct;
+    setting.m_t_correct_uc = t_correct_uc;
+    setting.m_target_time_sys = target_time_sys;
+    setting.m_target_time_ref = target_time_ref;
+    setting.m_factory_cont = &factory_cont;
+    setting.m_keyword_list = keyword_list;
+    setting.m_column_gti = column_gti;
+    setting.m_column_other = column_other;
+    setting.m_block_size = block_size;
+    setting.m_num_thread = num_thread;
+    setting.m_queue_depth = queue_depth;
+    setting.m_delay_tolerance = delay_tolerance;
+    setting.m_clobber = clobber;
+    setting.m_streaming = streaming;
+    setting.m_incremental = incremental;
+
+    // Keep the spacecraft file loaded while all the input files are corrected.
+    GlastScTimeHandler::ScFileHolder sc_file_holder(orbitFile_s, sc_extension);
+
+    // Correct the input files one after another, or concurrently in batch mode if requested.
+    std::size_t num_file = in_file_cont.size();
+    if (num_worker <= 1 || num_file <= 1) {
+      for (std::size_t file_index = 0; file_index < num_file; ++file_index) {
+        correctFile(setting, in_file_cont[file_index], target_cont[file_index]);
+      }
+
+    } else {
+      // Let each worker thread take the next input file to correct, until no file is left.
+      std::vector<std::exception_ptr> error_cont(num_file);
+      std::atomic<std::size_t> next_index(0);
+      auto worker = [&]() {
+        for (std::size_t file_index = next_index++; file_index < num_file; file_index = next_index++) {
+          try {
+            correctFile(setting, in_file_cont[file_index], target_cont[file_index]);
+          } catch (...) {
+            error_cont[file_index] = std::current_exception();
+          }
+        }
+      };
+      std::vector<std::thread> thread_cont;
+      for (std::size_t thread_index = 0; thread_index < std::min(static_cast<std::size_t>(num_worker), num_file); ++thread_index) {
+        thread_cont.push_back(std::thread(worker));
+      }
+      for (std::vector<std::thread>::iterator thread_itor = thread_cont.begin(); thread_itor != thread_cont.end(); ++thread_itor) {
+        thread_itor->join();
+      }
+
+      // Report all the files that failed, and re-throw the first error.
+      std::exception_ptr first_error(nullptr);
+      for (std::size_t file_index = 0; file_index < num_file; ++file_index) {
+        if (!error_cont[file_index]) continue;
+        if (!first_error) first_error = error_cont[file_index];
+        try {
+          std::rethrow_exception(error_cont[file_index]);
+        } catch (const std::exception & x) {
+          m_os.err() << "Error occurred while correcting " << in_file_cont[file_index] << ": " << x.what() << std::endl;
+        } catch (...) {
+          m_os.err() << "Unknown error occurred while correcting " << in_file_cont[file_index] << std::endl;
+        }
+      }
+      if (first_error) std::rethrow_exception(first_error);
+    }
+
+    // Report the maximum estimated error of interpolated time delays.
+    if (delay_tolerance > 0.) {
+      m_os.info(2) << "Maximum estimated error of interpolated time delays: " << setting.getMaxDelayError() <<
+        " seconds (tolerance: " << delay_tolerance << " seconds)" << std::endl;
+    }
+
+    // Report performance statistics.
+    if (report_stat) {
       std::ostringstream oss;
-      oss << ext_index;
-      std::string ext_name = oss.str();
-      std::unique_ptr<tip::Extension> output_extension(tip::IFileSvc::instance().editExtension(tmpOutFile_s, ext_name));
+      PerformanceMonitor::report(oss);
+      m_os.info(4) << "Performance statistics:" << std::endl << oss.str();
+    }
+    if (write_stat_file) PerformanceMonitor::writeJson(stat_file);
+
+    // Clean up.
+    for (factory_cont_type::reverse_iterator fact_itor = factory_cont.rbegin(); fact_itor != factory_cont.rend(); ++fact_itor) {
+      delete *fact_itor;
+      *fact_itor = 0;
+    }
+  }
+
+  void TimeCorrectorApp::correctFile(const CorrectionSetting & setting, const std::string & inFile_s,
+    const std::vector<CorrectionTarget> & target_cont) {
+    // Check existence of the input FITS file.
+    if (!tip::IFileSvc::instance().fileExists(inFile_s)) {
+      throw std::runtime_error("File not found: " + inFile_s);
+    }
+
+    // Get file summary of the input FITS file.
+    tip::FileSummary file_summary;
+    tip::IFileSvc::instance().getFileSummary(inFile_s, file_summary);
+
+    // Loop over all extensions of the input file, including primary HDU, to check whether input file is supported or not.
+    // Note: The header keywords that determine the event time handler are read only once per extension, and reused below.
+    // Note: The time columns to correct are also selected here for each extension.
+    std::vector<GlastTimeHandler::HeaderKeyword> input_keyword;
+    input_keyword.reserve(file_summary.size());
+    std::vector<const std::list<std::string> *> column_list_cont;
+    int ext_number = 0;
+    for (tip::FileSummary::const_iterator ext_itor = file_summary.begin(); ext_itor != file_summary.end(); ++ext_itor, ++ext_number) {
+      bool supported = false;
+      try {
+        std::ostringstream oss;
+        oss << ext_number;
+        input_keyword.push_back(GlastTimeHandler::readHeaderKeyword(inFile_s, oss.str()));
+        for (factory_cont_type::const_iterator fact_itor = setting.m_factory_cont->begin();
+          fact_itor != setting.m_factory_cont->end(); ++fact_itor) {
+          if ((*fact_itor)->isSupported(input_keyword.back())) supported = true;
+        }
+      } catch (const tip::TipException &) {
+        supported = false;
+      }
+      if (!supported) {
+        std::ostringstream oss;
+        oss << "Unsupported timing extension: HDU "  << ext_number;
+        if (0 == ext_number) oss << " (primary HDU)";
+        else oss << " (EXTNAME=" << ext_itor->getExtId() << ")";
+        oss << " of input file \"" << inFile_s << "\"";
+        throw std::runtime_error(oss.str());
+      }
+      column_list_cont.push_back("GTI" == ext_itor->getExtId() ? &setting.m_column_gti : &setting.m_column_other);
+    }
+
+    // Check the output files, and create temporary output file names.
+    // Note: In incremental mode, an existing output file may be appended to even if clobber parameter is set to no, but
+    //       not be overwritten. Whether it can be appended to is checked below.
+    bool keeping_out_file = false;
+    std::vector<std::string> tmp_out_file_cont;
+    std::vector<SourcePosition> src_position_cont;
+    for (std::vector<CorrectionTarget>::const_iterator target_itor = target_cont.begin(); target_itor != target_cont.end();
+      ++target_itor) {
+      const std::string & outFile_s = target_itor->m_out_file;
+
+      // Check whether output file name already exists or not, if clobber parameter is set to no.
+      if (!setting.m_clobber) {
+        bool file_readable = false;
+        try {
+          std::ifstream is(outFile_s.c_str());
+          if (is.good()) file_readable = true;
+        } catch (const std::exception &) {}
+        if (file_readable && setting.m_incremental && 1 == target_cont.size()) keeping_out_file = true;
+        else if (file_readable) throw std::runtime_error("File " + outFile_s + " exists, but clobber not set");
+      }
+
+      // Confirm that outfile is writable.
+      bool file_writable = false;
+      try {
+        std::ofstream os(outFile_s.c_str(), std::ios::out | std::ios::app);
+        if (os.good()) file_writable = true;
+      } catch (const std::exception &) {}
+      if (!file_writable)
+        throw std::runtime_error("Cannot open file " + outFile_s + " for writing");
+
+      // Create temporary output file name.
+      tmp_out_file_cont.push_back(tmpFileName(outFile_s));
+      src_position_cont.push_back(SourcePosition(target_itor->m_ra, target_itor->m_dec));
+    }
+    std::vector<CorrectionTarget>::size_type num_target = target_cont.size();
 
+    // Define how to modify a header of the output file so that an appropriate EventTimeHandler object will be created from it.
+    auto update_header = [&](tip::Header & output_header, const CorrectionTarget & target) {
       // Change the header keywords of the output file that determine how to interpret event times.
-      tip::Header & output_header = output_extension->getHeader();
-      output_header["TIMESYS"].set(target_time_sys);
+      output_header["TIMESYS"].set(setting.m_target_time_sys);
       output_header["TIMESYS"].setComment("type of time system that is used");
-      output_header["TIMEREF"].set(target_time_ref);
+      output_header["TIMEREF"].set(setting.m_target_time_ref);
       output_header["TIMEREF"].setComment("reference frame used for times");
 
       // Update header keywords with parameters of arrival time corrections.
-      output_header["RA_NOM"].set(ra);
+      output_header["RA_NOM"].set(target.m_ra);
       output_header["RA_NOM"].setComment("Right Ascension used for arrival time corrections");
-      output_header["DEC_NOM"].set(dec);
+      output_header["DEC_NOM"].set(target.m_dec);
       output_header["DEC_NOM"].setComment("Declination used for arrival time corrections");
-      output_header["RADECSYS"].set(refFrame);
+      output_header["RADECSYS"].set(setting.m_ref_frame);
       output_header["RADECSYS"].setComment("coordinate reference system");
-      output_header["PLEPHEM"].set(pl_ephem);
+      output_header["PLEPHEM"].set(setting.m_pl_ephem);
       output_header["PLEPHEM"].setComment("solar system ephemeris used for arrival time corrections");
       output_header["TIMEZERO"].set(0.);
       output_header["TIMEZERO"].setComment("clock correction");
-      output_header["CREATOR"].set(creator_name);
+      output_header["CREATOR"].set(setting.m_creator_name);
       output_header["CREATOR"].setComment("software and version creating file");
-      output_header["DATE"].set(date_keyword_value);
+      output_header["DATE"].set(setting.m_date_keyword_value);
       output_header["DATE"].setComment("file creation date (YYYY-MM-DDThh:mm:ss UT)");
 
       // Determine TIERRELA value, in the same manner as in axBary.c by Arnold Rots, and set it to the header.
@@ -319,51 +1644,93 @@ namespace timeSystem {
 
       // Update FILENAME header keyword if exists.
       if (output_header.find("FILENAME") != output_header.end()) {
-        std::string basename = outFile_s;
+        std::string basename = target.m_out_file;
         std::string path_delimiter = facilities::commonUtilities::joinPath("", "");
         std::string::size_type end_of_path = basename.find_last_of(path_delimiter);
         if (end_of_path != std::string::npos) basename.erase(0, end_of_path+1);
         output_header["FILENAME"].set(basename);
       }
+    };
+
+    // In incremental mode, find the rows already corrected in the existing output file, so as to correct only the rows
+    // appended to the input file since then.
+    // Note: Incremental corrections are available only for a single output file. All the rows are corrected otherwise,
+    //       or if the output file does not record corrections of the same rows with the same parameters.
+    IncrementalRecord incremental_record(file_summary.size(), setting.m_sc_file_name);
+    bool appending = (setting.m_incremental && 1 == num_target && readIncrementalRecord(inFile_s, target_cont[0].m_out_file,
+      column_list_cont, target_cont[0], setting.m_target_time_sys, setting.m_target_time_ref, setting.m_pl_ephem,
+      setting.m_ang_tolerance, incremental_record));
+    if (keeping_out_file && !appending) {
+      throw std::runtime_error("File " + target_cont[0].m_out_file + " exists, but clobber not set, and its rows cannot be" +
+        " appended to in incremental mode, because it was not written from the same rows with the same parameters");
     }
 
-    // Get spacecraft file name, spacecraft data extension name, and angular tolerance.
-    std::string orbitFile_s = pars["scfile"];
-    std::string sc_extension = pars["sctable"];
-    double ang_tolerance = pars["angtol"];
+    // Copy the input to the temporary output files, and modify the headers of the copies, unless streaming the output.
+    // In incremental mode, copy the existing output file instead, and append the new rows of the input file to the copy.
+    // Note: In streaming mode, each HDU is copied and modified when it is corrected below.
+    // Note: Streaming is available only for a single output file, and not for appending rows.
+    // Note: The header keywords of the output files are taken from the modified headers, so as not to read them again.
+    std::vector<std::vector<GlastTimeHandler::HeaderKeyword> > output_keyword(num_target);
+    std::unique_ptr<StreamCopier> stream_copier(nullptr);
+    if (setting.m_streaming && 1 == num_target && !appending) {
+      stream_copier.reset(new StreamCopier(inFile_s, tmp_out_file_cont[0]));
 
-    // List header keyword names to convert.
-    std::list<std::string> keyword_list;
-    keyword_list.push_back("TSTART");
-    keyword_list.push_back("TSTOP");
-    keyword_list.push_back("DATE-OBS");
-    keyword_list.push_back("DATE-END");
+    } else {
+      for (std::vector<CorrectionTarget>::size_type target_index = 0; target_index < num_target; ++target_index) {
+        // Open the input file, or the existing output file to append rows to, and copy it to the temporary output file.
+        const std::string & tmpOutFile_s = tmp_out_file_cont[target_index];
+        {
+          PerformanceMonitor::StageTimer timer(PerformanceMonitor::FILE_WRITE);
+          tip::TipFile inTipFile = tip::IFileSvc::instance().openFile(appending ? target_cont[target_index].m_out_file : inFile_s);
+          inTipFile.copyFile(tmpOutFile_s, true);
+        }
+        if (appending) {
+          appendRows(inFile_s, tmpOutFile_s, incremental_record.m_num_rows);
+          eraseHistoryBlock(tmpOutFile_s, getName());
+        }
 
-    // List column names to convert.
-    std::list<std::string> column_gti;
-    column_gti.push_back("START");
-    column_gti.push_back("STOP");
-    std::list<std::string> column_other;
-    std::string time_field = pars["timefield"];
-    column_other.push_back(time_field);
+        // Modify the headers of the output file.
+        for (tip::FileSummary::size_type ext_index = 0; ext_index < file_summary.size(); ++ext_index) {
+          std::ostringstream oss;
+          oss << ext_index;
+          std::unique_ptr<tip::Extension> output_extension(tip::IFileSvc::instance().editExtension(tmpOutFile_s, oss.str()));
+          update_header(output_extension->getHeader(), target_cont[target_index]);
+          output_keyword[target_index].push_back(GlastTimeHandler::HeaderKeyword(output_extension->getHeader()));
+        }
+      }
+    }
 
     // Loop over all extensions in input and output files, including primary HDU.
     ext_number = 0;
     for (tip::FileSummary::const_iterator ext_itor = file_summary.begin(); ext_itor != file_summary.end(); ++ext_itor, ++ext_number) {
-      // Open this extension of the input file, and the corresponding extension of the output file.
+      // Copy the header of this extension in streaming mode, and modify it.
+      if (stream_copier.get()) {
+        stream_copier->copyHeader(ext_number);
+        std::ostringstream oss;
+        oss << ext_number;
+        std::unique_ptr<tip::Extension> output_extension(tip::IFileSvc::instance().editExtension(tmp_out_file_cont[0], oss.str()));
+        update_header(output_extension->getHeader(), target_cont[0]);
+        output_keyword[0].push_back(GlastTimeHandler::HeaderKeyword(output_extension->getHeader()));
+      }
+
+      // Open this extension of the input file, and the corresponding extension of the output files.
+      std::vector<GlastTimeHandler::HeaderKeyword> this_output_keyword;
+      for (std::vector<CorrectionTarget>::size_type target_index = 0; target_index < num_target; ++target_index) {
+        this_output_keyword.push_back(output_keyword[target_index][ext_number]);
+      }
       std::unique_ptr<EventTimeHandler> input_handler(nullptr);
-      std::unique_ptr<EventTimeHandler> output_handler(nullptr);
-      for (factory_cont_type::const_iterator fact_itor = factory_cont.begin();
-        fact_itor != factory_cont.end() && (0 == input_handler.get() || (0 == output_handler.get())); ++fact_itor) {
-        std::pair<EventTimeHandler *, EventTimeHandler *> handler_pair = (*fact_itor)->create(inFile_s, tmpOutFile_s, ext_number);
-        input_handler.reset(handler_pair.first);
-        output_handler.reset(handler_pair.second);
+      std::vector<std::unique_ptr<EventTimeHandler> > output_handler_cont;
+      bool created = false;
+      for (factory_cont_type::const_iterator fact_itor = setting.m_factory_cont->begin();
+        fact_itor != setting.m_factory_cont->end() && !created; ++fact_itor) {
+        created = (*fact_itor)->create(inFile_s, input_keyword[ext_number], tmp_out_file_cont, this_output_keyword, ext_number,
+          input_handler, output_handler_cont);
       }
 
       // Check whether both of the input and the output files were successfully opened or not.
-      if (0 == input_handler.get() || 0 == output_handler.get()) {
+      if (!created) {
         std::ostringstream oss;
-        oss << "Arrival time correction \"" << t_correct << "\" not supported for HDU " << ext_number;
+        oss << "Arrival time correction \"" << setting.m_t_correct << "\" not supported for HDU " << ext_number;
         if (0 == ext_number) oss << " (primary HDU)";
         else oss << " (EXTNAME=" << ext_itor->getExtId() << ")";
         oss << " of input file \"" << inFile_s << "\"";
@@ -371,66 +1738,190 @@ namespace timeSystem {
       }
 
       // Write out all the parameters into HISTORY keywords.
-      tip::Header & output_header = output_handler->getHeader();
-      output_header.addHistory("File created or modified by " + creator_name + " on " + date_keyword_value);
-      const st_app::AppParGroup & const_pars(pars);
-      for (hoops::ConstGenParItor par_itor = const_pars.begin(); par_itor != const_pars.end(); ++par_itor) {
-        std::ostringstream oss_par;
-        oss_par << getName() << ".par: " << **par_itor;
-        output_header.addHistory(oss_par.str());
+      const st_app::AppParGroup & const_pars(getParGroup());
+      for (std::vector<CorrectionTarget>::size_type target_index = 0; target_index < num_target; ++target_index) {
+        tip::Header & output_header = output_handler_cont[target_index]->getHeader();
+        output_header.addHistory("File created or modified by " + setting.m_creator_name + " on " + setting.m_date_keyword_value);
+        for (hoops::ConstGenParItor par_itor = const_pars.begin(); par_itor != const_pars.end(); ++par_itor) {
+          std::ostringstream oss_par;
+          oss_par << getName() << ".par: " << **par_itor;
+          output_header.addHistory(oss_par.str());
+        }
+      }
+
+      // Record the number of rows of this extension and their fingerprint in incremental mode, for the next run to start from.
+      // Note: The fingerprint of the rows corrected by the last run is continued with the appended rows.
+      if (setting.m_incremental) {
+        int status = 0;
+        fitsfile * fptr = 0;
+        fits_open_file(&fptr, inFile_s.c_str(), READONLY, &status);
+        FitsFileCloser closer(fptr);
+        fits_movabs_hdu(fptr, ext_number + 1, 0, &status);
+        long num_rows = getNumTableRows(fptr, status);
+        long first_row = incremental_record.m_num_rows[ext_number];
+        std::uint64_t fingerprint = fingerprintRows(fptr, *column_list_cont[ext_number], first_row, num_rows - first_row,
+          incremental_record.m_fingerprint[ext_number], status);
+        if (status) throw tip::TipException(status, "Error occurred while fingerprinting rows of " + inFile_s);
+        for (std::vector<CorrectionTarget>::size_type target_index = 0; target_index < num_target; ++target_index) {
+          tip::Header & output_header = output_handler_cont[target_index]->getHeader();
+          output_header["TCNROWS"].set(num_rows);
+          output_header["TCNROWS"].setComment("number of rows of input file corrected");
+          output_header["TCINSUM"].set(formatFingerprint(fingerprint));
+          output_header["TCINSUM"].setComment("fingerprint of corrected rows of input file");
+        }
       }
 
       // Initialize arrival time corrections.
       // Note: Always require for solar system ephemeris to match between successive arrival time conversions.
       static const bool match_solar_eph = true;
-      input_handler->initTimeCorrection(orbitFile_s, sc_extension, solar_eph, match_solar_eph, ang_tolerance);
-      input_handler->setSourcePosition(SourcePosition(ra, dec));
+      input_handler->initTimeCorrection(setting.m_sc_file_name, setting.m_sc_extension_name, setting.m_solar_eph, match_solar_eph,
+        setting.m_ang_tolerance);
 
       // Apply arrival time correction to header keyword values.
       tip::Header & input_header = input_handler->getHeader();
-      for (std::list<std::string>::const_iterator name_itor = keyword_list.begin(); name_itor != keyword_list.end(); ++name_itor) {
-        const std::string & keyword_name = *name_itor;
-        if (input_header.find(keyword_name) != input_header.end()) {
-          if ("BARY" == t_correct_uc) {
-            output_handler->writeTime(keyword_name, input_handler->getBaryTime(keyword_name, true), true);
-          } else if ("GEO" == t_correct_uc) {
-            output_handler->writeTime(keyword_name, input_handler->getGeoTime(keyword_name, true), true);
-          } else {
-            throw std::runtime_error("Unsupported arrival time correction: " + t_correct);
+      for (std::vector<CorrectionTarget>::size_type target_index = 0; target_index < num_target; ++target_index) {
+        EventTimeHandler & output_handler = *output_handler_cont[target_index];
+        input_handler->setSourcePosition(src_position_cont[target_index]);
+        for (std::list<std::string>::const_iterator name_itor = setting.m_keyword_list.begin();
+          name_itor != setting.m_keyword_list.end(); ++name_itor) {
+          const std::string & keyword_name = *name_itor;
+          if (input_header.find(keyword_name) != input_header.end()) {
+            if ("BARY" == setting.m_t_correct_uc) {
+              output_handler.writeTime(keyword_name, input_handler->getBaryTime(keyword_name, true), true);
+            } else if ("GEO" == setting.m_t_correct_uc) {
+              output_handler.writeTime(keyword_name, input_handler->getGeoTime(keyword_name, true), true);
+            } else {
+              throw std::runtime_error("Unsupported arrival time correction: " + setting.m_t_correct);
+            }
           }
         }
       }
 
       // Select columns to convert.
-      const std::list<std::string> & column_list = ("GTI" == ext_itor->getExtId() ? column_gti : column_other);
-
-      // Loop over all FITS rows.
-      output_handler->setFirstRecord();
-      for (input_handler->setFirstRecord(); !(input_handler->isEndOfTable() || output_handler->isEndOfTable());
-        input_handler->setNextRecord(), output_handler->setNextRecord()) {
-
-        // Apply arrival time correction to the specified columns.
-        for (std::list<std::string>::const_iterator name_itor = column_list.begin(); name_itor != column_list.end(); ++name_itor) {
-          const std::string & column_name = *name_itor;
-          if ("BARY" == t_correct_uc) {
-            output_handler->writeTime(column_name, input_handler->getBaryTime(column_name));
-          } else if ("GEO" == t_correct_uc) {
-            output_handler->writeTime(column_name, input_handler->getGeoTime(column_name));
-          } else {
-            throw std::runtime_error("Unsupported arrival time correction: " + t_correct);
+      const std::list<std::string> & column_list = *column_list_cont[ext_number];
+
+      // Leave the rows of this extension as they are if the input times are already in the frame of the correction, and
+      // the output files measure them in the same time system from the same MJDREF, i.e., the correction is the identity.
+      // Note: The consistency of the source positions and the solar system ephemeris has been checked above.
+      GlastTimeHandler * input_glast_handler = dynamic_cast<GlastTimeHandler *>(input_handler.get());
+      bool identity = (0 != input_glast_handler && 0 == dynamic_cast<GlastScTimeHandler *>(input_handler.get()));
+      for (std::vector<CorrectionTarget>::size_type target_index = 0; identity && target_index < num_target; ++target_index) {
+        GlastTimeHandler * output_glast_handler = dynamic_cast<GlastTimeHandler *>(output_handler_cont[target_index].get());
+        identity = (0 != output_glast_handler && &output_glast_handler->getTimeSystem() == &input_glast_handler->getTimeSystem()
+          && output_glast_handler->hasSameMjdRef(*input_glast_handler));
+      }
+      if (identity) {
+        if (stream_copier.get()) stream_copier->copyData();
+        continue;
+      }
+
+      // Correct arrival times block by block if requested, and if all of the handlers support column-wise access.
+      GlastScTimeHandler * input_block_handler = dynamic_cast<GlastScTimeHandler *>(input_handler.get());
+      std::vector<GlastTimeHandler *> output_block_handler_cont;
+      bool block_wise = (setting.m_block_size > 0 && 0 != input_block_handler);
+      input_handler->setFirstRecord();
+      bool end_of_table = input_handler->isEndOfTable();
+      for (std::vector<CorrectionTarget>::size_type target_index = 0; target_index < num_target; ++target_index) {
+        EventTimeHandler * output_handler = output_handler_cont[target_index].get();
+        output_block_handler_cont.push_back(dynamic_cast<GlastTimeHandler *>(output_handler));
+        if (0 == output_block_handler_cont.back()) block_wise = false;
+        output_handler->setFirstRecord();
+        if (output_handler->isEndOfTable()) end_of_table = true;
+      }
+      if (block_wise) input_block_handler->setDelayTolerance(setting.m_delay_tolerance);
+      if (stream_copier.get() && block_wise && stream_copier->canCopyTable(column_list)) {
+        // Copy the rows of this extension, correcting arrival times on the way.
+        BlockCorrector corrector(*input_block_handler, output_block_handler_cont, src_position_cont, "BARY" == setting.m_t_correct_uc,
+          setting.m_num_thread);
+        stream_copier->copyTable(column_list, corrector, setting.m_block_size, setting.m_queue_depth);
+        setting.recordDelayError(*input_block_handler);
+        continue;
+      }
+
+      // Copy the data of this extension as is in streaming mode, to correct arrival times in the output file below.
+      if (stream_copier.get()) stream_copier->copyData();
+      if (block_wise) {
+        // Compute the number of rows to process, leaving it zero for extensions without a table.
+        tip::Index_t num_rows = 0;
+        if (!end_of_table) {
+          num_rows = input_handler->getTable().getNumRecords();
+          for (std::vector<CorrectionTarget>::size_type target_index = 0; target_index < num_target; ++target_index) {
+            num_rows = std::min(num_rows, output_handler_cont[target_index]->getTable().getNumRecords());
+          }
+        }
+
+        // Loop over blocks of FITS rows, skipping the rows already corrected in incremental mode.
+        BlockCorrector corrector(*input_block_handler, output_block_handler_cont, src_position_cont, "BARY" == setting.m_t_correct_uc,
+          setting.m_num_thread);
+        std::vector<double> glast_time;
+        std::vector<std::vector<double> > corrected_time;
+        for (tip::Index_t first_row = incremental_record.m_num_rows[ext_number]; first_row < num_rows;
+          first_row += setting.m_block_size) {
+          tip::Index_t num_block_rows = std::min(static_cast<tip::Index_t>(setting.m_block_size), num_rows - first_row);
+          PerformanceMonitor::addCount(PerformanceMonitor::ROW_PROCESSED, num_block_rows);
+
+          // Apply arrival time correction to the specified columns, for all the sources at a time.
+          for (std::list<std::string>::const_iterator name_itor = column_list.begin(); name_itor != column_list.end(); ++name_itor) {
+            const std::string & column_name = *name_itor;
+            input_block_handler->readGlastTimeColumn(column_name, first_row, num_block_rows, glast_time);
+            corrector.correct(glast_time, corrected_time);
+            for (std::vector<CorrectionTarget>::size_type target_index = 0; target_index < num_target; ++target_index) {
+              output_block_handler_cont[target_index]->writeGlastTimeColumn(column_name, first_row, corrected_time[target_index]);
+            }
+          }
+        }
+        setting.recordDelayError(*input_block_handler);
+
+      } else {
+        // Skip the rows already corrected in incremental mode.
+        for (long row_index = 0; row_index < incremental_record.m_num_rows[ext_number] && !end_of_table; ++row_index) {
+          input_handler->setNextRecord();
+          end_of_table = input_handler->isEndOfTable();
+          for (std::vector<CorrectionTarget>::size_type target_index = 0; target_index < num_target; ++target_index) {
+            output_handler_cont[target_index]->setNextRecord();
+            if (output_handler_cont[target_index]->isEndOfTable()) end_of_table = true;
+          }
+        }
+
+        // Loop over all FITS rows.
+        while (!end_of_table) {
+          PerformanceMonitor::addCount(PerformanceMonitor::ROW_PROCESSED, 1);
+
+          // Apply arrival time correction to the specified columns.
+          for (std::vector<CorrectionTarget>::size_type target_index = 0; target_index < num_target; ++target_index) {
+            EventTimeHandler & output_handler = *output_handler_cont[target_index];
+            if (num_target > 1) input_handler->setSourcePosition(src_position_cont[target_index]);
+            for (std::list<std::string>::const_iterator name_itor = column_list.begin(); name_itor != column_list.end(); ++name_itor) {
+              const std::string & column_name = *name_itor;
+              if ("BARY" == setting.m_t_correct_uc) {
+                output_handler.writeTime(column_name, input_handler->getBaryTime(column_name));
+              } else if ("GEO" == setting.m_t_correct_uc) {
+                output_handler.writeTime(column_name, input_handler->getGeoTime(column_name));
+              } else {
+                throw std::runtime_error("Unsupported arrival time correction: " + setting.m_t_correct);
+              }
+            }
+          }
+
+          // Move on to the next rows.
+          input_handler->setNextRecord();
+          end_of_table = input_handler->isEndOfTable();
+          for (std::vector<CorrectionTarget>::size_type target_index = 0; target_index < num_target; ++target_index) {
+            output_handler_cont[target_index]->setNextRecord();
+            if (output_handler_cont[target_index]->isEndOfTable()) end_of_table = true;
           }
         }
       }
     }
 
-    // Move the temporary output file to the real output file.
-    std::remove(outFile_s.c_str());
-    std::rename(tmpOutFile_s.c_str(), outFile_s.c_str());
+    // Close the files in streaming mode before moving the output file.
+    stream_copier.reset(nullptr);
 
-    // Clean up.
-    for (factory_cont_type::reverse_iterator fact_itor = factory_cont.rbegin(); fact_itor != factory_cont.rend(); ++fact_itor) {
-      delete *fact_itor;
-      *fact_itor = 0;
+    // Move the temporary output files to the real output files.
+    for (std::vector<CorrectionTarget>::size_type target_index = 0; target_index < num_target; ++target_index) {
+      const std::string & outFile_s = target_cont[target_index].m_out_file;
+      std::remove(outFile_s.c_str());
+      std::rename(tmp_out_file_cont[target_index].c_str(), outFile_s.c_str());
     }
   }
 
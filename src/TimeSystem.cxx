@@ -3,10 +3,9 @@
     \authors Masaharu Hirayama, GSSC
              James Peachey, HEASARC/GSSC
 */
-#include "st_facilities/Env.h"
-
 #include "timeSystem/Duration.h"
 #include "timeSystem/MjdFormat.h"
+#include "timeSystem/PerformanceMonitor.h"
 #include "timeSystem/TimeConstant.h"
 #include "timeSystem/TimeFormat.h"
 #include "timeSystem/TimeSystem.h"
@@ -19,75 +18,104 @@ extern "C" {
 double ctatv (long, double) ;
 }
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
+#include <vector>
+
+#include <sys/stat.h>
 
 using namespace timeSystem;
 
 std::string timeSystem::TimeSystem::s_default_leap_sec_file;
+std::string timeSystem::TimeSystem::s_leap_sec_cache_file;
 
 namespace {
 
-  /** \class TaiSystem
-      \brief Class that represents TAI time system.
+  /// \brief Codes of time systems implemented in this file, to be used as indices of the conversion dispatch table.
+  enum SystemCode { TAI_CODE, TDB_CODE, TT_CODE, UTC_CODE, NUM_SYSTEM_CODE };
+
+  /** \class BuiltinSystem
+      \brief Base class of time systems implemented in this file. Conversions between them are dispatched through a table of
+             direct conversion functions, indexed by system codes, so that no time system names are compared or looked up.
   */
-  class TaiSystem : public TimeSystem {
+  class BuiltinSystem : public TimeSystem {
     public:
-      /// \brief Construct a TaiSystem object.
-      TaiSystem(): TimeSystem("TAI") {}
-
       /** \brief Convert a time moment expressed in a different time system to the one in this time system, and return it.
           \param time_system Time system to conver a time moment from.
           \param moment Time moment to convert.
       */
       virtual moment_type convertFrom(const TimeSystem & time_system, const moment_type & moment) const;
+
+      /** \brief Convert time moments expressed in a different time system to the ones in this time system, and set them to
+                 a caller-provided array.
+          \param time_system Time system to conver time moments from.
+          \param moment Array of time moments to convert.
+          \param num_moment Number of time moments to convert.
+          \param result Array of at least num_moment time moments, to which the converted ones are set.
+      */
+      virtual void convertArrayFrom(const TimeSystem & time_system, const moment_type * moment, std::size_t num_moment,
+        moment_type * result) const;
+
+      /** \brief Return a time system implemented in this file.
+          \param system_code Code of the time system to return.
+      */
+      static const TimeSystem & getBuiltinSystem(SystemCode system_code);
+
+    protected:
+      /** \brief Construct a BuiltinSystem object.
+          \param system_name Name of the time system to construct.
+          \param system_code Code of the time system to construct.
+      */
+      BuiltinSystem(const std::string & system_name, SystemCode system_code);
+
+    private:
+      SystemCode m_system_code;
+      static const BuiltinSystem * s_builtin_system[NUM_SYSTEM_CODE];
+  };
+
+  /** \class TaiSystem
+      \brief Class that represents TAI time system.
+  */
+  class TaiSystem : public BuiltinSystem {
+    public:
+      /// \brief Construct a TaiSystem object.
+      TaiSystem(): BuiltinSystem("TAI", TAI_CODE) {}
   };
 
   /** \class TaiSystem
       \brief Class that represents TDB time system.
   */
-  class TdbSystem : public TimeSystem {
+  class TdbSystem : public BuiltinSystem {
     public:
       /// \brief Construct a TdbSystem object.
-      TdbSystem(): TimeSystem("TDB") {}
-
-      /** \brief Convert a time moment expressed in a different time system to the one in this time system, and return it.
-          \param time_system Time system to conver a time moment from.
-          \param moment Time moment to convert.
-      */
-      virtual moment_type convertFrom(const TimeSystem & time_system, const moment_type & moment) const;
+      TdbSystem(): BuiltinSystem("TDB", TDB_CODE) {}
   };
 
   /** \class TaiSystem
       \brief Class that represents TT time system.
   */
-  class TtSystem : public TimeSystem {
+  class TtSystem : public BuiltinSystem {
     public:
       /// \brief Construct a TtSystem object.
-      TtSystem(): TimeSystem("TT") {}
-
-      /** \brief Convert a time moment expressed in a different time system to the one in this time system, and return it.
-          \param time_system Time system to conver a time moment from.
-          \param moment Time moment to convert.
-      */
-      virtual moment_type convertFrom(const TimeSystem & time_system, const moment_type & moment) const;
+      TtSystem(): BuiltinSystem("TT", TT_CODE) {}
   };
 
   /** \class TaiSystem
       \brief Class that represents UTC time system.
   */
-  class UtcSystem : public TimeSystem {
+  class UtcSystem : public BuiltinSystem {
     public:
       /// \brief Construct a UtcSystem object.
-      UtcSystem(): TimeSystem("UTC") {}
-
-      /** \brief Convert a time moment expressed in a different time system to the one in this time system, and return it.
-          \param time_system Time system to conver a time moment from.
-          \param moment Time moment to convert.
-      */
-      virtual moment_type convertFrom(const TimeSystem & time_system, const moment_type & moment) const;
+      UtcSystem(): BuiltinSystem("UTC", UTC_CODE) {}
 
       /** \brief Compute time difference between two moments of time, and return it.
           \param moment1 Time moment from which the other time moment is to be subtracted.
@@ -95,6 +123,12 @@ namespace {
       */
       virtual Duration computeTimeDifference(const moment_type & moment1, const moment_type & moment2) const;
 
+      /** \brief Compute time difference between two moments of time in seconds, and return it.
+          \param moment1 Time moment from which the other time moment is to be subtracted.
+          \param moment2 Time moment which is subtracted from the other time moment.
+      */
+      virtual double computeTimeDifferenceInSec(const moment_type & moment1, const moment_type & moment2) const;
+
       /** \brief Compute date and time of a given time moment, and return it.
           \param moment Time moment to compute date and time for.
       */
@@ -111,187 +145,532 @@ namespace {
       void checkMoment(const moment_type & moment) const;
   };
 
+  /** \class BuiltinLeapSec
+      \brief Entry of the leap second table built into this library, in the same form as a row of a leap-second file.
+  */
+  struct BuiltinLeapSec {
+    long m_mjd;      ///< MJD number (in UTC system) at the beginning of which leap seconds are inserted or removed.
+    long m_leap_sec; ///< Number of leap seconds inserted (positive) or removed (negative).
+  };
+
+  // Leap second table built into this library, which is used unless a leap-second file is given.
+  // Note: This table is up to date with the IERS Bulletin C, which announced the leap second inserted at the end of 2016
+  //       as the last one as of this writing.
+  constexpr BuiltinLeapSec s_builtin_leap_sec[] = {
+    { 41317, 0 }, { 41499, 1 }, { 41683, 1 }, { 42048, 1 }, { 42413, 1 }, { 42778, 1 }, { 43144, 1 }, { 43509, 1 },
+    { 43874, 1 }, { 44239, 1 }, { 44786, 1 }, { 45151, 1 }, { 45516, 1 }, { 46247, 1 }, { 47161, 1 }, { 47892, 1 },
+    { 48257, 1 }, { 48804, 1 }, { 49169, 1 }, { 49534, 1 }, { 50083, 1 }, { 50630, 1 }, { 51179, 1 }, { 53736, 1 },
+    { 54832, 1 }, { 56109, 1 }, { 57204, 1 }, { 57754, 1 }
+  };
+
+  // Name of the leap second table built into this library, to be shown in messages.
+  const char * const s_builtin_leap_sec_name = "built-in leap second data";
+
+  // Signature, byte order mark, and the maximum number of entries of a snapshot file of a leap second table.
+  // Note: A snapshot file is only meant to be read on the host that wrote it, and is ignored if its byte order differs.
+  const char s_snapshot_magic[8] = { 'T', 'S', 'L', 'E', 'A', 'P', '0', '1' };
+  const long long s_snapshot_byte_order = 0x0102030405060708LL;
+  const long long s_snapshot_max_entry = 100000;
+
   /** \class LeapSecTable
-      \brief Class that represents a leap second table.
+      \brief Class that represents a leap second table. A loaded table is never modified. Loading new leap second data
+             creates a new table and replaces the one in use at once, so that the table can be looked up without locks.
   */
   class LeapSecTable {
     public:
-      /// \brief Return a leap second table.
-      static LeapSecTable & getTable();
-
-      /// \brief Return the file name from which this leap second data is loaded.
-      std::string getFileName() const;
+      /** \brief Return the leap second table in use. The returned table remains valid after a new table is loaded, so that
+                 conversions already in progress keep using the same table until they complete.
+      */
+      static const LeapSecTable & getTable();
 
-      /** \brief Load leap second data from a given FITS file.
-          \param leap_sec_file_name Name of a leap-second file in the FITS format.
+      /** \brief Load leap second data from a given FITS file, or those built into this library, and replace the leap second
+                 table in use with a new one.
+          \param leap_sec_file_name Name of a leap-second file in the FITS format. If empty, the leap second data built
+                 into this library are loaded.
           \param force_load Set to true to load new leap-second data even if already loaded.
                             Set to false not to load them in case leap-second data have already been loaded.
+          \param cache_file_name Name of a snapshot file of leap second data read from leap_sec_file_name. The snapshot is
+                 read instead of leap_sec_file_name if it is up to date, and is written otherwise. If empty, no snapshot
+                 is read or written.
       */
-      void load(const std::string & leap_sec_file_name, bool force_load);
+      static void load(const std::string & leap_sec_file_name, bool force_load, const std::string & cache_file_name);
+
+      /// \brief Return the file name from which this leap second data is loaded.
+      std::string getFileName() const;
+
+      /// \brief Return a logical true if this table has no entries, and a logical false otherwise.
+      bool empty() const { return m_mjd_table.empty(); }
 
       /** \brief Return the sum of all leap seconds that are inserted or removed before the beginning of a given MJD.
           \param mjd MJD number upto when leap seconds are summed up.
       */
       long getCumulativeLeapSec(long mjd) const;
 
+      /** \brief Return the sum of all leap seconds that are inserted or removed before the beginning of a given MJD,
+                 and set the range of MJD numbers for which the same sum is returned.
+          \param mjd MJD number upto when leap seconds are summed up.
+          \param first_mjd The first MJD number of the range.
+          \param end_mjd The MJD number right after the last one of the range.
+      */
+      long getCumulativeLeapSec(long mjd, long & first_mjd, long & end_mjd) const;
+
       /// \brief Return the earliest MJD that the loaded leap-second table covers.
       long getEarliestMjd() const;
 
     private:
-      typedef std::map<long, long> table_type;
-      // A value of this map is the cumulative number of leap seconds since the introduction of leap seconds
-      // at the beginning of the date whose MJD in UTC is given by the key of the std::map object.
-      table_type m_table;
+      typedef std::vector<long> table_type;
+      // An element of m_leap_sec_table is the cumulative number of leap seconds since the introduction of leap seconds
+      // at the beginning of the date whose MJD in UTC is given by the element of m_mjd_table at the same index.
+      // Note: Elements of m_mjd_table are sorted in ascending order without duplicates.
+      table_type m_mjd_table;
+      table_type m_leap_sec_table;
+
+      // Index of the entry found by the last look-up, to be checked first in the next look-up.
+      // Note: This is atomic so that threads can update it concurrently. Any value is safe to use, because it is only a hint.
+      mutable std::atomic<table_type::size_type> m_last_index;
 
       std::string m_file_name;
 
+      // Table in use, or null if none has been loaded.
+      static std::atomic<const LeapSecTable *> s_current_table;
+
       /// \brief Construct a LeapSecTable object.
-      LeapSecTable() {}
-  };
+      LeapSecTable(): m_mjd_table(), m_leap_sec_table(), m_last_index(0), m_file_name() {}
 
-  /// \brief Return the time difference between TT and TAI.
-  Duration computeTtMinusTai() {
-    static const Duration s_tt_minus_tai(32.184, "Sec");
-    return s_tt_minus_tai;
-  }
+      /** \brief Read leap second data from a given FITS file into this table.
+          \param leap_sec_file_name Name of a leap-second file in the FITS format.
+      */
+      void read(const std::string & leap_sec_file_name);
 
-  moment_type TaiSystem::convertFrom(const TimeSystem & time_system, const moment_type & moment) const {
-    if (&time_system != this) {
-      if ("TDB" == time_system.getName()) {
-        const TimeSystem & tt(getSystem("TT"));
-        return convertFrom(tt, tt.convertFrom(time_system, moment));
+      /// \brief Read leap second data built into this library into this table.
+      void readBuiltin();
 
-      } else if ("TT" == time_system.getName()) {
-        return moment_type(moment.first, moment.second - computeTtMinusTai());
+      /** \brief Read a snapshot of leap second data into this table, if it was written for the current contents of a given
+                 leap-second file. Return true if it was read, and false otherwise, in which case this table is left empty.
+          \param cache_file_name Name of the snapshot file.
+          \param leap_sec_file_name Name of the leap-second file from which the snapshot was written.
+      */
+      bool readSnapshot(const std::string & cache_file_name, const std::string & leap_sec_file_name);
 
-      } else if ("UTC" == time_system.getName()) {
-        // Check whether the given moment is valid in the current UTC system.
-        time_system.checkMoment(moment);
+      /** \brief Write a snapshot of this table, which was read from a given leap-second file. Errors are ignored, in which
+                 case leap second data are read from the leap-second file next time.
+          \param cache_file_name Name of the snapshot file.
+          \param leap_sec_file_name Name of the leap-second file from which this table was read.
+      */
+      void writeSnapshot(const std::string & cache_file_name, const std::string & leap_sec_file_name) const;
 
-        // Compute TAI - UTC in seconds.
-        // Note: The given moment must be interpreted as is, so that the leap-second table is properly looked up.
-        const LeapSecTable & leap_sec_table(LeapSecTable::getTable());
-        long tai_minus_utc = 10 + leap_sec_table.getCumulativeLeapSec(moment.first);
+      /** \brief Store given entries in this table.
+          \param sorted_table Cumulative numbers of leap seconds at the beginning of dates, indexed by MJD numbers of the dates.
+      */
+      void store(const std::map<long, long> & sorted_table);
 
-        // Add the TAI - UTC to the given moment in TAI system.
-        return moment_type(moment.first, moment.second + Duration(tai_minus_utc, "Sec"));
+      /** \brief Return the index of the entry of the leap second table that applies to a given MJD.
+          \param mjd MJD number to find the entry for.
+      */
+      table_type::size_type findEntry(long mjd) const;
+  };
 
-      } else {
-        throw std::logic_error("Conversion from " + time_system.getName() + " to " + getName() + " is not implemented");
+  /** \class LeapSecCache
+      \brief Class to look up the leap second table only when a given MJD is out of the leap-second epoch looked up last,
+             so that the table is looked up once per leap-second epoch for conversions of many time moments in a row.
+  */
+  class LeapSecCache {
+    public:
+      /** \brief Construct a LeapSecCache object.
+          \param leap_sec_table Leap second table to look up.
+      */
+      explicit LeapSecCache(const LeapSecTable & leap_sec_table): m_table(leap_sec_table), m_first_mjd(0), m_end_mjd(0),
+        m_leap_sec(0) {}
+
+      /** \brief Return the sum of all leap seconds that are inserted or removed before the beginning of a given MJD.
+          \param mjd MJD number upto when leap seconds are summed up.
+      */
+      long getCumulativeLeapSec(long mjd) {
+        if (mjd < m_first_mjd || mjd >= m_end_mjd) {
+          m_leap_sec = m_table.getCumulativeLeapSec(mjd, m_first_mjd, m_end_mjd);
+        }
+        return m_leap_sec;
       }
-    }
-    return moment;
+
+    private:
+      const LeapSecTable & m_table;
+      long m_first_mjd;
+      long m_end_mjd;
+      long m_leap_sec;
+  };
+
+  /** \class TdbMinusTtTable
+      \brief Class that represents a table of Chebyshev polynomials that approximate the time difference, TDB - TT,
+             as a function of time in TT system.
+  */
+  class TdbMinusTtTable {
+    public:
+      /// \brief Return a table of the time difference.
+      static TdbMinusTtTable & getTable();
+
+      /** \brief Compute Chebyshev polynomials for a given span of time.
+          \param first_mjd The first MJD number (in TT system) of the span.
+          \param last_mjd The last MJD number (in TT system) of the span.
+      */
+      void build(long first_mjd, long last_mjd);
+
+      /// \brief Discard all the Chebyshev polynomials computed so far.
+      void clear();
+
+      /** \brief Compute TDB - TT in seconds at a given date and time, if covered by this table.
+                 Return true if the given date and time is covered, and false otherwise.
+          \param datetime Date and time in TT system at which the time difference is computed.
+          \param tdb_minus_tt Computed time difference in seconds.
+      */
+      bool compute(const datetime_type & datetime, double & tdb_minus_tt) const;
+
+    private:
+      std::vector<double> m_coeff;
+      long m_first_mjd;
+      long m_num_segment;
+
+      /// \brief Construct a TdbMinusTtTable object.
+      TdbMinusTtTable(): m_coeff(), m_first_mjd(0), m_num_segment(0) {}
+
+      /** \brief Compute TDB - TT in seconds from Chebyshev polynomials of a given segment.
+          \param segment_index Index of the segment.
+          \param x Normalized time in the segment (-1 <= x <= 1).
+      */
+      double evaluate(long segment_index, double x) const;
+  };
+
+  // Length of a segment in days, and the number of Chebyshev coefficients per segment.
+  // Note: The shortest period in the series expansion computed by ctatv C-function is approximately 14 days, with which
+  //       polynomials of 8th degree over 4 days approximate the series to better than 1 picosecond.
+  const long s_tdb_segment_day = 4;
+  const long s_tdb_num_coeff = 9;
+
+  /// \brief Return the time difference between TT and TAI.
+  Duration computeTtMinusTai() {
+    static const Duration s_tt_minus_tai(Duration::from<Sec>(32.184));
+    return s_tt_minus_tai;
   }
 
   // Note: Keep computeTdbMinusTt method global, so that TdbSystem and TtSystem can call it.
   Duration computeTdbMinusTt(const datetime_type & datetime) {
+    // Use the precomputed table if it covers the given time.
+    double tdb_minus_tt = 0.;
+    if (TdbMinusTtTable::getTable().compute(datetime, tdb_minus_tt)) return Duration::from<Sec>(tdb_minus_tt);
+
     // Convert the time to JD number.
     const TimeFormat<Jd> & jd_format(TimeFormatFactory<Jd>::getFormat());
     Jd jd_rep = jd_format.convert(datetime);
 
     // Compute the difference and return it.
-    return Duration(ctatv(jd_rep.m_int, jd_rep.m_frac), "Sec");
+    return Duration::from<Sec>(ctatv(jd_rep.m_int, jd_rep.m_frac));
   }
 
-  moment_type TdbSystem::convertFrom(const TimeSystem & time_system, const moment_type & moment) const {
-    if (&time_system != this) {
-      if ("TAI" == time_system.getName() || "UTC" == time_system.getName()) {
-        const TimeSystem & tt(getSystem("TT"));
-        return convertFrom(tt, tt.convertFrom(time_system, moment));
+  /// \brief Type of a function to convert a time moment directly from one time system to another.
+  typedef moment_type (*conversion_type)(const moment_type & moment);
 
-      } else if ("TT" == time_system.getName()) {
-        datetime_type tt_datetime = time_system.computeDateTime(moment);
-        return moment_type(moment.first, moment.second + computeTdbMinusTt(tt_datetime));
+  /// \brief Return a given moment as is, for conversions within the same time system.
+  moment_type convertIdentity(const moment_type & moment) {
+    return moment;
+  }
+
+  /// \brief Convert a given moment from TT to TAI.
+  moment_type convertTtToTai(const moment_type & moment) {
+    return moment_type(moment.first, moment.second - computeTtMinusTai());
+  }
+
+  /// \brief Convert a given moment from TAI to TT.
+  moment_type convertTaiToTt(const moment_type & moment) {
+    return moment_type(moment.first, moment.second + computeTtMinusTai());
+  }
+
+  /// \brief Convert a given moment from TT to TDB.
+  moment_type convertTtToTdb(const moment_type & moment) {
+    datetime_type tt_datetime = BuiltinSystem::getBuiltinSystem(TT_CODE).computeDateTime(moment);
+    return moment_type(moment.first, moment.second + computeTdbMinusTt(tt_datetime));
+  }
+
+  /// \brief Convert a given moment from TDB to TT.
+  moment_type convertTdbToTt(const moment_type & moment) {
+    const TimeSystem & tt(BuiltinSystem::getBuiltinSystem(TT_CODE));
+
+    // Compute TT directly if the precomputed table covers the given moment.
+    // Note: The slope of TDB - TT is less than 1.e-9, so that TDB - TT at the TDB moment is only a few nanoseconds away
+    //       from that at the TT moment, and TDB - TT at the TT moment computed from it is exact to the picosecond level.
+    const TdbMinusTtTable & tdb_table(TdbMinusTtTable::getTable());
+    double tdb_minus_tt = 0.;
+    if (tdb_table.compute(tt.computeDateTime(moment), tdb_minus_tt)) {
+      moment_type tt_moment(moment.first, moment.second - Duration::from<Sec>(tdb_minus_tt));
+      if (tdb_table.compute(tt.computeDateTime(tt_moment), tdb_minus_tt)) {
+        return moment_type(moment.first, moment.second - Duration::from<Sec>(tdb_minus_tt));
+      }
+    }
+
+    // Prepare for time conversion from TDB to TT.
+    const int max_iteration = 100;
+    const Duration epsilon(Duration::from<Sec>(100.e-9)); // 100 ns, to match Arnold Rots's function ctatv().
+
+    // Use the input moment as the 1st approximation of MJD time in TT system.
+    moment_type tt_moment(moment);
+
+    // Refine the output moment (tt_moment) iteratively.
+    moment_type tdb_moment(moment);
+    for (int ii=0; ii<max_iteration; ii++) {
+      // Compute (TDB - TT) at the candidate TT moment.
+      datetime_type tt_datetime = tt.computeDateTime(tt_moment);
+      Duration tdb_minus_tt = computeTdbMinusTt(tt_datetime);
+
+      // Compute TDB moment for the candidate TT moment.
+      tdb_moment.second = tt_moment.second + tdb_minus_tt;
+
+      // Check if the TDB moment is close enough for the input moment.
+      if (tdb_moment.second.equivalentTo(moment.second, epsilon)) {
+        // Return the TT moment.
+        PerformanceMonitor::addCount(PerformanceMonitor::TDB_TO_TT_ITERATION, ii + 1);
+        return tt_moment;
 
       } else {
-        throw std::logic_error("Conversion from " + time_system.getName() + " to " + getName() + " is not implemented");
+        // Compute the next candidate.
+        tt_moment.second = moment.second - tdb_minus_tt;
       }
     }
-    return moment;
+
+    // Conversion from TDB to TT not converged (error).
+    throw std::runtime_error("Conversion from TDB to TT did not converge");
+  }
+
+  /// \brief Convert a given moment from UTC to TAI.
+  moment_type convertUtcToTai(const moment_type & moment) {
+    // Check whether the given moment is valid in the current UTC system.
+    BuiltinSystem::getBuiltinSystem(UTC_CODE).checkMoment(moment);
+
+    // Compute TAI - UTC in seconds.
+    // Note: The given moment must be interpreted as is, so that the leap-second table is properly looked up.
+    const LeapSecTable & leap_sec_table(LeapSecTable::getTable());
+    long tai_minus_utc = 10 + leap_sec_table.getCumulativeLeapSec(moment.first);
+
+    // Add the TAI - UTC to the given moment in TAI system.
+    return moment_type(moment.first, moment.second + Duration::from<Sec>(tai_minus_utc));
+  }
+
+  /// \brief Convert a given moment from TAI to UTC.
+  moment_type convertTaiToUtc(const moment_type & moment) {
+    // Get the leap-second table and the oldest MJD in the table.
+    const LeapSecTable & leap_sec_table(LeapSecTable::getTable());
+    long earliest_mjd = leap_sec_table.getEarliestMjd();
+
+    // Adjust the origin of the given moment, so that it can be used as the origin of a UTC moment.
+    moment_type result_moment(moment);
+    if (result_moment.first < earliest_mjd) {
+      // Adjust the origin of the given monent, such that it comes after the first entry of the leap-second table.
+      result_moment.first = earliest_mjd;
+      result_moment.second = BuiltinSystem::getBuiltinSystem(TAI_CODE).computeTimeDifference(moment,
+        moment_type(earliest_mjd, Duration::zero()));
+    }
+
+    // Compute UTC - TAI in seconds, and add it to the given moment in UTC system.
+    long utc_minus_tai = -10 - leap_sec_table.getCumulativeLeapSec(result_moment.first);
+    result_moment.second += Duration::from<Sec>(utc_minus_tai);
+
+    // Check whether the resultant moment is valid in the current UTC system.
+    BuiltinSystem::getBuiltinSystem(UTC_CODE).checkMoment(result_moment);
+
+    // Return the moment.
+    return result_moment;
   }
 
-  moment_type TtSystem::convertFrom(const TimeSystem & time_system, const moment_type & moment) const {
-    if (&time_system != this) {
-      if ("TAI" == time_system.getName()) {
-        return moment_type(moment.first, moment.second + computeTtMinusTai());
+  /// \brief Convert a given moment from TDB to TAI.
+  moment_type convertTdbToTai(const moment_type & moment) {
+    return convertTtToTai(convertTdbToTt(moment));
+  }
 
-      } else if ("TDB" == time_system.getName()) {
-        // Prepare for time conversion from TDB to TT.
-        const int max_iteration = 100;
-        const Duration epsilon(100.e-9, "Sec"); // 100 ns, to match Arnold Rots's function ctatv().
+  /// \brief Convert a given moment from TAI to TDB.
+  moment_type convertTaiToTdb(const moment_type & moment) {
+    return convertTtToTdb(convertTaiToTt(moment));
+  }
 
-        // Use the input moment as the 1st approximation of MJD time in TT system.
-        moment_type tt_moment(moment);
+  /// \brief Convert a given moment from UTC to TDB.
+  moment_type convertUtcToTdb(const moment_type & moment) {
+    return convertTtToTdb(convertTaiToTt(convertUtcToTai(moment)));
+  }
 
-        // Refine the output moment (tt_moment) iteratively.
-        moment_type tdb_moment(moment);
-        for (int ii=0; ii<max_iteration; ii++) {
-          // Compute (TDB - TT) at the candidate TT moment.
-          datetime_type tt_datetime = computeDateTime(tt_moment);
-          Duration tdb_minus_tt = computeTdbMinusTt(tt_datetime);
+  /// \brief Convert a given moment from TDB to UTC.
+  moment_type convertTdbToUtc(const moment_type & moment) {
+    return convertTaiToUtc(convertTtToTai(convertTdbToTt(moment)));
+  }
 
-          // Compute TDB moment for the candidate TT moment.
-          tdb_moment.second = tt_moment.second + tdb_minus_tt;
+  /// \brief Convert a given moment from UTC to TT.
+  moment_type convertUtcToTt(const moment_type & moment) {
+    return convertTaiToTt(convertUtcToTai(moment));
+  }
 
-          // Check if the TDB moment is close enough for the input moment.
-          if (tdb_moment.second.equivalentTo(moment.second, epsilon)) {
-            // Return the TT moment.
-            return tt_moment;
+  /// \brief Convert a given moment from TT to UTC.
+  moment_type convertTtToUtc(const moment_type & moment) {
+    return convertTaiToUtc(convertTtToTai(moment));
+  }
 
-          } else {
-            // Compute the next candidate.
-            tt_moment.second = moment.second - tdb_minus_tt;
-          }
-        }
+  // Dispatch table of conversion functions, indexed by the codes of the destination and the source time systems in this order.
+  const conversion_type s_conversion_table[NUM_SYSTEM_CODE][NUM_SYSTEM_CODE] = {
+    // From: TAI            TDB              TT               UTC
+    { convertIdentity, convertTdbToTai, convertTtToTai,  convertUtcToTai }, // To TAI.
+    { convertTaiToTdb, convertIdentity, convertTtToTdb,  convertUtcToTdb }, // To TDB.
+    { convertTaiToTt,  convertTdbToTt,  convertIdentity, convertUtcToTt  }, // To TT.
+    { convertTaiToUtc, convertTdbToUtc, convertTtToUtc,  convertIdentity }  // To UTC.
+  };
 
-        // Conversion from TDB to TT not converged (error).
-        throw std::runtime_error("Conversion from " + time_system.getName() + " to " + getName() + " did not converge");
+  /// \brief Type of a function to convert time moments in an array directly from one time system to another.
+  typedef void (*array_conversion_type)(const moment_type * moment, std::size_t num_moment, moment_type * result);
 
-      } else if ("UTC" == time_system.getName()) {
-        const TimeSystem & tai(getSystem("TAI"));
-        return convertFrom(tai, tai.convertFrom(time_system, moment));
+  /// \brief Convert given moments one by one by a given conversion function.
+  template <conversion_type Conversion>
+  void convertArray(const moment_type * moment, std::size_t num_moment, moment_type * result) {
+    for (std::size_t ii = 0; ii < num_moment; ++ii) result[ii] = Conversion(moment[ii]);
+  }
 
-      } else {
-        throw std::logic_error("Conversion from " + time_system.getName() + " to " + getName() + " is not implemented");
+  /** \class UtcArrayChecker
+      \brief Class to check validity of time moments in UTC system, for conversions of many time moments in a row.
+             The check is the same as UtcSystem::checkMoment method, but it looks up the leap second table once per
+             leap-second epoch.
+  */
+  class UtcArrayChecker {
+    public:
+      /// \brief Construct a UtcArrayChecker object, which keeps looking up the leap second table in use at construction.
+      UtcArrayChecker(): m_table(LeapSecTable::getTable()), m_earliest_mjd(m_table.getEarliestMjd()),
+        m_earliest_leap_sec(m_table.getCumulativeLeapSec(m_earliest_mjd)), m_leap_sec_cache(m_table) {}
+
+      /// \brief Return the earliest MJD that the leap-second table covers.
+      long getEarliestMjd() const { return m_earliest_mjd; }
+
+      /** \brief Return the sum of all leap seconds that are inserted or removed before the beginning of a given MJD.
+          \param mjd MJD number upto when leap seconds are summed up.
+      */
+      long getCumulativeLeapSec(long mjd) { return m_leap_sec_cache.getCumulativeLeapSec(mjd); }
+
+      /** \brief Check validity of a given time moment.
+          \param moment Time moment to be tested.
+      */
+      void checkMoment(const moment_type & moment) {
+        // Compute the time difference from the earliest MJD, in the same way as UtcSystem::computeTimeDifference method.
+        // Note: UtcSystem::checkMoment method is called for an invalid moment, so that it throws an exception with its message.
+        const TimeSystem & utc(BuiltinSystem::getBuiltinSystem(UTC_CODE));
+        if (moment.first < m_earliest_mjd) utc.checkMoment(moment);
+        Duration elapsed = Duration(moment.first - m_earliest_mjd, 0.) +
+          Duration::from<Sec>(m_leap_sec_cache.getCumulativeLeapSec(moment.first) - m_earliest_leap_sec) +
+          (moment.second - Duration::zero());
+        if (Duration::zero() > elapsed) utc.checkMoment(moment);
+      }
+
+    private:
+      const LeapSecTable & m_table;
+      long m_earliest_mjd;
+      long m_earliest_leap_sec;
+      LeapSecCache m_leap_sec_cache;
+  };
+
+  /// \brief Convert given moments from UTC to TAI, looking up the leap second table once per leap-second epoch.
+  void convertUtcToTaiArray(const moment_type * moment, std::size_t num_moment, moment_type * result) {
+    if (0 == num_moment) return;
+    UtcArrayChecker utc_checker;
+    for (std::size_t ii = 0; ii < num_moment; ++ii) {
+      // Check whether the given moment is valid in the current UTC system.
+      utc_checker.checkMoment(moment[ii]);
+
+      // Add the TAI - UTC to the given moment in TAI system.
+      long tai_minus_utc = 10 + utc_checker.getCumulativeLeapSec(moment[ii].first);
+      result[ii] = moment_type(moment[ii].first, moment[ii].second + Duration::from<Sec>(tai_minus_utc));
+    }
+  }
+
+  /// \brief Convert given moments from TAI to UTC, looking up the leap second table once per leap-second epoch.
+  void convertTaiToUtcArray(const moment_type * moment, std::size_t num_moment, moment_type * result) {
+    if (0 == num_moment) return;
+    const TimeSystem & tai(BuiltinSystem::getBuiltinSystem(TAI_CODE));
+    UtcArrayChecker utc_checker;
+    long earliest_mjd = utc_checker.getEarliestMjd();
+    for (std::size_t ii = 0; ii < num_moment; ++ii) {
+      // Adjust the origin of the given moment, so that it can be used as the origin of a UTC moment.
+      moment_type result_moment(moment[ii]);
+      if (result_moment.first < earliest_mjd) {
+        result_moment.first = earliest_mjd;
+        result_moment.second = tai.computeTimeDifference(moment[ii], moment_type(earliest_mjd, Duration::zero()));
       }
+
+      // Compute UTC - TAI in seconds, and add it to the given moment in UTC system.
+      long utc_minus_tai = -10 - utc_checker.getCumulativeLeapSec(result_moment.first);
+      result_moment.second += Duration::from<Sec>(utc_minus_tai);
+
+      // Check whether the resultant moment is valid in the current UTC system.
+      utc_checker.checkMoment(result_moment);
+      result[ii] = result_moment;
     }
-    return moment;
   }
 
-  moment_type UtcSystem::convertFrom(const TimeSystem & time_system, const moment_type & moment) const {
-    if (&time_system != this) {
-      if ("TAI" == time_system.getName()) {
-        // Get the leap-second table and the oldest MJD in the table.
-        const LeapSecTable & leap_sec_table(LeapSecTable::getTable());
-        long earliest_mjd = leap_sec_table.getEarliestMjd();
+  /// \brief Convert given moments from UTC to TDB.
+  void convertUtcToTdbArray(const moment_type * moment, std::size_t num_moment, moment_type * result) {
+    convertUtcToTaiArray(moment, num_moment, result);
+    convertArray<convertTaiToTdb>(result, num_moment, result);
+  }
 
-        // Adjust the origin of the given moment, so that it can be used as the origin of a UTC moment.
-        moment_type result_moment(moment);
-        if (result_moment.first < earliest_mjd) {
-          // Adjust the origin of the given monent, such that it comes after the first entry of the leap-second table.
-          result_moment.first = earliest_mjd;
-          result_moment.second = time_system.computeTimeDifference(moment, moment_type(earliest_mjd, Duration::zero()));
-        }
+  /// \brief Convert given moments from TDB to UTC.
+  void convertTdbToUtcArray(const moment_type * moment, std::size_t num_moment, moment_type * result) {
+    convertArray<convertTdbToTai>(moment, num_moment, result);
+    convertTaiToUtcArray(result, num_moment, result);
+  }
+
+  /// \brief Convert given moments from UTC to TT.
+  void convertUtcToTtArray(const moment_type * moment, std::size_t num_moment, moment_type * result) {
+    convertUtcToTaiArray(moment, num_moment, result);
+    convertArray<convertTaiToTt>(result, num_moment, result);
+  }
 
-        // Compute UTC - TAI in seconds, and add it to the given moment in UTC system.
-        long utc_minus_tai = -10 - leap_sec_table.getCumulativeLeapSec(result_moment.first);
-        result_moment.second += Duration(utc_minus_tai, "Sec");
+  /// \brief Convert given moments from TT to UTC.
+  void convertTtToUtcArray(const moment_type * moment, std::size_t num_moment, moment_type * result) {
+    convertArray<convertTtToTai>(moment, num_moment, result);
+    convertTaiToUtcArray(result, num_moment, result);
+  }
 
-        // Check whether the resultant moment is valid in the current UTC system.
-        checkMoment(result_moment);
+  // Dispatch table of array conversion functions, indexed in the same way as the dispatch table of conversion functions.
+  const array_conversion_type s_array_conversion_table[NUM_SYSTEM_CODE][NUM_SYSTEM_CODE] = {
+    // From TAI, TDB, TT, and UTC (left to right), to TAI, TDB, TT, and UTC (top to bottom).
+    { convertArray<convertIdentity>, convertArray<convertTdbToTai>, convertArray<convertTtToTai>,  convertUtcToTaiArray },
+    { convertArray<convertTaiToTdb>, convertArray<convertIdentity>, convertArray<convertTtToTdb>,  convertUtcToTdbArray },
+    { convertArray<convertTaiToTt>,  convertArray<convertTdbToTt>,  convertArray<convertIdentity>, convertUtcToTtArray },
+    { convertTaiToUtcArray,          convertTdbToUtcArray,          convertTtToUtcArray,           convertArray<convertIdentity> }
+  };
 
-        // Return the moment.
-        return result_moment;
+  const BuiltinSystem * BuiltinSystem::s_builtin_system[NUM_SYSTEM_CODE] = { 0, 0, 0, 0 };
 
-      } else if ("TDB" == time_system.getName() || "TT" == time_system.getName()) {
-        const TimeSystem & tai(getSystem("TAI"));
-        return convertFrom(tai, tai.convertFrom(time_system, moment));
+  BuiltinSystem::BuiltinSystem(const std::string & system_name, SystemCode system_code): TimeSystem(system_name),
+    m_system_code(system_code) {
+    s_builtin_system[system_code] = this;
+  }
 
-      } else {
-        throw std::logic_error("Conversion from " + time_system.getName() + " to " + getName() + " is not implemented");
+  const TimeSystem & BuiltinSystem::getBuiltinSystem(SystemCode system_code) {
+    return *s_builtin_system[system_code];
+  }
+
+  moment_type BuiltinSystem::convertFrom(const TimeSystem & time_system, const moment_type & moment) const {
+    // Find the code of the given time system.
+    // Note: Time systems are identified by their addresses, so that no names are compared.
+    for (int system_code = 0; system_code < NUM_SYSTEM_CODE; ++system_code) {
+      if (&time_system == s_builtin_system[system_code]) return s_conversion_table[m_system_code][system_code](moment);
+    }
+
+    // Conversion from a time system not implemented in this file (error).
+    throw std::logic_error("Conversion from " + time_system.getName() + " to " + getName() + " is not implemented");
+  }
+
+  void BuiltinSystem::convertArrayFrom(const TimeSystem & time_system, const moment_type * moment, std::size_t num_moment,
+    moment_type * result) const {
+    // Find the code of the given time system once for all the given moments.
+    for (int system_code = 0; system_code < NUM_SYSTEM_CODE; ++system_code) {
+      if (&time_system == s_builtin_system[system_code]) {
+        s_array_conversion_table[m_system_code][system_code](moment, num_moment, result);
+        return;
       }
     }
-    return moment;
+
+    // Conversion from a time system not implemented in this file (error).
+    throw std::logic_error("Conversion from " + time_system.getName() + " to " + getName() + " is not implemented");
   }
 
   Duration UtcSystem::computeTimeDifference(const moment_type & moment1, const moment_type & moment2) const {
@@ -301,14 +680,24 @@ namespace {
     long leap2 = leap_sec_table.getCumulativeLeapSec(moment2.first);
 
     // Compute and return the time difference.
-    return Duration(moment1.first - moment2.first, "Day") + Duration(leap1 - leap2, "Sec") + (moment1.second - moment2.second);
+    return Duration(moment1.first - moment2.first, 0.) + Duration::from<Sec>(leap1 - leap2) + (moment1.second - moment2.second);
+  }
+
+  double UtcSystem::computeTimeDifferenceInSec(const moment_type & moment1, const moment_type & moment2) const {
+    // Compute the cumulative numbers of leap seconds at the beginning of MJD given by moment1.first and moment2.first.
+    const LeapSecTable & leap_sec_table(LeapSecTable::getTable());
+    long leap1 = leap_sec_table.getCumulativeLeapSec(moment1.first);
+    long leap2 = leap_sec_table.getCumulativeLeapSec(moment2.first);
+
+    // Compute and return the time difference, adding the leap seconds before conversion to seconds.
+    return (Duration::from<Sec>(leap1 - leap2) + (moment1.second - moment2.second)).computeSec(moment1.first - moment2.first);
   }
 
   datetime_type UtcSystem::computeDateTime(const moment_type & moment) const {
     // Compute candidate MJD in day & second format.
     long day_int = 0;
     double day_frac = 0.;
-    moment.second.get("Day", day_int, day_frac);
+    moment.second.get<Day>(day_int, day_frac);
     if (day_frac < 0.) --day_int;
     datetime_type datetime(moment.first + day_int, 0.);
 
@@ -321,7 +710,7 @@ namespace {
 
       // Update the candidate.
       datetime.first += mjd_adjust;
-      datetime.second = computeTimeDifference(moment, moment_type(datetime.first, Duration::zero())).get("Sec");
+      datetime.second = computeTimeDifference(moment, moment_type(datetime.first, Duration::zero())).get<Sec>();
 
       // Determine the next adjustment.
       // Note: this do-while loop ends with a change of the sign of datetime.second.
@@ -347,7 +736,7 @@ namespace {
     // Compute the number of seconds in the given date.
     moment_type this_date(datetime.first, Duration::zero());
     moment_type next_date(datetime.first + 1, Duration::zero());
-    double max_second = computeTimeDifference(next_date, this_date).get("Sec");
+    double max_second = computeTimeDifference(next_date, this_date).get<Sec>();
 
     // Check the date and time.
     if (datetime.second < 0. || datetime.second >= max_second) {
@@ -357,7 +746,7 @@ namespace {
     }
 
     // Compute and return the moment.
-    return moment_type(datetime.first, Duration(datetime.second, "Sec"));
+    return moment_type(datetime.first, Duration::from<Sec>(datetime.second));
   }
 
   void UtcSystem::checkMoment(const moment_type & moment) const {
@@ -382,27 +771,55 @@ namespace {
     }
   }
 
-  LeapSecTable & LeapSecTable::getTable() {
-    static LeapSecTable s_leap_sec_table;
-    return s_leap_sec_table;
+  std::atomic<const LeapSecTable *> LeapSecTable::s_current_table(0);
+
+  const LeapSecTable & LeapSecTable::getTable() {
+    static const LeapSecTable s_empty_table;
+    const LeapSecTable * table = s_current_table.load(std::memory_order_acquire);
+    return table ? *table : s_empty_table;
+  }
+
+  void LeapSecTable::load(const std::string & leap_sec_file_name, bool force_load, const std::string & cache_file_name) {
+    // Prevent loading unless it hasn't been done or caller demands it, without holding a lock if it has been done.
+    if (!(force_load || getTable().empty())) return;
+
+    // Hold a lock so that only one thread loads the table at a time.
+    static std::mutex s_load_mutex;
+    std::lock_guard<std::mutex> lock(s_load_mutex);
+    if (!(force_load || getTable().empty())) return;
+
+    // Read leap second definitions into a new table, leaving the table in use intact in case of an error.
+    // Note: A snapshot is read instead of the leap-second file if it is up to date, and is written after the file is read.
+    std::unique_ptr<LeapSecTable> new_table(new LeapSecTable());
+    if (leap_sec_file_name.empty()) {
+      new_table->readBuiltin();
+    } else if (cache_file_name.empty()) {
+      new_table->read(leap_sec_file_name);
+    } else if (!new_table->readSnapshot(cache_file_name, leap_sec_file_name)) {
+      new_table->read(leap_sec_file_name);
+      new_table->writeSnapshot(cache_file_name, leap_sec_file_name);
+    }
+
+    // Replace the table in use with the new one.
+    // Note: Replaced tables are kept until the end of the process, because other threads may still be looking them up.
+    static std::vector<std::unique_ptr<const LeapSecTable> > s_table_cont;
+    s_table_cont.push_back(std::unique_ptr<const LeapSecTable>(new_table.release()));
+    s_current_table.store(s_table_cont.back().get(), std::memory_order_release);
   }
 
   std::string LeapSecTable::getFileName() const {
     return m_file_name;
   }
 
-  void LeapSecTable::load(const std::string & leap_sec_file_name, bool force_load) {
-    // Prevent loading unless it hasn't been done or caller demands it.
-    if (!(force_load || m_table.empty())) return;
-
-    // Erase previously loaded leap seconds definitions.
-    m_table.clear();
-
+  void LeapSecTable::read(const std::string & leap_sec_file_name) {
     // Set the leap second file name to the data member for future reference.
     m_file_name = leap_sec_file_name;
 
     // Read MJD and number of leap seconds from table.
+    // Note: Entries are collected in a std::map first, so that they are sorted by MJD and a later entry for the same MJD
+    //       supersedes an earlier one.
     std::unique_ptr<const tip::Table> leap_sec_table(tip::IFileSvc::instance().readTable(m_file_name, "1"));
+    std::map<long, long> sorted_table;
     long cumulative_leap_sec = 0;
     for (tip::Table::ConstIterator itor = leap_sec_table->begin(); itor != leap_sec_table->end(); ++itor) {
       // Read the MJD and LEAPSECS from the table.
@@ -421,33 +838,223 @@ namespace {
       cumulative_leap_sec += leap_sec;
 
       // Add an entry to conversion tables.
-      m_table[mjd] = cumulative_leap_sec;
+      sorted_table[mjd] = cumulative_leap_sec;
+    }
+
+    // Store the entries in contiguous arrays.
+    store(sorted_table);
+  }
+
+  void LeapSecTable::readBuiltin() {
+    // Sum up leap seconds in the same way as those read from a leap-second file.
+    m_file_name = s_builtin_leap_sec_name;
+    std::map<long, long> sorted_table;
+    long cumulative_leap_sec = 0;
+    std::size_t num_entry = sizeof(s_builtin_leap_sec) / sizeof(s_builtin_leap_sec[0]);
+    for (std::size_t ii = 0; ii < num_entry; ++ii) {
+      cumulative_leap_sec += s_builtin_leap_sec[ii].m_leap_sec;
+      sorted_table[s_builtin_leap_sec[ii].m_mjd] = cumulative_leap_sec;
+    }
+    store(sorted_table);
+  }
+
+  void LeapSecTable::store(const std::map<long, long> & sorted_table) {
+    m_mjd_table.reserve(sorted_table.size());
+    m_leap_sec_table.reserve(sorted_table.size());
+    for (std::map<long, long>::const_iterator itor = sorted_table.begin(); itor != sorted_table.end(); ++itor) {
+      m_mjd_table.push_back(itor->first);
+      m_leap_sec_table.push_back(itor->second);
+    }
+  }
+
+  bool LeapSecTable::readSnapshot(const std::string & cache_file_name, const std::string & leap_sec_file_name) {
+    // Get the modification time and the size of the leap-second file, which the snapshot must have been written for.
+    struct stat file_stat;
+    if (0 != stat(leap_sec_file_name.c_str(), &file_stat)) return false;
+
+    // Read the header of the snapshot, and check it.
+    std::ifstream ifs(cache_file_name.c_str(), std::ios::in | std::ios::binary);
+    char magic[sizeof(s_snapshot_magic)];
+    long long header[4] = { 0, 0, 0, 0 };
+    if (!ifs.read(magic, sizeof(magic)) || !ifs.read(reinterpret_cast<char *>(header), sizeof(header))) return false;
+    if (0 != std::char_traits<char>::compare(magic, s_snapshot_magic, sizeof(magic)) || s_snapshot_byte_order != header[0] ||
+      static_cast<long long>(file_stat.st_mtime) != header[1] || static_cast<long long>(file_stat.st_size) != header[2] ||
+      header[3] < 0 || header[3] > s_snapshot_max_entry) return false;
+    std::string file_name(leap_sec_file_name.size(), '\0');
+    long long name_size = 0;
+    if (!ifs.read(reinterpret_cast<char *>(&name_size), sizeof(name_size)) ||
+      static_cast<long long>(leap_sec_file_name.size()) != name_size || (name_size > 0 && !ifs.read(&file_name[0], name_size)) ||
+      file_name != leap_sec_file_name) return false;
+
+    // Read the entries.
+    std::vector<long long> entry(2 * header[3]);
+    if (!entry.empty() && !ifs.read(reinterpret_cast<char *>(&entry[0]), entry.size() * sizeof(entry[0]))) return false;
+    m_file_name = leap_sec_file_name;
+    for (std::vector<long long>::size_type ii = 0; ii < entry.size(); ii += 2) {
+      m_mjd_table.push_back(static_cast<long>(entry[ii]));
+      m_leap_sec_table.push_back(static_cast<long>(entry[ii + 1]));
+    }
+    return true;
+  }
+
+  void LeapSecTable::writeSnapshot(const std::string & cache_file_name, const std::string & leap_sec_file_name) const {
+    // Get the modification time and the size of the leap-second file, which the snapshot is written for.
+    struct stat file_stat;
+    if (0 != stat(leap_sec_file_name.c_str(), &file_stat)) return;
+
+    // Write a snapshot to a temporary file.
+    std::string temp_file_name(cache_file_name + ".tmp");
+    {
+      std::ofstream ofs(temp_file_name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+      long long header[5] = { s_snapshot_byte_order, static_cast<long long>(file_stat.st_mtime),
+        static_cast<long long>(file_stat.st_size), static_cast<long long>(m_mjd_table.size()),
+        static_cast<long long>(leap_sec_file_name.size()) };
+      ofs.write(s_snapshot_magic, sizeof(s_snapshot_magic));
+      ofs.write(reinterpret_cast<const char *>(header), sizeof(header));
+      ofs.write(leap_sec_file_name.data(), leap_sec_file_name.size());
+      for (table_type::size_type ii = 0; ii < m_mjd_table.size(); ++ii) {
+        long long entry[2] = { m_mjd_table[ii], m_leap_sec_table[ii] };
+        ofs.write(reinterpret_cast<const char *>(entry), sizeof(entry));
+      }
+      if (!ofs.flush()) {
+        ofs.close();
+        std::remove(temp_file_name.c_str());
+        return;
+      }
     }
+
+    // Replace the snapshot at once, so that other processes never read a partially written one.
+    if (0 != std::rename(temp_file_name.c_str(), cache_file_name.c_str())) std::remove(temp_file_name.c_str());
   }
 
   long LeapSecTable::getCumulativeLeapSec(long mjd) const {
+    return m_leap_sec_table[findEntry(mjd)];
+  }
+
+  long LeapSecTable::getCumulativeLeapSec(long mjd, long & first_mjd, long & end_mjd) const {
+    // Find the entry, and set the range of MJD numbers that the entry applies to.
+    table_type::size_type index = findEntry(mjd);
+    first_mjd = m_mjd_table[index];
+    end_mjd = (index + 1 == m_mjd_table.size() ? std::numeric_limits<long>::max() : m_mjd_table[index + 1]);
+
+    // Return the contents of the entry.
+    return m_leap_sec_table[index];
+  }
+
+  LeapSecTable::table_type::size_type LeapSecTable::findEntry(long mjd) const {
+    // Check the entry found by the last look-up first, because consecutive look-ups are usually in the same leap-second epoch.
+    table_type::size_type num_entry = m_mjd_table.size();
+    table_type::size_type index = m_last_index.load(std::memory_order_relaxed);
+    if (index < num_entry && m_mjd_table[index] <= mjd && (index + 1 == num_entry || mjd < m_mjd_table[index + 1])) return index;
+
     // Find the first entry of the leap second table which is <= the given MJD.
-    table_type::const_iterator itor = m_table.upper_bound(mjd);
-    if (itor == m_table.begin()) {
+    if (m_mjd_table.empty()) throw std::runtime_error("The leap-second table is empty");
+    table_type::const_iterator itor = std::upper_bound(m_mjd_table.begin(), m_mjd_table.end(), mjd);
+    if (itor == m_mjd_table.begin()) {
       // The given MJD time is too early for UTC.
       std::ostringstream os;
       os << "The leap-second table is looked up for " << mjd << ".0 MJD (UTC), which is before its first entry " <<
-        m_table.begin()->first << ".0 MJD (UTC)";
+        m_mjd_table.front() << ".0 MJD (UTC)";
       throw std::runtime_error(os.str());
     }
     --itor;
 
-    // Return the contents of the entry.
-    return itor->second;
+    // Remember the entry for the next look-up, and return its index.
+    index = itor - m_mjd_table.begin();
+    m_last_index.store(index, std::memory_order_relaxed);
+    return index;
   }
 
   long LeapSecTable::getEarliestMjd() const {
     // Look for the first entry.
-    table_type::const_iterator itor = m_table.begin();
-    if (itor == m_table.end()) throw std::runtime_error("The leap-second table is empty");
+    if (m_mjd_table.empty()) throw std::runtime_error("The leap-second table is empty");
 
     // Return the MJD value of the first entry.
-    return itor->first;
+    return m_mjd_table.front();
+  }
+
+  TdbMinusTtTable & TdbMinusTtTable::getTable() {
+    static TdbMinusTtTable s_tdb_minus_tt_table;
+    return s_tdb_minus_tt_table;
+  }
+
+  void TdbMinusTtTable::build(long first_mjd, long last_mjd) {
+    // Check the span.
+    if (first_mjd > last_mjd) {
+      std::ostringstream os;
+      os << "The first MJD (" << first_mjd << ") is later than the last MJD (" << last_mjd << ") for precomputing TDB - TT";
+      throw std::runtime_error(os.str());
+    }
+
+    // Compute Chebyshev nodes in a segment.
+    static const double s_pi = 3.14159265358979323846;
+    std::vector<double> node(s_tdb_num_coeff);
+    for (long node_index = 0; node_index < s_tdb_num_coeff; ++node_index) {
+      node[node_index] = std::cos(s_pi * (node_index + .5) / s_tdb_num_coeff);
+    }
+
+    // Compute Chebyshev coefficients for each segment.
+    long num_segment = (last_mjd - first_mjd + s_tdb_segment_day) / s_tdb_segment_day;
+    std::vector<double> coeff(num_segment * s_tdb_num_coeff, 0.);
+    std::vector<double> value(s_tdb_num_coeff);
+    for (long segment_index = 0; segment_index < num_segment; ++segment_index) {
+      // Compute TDB - TT at the nodes.
+      // Note: Julian Date is MJD + 2400000.5, and the day offset from the beginning of the span is split into its integer
+      //       and fractional parts to keep precision.
+      for (long node_index = 0; node_index < s_tdb_num_coeff; ++node_index) {
+        double day_offset = s_tdb_segment_day * (segment_index + .5 * (node[node_index] + 1.));
+        double day_int = std::floor(day_offset);
+        value[node_index] = ctatv(first_mjd + static_cast<long>(day_int) + 2400000, day_offset - day_int + .5);
+      }
+
+      // Compute the coefficients.
+      double * coeff_ptr = &coeff[segment_index * s_tdb_num_coeff];
+      for (long coeff_index = 0; coeff_index < s_tdb_num_coeff; ++coeff_index) {
+        double sum = 0.;
+        for (long node_index = 0; node_index < s_tdb_num_coeff; ++node_index) {
+          sum += value[node_index] * std::cos(s_pi * coeff_index * (node_index + .5) / s_tdb_num_coeff);
+        }
+        coeff_ptr[coeff_index] = 2. * sum / s_tdb_num_coeff;
+      }
+    }
+
+    // Replace the table contents.
+    m_coeff.swap(coeff);
+    m_first_mjd = first_mjd;
+    m_num_segment = num_segment;
+  }
+
+  void TdbMinusTtTable::clear() {
+    m_coeff.clear();
+    m_first_mjd = 0;
+    m_num_segment = 0;
+  }
+
+  bool TdbMinusTtTable::compute(const datetime_type & datetime, double & tdb_minus_tt) const {
+    // Compute the segment that covers the given time.
+    if (0 == m_num_segment) return false;
+    double day_offset = (datetime.first - m_first_mjd) + datetime.second / SecPerDay();
+    if (day_offset < 0.) return false;
+    long segment_index = static_cast<long>(day_offset / s_tdb_segment_day);
+    if (segment_index >= m_num_segment) return false;
+
+    // Compute the time difference.
+    double x = 2. * (day_offset - segment_index * s_tdb_segment_day) / s_tdb_segment_day - 1.;
+    tdb_minus_tt = evaluate(segment_index, x);
+    return true;
+  }
+
+  double TdbMinusTtTable::evaluate(long segment_index, double x) const {
+    // Evaluate Chebyshev polynomials by Clenshaw's recurrence.
+    const double * coeff_ptr = &m_coeff[segment_index * s_tdb_num_coeff];
+    double b1 = 0.;
+    double b2 = 0.;
+    for (long coeff_index = s_tdb_num_coeff - 1; coeff_index > 0; --coeff_index) {
+      double b0 = 2. * x * b1 - b2 + coeff_ptr[coeff_index];
+      b2 = b1;
+      b1 = b0;
+    }
+    return x * b1 - b2 + .5 * coeff_ptr[0];
   }
 
 }
@@ -455,48 +1062,51 @@ namespace {
 namespace timeSystem {
 
   const TimeSystem & TimeSystem::getSystem(const std::string & system_name) {
-    // Create TimeSystem objects.
-    static const TaiSystem s_tai_system;
-    static const TdbSystem s_tdb_system;
-    static const TtSystem s_tt_system;
-    static const UtcSystem s_utc_system;
+    // Create TimeSystem objects, which register themselves, only once.
+    // Note: The registry is never modified after this initialization, which is done only once even if this method is called
+    //       in multiple threads at the same time, so that it can be read without locks.
+    static const container_type & s_container([]() -> const container_type & {
+      static const TaiSystem s_tai_system;
+      static const TdbSystem s_tdb_system;
+      static const TtSystem s_tt_system;
+      static const UtcSystem s_utc_system;
+      return getContainer();
+    }());
 
     // Make the given time system name case-insensitive.
     std::string uc_system_name = system_name;
     for (std::string::iterator itor = uc_system_name.begin(); itor != uc_system_name.end(); ++itor) *itor = std::toupper(*itor);
 
     // Find a requested TimeSystem object.
-    container_type & container(getContainer());
-    container_type::iterator cont_itor = container.find(uc_system_name);
-    if (container.end() == cont_itor) throw std::runtime_error("No such time system implemented: " + system_name);
+    container_type::const_iterator cont_itor = s_container.find(uc_system_name);
+    if (s_container.end() == cont_itor) throw std::runtime_error("No such time system implemented: " + system_name);
     const TimeSystem & system(*cont_itor->second);
 
     // Load a leap-second table if UTC system is requested.
-    if (system.getName() == "UTC") loadLeapSeconds("", false);
+    if ("UTC" == cont_itor->first) loadLeapSeconds("", false);
 
     // Return the time system.
     return system;
   }
 
   void TimeSystem::loadLeapSeconds(std::string leap_sec_file_name, bool force_load) {
+    // Do nothing if leap-second data have already been loaded, unless the caller demands loading.
+    if (!(force_load || LeapSecTable::getTable().empty())) return;
+
     // Rationalize the leap-second file name.
+    // Note: An empty name after this makes the leap second table built into this library loaded.
     std::string uc_file_name = leap_sec_file_name;
     for (std::string::iterator itor = uc_file_name.begin(); itor != uc_file_name.end(); ++itor) *itor = std::toupper(*itor);
     if (uc_file_name.empty() || "DEFAULT" == uc_file_name) leap_sec_file_name = getDefaultLeapSecFileName();
 
     // Load the leap-second table.
-    LeapSecTable & leap_sec_table(LeapSecTable::getTable());
-    leap_sec_table.load(leap_sec_file_name, force_load);
+    LeapSecTable::load(leap_sec_file_name, force_load, s_leap_sec_cache_file);
   }
 
   std::string TimeSystem::getDefaultLeapSecFileName() {
     std::string uc_file_name = s_default_leap_sec_file;
     for (std::string::iterator itor = uc_file_name.begin(); itor != uc_file_name.end(); ++itor) *itor = std::toupper(*itor);
-    if (uc_file_name.empty() || "DEFAULT" == uc_file_name) {
-      using namespace st_facilities;
-      // Location of default leap sec table.
-      return Env::appendFileName(Env::getEnv("TIMING_DIR"), "leapsec.fits");
-    }
+    if (uc_file_name.empty() || "DEFAULT" == uc_file_name) return std::string();
     return s_default_leap_sec_file;
   }
 
@@ -504,6 +1114,22 @@ namespace timeSystem {
     s_default_leap_sec_file = leap_sec_file_name;
   }
 
+  void TimeSystem::setLeapSecCacheFileName(const std::string & cache_file_name) {
+    s_leap_sec_cache_file = cache_file_name;
+  }
+
+  void TimeSystem::precomputeTdbMinusTt(long first_mjd, long last_mjd) {
+    TdbMinusTtTable::getTable().build(first_mjd, last_mjd);
+  }
+
+  void TimeSystem::clearTdbMinusTt() {
+    TdbMinusTtTable::getTable().clear();
+  }
+
+  double TimeSystem::computeTdbMinusTtInSec(const datetime_type & tt_datetime) {
+    return computeTdbMinusTt(tt_datetime).get<Sec>();
+  }
+
   TimeSystem::container_type & TimeSystem::getContainer() {
     static container_type s_prototype;
     return s_prototype;
@@ -521,8 +1147,17 @@ namespace timeSystem {
     return m_system_name;
   }
 
+  void TimeSystem::convertArrayFrom(const TimeSystem & time_system, const moment_type * moment, std::size_t num_moment,
+    moment_type * result) const {
+    for (std::size_t ii = 0; ii < num_moment; ++ii) result[ii] = convertFrom(time_system, moment[ii]);
+  }
+
   Duration TimeSystem::computeTimeDifference(const moment_type & moment1, const moment_type & moment2) const {
-    return Duration(moment1.first - moment2.first, "Day") + (moment1.second - moment2.second);
+    return Duration(moment1.first - moment2.first, 0.) + (moment1.second - moment2.second);
+  }
+
+  double TimeSystem::computeTimeDifferenceInSec(const moment_type & moment1, const moment_type & moment2) const {
+    return (moment1.second - moment2.second).computeSec(moment1.first - moment2.first);
   }
 
   datetime_type TimeSystem::computeDateTime(const moment_type & moment) const {
@@ -530,10 +1165,10 @@ namespace timeSystem {
     const Duration & elapsed_total(moment.second);
     long elapsed_int = 0;
     double elapsed_frac = 0.;
-    elapsed_total.get("Day", elapsed_int, elapsed_frac);
+    elapsed_total.get<Day>(elapsed_int, elapsed_frac);
     if (elapsed_frac < 0.) --elapsed_int;
-    Duration elapsed_residual = elapsed_total - Duration(elapsed_int, "Day");
-    double elapsed_sec = elapsed_residual.get("Sec");
+    Duration elapsed_residual = elapsed_total - Duration(elapsed_int, 0.);
+    double elapsed_sec = elapsed_residual.get<Sec>();
 
     // Return the date and time.
     return datetime_type(moment.first + elapsed_int, elapsed_sec);
@@ -548,7 +1183,7 @@ namespace timeSystem {
     }
 
     // Compute and return the moment.
-    return moment_type(datetime.first, Duration(datetime.second, "Sec"));
+    return moment_type(datetime.first, Duration::from<Sec>(datetime.second));
   }
 
   void TimeSystem::checkMoment(const moment_type & /* moment */) const {
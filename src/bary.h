@@ -116,6 +116,36 @@ typedef struct {
   double pbdot ;        /* First derivative of pb */
 } PsrBinPar ;
 
+/*
+ *  JPLEphem holds the state of one JPL planetary ephemeris: its constants
+ *  and a buffer for the ephemeris record in memory.  The functions with
+ *  a "_r" suffix in dpleph.c only use the state in the JPLEphem they are
+ *  given, so that more than one ephemeris can be used at the same time,
+ *  and each thread can use its own JPLEphem without locking.  Callers
+ *  outside of C may treat it as an opaque type, using newephem_r,
+ *  cloneephem_r, and freeephem_r to create and destroy it.
+ */
+typedef struct JPLEphem {
+  char ephfile[1024] ;  /* Name of the ephemeris file */
+  long irecsz ;         /* length of ephemeris records (no. of bytes) */
+  double ss1, ss2, ss3, ss3inv ; /* start, stop, record length, and its inverse */
+  long currec ;         /* record number in buffer (0: none) */
+  double emratinv ;     /* emratinv = 1.0 / (1.0 + emrat) */
+  double *buffer ;      /* ephemeris record in memory */
+  double *table ;       /* ephemeris records in memory (NULL: read on demand) */
+  int owntable ;        /* non-zero if table is to be freed with this struct */
+  long firstrec ;       /* record number of the first record in table */
+  long ntabrec ;        /* number of records in table */
+  double *rdbuf ;       /* buffer for a record read on demand (owned) */
+  long iptr[13], ncf[13], na[13] ; /* coefficient pointers, counts, and sets */
+  long buflen ;         /* length of ephemeris records (no. of doubles) */
+  long nrecs ;          /* number of records */
+  double clight ;       /* speed of light (km/s) */
+  double au ;           /* astronomical unit (km) */
+  double aufac, velfac ; /* scaling factors for positions and velocities */
+  long nswitch ;        /* number of switches of the record in buffer */
+} JPLEphem ;
+
 /*  Externally referenced functions  */
 void met2mjd (double, MJDTime *) ;
 double mjd2met (MJDTime *) ;
@@ -156,6 +186,15 @@ double UTCtoTAI (MJDTime *) ;
 double ctatv (long, double) ;
 int initephem (int, int *, double *, double *, double *) ;
 const double *dpleph (double *, int, int) ;
+JPLEphem *newephem_r (void) ;
+int initephem_r (JPLEphem *, int, int *, double *, double *, double *) ;
+int dpleph_r (JPLEphem *, double *, int, int, double *) ;
+int dpleph_block_r (JPLEphem *, long, double *, int, int, double *) ;
+int prefetchephem_r (JPLEphem *, double *, double *, double **, long *) ;
+long ephemtablesize_r (const JPLEphem *) ;
+long ephemswitches_r (const JPLEphem *) ;
+JPLEphem *cloneephem_r (const JPLEphem *) ;
+void freeephem_r (JPLEphem *) ;
 FILE *openAFile (const char *) ;
 fitsfile *openFFile (const char *) ;
 
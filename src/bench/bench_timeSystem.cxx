@@ -0,0 +1,330 @@
+/** \file bench_timeSystem.cxx
+    \brief Micro-benchmarks for the hot operations of timeSystem package.
+
+    Each benchmark reports the wall-clock time and the number of heap allocations per operation. Inputs are taken from the
+    test data files distributed with this package (testevdata_1day.fits and testscdata_1day.fits), so that results are
+    comparable across releases and machines. An alternative data directory may be given as the first command-line argument.
+*/
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "facilities/commonUtilities.h"
+
+#include "timeSystem/AbsoluteTime.h"
+#include "timeSystem/BaryTimeComputer.h"
+#include "timeSystem/CalendarFormat.h"
+#include "timeSystem/Duration.h"
+#include "timeSystem/ElapsedTime.h"
+#include "timeSystem/MjdFormat.h"
+#include "timeSystem/SourcePosition.h"
+#include "timeSystem/TimeInterval.h"
+#include "timeSystem/TimeSystem.h"
+
+extern "C" {
+#include "timeSystem/glastscorbit.h"
+}
+
+extern "C" {
+// Copied from bary.h.
+int initephem (int, int *, double *, double *, double *) ;
+const double *dpleph (double *, int, int) ;
+}
+
+#include "tip/IFileSvc.h"
+#include "tip/Table.h"
+
+namespace {
+
+  /// \brief The number of heap allocations made in this process so far.
+  std::atomic<unsigned long long> s_num_alloc(0);
+
+}
+
+// Count heap allocations, so that each benchmark can report allocations per operation.
+void * operator new(std::size_t size) {
+  ++s_num_alloc;
+  void * ptr = std::malloc(0 == size ? 1 : size);
+  if (0 == ptr) throw std::bad_alloc();
+  return ptr;
+}
+
+void * operator new[](std::size_t size) {
+  return operator new(size);
+}
+
+void operator delete(void * ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void * ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void * ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void * ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+namespace {
+
+  using namespace timeSystem;
+
+  /// \brief Sink for benchmark results, to prevent compilers from optimizing away the operations measured.
+  volatile double s_sink = 0.;
+
+  /** \brief Run a benchmark and report its cost per operation. The operation is first run once for warming up, then
+             repeated until the total run time reaches a fixed minimum.
+      \param bench_name Name of the benchmark to report.
+      \param num_op The number of operations performed by one call to the given function.
+      \param func Function to run. It must return a double value, which is accumulated in a sink.
+  */
+  template <typename FuncType>
+  void runBenchmark(const std::string & bench_name, std::size_t num_op, FuncType func) {
+    typedef std::chrono::steady_clock clock_type;
+    const std::chrono::nanoseconds min_run_time(std::chrono::milliseconds(200));
+
+    // Warm up caches, lazily initialized objects, and so on.
+    s_sink = s_sink + func();
+
+    // Repeat the given function until enough time elapses.
+    unsigned long long num_call = 0;
+    unsigned long long num_alloc_start = s_num_alloc.load();
+    clock_type::time_point time_start = clock_type::now();
+    std::chrono::nanoseconds run_time(0);
+    do {
+      s_sink = s_sink + func();
+      ++num_call;
+      run_time = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - time_start);
+    } while (run_time < min_run_time);
+    unsigned long long num_alloc = s_num_alloc.load() - num_alloc_start;
+
+    // Report the results.
+    double total_op = static_cast<double>(num_call) * static_cast<double>(num_op);
+    std::cout << std::left << std::setw(48) << bench_name << std::right << std::fixed
+      << std::setw(14) << std::setprecision(1) << run_time.count() / total_op << " ns/op"
+      << std::setw(10) << std::setprecision(2) << num_alloc / total_op << " allocs/op" << std::endl;
+  }
+
+  /** \brief Read event times from the TIME column of an event file.
+      \param event_file Name of the event file to read.
+      \param glast_time Event times (Mission Elapsed Times) are set to this argument.
+  */
+  void readEventTime(const std::string & event_file, std::vector<double> & glast_time) {
+    std::unique_ptr<const tip::Table> table(tip::IFileSvc::instance().readTable(event_file, "EVENTS"));
+    glast_time.clear();
+    for (tip::Table::ConstIterator itor = table->begin(); itor != table->end(); ++itor) {
+      double time_value = 0.;
+      (*itor)["TIME"].get(time_value);
+      glast_time.push_back(time_value);
+    }
+    if (glast_time.empty()) throw std::runtime_error("No events found in " + event_file);
+  }
+
+  /** \brief Run all the benchmarks.
+      \param data_dir Name of the directory that contains the test data files.
+  */
+  void runAllBenchmarks(const std::string & data_dir) {
+    const std::string event_file = facilities::commonUtilities::joinPath(data_dir, "testevdata_1day.fits");
+    const std::string sc_file = facilities::commonUtilities::joinPath(data_dir, "testscdata_1day.fits");
+
+    // Read event times to use as inputs.
+    std::vector<double> glast_time;
+    readEventTime(event_file, glast_time);
+    const std::size_t num_event = glast_time.size();
+    std::cout << "Read " << num_event << " event times from " << event_file << std::endl;
+
+    // Compute event times as AbsoluteTime objects.
+    // Note: The Fermi MJDREF (MJD 51910.0 in TT), is used as the origin of Mission Elapsed Time.
+    const TimeSystem & tt_system(TimeSystem::getSystem("TT"));
+    const long mjd_ref = 51910;
+    std::vector<AbsoluteTime> abs_time;
+    abs_time.reserve(num_event);
+    for (std::size_t ii = 0; ii < num_event; ++ii) {
+      abs_time.push_back(AbsoluteTime(tt_system, mjd_ref, Duration::from<Sec>(glast_time[ii])));
+    }
+
+    // Benchmark TimeSystem::convertFrom for every pair of time systems.
+    const char * system_name[] = { "TAI", "TDB", "TT", "UTC" };
+    const std::size_t num_system = sizeof(system_name) / sizeof(system_name[0]);
+    std::vector<moment_type> moment;
+    moment.reserve(num_event);
+    for (std::size_t ii = 0; ii < num_event; ++ii) moment.push_back(moment_type(mjd_ref, Duration::from<Sec>(glast_time[ii])));
+    for (std::size_t src_idx = 0; src_idx < num_system; ++src_idx) {
+      const TimeSystem & src_system(TimeSystem::getSystem(system_name[src_idx]));
+      for (std::size_t dest_idx = 0; dest_idx < num_system; ++dest_idx) {
+        const TimeSystem & dest_system(TimeSystem::getSystem(system_name[dest_idx]));
+        runBenchmark(std::string("TimeSystem::convertFrom ") + system_name[src_idx] + " -> " + system_name[dest_idx], num_event,
+          [&]() {
+            double sum = 0.;
+            for (std::size_t ii = 0; ii < num_event; ++ii) sum += dest_system.convertFrom(src_system, moment[ii]).first;
+            return sum;
+          });
+      }
+    }
+
+    // Benchmark AbsoluteTime arithmetic and comparisons.
+    const ElapsedTime time_step(tt_system, Duration::from<Sec>(1.5));
+    runBenchmark("AbsoluteTime + ElapsedTime", num_event, [&]() {
+      double sum = 0.;
+      for (std::size_t ii = 0; ii < num_event; ++ii) sum += ((abs_time[ii] + time_step) > abs_time[0] ? 1. : 0.);
+      return sum;
+    });
+    runBenchmark("AbsoluteTime - AbsoluteTime", num_event, [&]() {
+      double sum = 0.;
+      for (std::size_t ii = 0; ii < num_event; ++ii) {
+        sum += (abs_time[ii] - abs_time[0]).computeDuration("TT").get<Sec>();
+      }
+      return sum;
+    });
+    runBenchmark("AbsoluteTime < AbsoluteTime", num_event, [&]() {
+      double sum = 0.;
+      for (std::size_t ii = 1; ii < num_event; ++ii) sum += (abs_time[ii - 1] < abs_time[ii] ? 1. : 0.);
+      return sum;
+    });
+
+    // Benchmark Duration construction.
+    runBenchmark("Duration(long, double)", num_event, [&]() {
+      double sum = 0.;
+      for (std::size_t ii = 0; ii < num_event; ++ii) sum += Duration(0, glast_time[ii]).get<Day>();
+      return sum;
+    });
+    runBenchmark("Duration::from<Sec>(double)", num_event, [&]() {
+      double sum = 0.;
+      for (std::size_t ii = 0; ii < num_event; ++ii) sum += Duration::from<Sec>(glast_time[ii]).get<Day>();
+      return sum;
+    });
+    runBenchmark("Duration(double, \"Sec\")", num_event, [&]() {
+      double sum = 0.;
+      for (std::size_t ii = 0; ii < num_event; ++ii) sum += Duration(glast_time[ii], "Sec").get<Day>();
+      return sum;
+    });
+
+    // Benchmark parsing and formatting of calendar dates and MJDs.
+    std::vector<std::string> calendar_string;
+    std::vector<std::string> mjd_string;
+    calendar_string.reserve(num_event);
+    mjd_string.reserve(num_event);
+    for (std::size_t ii = 0; ii < num_event; ++ii) {
+      calendar_string.push_back(abs_time[ii].represent("TT", CalendarFmt));
+      mjd_string.push_back(abs_time[ii].represent("TT", MjdFmt));
+    }
+    runBenchmark("CalendarFormat parse", num_event, [&]() {
+      double sum = 0.;
+      for (std::size_t ii = 0; ii < num_event; ++ii) sum += CalendarFmt.parse(calendar_string[ii]).m_sec;
+      return sum;
+    });
+    runBenchmark("CalendarFormat format", num_event, [&]() {
+      double sum = 0.;
+      for (std::size_t ii = 0; ii < num_event; ++ii) {
+        Calendar calendar_rep(0, 0, 0, 0, 0, 0.);
+        abs_time[ii].get("TT", calendar_rep);
+        sum += CalendarFmt.format(calendar_rep).size();
+      }
+      return sum;
+    });
+    runBenchmark("MjdFormat parse", num_event, [&]() {
+      double sum = 0.;
+      for (std::size_t ii = 0; ii < num_event; ++ii) sum += MjdFmt.parse(mjd_string[ii]).m_frac;
+      return sum;
+    });
+    runBenchmark("MjdFormat format", num_event, [&]() {
+      double sum = 0.;
+      for (std::size_t ii = 0; ii < num_event; ++ii) {
+        Mjd mjd_rep(0, 0.);
+        abs_time[ii].get(tt_system, mjd_rep);
+        sum += MjdFmt.format(mjd_rep).size();
+      }
+      return sum;
+    });
+
+    // Benchmark interpolation of spacecraft positions.
+    char * sc_file_char = const_cast<char *>(sc_file.c_str());
+    GlastScFile * scptr = glastscorbit_open(sc_file_char, const_cast<char *>("SC_DATA"));
+    if (0 == scptr || glastscorbit_getstatus(scptr)) throw std::runtime_error("Could not open spacecraft file " + sc_file);
+    std::vector<double> sc_position(3 * num_event);
+    for (std::size_t ii = 0; ii < num_event; ++ii) {
+      if (glastscorbit_calcpos(scptr, glast_time[ii], &sc_position[3 * ii])) {
+        throw std::runtime_error("Could not compute spacecraft positions from " + sc_file);
+      }
+    }
+    runBenchmark("glastscorbit_calcpos", num_event, [&]() {
+      double sum = 0.;
+      double position[3];
+      for (std::size_t ii = 0; ii < num_event; ++ii) {
+        glastscorbit_calcpos(scptr, glast_time[ii], position);
+        sum += position[0];
+      }
+      return sum;
+    });
+    glastscorbit_close(scptr);
+
+    // Benchmark interpolation of solar system ephemeris.
+    int denum = 0;
+    double speed_of_light = 0.;
+    double radsol = 0.;
+    double solar_mass = 0.;
+    if (initephem(405, &denum, &speed_of_light, &radsol, &solar_mass)) {
+      throw std::runtime_error("Could not initialize JPL DE405 ephemeris");
+    }
+    std::vector<Jd> tt_jd;
+    tt_jd.reserve(num_event);
+    for (std::size_t ii = 0; ii < num_event; ++ii) {
+      Jd jd_rep(0, 0.);
+      abs_time[ii].get(tt_system, jd_rep);
+      tt_jd.push_back(jd_rep);
+    }
+    runBenchmark("dpleph", num_event, [&]() {
+      double sum = 0.;
+      for (std::size_t ii = 0; ii < num_event; ++ii) {
+        double jdt[2] = { static_cast<double>(tt_jd[ii].m_int), tt_jd[ii].m_frac };
+        const double * posn = dpleph(jdt, 3, 11);
+        if (posn) sum += posn[0];
+      }
+      return sum;
+    });
+
+    // Benchmark barycentric corrections.
+    const BaryTimeComputer & computer(BaryTimeComputer::getComputer("JPL DE405"));
+    const SourcePosition src_position(83.6331, 22.0145);
+    runBenchmark("JplComputer::computeBaryTime", num_event, [&]() {
+      double sum = 0.;
+      for (std::size_t ii = 0; ii < num_event; ++ii) {
+        AbsoluteTime bary_time(abs_time[ii]);
+        computer.computeBaryTime(src_position, &sc_position[3 * ii], bary_time);
+        sum += (bary_time > abs_time[ii] ? 1. : 0.);
+      }
+      return sum;
+    });
+  }
+
+}
+
+int main(int argc, char ** argv) {
+  int status = 0;
+  try {
+    // Find the directory of the test data files.
+    facilities::commonUtilities::setupEnvironment();
+    std::string data_dir(argc > 1 ? argv[1] : facilities::commonUtilities::getDataPath("timeSystem"));
+
+    // Run the benchmarks.
+    runAllBenchmarks(data_dir);
+
+  } catch (const std::exception & x) {
+    std::cerr << "bench_timeSystem: " << x.what() << std::endl;
+    status = 1;
+  }
+  return status;
+}
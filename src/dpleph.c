@@ -19,14 +19,55 @@ char *dplrcsid = "RCS: $Id: dpleph.c,v 1.1.1.1 2006/04/21 20:56:15 peachey Exp $
  *    int initephem (int ephnum, int *denum, double *c, double *radsol,
  *                   double *msol)
  *    const double *dpleph (double *jd, int ntarg, int ncent)
+ *    int initephem_r (JPLEphem *eph, int ephnum, int *denum, double *c,
+ *                     double *radsol, double *msol)
+ *    int dpleph_r (JPLEphem *eph, double *jd, int ntarg, int ncent,
+ *                  double *posn)
+ *    int dpleph_block_r (JPLEphem *eph, long njd, double *jd, int ntarg,
+ *                        int ncent, double *posn)
+ *    int prefetchephem_r (JPLEphem *eph, double *jd1, double *jd2,
+ *                         double **oldtable, long *nbytes)
+ *    long ephemtablesize_r (const JPLEphem *eph)
+ *    long ephemswitches_r (const JPLEphem *eph)
+ *    JPLEphem *newephem_r (void)
+ *    JPLEphem *cloneephem_r (const JPLEphem *src)
+ *    void freeephem_r (JPLEphem *eph)
  *
  *  Internal:
- *    int state (double *jd, int ntarg, int ncent, double *posn)
- *    int getstate (int ntarg, double t1, double *posn)
- *    int interp (double *buf, double t1, int ncf, int na, double *pv)
- *    int readephem (long recnum)
+ *    int state (JPLEphem *eph, double *jd, int ntarg, int ncent,
+ *               double *posn)
+ *    int findrecord (JPLEphem *eph, double *jd, double *t1)
+ *    int getstate (JPLEphem *eph, int ntarg, double t1, ChebCache *cache,
+ *                  double *posn)
+ *    int interp (JPLEphem *eph, double *buf, double t1, int ncf, int na,
+ *                double *pv)
+ *    ChebPoly *chebpoly (ChebCache *cache, double t1, int na, int ncf)
+ *    void interpcheb (JPLEphem *eph, double *buf, const ChebPoly *cp,
+ *                     int ncf, double *pv)
+ *    int readephem (JPLEphem *eph, long recnum)
  *    double findcval (char **cnam, double *cval, long n, char *name)
  *
+ *  All state of an ephemeris is kept in a JPLEphem struct (see bary.h).
+ *  The functions with a "_r" suffix are reentrant: they only touch the
+ *  JPLEphem they are given.  initephem and dpleph are kept for backward
+ *  compatibility, and use a JPLEphem and a position array private to this
+ *  file, thus they are not reentrant.
+ *
+ *  The Chebyshev polynomials evaluated at one epoch are kept in a
+ *  ChebCache while the states of the target and the center are
+ *  interpolated, so that bodies whose coefficients share a sub-interval
+ *  layout (e.g., the Earth-Moon barycenter and the Sun) share the
+ *  polynomial recurrence.  dpleph_block_r interpolates a block of epochs
+ *  in one call, without the overhead of calling dpleph_r for each.
+ *
+ *  initephem_r reads all records of the ephemeris into memory while the
+ *  file is open, so that a record switch in state is a pointer update
+ *  rather than file I/O.  The records are shared (read-only) by all
+ *  copies made by cloneephem_r.  Only if the memory for them cannot be
+ *  allocated, records are read from the file on demand by readephem.
+ *  In that case, prefetchephem_r reads the records that cover a given
+ *  time span into memory at once, before that span is interpolated.
+ *
  *  To find and open the ephemeris file, the function openFFile from
  *  bary.c is used.  The environment variables used, and the name of
  *  the ephemeris file (macro EPHEM), are defined in bary.h.
@@ -40,25 +81,39 @@ char *dplrcsid = "RCS: $Id: dpleph.c,v 1.1.1.1 2006/04/21 20:56:15 peachey Exp $
  *----------------------------------------------------------------------*/
 
 #include "bary.h"
-static char ephfile[1024] ;
-static long irecsz ;   /* length of ephemeris records (no. of doubles)  */
-static double ss1, ss2, ss3, ss3inv ;
-static long currec = 0 ;
-static double emratinv ; /* emratinv = 1.0 / (1.0 + emrat) */
-static double *buffer=NULL ;
-static long iptr[13], ncf[13], na[13] ;
-static long buflen ;
-static long nrecs ;
-static double clight ;
-static double au ;
-static double aufac, velfac ;
-
-int state (double *, int, int, double *) ;
-int getstate (int, double, double *) ;
-int interp (double *, double, int, int, double *) ;
-int readephem (long) ;
+static JPLEphem defephem ; /* Ephemeris used by initephem and dpleph */
+
+/*
+ *  Chebyshev polynomials and their derivatives evaluated at one epoch,
+ *  for one number of sub-intervals (na) per record.  Polynomials are
+ *  extended on demand up to the number of coefficients needed (at most
+ *  18 in the JPL ephemerides).
+ */
+#define MAXCHEBCOEFF 18
+#define MAXCHEBPOLY 13
+typedef struct ChebPoly {
+  int na ;                  /* # of sub-intervals per record */
+  int l ;                   /* Sub-interval number for the epoch */
+  int np ;                  /* # of polynomials evaluated in pc */
+  int nv ;                  /* # of derivatives evaluated in vc */
+  double twot ;             /* Twice the normalized Chebyshev time */
+  double pc[MAXCHEBCOEFF] ; /* Polynomial values */
+  double vc[MAXCHEBCOEFF] ; /* Derivative values */
+} ChebPoly ;
+typedef struct ChebCache {
+  int npoly ;
+  ChebPoly poly[MAXCHEBPOLY] ;
+} ChebCache ;
+
+int state (JPLEphem *, double *, int, int, double *) ;
+int findrecord (JPLEphem *, double *, double *) ;
+int getstate (JPLEphem *, int, double, ChebCache *, double *) ;
+int interp (JPLEphem *, double *, double, int, int, double *) ;
+ChebPoly *chebpoly (ChebCache *, double, int, int) ;
+void interpcheb (JPLEphem *, double *, const ChebPoly *, int, double *) ;
+int readephem (JPLEphem *, long) ;
 double findcval (char **, double *, long, char *) ;
-
+
 /*-----------------------------------------------------------------------
  *
  *  const double *dpleph (double *jd, int ntarg, int ncent)
@@ -97,6 +152,33 @@ double findcval (char **, double *, long, char *) ;
 const double *dpleph (double *jd, int ntarg, int ncent)
 {
   static double posn[12] ;
+
+  if ( dpleph_r (&defephem, jd, ntarg, ncent, posn) )
+    return (const double *) NULL ;
+  else {
+    return (const double *) posn ;
+  }
+}
+
+/*-----------------------------------------------------------------------
+ *
+ *  int dpleph_r (JPLEphem *eph, double *jd, int ntarg, int ncent,
+ *                double *posn)
+ *
+ *    JPLEphem *eph     Ephemeris initialized by initephem_r
+ *    double[2] jd      JD time for which ephemeris is requested
+ *    int       ntarg   Target for which position is requested
+ *    int       ncent   Center for which position is requested
+ *    double[12] posn   Interpolated quantities requested (output)
+ *
+ *  dpleph_r is the reentrant version of dpleph.  It sets the concatenated
+ *  state vectors of the target and the center to posn, in the same way
+ *  as dpleph, and returns 0 on success, non-zero otherwise.
+ *
+ *----------------------------------------------------------------------*/
+
+int dpleph_r (JPLEphem *eph, double *jd, int ntarg, int ncent, double *posn)
+{
   long jdint ;
   double jdtmp ;
 /* Masaharu Hirayama 1 November 2008: Commented out variable 'i' in the
@@ -123,16 +205,83 @@ const double *dpleph (double *jd, int ntarg, int ncent)
 /*
  *      Get the positions and return
  */
-  if ( state (jd, ntarg, ncent, posn) )
-    return (const double *) NULL ;
-  else {
-    return (const double *) posn ;
+  return state (eph, jd, ntarg, ncent, posn) ;
+}
+
+/*-----------------------------------------------------------------------
+ *
+ *  int dpleph_block_r (JPLEphem *eph, long njd, double *jd, int ntarg,
+ *                      int ncent, double *posn)
+ *
+ *    JPLEphem *eph          Ephemeris initialized by initephem_r
+ *    long      njd          Number of JD times
+ *    double[2*njd] jd       JD times for which ephemeris is requested,
+ *                           as pairs of integer and fractional parts
+ *    int       ntarg        Target for which position is requested
+ *    int       ncent        Center for which position is requested
+ *    double[12*njd] posn    Interpolated quantities requested (output)
+ *
+ *  dpleph_block_r does the same as dpleph_r for each of the njd times in
+ *  jd, and sets the results to posn, 12 elements per time in the same
+ *  order as jd.  Times sorted in ascending order give the best
+ *  performance, since consecutive times then fall in the same record.
+ *  Returns 0 on success; otherwise, the status of dpleph_r for the first
+ *  time that failed, in which case posn is valid only for the times
+ *  before it.
+ *
+ *----------------------------------------------------------------------*/
+
+int dpleph_block_r (JPLEphem *eph, long njd, double *jd, int ntarg, int ncent, double *posn)
+{
+  long i ;
+  int status ;
+  long jdint ;
+  double jdtmp, t1 ;
+  double *jdptr ;
+  ChebCache cache ;
+
+  for (i=0; i<njd; i++) {
+/*
+ *     Make sure jd is in proper range
+ */
+    jdptr = jd + 2 * i ;
+    jdint = (long) jdptr[0] ;
+    jdtmp = (double) jdptr[0] - jdint ;
+    jdptr[0] = (double) jdint ;
+    jdptr[1] += jdtmp ;
+    while ( jdptr[1] >= 0.5 ) {
+      jdptr[1]-- ;
+      jdptr[0]++ ;
+    }
+    while ( jdptr[1] < -0.5 ) {
+      jdptr[1]++ ;
+      jdptr[0]-- ;
+    }
+
+/*
+ *     Point to the record for this time; no I/O unless the record changes
+ */
+    if ( ( status = findrecord (eph, jdptr, &t1) ) )
+      return status ;
+
+/*
+ *     Get state vectors for target and center, sharing polynomials
+ */
+    cache.npoly = 0 ;
+    if ( getstate (eph, ntarg, t1, &cache, posn + 12 * i) )
+      return -1 ;
+    if ( ncent > 0 )
+      if ( getstate (eph, ncent, t1, &cache, posn + 12 * i + 6) )
+        return -2 ;
   }
+
+  return 0 ;
 }
 
 /*-----------------------------------------------------------------------
  *
- *  int state (double *jd, int ntarg, int ncent, double *posn)
+ *  int state (JPLEphem *eph, double *jd, int ntarg, int ncent,
+ *             double *posn)
  *     This function reads and interpolates the JPL ephemeris,
  *     returning position and velocity of the bodies ntarg and ncent
  *     with respect to the solar system barycenter at JD (TT) time
@@ -140,6 +289,7 @@ const double *dpleph (double *jd, int ntarg, int ncent)
  *
  *     Arguments:
  *       Input:
+ *             eph   Ephemeris to read and interpolate
  *           jd[0]   JD (TT) - integer part
  *           jd[1]   JD (TT) - fractional part (-0.5 <= jdfr < +0.5)
  *           ntarg   Target number
@@ -156,26 +306,71 @@ const double *dpleph (double *jd, int ntarg, int ncent)
  *
  *----------------------------------------------------------------------*/
 
-int state (double *jd, int ntarg, int ncent, double *posn)
+int state (JPLEphem *eph, double *jd, int ntarg, int ncent, double *posn)
 {
-  double t, t1, t2 ;
-/* Masaharu Hirayama 1 November 2008: Commented out variable 'i' in the
-   following line because it is not used in any part of this function.
-  int i ;
-*/
+  double t1 ;
+  int status ;
+  ChebCache cache ;
+
+/*
+ *       Point to correct record, and get Chebyshev time in it
+ */
+  if ( ( status = findrecord (eph, jd, &t1) ) )
+    return status ;
+
+/*
+ *       Get state vector for target
+ */
+  cache.npoly = 0 ;
+  if ( getstate (eph, ntarg, t1, &cache, posn) )
+    return -1 ;
+
+/*
+ *       Get state vector for center
+ */
+  if ( ncent > 0 )
+   if ( getstate (eph, ncent, t1, &cache, posn+6) )
+     return -2 ;
+
+/*
+ *   Return
+ */
+  return 0 ;
+}
+
+/*-----------------------------------------------------------------------
+ *
+ *  int findrecord (JPLEphem *eph, double *jd, double *t1)
+ *     This function makes eph->buffer point to the record of the JPL
+ *     ephemeris that covers JD (TT) time jdint + jdfr, reading it from
+ *     the file if necessary, and computes the Chebyshev time in it.
+ *
+ *     Arguments:
+ *       Input:
+ *             eph   Ephemeris to read
+ *           jd[0]   JD (TT) - integer part
+ *           jd[1]   JD (TT) - fractional part (-0.5 <= jdfr < +0.5)
+ *       Output:
+ *              t1   Chebyshev time in the record (0 <= t1 <= 1)
+ *
+ *----------------------------------------------------------------------*/
+
+int findrecord (JPLEphem *eph, double *jd, double *t1)
+{
+  double t, t2 ;
   long recnum ;
 
 /*
  *      Reference to most recent midnight
  */
-  t1 = jd[0] - 0.5 ;
+  *t1 = jd[0] - 0.5 ;
   t2 = jd[1] + 0.5 ;
-  t = t1 + t2 ;
+  t = *t1 + t2 ;
 
 /*
  *       Error return for epoch out of range
  */
-  if ( ( t < ss1 ) || ( t > ss2 ) ) {
+  if ( ( t < eph->ss1 ) || ( t > eph->ss2 ) ) {
     fprintf (stderr, "dpleph[state]: Time %f outside range of ephemeris\n",
 	     t) ;
     return 1 ;
@@ -184,45 +379,46 @@ int state (double *jd, int ntarg, int ncent, double *posn)
 /*
  *       Calculate record # and relative time in interval
  */
-  recnum = (int) ((double) (t1 - ss1) * ss3inv) + 1 ;
-  if ( t1 == ss2 )
+  recnum = (int) ((double) (*t1 - eph->ss1) * eph->ss3inv) + 1 ;
+  if ( *t1 == eph->ss2 )
     recnum-- ;
-  t1 = ((t1 - ((double) (recnum - 1) * ss3 + ss1)) + t2) * ss3inv ;
+  *t1 = ((*t1 - ((double) (recnum - 1) * eph->ss3 + eph->ss1)) + t2) * eph->ss3inv ;
 
 /*
- *       Read correct record if not in memory
+ *       Point to correct record if all records are in memory,
+ *       otherwise read correct record if not in memory
  */
-  if ( recnum != currec ) {
-    currec = recnum ;
-    if ( readephem (recnum) ) {
+  if ( eph->table && ( recnum >= eph->firstrec ) && ( recnum < eph->firstrec + eph->ntabrec ) ) {
+    if ( recnum != eph->currec )
+      eph->nswitch++ ;
+    eph->buffer = eph->table + (recnum - eph->firstrec) * eph->buflen ;
+    eph->currec = recnum ;
+  }
+  else if ( eph->table && ( eph->ntabrec == eph->nrecs ) ) {
+    fprintf (stderr, "dpleph[state]: Record %ld outside range of ephemeris\n",
+	     recnum) ;
+    return 2 ;
+  }
+  else if ( recnum != eph->currec ) {
+    eph->nswitch++ ;
+    eph->currec = recnum ;
+    if ( eph->rdbuf == NULL )
+      eph->rdbuf = (double *) malloc (eph->buflen * sizeof (double)) ;
+    eph->buffer = eph->rdbuf ;
+    if ( ( eph->rdbuf == NULL ) || readephem (eph, recnum) ) {
       fprintf (stderr, "dpleph[state]: Read failure in ephemeris file, record %d\n",
 	       recnum) ;
       return 2 ;
     }
   }
 
-/*
- *       Get state vector for target
- */
-  if ( getstate (ntarg, t1, posn) )
-    return -1 ;
-
-/*
- *       Get state vector for center
- */
-  if ( ncent > 0 )
-   if ( getstate (ncent, t1, posn+6) )
-     return -2 ;
-
-/*
- *   Return
- */
   return 0 ;
 }
-
+
 /*-----------------------------------------------------------------------
  *
- *  int getstate (int ntarg, double t1, double *posn)
+ *  int getstate (JPLEphem *eph, int ntarg, double t1, ChebCache *cache,
+ *                double *posn)
  *     This function reads and interpolates the JPL ephemeris,
  *     returning position and velocity of body ntarg
  *     with respect to the solar system barycenter at Chebyshev time t1.
@@ -233,8 +429,12 @@ int state (double *jd, int ntarg, int ncent, double *posn)
  *
  *     Arguments:
  *       Input:
+ *             eph   Ephemeris to interpolate
  *           ntarg   Target number
  *              t1   Chebyshev time
+ *       Input/Output:
+ *           cache   Chebyshev polynomials already evaluated at t1;
+ *                   polynomials newly evaluated are added to it
  *       Output:
  *        posn[6]   Interpolated quantities requested:
  *                     posn[0:2] ntarg position  posn[3:5] ntarg velocity
@@ -242,7 +442,7 @@ int state (double *jd, int ntarg, int ncent, double *posn)
  *
  *----------------------------------------------------------------------*/
 
-int getstate (int ntarg, double t1, double *posn) {
+int getstate (JPLEphem *eph, int ntarg, double t1, ChebCache *cache, double *posn) {
   int mtarg, mcent, i ;
   double st[6], scale ;
 
@@ -259,12 +459,12 @@ int getstate (int ntarg, double t1, double *posn) {
   switch ( ntarg ) {
   case 3:               /* Earth: from EM barycenter and Moon */
     mcent = 9 ;
-    scale = -emratinv ;
+    scale = -eph->emratinv ;
     break ;
   case 10:              /* Moon: need to add EM barycenter */
     mtarg = 2 ;
     mcent = 9 ;
-    scale = 1.0 - emratinv ;
+    scale = 1.0 - eph->emratinv ;
     break ;
   case 13:              /* EM barycenter */
     mtarg = 2 ;
@@ -285,16 +485,18 @@ int getstate (int ntarg, double t1, double *posn) {
 /*
  *   Interpolate mtarg
  */
-  if ( ncf[mtarg] <= 0 ) {
+  if ( eph->ncf[mtarg] <= 0 ) {
     fprintf (stderr, "dpleph[getstate]: No data for solar system body %d\n", ntarg) ;
     return -1 ;
   }
 
   if ( mtarg >= 0 )
-    interp (buffer+iptr[mtarg]-1, t1, ncf[mtarg], na[mtarg], posn) ;
+    interpcheb (eph, eph->buffer+eph->iptr[mtarg]-1,
+		chebpoly (cache, t1, eph->na[mtarg], eph->ncf[mtarg]), eph->ncf[mtarg], posn) ;
 
   if ( mcent >= 0 ) {
-    interp (buffer+iptr[mcent]-1, t1, ncf[mcent], na[mcent], st) ;
+    interpcheb (eph, eph->buffer+eph->iptr[mcent]-1,
+		chebpoly (cache, t1, eph->na[mcent], eph->ncf[mcent]), eph->ncf[mcent], st) ;
     for (i=0; i<6; i++)
       posn[i] += st[i] * scale ;
   }
@@ -304,7 +506,7 @@ int getstate (int ntarg, double t1, double *posn) {
  */
   if ( mtarg < 12 )
     for (i=0; i<6; i++)
-      posn[i] *= aufac ;
+      posn[i] *= eph->aufac ;
   else
     for (i=0; i<3; i++)
       posn[i] /= SECDAY ;
@@ -317,13 +519,15 @@ int getstate (int ntarg, double t1, double *posn) {
 
 /*-----------------------------------------------------------------------
  *
- *  int interp (double *buf, double t1, int ncf, int na, double *pv)
+ *  int interp (JPLEphem *eph, double *buf, double t1, int ncf, int na,
+ *              double *pv)
  *
  *     This function differentiates and interpolates a
  *     set of Chebyshev coefficients to give position and velocity
  *
  *     Arguments:
  *       Input:
+ *         eph   Ephemeris that buf belongs to
  *         buf   1st location of array of Chebyshev coefficients of position
  *          t1   t1 is fractional time in interval covered by
  *               coefficients at which interpolation is wanted
@@ -337,38 +541,75 @@ int getstate (int ntarg, double t1, double *posn) {
  *
  *----------------------------------------------------------------------*/
 
-int interp (double *buf, double t1, int ncf, int na, double *pv)
+int interp (JPLEphem *eph, double *buf, double t1, int ncf, int na, double *pv)
 {
+  ChebCache cache ;
+
+  cache.npoly = 0 ;
+  interpcheb (eph, buf, chebpoly (&cache, t1, na, ncf), ncf, pv) ;
+
+/*
+ *     Return
+ */
+  return 0 ;
+}
 
-  static double pc[18], vc[18] ;
-/* Masaharu Hirayama 1 November 2008: Commented out variable 'k' in the
-   following line because it is not used in any part of this function. */
-  int i, j, /*k,*/ l ;
-  static int np = 2 ;
-  static int nv = 3 ;
-  static double twot = 0.0 ;
+/*-----------------------------------------------------------------------
+ *
+ *  ChebPoly *chebpoly (ChebCache *cache, double t1, int na, int ncf)
+ *
+ *     This function returns Chebyshev polynomials and their derivatives
+ *     for na sub-intervals evaluated at fractional time t1, taking them
+ *     from cache if already evaluated there, and evaluating (and adding
+ *     them to cache) otherwise.  At least ncf polynomials are evaluated.
+ *
+ *     Arguments:
+ *       Input/Output:
+ *       cache   Polynomials evaluated at t1 so far
+ *       Input:
+ *          t1   t1 is fractional time in interval covered by
+ *               coefficients at which interpolation is wanted
+ *               (0 <= t1 <= 1).
+ *          na   # of sets of coefficients in full array
+ *               (i.e., # of sub-intervals in full interval)
+ *         ncf   # of coefficients per component
+ *
+ *----------------------------------------------------------------------*/
+
+ChebPoly *chebpoly (ChebCache *cache, double t1, int na, int ncf)
+{
+  int i ;
   double dna, temp, dt1, tc ;
-  double *bufptr ;
-  double *pvptr ;
-  double vfac ;
+  ChebPoly *cp ;
 
-  pc[0] = 1.0 ;
-  pc[1] = 0.0 ;
-  vc[1] = 1.0 ;
+/*
+ *       Look for polynomials already evaluated for this layout
+ */
+  cp = NULL ;
+  for (i=0; i<cache->npoly; i++) {
+    if ( cache->poly[i].na == na ) {
+      cp = cache->poly + i ;
+      break ;
+    }
+  }
+
+  if ( cp == NULL ) {
+    cp = cache->poly + ( cache->npoly < MAXCHEBPOLY ? cache->npoly++ : MAXCHEBPOLY - 1 ) ;
 
 /*
  *       Get correct sub-interval number for this set of coefficients
  *       and then get normalized Chebyshev time within that subinterval
  */
-  dna = (double) na ;
-  dt1 = (int) t1 ;
-  temp = dna * t1 ;
-  l = (int) ((double) temp - dt1) ;
+    dna = (double) na ;
+    dt1 = (int) t1 ;
+    temp = dna * t1 ;
+    cp->na = na ;
+    cp->l = (int) ((double) temp - dt1) ;
 
 /*
  *         tc is the normalized chebyshev time (-1 <= tc <= 1)
  */
-  tc = 2.0 * (temp - floor(temp) + dt1) -1.0 ;
+    tc = 2.0 * (temp - floor(temp) + dt1) -1.0 ;
 
 /*
  *       Check to see whether Chebyshev time has changed,
@@ -377,94 +618,123 @@ int interp (double *buf, double t1, int ncf, int na, double *pv)
  *       contains the value of tc on the previous call.)
  *       This option was removed since it caused more grief than savings.
  */
-  np = 2 ;
-  nv = 3 ;
-  pc[1] = tc ;
-  twot = tc + tc ;
+    cp->pc[0] = 1.0 ;
+    cp->pc[1] = tc ;
+    cp->vc[1] = 1.0 ;
+    cp->twot = tc + tc ;
+    cp->vc[2] = cp->twot + cp->twot ;
+    cp->np = 2 ;
+    cp->nv = 3 ;
+  }
 
 /*
  *       Be sure that at least 'ncf' polynomials have been evaluated
  *       and are stored in the array 'pc'.
  */
-  if ( np < ncf ) {
-    for (i=np; i<ncf; i++)
-      pc[i] = twot * pc[i-1] - pc[i-2] ;
-    np = ncf ;
+  if ( cp->np < ncf ) {
+    for (i=cp->np; i<ncf; i++)
+      cp->pc[i] = cp->twot * cp->pc[i-1] - cp->pc[i-2] ;
+    cp->np = ncf ;
   }
 
+/*
+ *       If velocity interpolation is wanted, be sure enough
+ *       derivative polynomials have been generated and stored.
+ */
+  if ( cp->nv < ncf ) {
+    for (i=cp->nv; i<ncf; i++)
+      cp->vc[i] = cp->twot * cp->vc[i-1] + 2.0 * cp->pc[i-1] - cp->vc[i-2] ;
+    cp->nv = ncf ;
+  }
+
+  return cp ;
+}
+
+/*-----------------------------------------------------------------------
+ *
+ *  void interpcheb (JPLEphem *eph, double *buf, const ChebPoly *cp,
+ *                   int ncf, double *pv)
+ *
+ *     This function interpolates a set of Chebyshev coefficients to give
+ *     position and velocity, using polynomials evaluated by chebpoly
+ *
+ *     Arguments:
+ *       Input:
+ *         eph   Ephemeris that buf belongs to
+ *         buf   1st location of array of Chebyshev coefficients of position
+ *          cp   Polynomials evaluated by chebpoly for at least ncf
+ *               coefficients
+ *         ncf   # of coefficients per component
+ *       Output:
+ *       pv[6]   interpolated quantities requested.
+ *
+ *----------------------------------------------------------------------*/
+
+void interpcheb (JPLEphem *eph, double *buf, const ChebPoly *cp, int ncf, double *pv)
+{
+  int i, j ;
+  double *bufptr ;
+  double *pvptr ;
+  double vfac ;
+
 /*
  *       Interpolate to get position for each component
  */
-  bufptr = buf + l * ncf * 3 ;
+  bufptr = buf + cp->l * ncf * 3 ;
   pvptr = pv ;
   for (i=0; i<3; i++, pvptr++) {
     *pvptr = 0.0 ;
     for (j=0; j<ncf; j++)
-      *pvptr += pc[j] * *(bufptr++) ;
-  }
-
-/*
- *       If velocity interpolation is wanted, be sure enough
- *       derivative polynomials have been generated and stored.
- */
-  vfac = dna * velfac ;
-  vc[2] = twot + twot ;
-  if ( nv < ncf ) {
-    for (i=nv; i<ncf; i++)
-      vc[i] = twot * vc[i-1] + 2.0 * pc[i-1] - vc[i-2] ;
-    nv = ncf ;
+      *pvptr += cp->pc[j] * *(bufptr++) ;
   }
 
 /*
  *       Interpolate to get velocity for each component
  */
-  bufptr = buf + l * ncf * 3 ;
+  vfac = (double) cp->na * eph->velfac ;
+  bufptr = buf + cp->l * ncf * 3 ;
   pvptr = pv + 3 ;
   for (i=0; i<3; i++, pvptr++) {
     *pvptr = 0.0 ;
     bufptr++ ;
     for (j=1; j<ncf; j++)
-      *pvptr += vc[j] * *(bufptr++) ;
+      *pvptr += cp->vc[j] * *(bufptr++) ;
     *pvptr *= vfac ;
   }
-
-/*
- *     Return
- */
-  return 0 ;
 }
-
+
 /*-----------------------------------------------------------------------
  *
- *  int readephem (long recnum)
+ *  int readephem (JPLEphem *eph, long recnum)
  *
  *     This function opens the ephemeris file and reads record
  *     <recnum> from the third extension.
  *
  *     Arguments:
  *       Input:
+ *            eph   Ephemeris to read the record into
  *         recnum   record number to be read
  *
  *----------------------------------------------------------------------*/
 
-int readephem (long recnum)
+int readephem (JPLEphem *eph, long recnum)
 {
   fitsfile *ephem_file;
   int status=0 ;
   int htype, any ;
   void *dum = NULL ;
 
-  if ( (ephem_file = openFFile (ephfile) ) == NULL ) {
+  if ( (ephem_file = openFFile (eph->ephfile) ) == NULL ) {
     status = 104 ;
     fprintf(stderr, "dpleph[readephem]: Cannot open file %s\n", EPHEM) ;
   }
 
   fits_movabs_hdu (ephem_file, 4, &htype, &status) ;
-  fits_read_col (ephem_file, TDOUBLE, 1, recnum, 1, buflen, dum,
-		   buffer, &any, &status) ;
+  fits_read_col (ephem_file, TDOUBLE, 1, recnum, 1, eph->buflen, dum,
+		   eph->buffer, &any, &status) ;
 
   if ( !status )
-    currec = recnum ;
+    eph->currec = recnum ;
 
   fits_close_file (ephem_file, &status) ;
 
@@ -491,6 +761,33 @@ int readephem (long recnum)
  *----------------------------------------------------------------------*/
 
 int initephem (int ephnum, int *denum, double *c, double *radsol, double *msol)
+{
+  return initephem_r (&defephem, ephnum, denum, c, radsol, msol) ;
+}
+
+/*-----------------------------------------------------------------------
+ *
+ *  int initephem_r (JPLEphem *eph, int ephnum, int *denum, double *c,
+ *                   double *radsol, double *msol)
+ *
+ *     This function is the reentrant version of initephem.  It
+ *     initializes <eph> for using the JPL planetary ephemeris, in the
+ *     same way as initephem.  <eph> must have been created by
+ *     newephem_r or cloneephem_r.
+ *
+ *     Arguments:
+ *       Input
+ *      ephnum   requested DE number of ephemeris (0: default)
+ *       Output:
+ *         eph   Ephemeris to be initialized
+ *       denum   DE number of ephemeris sed
+ *           c   speed of light (m/s)
+ *      radsol   solar radius (light secs)
+ *        msol   GM(solar), using light second as unit of length
+ *
+ *----------------------------------------------------------------------*/
+
+int initephem_r (JPLEphem *eph, int ephnum, int *denum, double *c, double *radsol, double *msol)
 {
   fitsfile *ephem_file;
   int status=0 ;
@@ -503,6 +800,7 @@ int initephem (int ephnum, int *denum, double *c, double *radsol, double *msol)
   double x ;
   void *dum = NULL ;
   int i ;
+  int tstatus ;
 
 /*
  *    --------------------------
@@ -512,8 +810,16 @@ int initephem (int ephnum, int *denum, double *c, double *radsol, double *msol)
   *denum = 0 ;
   for (i=0; i<200; i++)
     cnam[i] = cnamchar + 7 * i ;
-  currec = 0 ;
-  if ( buffer ) free (buffer) ;
+  eph->currec = 0 ;
+  eph->nswitch = 0 ;
+  if ( eph->table && eph->owntable ) free (eph->table) ;
+  if ( eph->rdbuf ) free (eph->rdbuf) ;
+  eph->buffer = NULL ;
+  eph->table = NULL ;
+  eph->owntable = 0 ;
+  eph->firstrec = 1 ;
+  eph->ntabrec = 0 ;
+  eph->rdbuf = NULL ;
 
 /*
  *    -------------------
@@ -521,12 +827,12 @@ int initephem (int ephnum, int *denum, double *c, double *radsol, double *msol)
  *    -------------------
  */
   if ( ephnum )
-    sprintf (ephfile, "%s.%d", EPHEM, ephnum ) ;
+    sprintf (eph->ephfile, "%s.%d", EPHEM, ephnum ) ;
   else
-    strcpy (ephfile, EPHEM) ;
-  if ( (ephem_file = openFFile (ephfile) ) == NULL ) {
+    strcpy (eph->ephfile, EPHEM) ;
+  if ( (ephem_file = openFFile (eph->ephfile) ) == NULL ) {
     status = 104 ;
-    fprintf(stderr, "dpleph[initephem]: Cannot open file %s\n", ephfile) ;
+    fprintf(stderr, "dpleph[initephem]: Cannot open file %s\n", eph->ephfile) ;
     return status ;
   }
 
@@ -542,27 +848,27 @@ int initephem (int ephnum, int *denum, double *c, double *radsol, double *msol)
 	    extname);
     status = -11 ;
   }
-  fits_read_key (ephem_file, TLONG, "NAXIS2", &nrecs, comment, &status) ;
-  if ( nrecs > 200 )
-    nrecs = 200 ;
-  fits_read_col_str (ephem_file, 1, 1, 1, nrecs, "",
+  fits_read_key (ephem_file, TLONG, "NAXIS2", &eph->nrecs, comment, &status) ;
+  if ( eph->nrecs > 200 )
+    eph->nrecs = 200 ;
+  fits_read_col_str (ephem_file, 1, 1, 1, eph->nrecs, "",
 		   cnam, &any, &status) ;
-  fits_read_col (ephem_file, TDOUBLE, 2, 1, 1, nrecs, dum,
+  fits_read_col (ephem_file, TDOUBLE, 2, 1, 1, eph->nrecs, dum,
 		   cval, &any, &status) ;
-  *denum = (int) ( findcval (cnam, cval, nrecs, "DENUM") + 0.5 ) ;
-  clight = findcval (cnam, cval, nrecs, "CLIGHT") ;
-  emratinv = findcval (cnam, cval, nrecs, "EMRAT") ;
-  if ( emratinv > 0.0 )
-    emratinv = 1.0 / (1.0 + emratinv) ;
-  au = findcval (cnam, cval, nrecs, "AU") ;
-  x = au / clight ;
-  *msol = findcval (cnam, cval, nrecs, "GMS") ;
+  *denum = (int) ( findcval (cnam, cval, eph->nrecs, "DENUM") + 0.5 ) ;
+  eph->clight = findcval (cnam, cval, eph->nrecs, "CLIGHT") ;
+  eph->emratinv = findcval (cnam, cval, eph->nrecs, "EMRAT") ;
+  if ( eph->emratinv > 0.0 )
+    eph->emratinv = 1.0 / (1.0 + eph->emratinv) ;
+  eph->au = findcval (cnam, cval, eph->nrecs, "AU") ;
+  x = eph->au / eph->clight ;
+  *msol = findcval (cnam, cval, eph->nrecs, "GMS") ;
   *msol = *msol * x * x * x / (86400.0 * 86400.0) ;
-  *radsol = findcval (cnam, cval, nrecs, "RADS") ;
+  *radsol = findcval (cnam, cval, eph->nrecs, "RADS") ;
   if ( *radsol < 0.0 )
-    *radsol = findcval (cnam, cval, nrecs, "ASUN") ;
-  *radsol /= clight ;
-  *c = clight * 1000.0 ;
+    *radsol = findcval (cnam, cval, eph->nrecs, "ASUN") ;
+  *radsol /= eph->clight ;
+  *c = eph->clight * 1000.0 ;
 
 /*
  *    ----------------------
@@ -575,15 +881,15 @@ int initephem (int ephnum, int *denum, double *c, double *radsol, double *msol)
     fprintf(stderr, "Second extension of ephemeris file is wrong type\n");
     status = -12 ;
   }
-  fits_read_key (ephem_file, TLONG, "NAXIS2", &nrecs, comment, &status) ;
-  if ( nrecs > 13 )
-    nrecs = 13 ;
-  fits_read_col (ephem_file, TLONG, 2, 1, 1, nrecs, dum,
-		   iptr, &any, &status) ;
-  fits_read_col (ephem_file, TLONG, 3, 1, 1, nrecs, dum,
-		   ncf, &any, &status) ;
-  fits_read_col (ephem_file, TLONG, 4, 1, 1, nrecs, dum,
-		   na, &any, &status) ;
+  fits_read_key (ephem_file, TLONG, "NAXIS2", &eph->nrecs, comment, &status) ;
+  if ( eph->nrecs > 13 )
+    eph->nrecs = 13 ;
+  fits_read_col (ephem_file, TLONG, 2, 1, 1, eph->nrecs, dum,
+		   eph->iptr, &any, &status) ;
+  fits_read_col (ephem_file, TLONG, 3, 1, 1, eph->nrecs, dum,
+		   eph->ncf, &any, &status) ;
+  fits_read_col (ephem_file, TLONG, 4, 1, 1, eph->nrecs, dum,
+		   eph->na, &any, &status) ;
 
 /*
  *    ---------------------
@@ -596,30 +902,55 @@ int initephem (int ephnum, int *denum, double *c, double *radsol, double *msol)
     fprintf(stderr, "Third extension of ephemeris file is wrong type\n");
     status = -13 ;
   }
-  fits_read_key (ephem_file, TDOUBLE, "TSTART", &ss1, comment, &status) ;
-  fits_read_key (ephem_file, TDOUBLE, "TSTOP", &ss2, comment, &status) ;
-  fits_read_key (ephem_file, TDOUBLE, "TIMEDEL", &ss3, comment, &status) ;
-  ss3inv = 1.0 / ss3 ;
-  fits_read_key (ephem_file, TLONG, "NAXIS1", &irecsz, comment, &status) ;
-  buflen = irecsz / 8 ;
-  buffer = (double *) malloc (buflen * sizeof (double)) ;
-  fits_read_key (ephem_file, TLONG, "NAXIS2", &nrecs, comment, &status) ;
-  if ( nrecs != ((long) ((ss2 - ss1 + 0.5 ) * ss3inv)) ) {
+  fits_read_key (ephem_file, TDOUBLE, "TSTART", &eph->ss1, comment, &status) ;
+  fits_read_key (ephem_file, TDOUBLE, "TSTOP", &eph->ss2, comment, &status) ;
+  fits_read_key (ephem_file, TDOUBLE, "TIMEDEL", &eph->ss3, comment, &status) ;
+  eph->ss3inv = 1.0 / eph->ss3 ;
+  fits_read_key (ephem_file, TLONG, "NAXIS1", &eph->irecsz, comment, &status) ;
+  eph->buflen = eph->irecsz / 8 ;
+  fits_read_key (ephem_file, TLONG, "NAXIS2", &eph->nrecs, comment, &status) ;
+  if ( eph->nrecs != ((long) ((eph->ss2 - eph->ss1 + 0.5 ) * eph->ss3inv)) ) {
     fprintf(stderr, "Ephemeris file is wrong length\n");
     status = -10 ;
   }
-  aufac = 1.0 / clight ;
-  velfac = 2.0 / (ss3 * 86400.0) ;
+
+/*
+ *    ----------------------------
+ *  - Read all records into memory -
+ *    ----------------------------
+ *  Records are contiguous in the table, so that fits_read_col reads them
+ *  all at once.  If this fails, fall back on reading one record at a time.
+ */
+  if ( !status && ( eph->nrecs > 0 ) && ( eph->buflen > 0 ) ) {
+    eph->table = (double *) malloc (eph->nrecs * eph->buflen * sizeof (double)) ;
+    if ( eph->table ) {
+      tstatus = 0 ;
+      fits_read_col (ephem_file, TDOUBLE, 1, 1, 1, eph->nrecs * eph->buflen, dum,
+		     eph->table, &any, &tstatus) ;
+      if ( tstatus ) {
+	free (eph->table) ;
+	eph->table = NULL ;
+      }
+      else {
+	eph->owntable = 1 ;
+	eph->ntabrec = eph->nrecs ;
+      }
+    }
+  }
+  if ( !eph->table )
+    eph->buffer = eph->rdbuf = (double *) malloc (eph->buflen * sizeof (double)) ;
+  eph->aufac = 1.0 / eph->clight ;
+  eph->velfac = 2.0 / (eph->ss3 * 86400.0) ;
 
   if ( status )
     fprintf(stderr, "dpleph[initephem]: Failed to open %s properly; status: %d\n",
-	    ephfile, status) ;
+	    eph->ephfile, status) ;
 
   fits_close_file (ephem_file, &status) ;
 
   if ( ephnum && ( ephnum != *denum ) ) {
     fprintf(stderr, "dpleph[initephem]: DENUM of %s (%d) disagrees with request  (%d)\n",
-	    ephfile, *denum, ephnum) ;
+	    eph->ephfile, *denum, ephnum) ;
     status = -1 ;
   }
 
@@ -631,6 +962,271 @@ int initephem (int ephnum, int *denum, double *c, double *radsol, double *msol)
   return status ;
 }
 
+/*-----------------------------------------------------------------------
+ *
+ *  JPLEphem *newephem_r (void)
+ *
+ *     This function creates a new, uninitialized ephemeris, which must
+ *     be initialized by initephem_r and destroyed by freeephem_r.
+ *
+ *     Return value:
+ *         pointer to the new ephemeris, NULL on allocation failure
+ *
+ *----------------------------------------------------------------------*/
+
+JPLEphem *newephem_r (void)
+{
+  return (JPLEphem *) calloc (1, sizeof (JPLEphem)) ;
+}
+
+/*-----------------------------------------------------------------------
+ *
+ *  JPLEphem *cloneephem_r (const JPLEphem *src)
+ *
+ *     This function creates a copy of <src>, which must have been
+ *     initialized by initephem_r.  The copy gets its own current record,
+ *     so that <src> and the copy can be used independently (e.g., in
+ *     different threads) without reading the ephemeris constants from
+ *     the file again.  If all records are in memory, the copy shares
+ *     them with <src>, thus <src> must not be destroyed before the copy.
+ *     The copy must be destroyed by freeephem_r.
+ *
+ *     Arguments:
+ *       Input:
+ *          src   Ephemeris to be copied
+ *       Return value:
+ *         pointer to the copy, NULL on failure
+ *
+ *----------------------------------------------------------------------*/
+
+JPLEphem *cloneephem_r (const JPLEphem *src)
+{
+  JPLEphem *dest = NULL ;
+
+  if ( ( src == NULL ) || ( src->buflen <= 0 ) )
+    return NULL ;
+
+  if ( (dest = (JPLEphem *) malloc (sizeof (JPLEphem)) ) == NULL )
+    return NULL ;
+  *dest = *src ;
+  dest->currec = 0 ;
+  dest->nswitch = 0 ;
+  dest->owntable = 0 ;
+  dest->buffer = NULL ;
+  dest->rdbuf = NULL ;
+  if ( dest->table )
+    return dest ;
+  dest->buffer = dest->rdbuf = (double *) malloc (src->buflen * sizeof (double)) ;
+  if ( dest->rdbuf == NULL ) {
+    fprintf(stderr, "dpleph[cloneephem_r]: Cannot allocate record buffer for %s\n",
+	    src->ephfile) ;
+    free (dest) ;
+    return NULL ;
+  }
+
+  return dest ;
+}
+
+/*-----------------------------------------------------------------------
+ *
+ *  int prefetchephem_r (JPLEphem *eph, double *jd1, double *jd2,
+ *                       double **oldtable, long *nbytes)
+ *
+ *     This function makes sure that all records of <eph> that cover
+ *     JD (TT) times from jd1[0]+jd1[1] to jd2[0]+jd2[1] are in memory, in
+ *     one contiguous block, so that interpolation in that span never
+ *     reads the ephemeris file.  Nothing is read if the records are
+ *     already in memory, which is always the case if initephem_r could
+ *     read all records.  Otherwise, the records are read into a new
+ *     block that replaces the records in memory, if any.  Records outside
+ *     the block are still read on demand.
+ *
+ *     The replaced block is not freed, because copies made by
+ *     cloneephem_r may still use it.  It is set to <oldtable> instead if
+ *     it belongs to <eph>, and must be freed by the caller when no copy
+ *     of <eph> uses it any longer.  Copies made after this call share the
+ *     new block.
+ *
+ *     Arguments:
+ *       Input/Output:
+ *          eph   Ephemeris initialized by initephem_r
+ *       Input:
+ *          jd1   JD time of the start of the span, as in dpleph_r
+ *          jd2   JD time of the end of the span, as in dpleph_r
+ *       Output:
+ *     oldtable   Replaced block to be freed by the caller (or NULL)
+ *       nbytes   Number of bytes of the records read into memory
+ *       Return value:
+ *         0 on success; non-zero if the span is outside the range of the
+ *         ephemeris, or the records cannot be read
+ *
+ *----------------------------------------------------------------------*/
+
+int prefetchephem_r (JPLEphem *eph, double *jd1, double *jd2, double **oldtable, long *nbytes)
+{
+  fitsfile *ephem_file;
+  int status=0 ;
+  int htype, any ;
+  void *dum = NULL ;
+  double t, t1 ;
+  long recnum[2], nrec, jdint ;
+  double jd[2], *jdptr[2] ;
+  double *block ;
+  int i ;
+
+  *oldtable = NULL ;
+  *nbytes = 0 ;
+  if ( eph->buflen <= 0 )
+    return 1 ;
+
+/*
+ *       Calculate record #s of the start and the end of the span,
+ *       in the same way as dpleph_r and findrecord
+ */
+  jdptr[0] = jd1 ;
+  jdptr[1] = jd2 ;
+  for (i=0; i<2; i++) {
+    jdint = (long) jdptr[i][0] ;
+    jd[0] = (double) jdint ;
+    jd[1] = jdptr[i][1] + ( jdptr[i][0] - jdint ) ;
+    while ( jd[1] >= 0.5 ) {
+      jd[1]-- ;
+      jd[0]++ ;
+    }
+    while ( jd[1] < -0.5 ) {
+      jd[1]++ ;
+      jd[0]-- ;
+    }
+    t1 = jd[0] - 0.5 ;
+    t = t1 + ( jd[1] + 0.5 ) ;
+    if ( ( t < eph->ss1 ) || ( t > eph->ss2 ) ) {
+      fprintf (stderr, "dpleph[prefetchephem]: Time %f outside range of ephemeris\n",
+	       t) ;
+      return 1 ;
+    }
+    recnum[i] = (int) ((double) (t1 - eph->ss1) * eph->ss3inv) + 1 ;
+    if ( t1 == eph->ss2 )
+      recnum[i]-- ;
+    if ( recnum[i] < 1 )
+      recnum[i] = 1 ;
+    if ( recnum[i] > eph->nrecs )
+      recnum[i] = eph->nrecs ;
+  }
+  if ( recnum[0] > recnum[1] ) {
+    nrec = recnum[0] ;
+    recnum[0] = recnum[1] ;
+    recnum[1] = nrec ;
+  }
+  nrec = recnum[1] - recnum[0] + 1 ;
+
+/*
+ *       Nothing to do if the records are already in memory
+ */
+  if ( eph->table && ( recnum[0] >= eph->firstrec )
+       && ( recnum[1] < eph->firstrec + eph->ntabrec ) )
+    return 0 ;
+
+/*
+ *       Read the records at once; they are contiguous in the table
+ */
+  block = (double *) malloc (nrec * eph->buflen * sizeof (double)) ;
+  if ( block == NULL ) {
+    fprintf (stderr, "dpleph[prefetchephem]: Cannot allocate %ld records of %s\n",
+	     nrec, eph->ephfile) ;
+    return 2 ;
+  }
+  if ( (ephem_file = openFFile (eph->ephfile) ) == NULL ) {
+    fprintf(stderr, "dpleph[prefetchephem]: Cannot open file %s\n", eph->ephfile) ;
+    free (block) ;
+    return 104 ;
+  }
+  fits_movabs_hdu (ephem_file, 4, &htype, &status) ;
+  fits_read_col (ephem_file, TDOUBLE, 1, recnum[0], 1, nrec * eph->buflen, dum,
+		 block, &any, &status) ;
+  i = 0 ;
+  fits_close_file (ephem_file, &i) ;
+  if ( status ) {
+    free (block) ;
+    return status ;
+  }
+
+/*
+ *       Replace the records in memory
+ */
+  if ( eph->table && eph->owntable )
+    *oldtable = eph->table ;
+  eph->table = block ;
+  eph->owntable = 1 ;
+  eph->firstrec = recnum[0] ;
+  eph->ntabrec = nrec ;
+  eph->currec = 0 ;
+  *nbytes = nrec * eph->buflen * (long) sizeof (double) ;
+  return 0 ;
+}
+
+/*-----------------------------------------------------------------------
+ *
+ *  long ephemtablesize_r (const JPLEphem *eph)
+ *
+ *     This function returns the number of bytes of the ephemeris records
+ *     of <eph> that are held in memory, not counting a record read on
+ *     demand.
+ *
+ *     Arguments:
+ *       Input:
+ *         eph   Ephemeris to be examined (may be NULL)
+ *
+ *----------------------------------------------------------------------*/
+
+long ephemtablesize_r (const JPLEphem *eph)
+{
+  if ( ( eph == NULL ) || ( eph->table == NULL ) )
+    return 0 ;
+  return eph->ntabrec * eph->buflen * (long) sizeof (double) ;
+}
+
+/*-----------------------------------------------------------------------
+ *
+ *  long ephemswitches_r (const JPLEphem *eph)
+ *
+ *     This function returns the number of times that the record to
+ *     interpolate has been switched in <eph> since it was initialized
+ *     or cloned, which is the number of record reads when the records
+ *     are not all in memory.
+ *
+ *     Arguments:
+ *       Input:
+ *         eph   Ephemeris to be examined (may be NULL)
+ *
+ *----------------------------------------------------------------------*/
+
+long ephemswitches_r (const JPLEphem *eph)
+{
+  return ( eph == NULL ) ? 0 : eph->nswitch ;
+}
+
+/*-----------------------------------------------------------------------
+ *
+ *  void freeephem_r (JPLEphem *eph)
+ *
+ *     This function destroys <eph> created by newephem_r or
+ *     cloneephem_r, including its record buffer.
+ *
+ *     Arguments:
+ *       Input:
+ *         eph   Ephemeris to be destroyed (may be NULL)
+ *
+ *----------------------------------------------------------------------*/
+
+void freeephem_r (JPLEphem *eph)
+{
+  if ( eph == NULL )
+    return ;
+  if ( eph->table && eph->owntable ) free (eph->table) ;
+  if ( eph->rdbuf ) free (eph->rdbuf) ;
+  free (eph) ;
+}
+
 /*-----------------------------------------------------------------------
  *
  *  double findcval (char **cnam, double *cval, long n, char *name)
@@ -106,6 +106,273 @@ void glastscorbit_clearerr(GlastScFile * scfile) {
   if (scfile) scfile->status = 0;
 }
 
+/** \brief Return the numbers of searches for bracketing rows answered by the cursor, and of those that fell back on
+           binary search, for a given spacecraft file pointer. Searches answered by the run table are counted in neither
+           of them, but returned by glastscorbit_getrunstat.
+           The function returns 0 if successful, and a non-zero error code if otherwise.
+    \param scfile Spacecraft file pointer whose cursor statistics are to be returned.
+    \param num_hit Pointer to which the number of searches answered by the cursor is to be set.
+    \param num_miss Pointer to which the number of searches that fell back on binary search is to be set.
+ */
+int glastscorbit_getcursorstat(GlastScFile * scfile, long * num_hit, long * num_miss) {
+  if (NULL == scfile || NULL == num_hit || NULL == num_miss) return NULL_INPUT_PTR;
+  *num_hit = scfile->num_hit;
+  *num_miss = scfile->num_miss;
+  return 0;
+}
+
+/** \brief Return the number of searches for bracketing rows answered by the table of runs of uniform cadence
+           after the cursor missed, for a given spacecraft file pointer.
+           The function returns 0 if successful, and a non-zero error code if otherwise.
+    \param scfile Spacecraft file pointer whose run table statistics are to be returned.
+    \param num_run_hit Pointer to which the number of searches answered by the run table is to be set.
+ */
+int glastscorbit_getrunstat(GlastScFile * scfile, long * num_run_hit) {
+  if (NULL == scfile || NULL == num_run_hit) return NULL_INPUT_PTR;
+  *num_run_hit = scfile->num_run_hit;
+  return 0;
+}
+
+/** \brief Return the number of rows of the cached spacecraft data for a given spacecraft file pointer.
+           The function returns 0 if successful, and a non-zero error code if otherwise.
+    \param scfile Spacecraft file pointer whose number of rows is to be returned.
+    \param num_rows Pointer to which the number of rows is to be set.
+ */
+int glastscorbit_getnumrows(GlastScFile * scfile, long * num_rows) {
+  if (NULL == scfile || NULL == num_rows) return NULL_INPUT_PTR;
+  if (NULL == scfile->data || NULL == *(scfile->data)) return BAD_FILEPTR;
+  if (scfile->status) return BAD_FILEPTR;
+  *num_rows = (*(scfile->data))->num_rows;
+  return 0;
+}
+
+/** \brief Return the time and the spacecraft position in a given row of the cached spacecraft data for a given
+           spacecraft file pointer. The function returns 0 if successful, and a non-zero error code if otherwise.
+    \param scfile Spacecraft file pointer whose cached spacecraft data are to be returned.
+    \param irow Index of the row to return, starting from zero (0).
+    \param sctime Pointer to which the time in the row is to be set.
+    \param scposn Array to which the spacecraft position in the row is to be set. The size of the array must be at least 3.
+ */
+int glastscorbit_getrow(GlastScFile * scfile, long irow, double * sctime, double scposn[]) {
+  GlastScData * scdata = NULL;
+  int ii = 0;
+
+  if (NULL == scfile || NULL == sctime || NULL == scposn) return NULL_INPUT_PTR;
+  if (NULL == scfile->data || NULL == *(scfile->data)) return BAD_FILEPTR;
+  if (scfile->status) return BAD_FILEPTR;
+  scdata = *(scfile->data);
+  if (irow < 0 || irow >= scdata->num_rows) return BAD_ROW_NUM;
+  *sctime = scdata->sctime_array[irow];
+  for (ii = 0; ii < 3; ++ii) scposn[ii] = scdata->scposn_array[3 * irow + ii];
+  return 0;
+}
+
+/** \brief Helper function to free the per-interval table of orbit interpolation constants
+           in given spacecraft data, and to reset the pointers to the arrays in it.
+    \param scdata Spacecraft data whose table is to be freed.
+ */
+static void clear_orbit_table(GlastScData * scdata)
+{
+  int ii = 0;
+
+  free(scdata->orbit_table);
+  scdata->orbit_table = NULL;
+  scdata->sclength_array = NULL;
+  scdata->scangle_array = NULL;
+  for (ii = 0; ii < 3; ++ii) {
+    scdata->scbasis1_array[ii] = NULL;
+    scdata->scbasis2_array[ii] = NULL;
+  }
+}
+
+/** \brief Helper function to compute constants for orbit interpolation that depend only on
+           a pair of neighboring rows of the cached spacecraft positions, for all the pairs.
+           For each interval, the spacecraft position is interpolated as
+           intlength * (basis1 * cos(fract * angle) + basis2 * sin(fract * angle)), where
+           intlength is the length of the spacecraft position vector linearly interpolated
+           between the rows, and fract is the fraction of the interval elapsed.
+           The constants are stored in separate arrays, one per quantity, so that time-ordered
+           calls to glastscorbit_calcpos read each array sequentially. The table is optional:
+           if memory allocation fails, no table is stored, and glastscorbit_calcpos computes
+           the same quantities for each call instead.
+    \param scdata Spacecraft data whose spacecraft positions are to be precomputed.
+ */
+static void build_orbit_table(GlastScData * scdata)
+{
+  long num_interval = scdata->num_rows - 1;
+  long irow = 0;
+  int ii = 0;
+
+  /* Allocate one memory block for all the arrays: one length per row, and seven values per interval. */
+  clear_orbit_table(scdata);
+  scdata->orbit_table = malloc(sizeof(double) * (scdata->num_rows + 7 * num_interval));
+  if (NULL == scdata->orbit_table) return;
+  scdata->sclength_array = scdata->orbit_table;
+  scdata->scangle_array = scdata->sclength_array + scdata->num_rows;
+  for (ii = 0; ii < 3; ++ii) {
+    scdata->scbasis1_array[ii] = scdata->scangle_array + (1 + ii) * num_interval;
+    scdata->scbasis2_array[ii] = scdata->scangle_array + (4 + ii) * num_interval;
+  }
+
+  /* Compute the length of the spacecraft position vector in each row. */
+  for (irow = 0; irow < scdata->num_rows; ++irow) {
+    double * scposn = scdata->scposn_array + 3 * irow;
+    scdata->sclength_array[irow] = sqrt(inner_product(scposn, scposn));
+  }
+
+  /* Compute the base vectors and the angle for each interval, in the same way as glastscorbit_calcpos does. */
+  /* Note: Degenerate cases are expressed with a zero angle and a null second base vector, so that
+     the interpolation formula reproduces the results of glastscorbit_calcpos for them exactly. */
+  for (irow = 0; irow < num_interval; ++irow) {
+    double * scposn1 = scdata->scposn_array + 3 * irow;
+    double * scposn2 = scposn1 + 3;
+    double length1 = scdata->sclength_array[irow];
+    double length2 = scdata->sclength_array[irow + 1];
+    double length12 = 0.;
+    double vector12[3], vectprod_out[3];
+
+    /* Compute a base vector on the orbital plane (vector12). */
+    outer_product(scposn1, scposn2, vectprod_out);
+    outer_product(vectprod_out, scposn1, vector12);
+    length12 = sqrt(inner_product(vector12, vector12));
+
+    if ((length1 == 0.0) && (length2 == 0.0)) {
+      /* both vectors are null */
+      scdata->scangle_array[irow] = 0.0;
+      for (ii = 0; ii < 3; ++ii) {
+        scdata->scbasis1_array[ii][irow] = 0.0;
+        scdata->scbasis2_array[ii][irow] = 0.0;
+      }
+
+    } else if (length1 == 0.0) {
+      /* scposn1 is null, but scposn2 is not */
+      scdata->scangle_array[irow] = 0.0;
+      for (ii = 0; ii < 3; ++ii) {
+        scdata->scbasis1_array[ii][irow] = scposn2[ii] / length2;
+        scdata->scbasis2_array[ii][irow] = 0.0;
+      }
+
+    } else if ((length2 == 0.0) || (length12 == 0.0)) {
+      /* left:  scposn2 is null, but scposn1 is not */
+      /* right: either vector is not null, but they are parallel */
+      scdata->scangle_array[irow] = 0.0;
+      for (ii = 0; ii < 3; ++ii) {
+        scdata->scbasis1_array[ii][irow] = scposn1[ii] / length1;
+        scdata->scbasis2_array[ii][irow] = 0.0;
+      }
+
+    } else { /* Both has a non-zero length, and they are not parallel. */
+      scdata->scangle_array[irow] = acos(inner_product(scposn1, scposn2) / length1 / length2);
+      for (ii = 0; ii < 3; ++ii) {
+        scdata->scbasis1_array[ii][irow] = scposn1[ii] / length1;
+        scdata->scbasis2_array[ii][irow] = vector12[ii] / length12;
+      }
+    }
+  }
+}
+
+/** \brief Helper function to free the table of runs of intervals of uniform length in given
+           spacecraft data, and to reset the pointer to it.
+    \param scdata Spacecraft data whose table is to be freed.
+ */
+static void clear_run_table(GlastScData * scdata)
+{
+  free(scdata->run_array);
+  scdata->run_array = NULL;
+  scdata->num_runs = 0;
+}
+
+/** \brief Helper function to find the end of a run of intervals of uniform length that starts at
+           a given row, and return the index of the first interval after the run. A run continues as
+           long as the time in each row is on the grid of the first interval of the run, within the
+           time tolerance.
+    \param sctime Times in the rows of spacecraft data, in time order.
+    \param first_row Index of the first row of the run.
+    \param num_interval The number of intervals in the spacecraft data.
+ */
+static long find_run_end(double sctime[], long first_row, long num_interval)
+{
+  double step = sctime[first_row + 1] - sctime[first_row];
+  long irow = first_row + 1;
+
+  for (; irow < num_interval; ++irow) {
+    if (fabs(sctime[irow + 1] - sctime[first_row] - (irow + 1 - first_row) * step) > time_tolerance) break;
+  }
+  return irow;
+}
+
+/** \brief Helper function to split the intervals of the cached spacecraft data into runs, in each
+           of which the rows are sampled at a uniform cadence within the time tolerance, so that the
+           interval that contains a given time can be computed arithmetically in a run. A gap between
+           runs forms a run of its own. The table is optional: if memory allocation fails, or if the
+           rows are not in time order, no table is stored, and search_interval uses binary search.
+    \param scdata Spacecraft data whose table of runs is to be built.
+ */
+static void build_run_table(GlastScData * scdata)
+{
+  long num_interval = scdata->num_rows - 1;
+  long num_runs = 0;
+  long irow = 0;
+  double * sctime = scdata->sctime_array;
+
+  /* Count the runs, checking that the rows are in time order. */
+  clear_run_table(scdata);
+  for (irow = 0; irow < num_interval; ++irow) {
+    if (sctime[irow + 1] <= sctime[irow]) return;
+  }
+  for (irow = 0; irow < num_interval; irow = find_run_end(sctime, irow, num_interval)) ++num_runs;
+
+  /* Allocate the table, and fill it in the same way as above. */
+  scdata->run_array = malloc(sizeof(GlastScRun) * num_runs);
+  if (NULL == scdata->run_array) return;
+  scdata->num_runs = num_runs;
+  for (irow = 0, num_runs = 0; irow < num_interval; ++num_runs) {
+    GlastScRun * run = scdata->run_array + num_runs;
+    run->first_interval = irow;
+    run->start_time = sctime[irow];
+    run->step = sctime[irow + 1] - sctime[irow];
+    irow = find_run_end(sctime, irow, num_interval);
+    run->num_intervals = irow - run->first_interval;
+  }
+}
+
+/** \brief Helper function to find the interval that contains a given time from the table of runs
+           of the cached spacecraft data, with a binary search over the runs, and an arithmetic
+           computation within a run. The index of the first row of the interval is set to the
+           argument of the function. The function returns a pointer to the time in the first row
+           of the interval if successful, and a null pointer if the table does not give an answer.
+    \param scdata Spacecraft data whose table of runs is to be searched.
+    \param evtime_array Time to search for, given as an interval of zero length as for compare_interval.
+ */
+static double * search_run_table(GlastScData * scdata, double evtime_array[2])
+{
+  GlastScRun * run = NULL;
+  long low = 0;
+  long high = scdata->num_runs;
+  long interval = 0;
+  long ii = 0;
+
+  /* Find the last run that starts at or before the given time. */
+  if (NULL == scdata->run_array || evtime_array[0] < scdata->run_array[0].start_time) return NULL;
+  while (high - low > 1) {
+    long middle = low + (high - low) / 2;
+    if (scdata->run_array[middle].start_time <= evtime_array[0]) low = middle;
+    else high = middle;
+  }
+  run = scdata->run_array + low;
+
+  /* Compute the interval in the run, and confirm it, allowing for rounding errors. */
+  interval = (long)floor((evtime_array[0] - run->start_time) / run->step);
+  if (interval >= run->num_intervals) interval = run->num_intervals - 1;
+  interval += run->first_interval;
+  for (ii = interval - 1; ii <= interval + 1; ++ii) {
+    if (ii >= 0 && ii < scdata->num_rows - 1 && 0 == compare_interval(evtime_array, scdata->sctime_array + ii)) {
+      return scdata->sctime_array + ii;
+    }
+  }
+  return NULL;
+}
+
 /** \brief Helper function to detach spacecraft data from a given spacecraft file pointer.
            If no other spacecraft file pointer needs the spacecraft data any longer,
            the function also cleans up the contents of the spacecraft data.
@@ -146,6 +413,17 @@ static int detach_scdata(GlastScFile * scfile)
       scdata->sctime_array = NULL;
       scdata->sctime_array_size = 0;
 
+      /* Free the allocated memory space for "SC_POSITION" column. */
+      free(scdata->scposn_array);
+      scdata->scposn_array = NULL;
+      scdata->scposn_array_size = 0;
+
+      /* Free the allocated memory space for orbit interpolation constants. */
+      clear_orbit_table(scdata);
+
+      /* Free the allocated memory space for runs of uniform cadence. */
+      clear_run_table(scdata);
+
       /* Free the allocated memory space for names. */
       free(scdata->filename);
       scdata->filename = NULL;
@@ -204,12 +482,20 @@ GlastScFile * glastscorbit_open(char *filename, char *extname)
   GlastScData * scdata = NULL;
   GlastScData ** scitor = NULL;
   int colnum_start = 0;
+  int typecode_scposn = 0;
+  long repeat_scposn = 0;
+  long width_scposn = 0;
+  long irow = 0;
 
   /* Create an object to return, and initialize the contents. */
   scfile = malloc(sizeof(GlastScFile));
   if (NULL == scfile) return scfile;
   scfile->data = NULL;
   scfile->status = 0;
+  scfile->cursor = -1;
+  scfile->num_hit = 0;
+  scfile->num_run_hit = 0;
+  scfile->num_miss = 0;
 
   /* Check the pointer arguments. */
   if (NULL == filename || NULL == extname) {
@@ -266,6 +552,12 @@ GlastScFile * glastscorbit_open(char *filename, char *extname)
   scdata->colnum_scposn = 0;
   scdata->sctime_array = NULL;
   scdata->sctime_array_size = 0;
+  scdata->scposn_array = NULL;
+  scdata->scposn_array_size = 0;
+  scdata->orbit_table = NULL;
+  clear_orbit_table(scdata);
+  scdata->run_array = NULL;
+  clear_run_table(scdata);
   scdata->filename = NULL;
   scdata->extname = NULL;
   scdata->open_count = 1;
@@ -308,6 +600,37 @@ GlastScFile * glastscorbit_open(char *filename, char *extname)
   /* Read "START" column. */
   fits_read_col(scdata->fits_ptr, TDOUBLE, colnum_start, 1, 1, scdata->num_rows, 0, scdata->sctime_array, 0, &(scfile->status));
 
+  /* Allocate memory space to cache "SC_POSITION" column. */
+  if (0 == scfile->status) {
+    scdata->scposn_array = malloc(sizeof(double) * 3 * scdata->num_rows);
+    if (NULL == scdata->scposn_array) {
+      scdata->scposn_array_size = 0;
+      scfile->status = MEMORY_ALLOCATION;
+    } else {
+      scdata->scposn_array_size = 3 * scdata->num_rows;
+    }
+  }
+
+  /* Read "SC_POSITION" column, so that glastscorbit_calcpos needs no file I/O. */
+  /* Note: Read the whole column at once if it has exactly three elements per row.
+     Otherwise, read the first three elements row by row. */
+  fits_get_coltype(scdata->fits_ptr, scdata->colnum_scposn, &typecode_scposn, &repeat_scposn, &width_scposn, &(scfile->status));
+  if (0 == scfile->status && 3 == repeat_scposn) {
+    fits_read_col(scdata->fits_ptr, TDOUBLE, scdata->colnum_scposn, 1, 1, 3 * scdata->num_rows, 0, scdata->scposn_array, 0,
+      &(scfile->status));
+  } else {
+    for (irow = 0; 0 == scfile->status && irow < scdata->num_rows; ++irow) {
+      fits_read_col(scdata->fits_ptr, TDOUBLE, scdata->colnum_scposn, irow + 1, 1, 3, 0, scdata->scposn_array + 3 * irow, 0,
+        &(scfile->status));
+    }
+  }
+
+  /* Precompute constants for orbit interpolation, so that glastscorbit_calcpos needs no per-interval computation. */
+  if (0 == scfile->status) build_orbit_table(scdata);
+
+  /* Find runs of uniform cadence, so that search_interval needs no binary search over all the rows. */
+  if (0 == scfile->status) build_run_table(scdata);
+
   /* Finally check errors in opening file. If an error occurred, close spacecraft file
      and free all the allocated memory spaces. Ignore an error in closing file, and
      preserve the error in opening it. */
@@ -317,14 +640,227 @@ GlastScFile * glastscorbit_open(char *filename, char *extname)
   return scfile;
 }
 
-/** \brief Read spacecraft positions from file and computes interpolated position.
+/** \brief Copy the cursor in a spacecraft file pointer to a given cursor.
+    \param scfile Spacecraft file pointer whose cursor is to be copied.
+    \param cursor Cursor to which the cursor in the spacecraft file pointer is to be copied.
+ */
+static void load_cursor(GlastScFile * scfile, GlastScCursor * cursor)
+{
+  cursor->interval = scfile->cursor;
+  cursor->num_hit = scfile->num_hit;
+  cursor->num_run_hit = scfile->num_run_hit;
+  cursor->num_miss = scfile->num_miss;
+}
+
+/** \brief Copy a given cursor to the cursor in a spacecraft file pointer.
+    \param cursor Cursor to be copied.
+    \param scfile Spacecraft file pointer to whose cursor the given cursor is to be copied.
+ */
+static void store_cursor(GlastScCursor * cursor, GlastScFile * scfile)
+{
+  scfile->cursor = cursor->interval;
+  scfile->num_hit = cursor->num_hit;
+  scfile->num_run_hit = cursor->num_run_hit;
+  scfile->num_miss = cursor->num_miss;
+}
+
+/** \brief Helper function to find the interval between two neighboring rows of the cached
+           spacecraft data that contains a given time. The index of the first row of the interval,
+           starting from zero (0), is set to the argument of the function. The function returns 0
+           if successful, and TIME_OUT_BOUNDS defined in glastscorbit.h if the given time is not
+           covered by the spacecraft data. The caller must check the given spacecraft data.
+    \param scdata Cached spacecraft data to be searched.
+    \param cursor Cursor to start the search with, which is updated with the result of the search.
+    \param t Time in Mission Elapsed Time (MET) to search for.
+    \param interval Pointer to which the index of the first row of the interval is to be set.
+ */
+static int search_interval(GlastScData * scdata, GlastScCursor * cursor, double t, long * interval)
+{
+  double evtime_array[2];
+  double *sctime_ptr = NULL;
+  int ii = 0;
+
+  /* Find two neighboring rows that bracket the given time. */
+  if (fabs(t - scdata->sctime_array[0]) <= time_tolerance) {
+    /* In this case, the given time is close enough to the time in the
+       first row within the given tolerance.  So, use the first two
+       rows for the computation. */
+    *interval = 0;
+
+  } else if (fabs(t - scdata->sctime_array[scdata->num_rows-1]) <= time_tolerance) {
+    /* In this case, the given time is close enough to the time in the
+       final row within the given tolerance.  So, use the penultimate
+       row and the final row for the computation. */
+    *interval = scdata->num_rows - 2;
+
+  } else {
+    evtime_array[0] = evtime_array[1] = t;
+
+    /* Try the interval found by the previous search and the next one first, because
+       event times are usually sorted, then the table of runs of uniform cadence, and fall
+       back on binary search if none of them gives the interval that contains the given time. */
+    sctime_ptr = NULL;
+    for (ii = 0; ii < 2; ++ii) {
+      long cursor_interval = cursor->interval + ii;
+      if (cursor_interval >= 0 && cursor_interval < scdata->num_rows - 1
+          && 0 == compare_interval(evtime_array, scdata->sctime_array + cursor_interval)) {
+        sctime_ptr = scdata->sctime_array + cursor_interval;
+        break;
+      }
+    }
+    if (sctime_ptr) {
+      cursor->num_hit++;
+    } else if (NULL != (sctime_ptr = search_run_table(scdata, evtime_array))) {
+      cursor->num_run_hit++;
+    } else {
+      cursor->num_miss++;
+      sctime_ptr = (double *)bsearch(evtime_array, scdata->sctime_array, scdata->num_rows - 1, sizeof(double), compare_interval);
+    }
+    if (NULL == sctime_ptr) {
+      /* In this case, the given time is out of bounds. */
+      return TIME_OUT_BOUNDS; /* Defined in glastscorbit.h. */
+    }
+
+    /* In this case, the given time is between the first and the
+       final rows, so use the row returned by bsearch and the next
+       row for the computation. */
+    *interval = sctime_ptr - scdata->sctime_array;
+  }
+
+  /* Remember the interval for the next search. */
+  cursor->interval = *interval;
+  return 0;
+}
+
+/** \brief Find the interval between two neighboring rows of the cached spacecraft data that
+           contains a given time, and set the index of the first row of the interval, starting
+           from zero (0), to the argument of the function. Spacecraft positions interpolated by
+           glastscorbit_calcpos change smoothly within an interval, but not across rows.
+           The function returns 0 if successful, and a non-zero error code if otherwise,
+           in the same manner as glastscorbit_calcpos.
+    \param scfile Spacecraft file pointer whose cached spacecraft data are to be searched.
+    \param t Time in Mission Elapsed Time (MET) to search for.
+    \param interval Pointer to which the index of the first row of the interval is to be set.
+ */
+int glastscorbit_getinterval(GlastScFile * scfile, double t, long * interval)
+{
+  GlastScCursor cursor;
+  int status = 0;
+
+  /* Search with the cursor in the spacecraft file pointer. */
+  if (NULL == scfile) return NULL_INPUT_PTR;
+  load_cursor(scfile, &cursor);
+  status = glastscorbit_getinterval_r(scfile, &cursor, t, interval);
+  store_cursor(&cursor, scfile);
+  return status;
+}
+
+/** \brief Initialize a caller-owned cursor for glastscorbit_calcpos_r and glastscorbit_getinterval_r,
+           so that the first search with it starts with no interval found yet and no statistics.
+    \param cursor Cursor to be initialized.
+ */
+void glastscorbit_initcursor(GlastScCursor * cursor)
+{
+  if (NULL == cursor) return;
+  cursor->interval = -1;
+  cursor->num_hit = 0;
+  cursor->num_run_hit = 0;
+  cursor->num_miss = 0;
+}
+
+/** \brief Reentrant version of glastscorbit_getinterval, which starts the search with a caller-owned cursor,
+           instead of the cursor in the spacecraft file pointer, and updates the given cursor and its statistics.
+           The function reads the cached spacecraft data, but modifies neither them nor the spacecraft file pointer,
+           so that threads with their own cursors may call it concurrently for the same spacecraft file, provided that
+           none of them opens or closes a spacecraft file at the same time.
+    \param scfile Spacecraft file pointer whose cached spacecraft data are to be searched.
+    \param cursor Cursor to start the search with, initialized by glastscorbit_initcursor.
+    \param t Time in Mission Elapsed Time (MET) to search for.
+    \param interval Pointer to which the index of the first row of the interval is to be set.
+ */
+int glastscorbit_getinterval_r(GlastScFile * scfile, GlastScCursor * cursor, double t, long * interval)
+{
+  /* Check the arguments. */
+  /* Note: Do NOT override scfile->status with these status codes, because
+     these errors are not from an I/O operation by this function. */
+  if (NULL == scfile || NULL == cursor || NULL == interval) return NULL_INPUT_PTR;
+  if (NULL == scfile->data || NULL == *(scfile->data)) return BAD_FILEPTR;
+  if (scfile->status) return BAD_FILEPTR;
+
+  /* Search for the interval. */
+  return search_interval(*(scfile->data), cursor, t, interval);
+}
+
+/** \brief Compute a spacecraft position at a given time by interpolation between two given spacecraft positions.
+           The positions are interpolated linearly in length and in orbital phase on the plane that contains
+           both of the given positions. The resultant spacecraft position is set to the last argument.
+    \param t Time in Mission Elapsed Time (MET) at which the spacecraft position is to be computed.
+    \param sctime1 Time in Mission Elapsed Time (MET) of the first spacecraft position.
+    \param scposn1 The first spacecraft position, whose size must be at least 3.
+    \param sctime2 Time in Mission Elapsed Time (MET) of the second spacecraft position.
+    \param scposn2 The second spacecraft position, whose size must be at least 3.
+    \param intposn Array to which interpolated spacecraft position at the given time is to be set,
+           in the same manner as in glastscorbit_calcpos. The size of the array must be at least 3.
+ */
+void glastscorbit_interpolate(double t, double sctime1, double scposn1[], double sctime2, double scposn2[], double intposn[])
+{
+  double fract, length1, length2, length12, intlength;
+  double vector12[3], vectprod_out[3];
+  int ii = 0;
+
+  /* Interpolate. */
+  fract = (t - sctime1) / (sctime2 - sctime1);
+
+  /* Linear interpolation for vector length. */
+  length1 = sqrt(inner_product(scposn1, scposn1));
+  length2 = sqrt(inner_product(scposn2, scposn2));
+  intlength = length1 + fract*(length2 - length1);
+
+  /* Compute a base vector on the orbital plane (vector12). */
+  outer_product(scposn1, scposn2, vectprod_out);
+  outer_product(vectprod_out, scposn1, vector12);
+  length12 = sqrt(inner_product(vector12, vector12));
+
+  /* Check vectors scposn1 and scposn2. */
+  if ((length1 == 0.0) && (length2 == 0.0)) {
+    /* both vectors are null */
+    for (ii = 0; ii < 3; ++ii) intposn[ii] = 0.0;
+
+  } else if (length1 == 0.0) {
+    /* scposn1 is null, but scposn2 is not */
+    for (ii = 0; ii < 3; ++ii) {
+      intposn[ii] = scposn2[ii] / length2 * intlength;
+    }
+
+  } else if ((length2 == 0.0) || (length12 == 0.0)) {
+    /* left:  scposn2 is null, but scposn1 is not */
+    /* right: either vector is not null, but they are parallel */
+    for (ii = 0; ii < 3; ++ii) {
+      intposn[ii] = scposn1[ii] / length1 * intlength;
+    }
+
+  } else { /* Both has a non-zero length, and they are not parallel. */
+    double inttheta, factor_cos, factor_sin;
+    /* Linear interpolation for orbital phase. */
+    inttheta = fract * acos(inner_product(scposn1, scposn2)
+                            / length1 / length2);
+    factor_cos = cos(inttheta);
+    factor_sin = sin(inttheta);
+    for (ii = 0; ii < 3; ++ii) {
+      intposn[ii] = intlength * (scposn1[ii] / length1 * factor_cos
+                                 + vector12[ii] / length12 * factor_sin);
+    }
+  }
+}
+
+/** \brief Compute interpolated spacecraft position from the cached spacecraft positions.
            The resultant spacecraft position is set to the argument of the function.
            The function returns 0 if successful, and a non-zero error code if otherwise.
            The returned error code can be decoded as a FITS error code, except a given
            time is not covered by the given spacecraft file, in which case the function
-           returns TIME_OUT_BOUNDS defined in glastscorbit.h. If an error occurs in file
-           I/O operation(s), then the function also sets the error code from the file I/O
-           to the given spacecraft file structure. The function does not perform any
+           returns TIME_OUT_BOUNDS defined in glastscorbit.h. The spacecraft positions are
+           read from file by glastscorbit_open, so the function performs no file I/O
+           operation. The function does not perform any
            computation when the given spacecraft file already has an I/O error. To clear
            the error code, call glastscorbit_clearerr with the structure.
     \param scfile Spacecraft file pointer whose contents is to be cleaned.
@@ -336,16 +872,43 @@ GlastScFile * glastscorbit_open(char *filename, char *extname)
            and intposn[2] z. The size of the array must be at least 3.
  */
 int glastscorbit_calcpos(GlastScFile * scfile, double t, double intposn[3])
+{
+  GlastScCursor cursor;
+  int status = 0;
+  int ii = 0;
+
+  /* Clear the previously stored values. */
+  for (ii = 0; ii < 3; ++ii) intposn[ii] = 0.0;
+
+  /* Compute with the cursor in the spacecraft file pointer. */
+  if (NULL == scfile) return NULL_INPUT_PTR;
+  load_cursor(scfile, &cursor);
+  status = glastscorbit_calcpos_r(scfile, &cursor, t, intposn);
+  store_cursor(&cursor, scfile);
+  return status;
+}
+
+/** \brief Reentrant version of glastscorbit_calcpos, which searches for the interval that contains a given time with
+           a caller-owned cursor, instead of the cursor in the spacecraft file pointer, and updates the given cursor and
+           its statistics. The function reads the cached spacecraft data, but modifies neither them nor the spacecraft
+           file pointer, so that threads with their own cursors may call it concurrently for the same spacecraft file,
+           provided that none of them opens or closes a spacecraft file at the same time.
+    \param scfile Spacecraft file pointer whose cached spacecraft data are to be used.
+    \param cursor Cursor to start the search with, initialized by glastscorbit_initcursor.
+    \param t Time in Mission Elapsed Time (MET) at which the spacecraft position is to be computed.
+    \param intposn Array to which interpolated spacecraft position at the given time is to be set,
+           in the same manner as glastscorbit_calcpos.
+ */
+int glastscorbit_calcpos_r(GlastScFile * scfile, GlastScCursor * cursor, double t, double intposn[])
 {
   GlastScData * scdata = NULL;
-  double evtime_array[2];
-  double *sctime_ptr = NULL;
+  long interval = 0;
   long scrow1 = 0;
   long scrow2 = 0;
   double sctime1 = 0.;
   double sctime2 = 0.;
-  double scposn1[3] = { 0., 0., 0. };
-  double scposn2[3] = { 0., 0., 0. };
+  double *scposn1 = NULL;
+  double *scposn2 = NULL;
   double fract = 0.;
   int ii = 0;
 
@@ -355,7 +918,7 @@ int glastscorbit_calcpos(GlastScFile * scfile, double t, double intposn[3])
   /* Do nothing if no spacecraft file information is available. */
   /* Note: Do NOT override scfile->status with this status, because
      this error is not from an I/O operation by this function. */
-  if (NULL == scfile) return NULL_INPUT_PTR;
+  if (NULL == scfile || NULL == cursor) return NULL_INPUT_PTR;
   if (NULL == scfile->data || NULL == *(scfile->data)) return BAD_FILEPTR;
 
   /* Return an error status if an error has occurred on this file. */
@@ -368,96 +931,37 @@ int glastscorbit_calcpos(GlastScFile * scfile, double t, double intposn[3])
 
   /* Find two neighboring rows from which the spacecraft position at
      the given time will be computed. */
-  if (fabs(t - scdata->sctime_array[0]) <= time_tolerance) {
-    /* In this case, the given time is close enough to the time in the
-       first row within the given tolerance.  So, use the first two
-       rows for the computation. */
-    scrow1 = 1;
-    scrow2 = 2;
-    sctime1 = scdata->sctime_array[0];
-    sctime2 = scdata->sctime_array[1];
-
-  } else if (fabs(t - scdata->sctime_array[scdata->num_rows-1]) <= time_tolerance) {
-    /* In this case, the given time is close enough to the time in the
-       final row within the given tolerance.  So, use the penultimate
-       row and the final row for the computation. */
-    scrow1 = scdata->num_rows - 1;
-    scrow2 = scdata->num_rows;
-    sctime1 = scdata->sctime_array[scdata->num_rows - 2];
-    sctime2 = scdata->sctime_array[scdata->num_rows - 1];
-
-  } else {
-    evtime_array[0] = evtime_array[1] = t;
-    sctime_ptr = (double *)bsearch(evtime_array, scdata->sctime_array, scdata->num_rows - 1, sizeof(double), compare_interval);
-    if (NULL == sctime_ptr) {
-      /* In this case, the given time is out of bounds. */
-      /* Note: Do NOT override scfile->status with this status, because
-         this error is not from an I/O operation by this function. */
-      return TIME_OUT_BOUNDS; /* Defined in glastscorbit.h. */
-    }
-
-    /* In this case, the given time is between the first and the
-       final rows, so use the row returned by bsearch and the next
-       row for the computation. */
-    scrow1 = sctime_ptr - scdata->sctime_array + 1;
-    scrow2 = scrow1 + 1;
-    sctime1 = sctime_ptr[0];
-    sctime2 = sctime_ptr[1];
-  }
-
-  /* Read "SC_POSITION" column in the two rows found above. */
-  fits_read_col(scdata->fits_ptr, TDOUBLE, scdata->colnum_scposn, scrow1, 1, 3, 0, scposn1, 0, &(scfile->status));
-  fits_read_col(scdata->fits_ptr, TDOUBLE, scdata->colnum_scposn, scrow2, 1, 3, 0, scposn2, 0, &(scfile->status));
+  /* Note: Do NOT override scfile->status with this status, because
+     this error is not from an I/O operation by this function. */
+  if (search_interval(scdata, cursor, t, &interval)) return TIME_OUT_BOUNDS;
+  scrow1 = interval + 1;
+  scrow2 = scrow1 + 1;
+  sctime1 = scdata->sctime_array[interval];
+  sctime2 = scdata->sctime_array[interval + 1];
 
-  /* Return if an error occurs while reading "SC_POSITION" columns. */
-  if (scfile->status) return scfile->status;
+  /* Look up "SC_POSITION" column in the two rows found above. */
+  scposn1 = scdata->scposn_array + 3 * (scrow1 - 1);
+  scposn2 = scdata->scposn_array + 3 * (scrow2 - 1);
 
   /* Interpolate. */
   fract = (t - sctime1) / (sctime2 - sctime1);
-  {
-    double length1, length2, length12, intlength;
-    double vector12[3], vectprod_out[3];
-    
-    /* Linear interpolation for vector length. */
-    length1 = sqrt(inner_product(scposn1, scposn1));
-    length2 = sqrt(inner_product(scposn2, scposn2));
-    intlength = length1 + fract*(length2 - length1);
-
-    /* Compute a base vector on the orbital plane (vector12). */
-    outer_product(scposn1, scposn2, vectprod_out);
-    outer_product(vectprod_out, scposn1, vector12);
-    length12 = sqrt(inner_product(vector12, vector12));
-
-    /* Check vectors scposn1 and scposn2. */
-    if ((length1 == 0.0) && (length2 == 0.0)) {
-      /* both vectors are null */
-      for (ii = 0; ii < 3; ++ii) intposn[ii] = 0.0;
-
-    } else if (length1 == 0.0) {
-      /* scposn1 is null, but scposn2 is not */
-      for (ii = 0; ii < 3; ++ii) {
-	intposn[ii] = scposn2[ii] / length2 * intlength;
-      }
-
-    } else if ((length2 == 0.0) || (length12 == 0.0)) {
-      /* left:  scposn2 is null, but scposn1 is not */
-      /* right: either vector is not null, but they are parallel */
-      for (ii = 0; ii < 3; ++ii) {
-	intposn[ii] = scposn1[ii] / length1 * intlength;
-      }
-
-    } else { /* Both has a non-zero length, and they are not parallel. */
-      double inttheta, factor_cos, factor_sin;
-      /* Linear interpolation for orbital phase. */
-      inttheta = fract * acos(inner_product(scposn1, scposn2)
-			      / length1 / length2);
-      factor_cos = cos(inttheta);
-      factor_sin = sin(inttheta);
-      for (ii = 0; ii < 3; ++ii) {
-	intposn[ii] = intlength * (scposn1[ii] / length1 * factor_cos 
-				   + vector12[ii] / length12 * factor_sin);
-      }
+  if (scdata->orbit_table) {
+    double intlength, inttheta, factor_cos, factor_sin;
+
+    /* Use the precomputed constants for this interval. */
+    intlength = scdata->sclength_array[interval]
+      + fract*(scdata->sclength_array[interval + 1] - scdata->sclength_array[interval]);
+    inttheta = fract * scdata->scangle_array[interval];
+    factor_cos = cos(inttheta);
+    factor_sin = sin(inttheta);
+    for (ii = 0; ii < 3; ++ii) {
+      intposn[ii] = intlength * (scdata->scbasis1_array[ii][interval] * factor_cos
+                                 + scdata->scbasis2_array[ii][interval] * factor_sin);
     }
+
+  } else {
+    /* Compute the interpolation from the two rows. */
+    glastscorbit_interpolate(t, sctime1, scposn1, sctime2, scposn2, intposn);
   }
 
   /* Return the computed spacecraft position. */
@@ -116,8 +116,8 @@ dec [double]
 (leapsecfile = DEFAULT) [file name]
     Name of the file containing the name of the leap second table, in
     OGIP-compliant leap second table format. If leapsecfile is the
-    string DEFAULT, the default leap-second file (leapsec.fits), which
-    is distributed with the extFiles package, will be used.
+    string DEFAULT, the leap second table built into the timeSystem
+    library, which is up to date as of its release, will be used.
 \endverbatim
 
 */
@@ -2,11 +2,14 @@
     \brief Unit test for timeSystem package.
     \author Masa Hirayama, James Peachey
 */
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <exception>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <list>
 #include <memory>
@@ -14,20 +17,24 @@
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "st_app/AppParGroup.h"
 #include "st_app/StApp.h"
 #include "st_app/StAppFactory.h"
 
 #include "timeSystem/AbsoluteTime.h"
+#include "timeSystem/AbsoluteTimeIn.h"
 #include "timeSystem/BaryTimeComputer.h"
 #include "timeSystem/CalendarFormat.h"
+#include "timeSystem/CorrectionService.h"
 #include "timeSystem/Duration.h"
 #include "timeSystem/ElapsedTime.h"
 #include "timeSystem/EventTimeHandler.h"
 #include "timeSystem/GlastTimeHandler.h"
 #include "timeSystem/IntFracUtility.h"
 #include "timeSystem/MjdFormat.h"
+#include "timeSystem/PerformanceMonitor.h"
 #include "timeSystem/PulsarTestApp.h"
 #include "timeSystem/SourcePosition.h"
 #include "timeSystem/TimeCorrectorApp.h"
@@ -73,6 +80,14 @@ class TimeCorrectorAppTester: public PulsarApplicationTester {
   virtual bool verify(const std::string & keyword_name, const tip::KeyRecord & out_keyword,
     const tip::KeyRecord & ref_keyword, std::ostream & error_stream) const;
 
+  /** \brief Return how to compare a given column of an output FITS file with its reference.
+      \param column_name Name of the FITS column to compare.
+      \param tolerance_abs Absolute tolerance in numeric comparison is set to this argument.
+      \param tolerance_rel Relative tolerance in numeric comparison is set to this argument.
+  */
+  virtual ColumnComparisonType getColumnComparison(const std::string & column_name, double & tolerance_abs,
+    double & tolerance_rel) const;
+
   /** \brief Return a logical true if the given table cell is considered correct, and a logical false otherwise.
       \param column_name Name of the FITS column that the given table cell belongs to.
       \param out_cell Table cell taken from the output file to be verified.
@@ -138,6 +153,17 @@ bool TimeCorrectorAppTester::verify(const std::string & keyword_name, const tip:
   return verified;
 }
 
+PulsarApplicationTester::ColumnComparisonType TimeCorrectorAppTester::getColumnComparison(const std::string & column_name,
+  double & tolerance_abs, double & tolerance_rel) const {
+  // Compare time columns as floating-point numbers, requiring a match down to 10 microseconds, and ignore other columns.
+  if ("TIME" == column_name || "START" == column_name || "STOP" == column_name) {
+    tolerance_abs = 1.e-5;
+    tolerance_rel = 0.;
+    return NUMERIC_COMPARISON;
+  }
+  return NO_COMPARISON;
+}
+
 bool TimeCorrectorAppTester::verify(const std::string & column_name, const tip::TableCell & out_cell,
   const tip::TableCell & ref_cell, std::ostream & error_stream) const {
   // Initialize return value.
@@ -176,6 +202,39 @@ bool TimeCorrectorAppTester::verify(const std::string & out_string, const std::s
   return verified;
 }
 
+/** \class CircularOrbitComputer
+    \brief Compute positions of an observatory in a circular orbit around the Earth, for tests of inverse barycentric corrections.
+*/
+class CircularOrbitComputer: public IObservatoryPositionComputer {
+  public:
+  /** \brief Construct a CircularOrbitComputer object.
+      \param origin Time at which the observatory is on the X-axis.
+      \param radius Radius of the orbit in meters.
+      \param period Orbital period in seconds.
+  */
+  CircularOrbitComputer(const AbsoluteTime & origin, double radius, double period): m_origin(origin), m_radius(radius),
+    m_period(period) {}
+
+  /** \brief Compute observatory positions at given times, and set them to the last argument.
+      \param abs_time Times at which observatory positions are to be computed.
+      \param obs_position Observatory positions at the given times, three elements (X, Y, and Z) per time.
+  */
+  virtual void computeObsPosition(const std::vector<AbsoluteTime> & abs_time, std::vector<double> & obs_position) const {
+    obs_position.resize(3 * abs_time.size());
+    for (std::size_t idx = 0; idx < abs_time.size(); ++idx) {
+      double phase = 2. * M_PI * abs_time[idx].computeElapsedTime("TT", m_origin).getDuration().get<Sec>() / m_period;
+      obs_position[3 * idx] = m_radius * std::cos(phase);
+      obs_position[3 * idx + 1] = m_radius * std::sin(phase);
+      obs_position[3 * idx + 2] = 0.;
+    }
+  }
+
+  private:
+  AbsoluteTime m_origin;
+  double m_radius;
+  double m_period;
+};
+
 /** \class TimeSystemTestApp
     \brief Test timeSystem package and applications in it.
 */
@@ -226,6 +285,9 @@ class TimeSystemTestApp : public PulsarTestApp {
     /// \brief Test GlastTimeHandler class.
     void testGlastTimeHandler();
 
+    /// \brief Test CorrectionService class.
+    void testCorrectionService();
+
     /// \brief Test TimeCorrectorApp class.
     void testTimeCorrectorApp();
 
@@ -394,6 +456,9 @@ void TimeSystemTestApp::runTest() {
   // Test GlastTimeHandler class.
   testGlastTimeHandler();
 
+  // Test CorrectionService class.
+  testCorrectionService();
+
   // Test TimeCorrectorApp class.
   testTimeCorrectorApp();
 }
@@ -426,6 +491,31 @@ void TimeSystemTestApp::testDurationGetter(long day, double sec, const std::stri
     err() << "Duration(" << day << ", " << sec << ").get(" << time_unit_name << ") returned " <<
       result_double << ", not " << expected_double << " as expected." << std::endl;
   }
+
+  // Test the getters that take a time unit as a template parameter, which must agree exactly with the above.
+  Duration time_duration(day, sec);
+  long typed_int = 0;
+  double typed_frac = 0.;
+  double typed_double = 0.;
+  if ("Day" == time_unit_name) {
+    time_duration.get<Day>(typed_int, typed_frac);
+    typed_double = time_duration.get<Day>();
+  } else if ("Hour" == time_unit_name) {
+    time_duration.get<Hour>(typed_int, typed_frac);
+    typed_double = time_duration.get<Hour>();
+  } else if ("Min" == time_unit_name) {
+    time_duration.get<Min>(typed_int, typed_frac);
+    typed_double = time_duration.get<Min>();
+  } else {
+    time_duration.get<Sec>(typed_int, typed_frac);
+    typed_double = time_duration.get<Sec>();
+  }
+  if (result_int != typed_int || result_frac != typed_frac || result_double != typed_double) {
+    err() << "Duration(" << day << ", " << sec << ").get<" << time_unit_name << ">(int_part, frac_part) and get<" <<
+      time_unit_name << ">() returned (" << typed_int << ", " << typed_frac << ") and " << typed_double << ", not (" <<
+      result_int << ", " << result_frac << ") and " << result_double << " as get(\"" << time_unit_name << "\") did." <<
+      std::endl;
+  }
 }
 
 void TimeSystemTestApp::testDurationConstructor(const std::string & time_unit_name, long int_part, double frac_part,
@@ -445,6 +535,31 @@ void TimeSystemTestApp::testDurationConstructor(const std::string & time_unit_na
       "\") created Duration of " << result << ", not equivalent to Duration of " << expected_result <<
       " with tolerance of " << tolerance_low << "." << std::endl;
   }
+
+  // Test the factory methods that take a time unit as a template parameter, which must agree exactly with the above.
+  Duration typed_result_high;
+  Duration typed_result_low;
+  if ("Day" == time_unit_name) {
+    typed_result_high = Duration::from<Day>(int_part, frac_part);
+    typed_result_low = Duration::from<Day>(int_part + frac_part);
+  } else if ("Hour" == time_unit_name) {
+    typed_result_high = Duration::from<Hour>(int_part, frac_part);
+    typed_result_low = Duration::from<Hour>(int_part + frac_part);
+  } else if ("Min" == time_unit_name) {
+    typed_result_high = Duration::from<Min>(int_part, frac_part);
+    typed_result_low = Duration::from<Min>(int_part + frac_part);
+  } else {
+    typed_result_high = Duration::from<Sec>(int_part, frac_part);
+    typed_result_low = Duration::from<Sec>(int_part + frac_part);
+  }
+  if (typed_result_high != Duration(int_part, frac_part, time_unit_name)) {
+    err() << "Duration::from<" << time_unit_name << ">(" << int_part << ", " << frac_part << ") created Duration of " <<
+      typed_result_high << ", not " << Duration(int_part, frac_part, time_unit_name) << " as expected." << std::endl;
+  }
+  if (typed_result_low != result) {
+    err() << "Duration::from<" << time_unit_name << ">(" << int_part + frac_part << ") created Duration of " <<
+      typed_result_low << ", not " << result << " as expected." << std::endl;
+  }
 }
 
 void TimeSystemTestApp::testOneComparison(const std::string & comparator, const Duration & dur1, const Duration & dur2,
@@ -794,11 +909,17 @@ void TimeSystemTestApp::testDuration() {
     }
   }
 
+  // Test for detections of overflow: negation of a whole number of days that equals the minimum of long type.
+  // Note: This is the only value that overflows by negation, in a computer system where min_long == -max_long - 1.
+  //       Negation of a time duration with a non-zero picoseconds part never overflows, because Duration class keeps
+  //       its day part as one less than the integer part of it for computational advantages.
+  try {
+    -Duration(std::numeric_limits<long>::min(), 0.);
+    err() << "Negating Duration(" << std::numeric_limits<long>::min() << ", 0.) did not throw an exception." << std::endl;
+  } catch (const std::exception &) {
+  }
+
   // Test for detections of overflow/underflow: addition and subtraction.
-  // Note: Negation (unary minus operator) cannot be tested because it is impossible to set a value that would cause
-  //       overflow/underflow by negation, in a computer system where min_long == -max_long - 1.  The condition happens
-  //       to match the current implementation of Duration class that keeps its day part as one less than the integer
-  //       part of it for computational advantages.
   large_dur = Duration(std::numeric_limits<long>::max(), SecPerDay() - 1.);
   try {
     large_dur + Duration(0, 2.);
@@ -895,6 +1016,25 @@ void TimeSystemTestApp::testDuration() {
       expected_quotient << ", as expected." << std::endl;
   }
 
+  // Test computation of the number of seconds with a number of days added.
+  double sec_result = Duration(2, .25).computeSec(-3);
+  double sec_expected = -86399.75;
+  if (sec_result != sec_expected) {
+    err() << "Duration(2, .25).computeSec(-3) returned " << sec_result << ", not " << sec_expected << " as expected." << std::endl;
+  }
+  Duration mission_time(0, 212339375.04258754849);
+  sec_result = mission_time.computeSec(0);
+  sec_expected = mission_time.get<Sec>();
+  if (std::fabs(sec_result - sec_expected) > tol_sec) {
+    err() << "Duration(" << mission_time << ").computeSec(0) returned " << sec_result << ", not " << sec_expected <<
+      " as expected." << std::endl;
+  }
+  try {
+    Duration(std::numeric_limits<long>::max(), 0.).computeSec(0);
+    err() << "Duration(" << std::numeric_limits<long>::max() << ", 0.).computeSec(0) did not throw an exception." << std::endl;
+  } catch (const std::exception &) {
+  }
+
   // Test limits of addition and subtraction.
   Duration one(1, 0.);
   const Duration & zero(Duration::zero());
@@ -1017,6 +1157,15 @@ void TimeSystemTestApp::testOneSubtraction(const moment_type & moment1, const mo
         moment2.first << ", " << moment2.second << "), not equivalent to the expected result, " <<
         expected_diff[time_system_name] << ", with tolerance of " << tolerance << "." << std::endl;
     }
+
+    double expected_sec = expected_diff[time_system_name].get<Sec>();
+    double time_diff_sec = time_system.computeTimeDifferenceInSec(moment1, moment2);
+    if (std::fabs(time_diff_sec - expected_sec) > tolerance.get<Sec>()) {
+      err() << "computeTimeDifferenceInSec(moment1, moment2) of " << time_system_name << " returned " << time_diff_sec <<
+        " for moment1 = moment_type(" << moment1.first << ", " << moment1.second << ") and moment2 = moment_type(" <<
+        moment2.first << ", " << moment2.second << "), not equivalent to the expected result, " << expected_sec <<
+        ", with tolerance of " << tolerance << "." << std::endl;
+    }
   }
 }
 
@@ -1106,6 +1255,43 @@ void TimeSystemTestApp::testTimeSystem() {
   testOneConversion("UTC", utc_ref_moment, "TDB", tdb_ref_moment, tdb_tolerance);
   testOneConversion("UTC", utc_ref_moment, "TT",  tt_ref_moment);
 
+  // Test conversions between TDB and TT with precomputed TDB - TT, which must agree with those without it.
+  const TimeSystem & tdb_sys(TimeSystem::getSystem("TDB"));
+  const TimeSystem & tt_sys(TimeSystem::getSystem("TT"));
+  std::list<moment_type> tt_moment_list;
+  for (long day_offset = -10; day_offset <= 10; day_offset += 3) {
+    for (double tt_sec = 0.; tt_sec < SecPerDay(); tt_sec += 12345.678) {
+      tt_moment_list.push_back(moment_type(ref_day + day_offset, Duration(tt_sec, "Sec")));
+    }
+  }
+  std::list<moment_type> tdb_moment_list;
+  for (std::list<moment_type>::const_iterator itor = tt_moment_list.begin(); itor != tt_moment_list.end(); ++itor) {
+    tdb_moment_list.push_back(tdb_sys.convertFrom(tt_sys, *itor));
+  }
+  TimeSystem::precomputeTdbMinusTt(ref_day - 10, ref_day + 10);
+  std::list<moment_type>::const_iterator tdb_itor = tdb_moment_list.begin();
+  for (std::list<moment_type>::const_iterator itor = tt_moment_list.begin(); itor != tt_moment_list.end(); ++itor, ++tdb_itor) {
+    testOneConversion("TT", *itor, "TDB", *tdb_itor, 1.e-9);
+    testOneConversion("TDB", *tdb_itor, "TT", *itor, 1.e-9);
+  }
+  testOneConversion("TT",  tt_ref_moment, "TDB", tdb_ref_moment, tdb_tolerance);
+  testOneConversion("TDB", tdb_ref_moment, "TT",  tt_ref_moment, tdb_tolerance);
+
+  // Test conversions between TDB and TT outside the span of precomputed TDB - TT.
+  moment_type tt_far_moment(ref_day + 365, Duration(tt_ref_sec, "Sec"));
+  moment_type tdb_far_moment(tdb_sys.convertFrom(tt_sys, tt_far_moment));
+  testOneConversion("TDB", tdb_far_moment, "TT", tt_far_moment, tdb_tolerance);
+  TimeSystem::clearTdbMinusTt();
+  testOneConversion("TT", tt_far_moment, "TDB", tdb_far_moment, 1.e-9);
+
+  // Test error detection in precomputing TDB - TT for an empty span.
+  try {
+    TimeSystem::precomputeTdbMinusTt(ref_day + 10, ref_day - 10);
+    err() << "TimeSystem::precomputeTdbMinusTt(" << ref_day + 10 << ", " << ref_day - 10 <<
+      ") did not throw an exception when it should." << std::endl;
+  } catch (const std::exception &) {
+  }
+
   // Use three leap seconds for generating tests.
   double diff0 = 31.;
   double diff1 = 32.;
@@ -1205,6 +1391,9 @@ void TimeSystemTestApp::testTimeSystem() {
     // That's OK!
   }
 
+  // Test that the leap second table loaded before is still in use after failures of loading a new one.
+  testOneConversion("TAI", tai_ref_moment, "UTC", utc_ref_moment);
+
   // Set the bogus leap second file name to a local variable. This file contains a removal of a leap second.
   std::string bogus_leap = prependDataPath("bogusls.fits");
 
@@ -1225,6 +1414,30 @@ void TimeSystemTestApp::testTimeSystem() {
 
   // Reset default leap second file name.
   TimeSystem::setDefaultLeapSecFileName("");
+  if (!TimeSystem::getDefaultLeapSecFileName().empty()) {
+    err() << "After resetting default leap second file name, default leap second file name was " <<
+      TimeSystem::getDefaultLeapSecFileName() << ", not an empty string as expected." << std::endl;
+  }
+
+  // Test loading the leap second table built into the library, which is used by default.
+  TimeSystem::loadLeapSeconds();
+  testOneConversion("UTC", moment_type(57753, Duration(100., "Sec")), "TAI", moment_type(57753, Duration(100. + 36., "Sec")));
+  testOneConversion("UTC", moment_type(57754, Duration(100., "Sec")), "TAI", moment_type(57754, Duration(100. + 37., "Sec")));
+
+  // Test loading a leap second file through a snapshot of it, which is written first and read next.
+  std::string leap_cache("test_leapsec.cache");
+  remove(leap_cache.c_str());
+  TimeSystem::setLeapSecCacheFileName(leap_cache);
+  TimeSystem::loadLeapSeconds(bogus_leap);
+  if (!std::ifstream(leap_cache.c_str())) {
+    err() << "After TimeSystem::setLeapSecCacheFileName(\"" << leap_cache << "\"), loadLeapSeconds(\"" << bogus_leap <<
+      "\") did not write a snapshot." << std::endl;
+  }
+  TimeSystem::loadLeapSeconds();
+  TimeSystem::loadLeapSeconds(bogus_leap);
+  testOneConversion("UTC", moment_type(53737, Duration(100., "Sec")), "TAI", moment_type(53737, Duration(100. + 31., "Sec")));
+  TimeSystem::setLeapSecCacheFileName("");
+  remove(leap_cache.c_str());
 
   // Finally, test loading the real leap seconds file.
   TimeSystem::loadLeapSeconds(bogus_leap);
@@ -1504,6 +1717,56 @@ void TimeSystemTestApp::testTimeSystem() {
     ") returned Moment(" << utc_moment.first << ", " << utc_moment.second <<
       "), which is earlier than the beginning of the current UTC definition " << oldest_mjd << " MJD." << std::endl;
   }
+
+  // Test conversions of arrays of moments, sorted in time order across leap seconds, which must agree exactly with
+  // conversions of moments one by one.
+  std::vector<moment_type> src_moment_array;
+  for (long day_offset = -2; day_offset <= 2; ++day_offset) {
+    for (double elapsed_sec = -.5; elapsed_sec < SecPerDay(); elapsed_sec += 7654.321) {
+      src_moment_array.push_back(moment_type(leap1 + day_offset, Duration(elapsed_sec, "Sec")));
+    }
+    src_moment_array.push_back(moment_type(leap1 + day_offset, Duration(delta_leap, 0.3, "Day")));
+  }
+  std::vector<std::string> system_name_list;
+  system_name_list.push_back("TAI");
+  system_name_list.push_back("TDB");
+  system_name_list.push_back("TT");
+  system_name_list.push_back("UTC");
+  for (std::vector<std::string>::const_iterator src_itor = system_name_list.begin(); src_itor != system_name_list.end(); ++src_itor) {
+    const TimeSystem & src_sys(TimeSystem::getSystem(*src_itor));
+    for (std::vector<std::string>::const_iterator dest_itor = system_name_list.begin(); dest_itor != system_name_list.end();
+      ++dest_itor) {
+      const TimeSystem & dest_sys(TimeSystem::getSystem(*dest_itor));
+      std::vector<moment_type> dest_moment_array(src_moment_array.size());
+      dest_sys.convertArrayFrom(src_sys, &src_moment_array[0], src_moment_array.size(), &dest_moment_array[0]);
+      std::vector<moment_type> in_place_array(src_moment_array);
+      dest_sys.convertArrayFrom(src_sys, &in_place_array[0], in_place_array.size(), &in_place_array[0]);
+      for (std::vector<moment_type>::size_type ii = 0; ii < src_moment_array.size(); ++ii) {
+        moment_type expected_moment = dest_sys.convertFrom(src_sys, src_moment_array[ii]);
+        if (expected_moment.first != dest_moment_array[ii].first || expected_moment.second != dest_moment_array[ii].second ||
+            expected_moment.first != in_place_array[ii].first || expected_moment.second != in_place_array[ii].second) {
+          err() << "Converting an array from " << src_sys << " to " << dest_sys << ", moment_type(" << src_moment_array[ii].first <<
+            ", " << src_moment_array[ii].second << ") was converted to moment_type(" << dest_moment_array[ii].first << ", " <<
+            dest_moment_array[ii].second << ") and moment_type(" << in_place_array[ii].first << ", " << in_place_array[ii].second <<
+            ") in place, not to moment_type(" << expected_moment.first << ", " << expected_moment.second <<
+            ") as converted one by one." << std::endl;
+        }
+      }
+    }
+  }
+
+  // Test detection of an invalid UTC moment in an array.
+  std::vector<moment_type> utc_moment_array(src_moment_array);
+  utc_moment_array.push_back(moment_type(utc_day, Duration(utc_sec, "Sec")));
+  std::vector<moment_type> tai_moment_array(utc_moment_array.size());
+  try {
+    TimeSystem::getSystem("TAI").convertArrayFrom(TimeSystem::getSystem("UTC"), &utc_moment_array[0], utc_moment_array.size(),
+      &tai_moment_array[0]);
+    err() << "Conversion of an array from UTC to TAI including moment_type(" << utc_day << ", " << utc_sec <<
+      ") did not throw an exception." << std::endl;
+  } catch (const std::exception &) {
+    // That's OK!
+  }
 }
 
 void TimeSystemTestApp::compareAbsoluteTime(const AbsoluteTime & abs_time, const AbsoluteTime & later_time) {
@@ -1575,6 +1838,18 @@ void TimeSystemTestApp::testAbsoluteTime() {
       expected_mjd1.m_day << " as expected." << std::endl;
   }
 
+  // Test the constructor and the getter that take a TimeSystem object, instead of a time system name.
+  const TimeSystem & tt_system(TimeSystem::getSystem("TT"));
+  abs_time = AbsoluteTime(tt_system, mjd_day, Duration(0, mjd_sec));
+  result_mjd = Mjd(0, 0.);
+  abs_time.get(tt_system, result_mjd);
+  double_tol = 100.e-9 / SecPerDay(); // 100 nanoseconds in days.
+  if (expected_mjd.m_int != result_mjd.m_int || std::fabs(expected_mjd.m_frac - result_mjd.m_frac) > double_tol) {
+    err() << "After abs_time = AbsoluteTime(TT system, " << mjd_day << ", Duration(0, " << mjd_sec <<
+      ")), abs_time.get(TT system, result_mjd) gave result_mjd = (" << result_mjd.m_int << ", " << result_mjd.m_frac <<
+      "), not (" << expected_mjd.m_int << ", " << expected_mjd.m_frac << ") as expected." << std::endl;
+  }
+
   // Test the getter for high-precision MJD, with a different time system.
   abs_time = AbsoluteTime("TT", mjd_day, mjd_sec);
   result_mjd = Mjd(0, 0.);
@@ -1884,6 +2159,44 @@ void TimeSystemTestApp::testAbsoluteTime() {
   if (!expected_diff.equivalentTo(difference, tolerance))
     err() << "Absolute time [" << abs_time_utc << "] subtracted from absolute time [" << later_time_utc << "] gave " << difference <<
       ", not " << expected_diff << " as expected." << std::endl;
+
+  // Test conversions between AbsoluteTime and AbsoluteTimeIn.
+  AbsoluteTimeIn<Tdb> abs_time_tdb(abs_time);
+  AbsoluteTimeIn<Tt> abs_time_tt(abs_time);
+  if (!AbsoluteTime(abs_time_tdb).equivalentTo(abs_time, epsilon))
+    err() << "AbsoluteTimeIn<Tdb> object converted from and to AbsoluteTime object [" << abs_time << "] gave " << abs_time_tdb <<
+      ", not equivalent to the original." << std::endl;
+  ElapsedTime conversion_tol("TDB", Duration(100.e-9, "Sec")); // 100 ns, the accuracy of conversions from TDB to TT.
+  if (!AbsoluteTime(abs_time_tt).equivalentTo(abs_time, conversion_tol))
+    err() << "AbsoluteTimeIn<Tt> object converted from and to AbsoluteTime object [" << abs_time << "] gave " << abs_time_tt <<
+      ", not equivalent to the original." << std::endl;
+
+  // Test arithmetic and comparison operators of AbsoluteTimeIn, for times with the same and with different time origins.
+  AbsoluteTimeIn<Tdb> later_time_tdb(later_time);
+  AbsoluteTimeIn<Tdb> later_time_tdb_shifted(later_time_tdb.getMoment().first + 1, later_time_tdb.getMoment().second -
+    Duration(1, 0.));
+  std::vector<AbsoluteTimeIn<Tdb> > later_time_cont(1, later_time_tdb);
+  later_time_cont.push_back(later_time_tdb_shifted);
+  later_time_cont.push_back(abs_time_tdb + Duration(100., "Sec"));
+  for (std::vector<AbsoluteTimeIn<Tdb> >::const_iterator itor = later_time_cont.begin(); itor != later_time_cont.end(); ++itor) {
+    difference = *itor - abs_time_tdb;
+    if (!Duration(100., "Sec").equivalentTo(difference, tolerance))
+      err() << "AbsoluteTimeIn object [" << abs_time_tdb << "] subtracted from AbsoluteTimeIn object [" << *itor << "] gave " <<
+        difference << ", not 100 seconds as expected." << std::endl;
+    if (!(abs_time_tdb < *itor && abs_time_tdb <= *itor && *itor > abs_time_tdb && *itor >= abs_time_tdb) ||
+      (*itor < abs_time_tdb || *itor <= abs_time_tdb || abs_time_tdb > *itor || abs_time_tdb >= *itor))
+      err() << "Comparison operators of AbsoluteTimeIn class did not find [" << abs_time_tdb << "] earlier than [" << *itor <<
+        "]." << std::endl;
+    if (!itor->equivalentTo(later_time_tdb, Duration(1.e-9, "Sec")))
+      err() << "AbsoluteTimeIn object [" << *itor << "] is not equivalent to [" << later_time_tdb << "]." << std::endl;
+  }
+  std::vector<double> elapsed_sec(later_time_cont.size());
+  computeElapsedSec(&later_time_cont[0], &later_time_cont[0] + later_time_cont.size(), abs_time_tdb, &elapsed_sec[0]);
+  for (std::size_t ii = 0; ii < elapsed_sec.size(); ++ii) {
+    if (std::fabs(elapsed_sec[ii] - 100.) > 1.e-9)
+      err() << "computeElapsedSec function gave " << elapsed_sec[ii] << " seconds for AbsoluteTimeIn object [" <<
+        later_time_cont[ii] << "] since [" << abs_time_tdb << "], not 100 seconds as expected." << std::endl;
+  }
 }
 
 void TimeSystemTestApp::testElapsedTime() {
@@ -1907,6 +2220,14 @@ void TimeSystemTestApp::testElapsedTime() {
       ", not TDB." << std::endl;
   }
 
+  // Test of the constructor that takes a TimeSystem object.
+  const TimeSystem & tdb_system(TimeSystem::getSystem("TDB"));
+  ElapsedTime elapsed_by_system(tdb_system, expected_dur);
+  if (&elapsed_by_system.getSystem() != &tdb_system || !elapsed_by_system.getDuration().equivalentTo(expected_dur, tolerance)) {
+    err() << "After ElapsedTime elapsed_by_system(TDB system, " << original_dur << "), it represented " << elapsed_by_system <<
+      ", not equivalent to " << elapsed << "." << std::endl;
+  }
+
   // Test of negate operator.
   ElapsedTime negative_elapsed = -elapsed;
   expected_dur = Duration(-1, -SecPerDay() * 0.125);
@@ -2330,6 +2651,38 @@ void TimeSystemTestApp::testTimeFormat() {
       result_jd.m_frac << ") JD, not (" << expected_jd.m_int << " + " << expected_jd.m_frac << ") JD as expected." << std::endl;
   }
 
+  // Test parsing strings in a buffer with a TimeFormat<Mjd> object, which must agree with parsing them one by one.
+  {
+    const std::size_t width = 32;
+    const std::size_t num_string = 3;
+    const char * time_string[num_string] = { "51910.500750162037037", "  51910.5", "5.19105e+4" };
+    char buffer[num_string * width];
+    std::fill(buffer, buffer + sizeof(buffer), ' ');
+    for (std::size_t ii = 0; ii < num_string; ++ii) std::copy(time_string[ii], time_string[ii] + std::strlen(time_string[ii]),
+      buffer + ii * width);
+    std::vector<Mjd> result_array(num_string, Mjd(0, 0.));
+    mjd_format.parseArray(buffer, width, num_string, &result_array[0]);
+    for (std::size_t ii = 0; ii < num_string; ++ii) {
+      result_mjd = mjd_format.parse(time_string[ii]);
+      if (result_mjd.m_int != result_array[ii].m_int || result_mjd.m_frac != result_array[ii].m_frac) {
+        err() << "TimeFormat<Mjd>::parseArray method parsed \"" << time_string[ii] << "\" into (" << result_array[ii].m_int <<
+          " + " << result_array[ii].m_frac << ") MJD, not (" << result_mjd.m_int << " + " << result_mjd.m_frac <<
+          ") MJD as expected." << std::endl;
+      }
+    }
+
+    // Test formatting into strings in a buffer with a TimeFormat<Mjd> object.
+    mjd_format.formatArray(&result_array[0], num_string, buffer, width, 7);
+    for (std::size_t ii = 0; ii < num_string; ++ii) {
+      expected_mjd_string = mjd_format.format(result_array[ii], 7);
+      result_mjd_string = std::string(buffer + ii * width, width);
+      if (expected_mjd_string + std::string(width - expected_mjd_string.size(), '\0') != result_mjd_string) {
+        err() << "TimeFormat<Mjd>::formatArray method stored \"" << result_mjd_string.c_str() << "\" in the buffer, not \"" <<
+          expected_mjd_string << "\" padded with null characters as expected." << std::endl;
+      }
+    }
+  }
+
   // Test formatting into string with a TimeFormat<Jd1> object, with decimal precision specified.
   // Note: Need to specify the number of digits to avoid failing this test due to unimportant rouding errors.
   expected_jd_string = "2451911.0007502 JD";
@@ -2590,6 +2943,76 @@ void TimeSystemTestApp::testTimeFormat() {
       expected_ordinal.m_hour << ", " << expected_ordinal.m_min << ", " << expected_ordinal.m_sec << ") as expected." << std::endl;
   }
 
+  // Test parsing strings in a buffer, terminated with a null character, padded with blanks, and in a non-canonical form.
+  {
+    const std::size_t width = 32;
+    const std::size_t num_string = 3;
+    const char * time_string[num_string] = { "2008-06-17T12:34:56.789", "2008-06-17T00:00:00.0", "2008-06-17T12:34:5.6789e1" };
+    char buffer[num_string * width];
+    std::fill(buffer, buffer + sizeof(buffer), ' ');
+    for (std::size_t ii = 0; ii < num_string; ++ii) std::copy(time_string[ii], time_string[ii] + std::strlen(time_string[ii]),
+      buffer + ii * width);
+    buffer[width - 1] = '\0';
+    std::vector<Calendar> result_array(num_string, Calendar(0, 0, 0, 0, 0, 0.));
+    calendar_format.parseArray(buffer, width, num_string, &result_array[0]);
+    for (std::size_t ii = 0; ii < num_string; ++ii) {
+      Calendar expected_rep = calendar_format.parse(time_string[ii]);
+      const Calendar & result_rep = result_array[ii];
+      if (expected_rep.m_year != result_rep.m_year || expected_rep.m_mon != result_rep.m_mon || expected_rep.m_day != result_rep.m_day ||
+          expected_rep.m_hour != result_rep.m_hour || expected_rep.m_min != result_rep.m_min || expected_rep.m_sec != result_rep.m_sec) {
+        err() << "TimeFormat<Calendar>::parseArray method parsed \"" << time_string[ii] << "\" into Calendar(" <<
+          result_rep.m_year << ", " << result_rep.m_mon << ", " << result_rep.m_day << ", " << result_rep.m_hour << ", " <<
+          result_rep.m_min << ", " << result_rep.m_sec << "), not Calendar(" << expected_rep.m_year << ", " << expected_rep.m_mon <<
+          ", " << expected_rep.m_day << ", " << expected_rep.m_hour << ", " << expected_rep.m_min << ", " << expected_rep.m_sec <<
+          ") as expected by TimeFormat<Calendar>::parse method." << std::endl;
+      }
+    }
+
+    // Test formatting into strings in a buffer, which should be the same as formatted one by one, and padded with null characters.
+    std::fill(buffer, buffer + sizeof(buffer), 'X');
+    calendar_format.formatArray(&result_array[0], num_string, buffer, width, 3);
+    for (std::size_t ii = 0; ii < num_string; ++ii) {
+      std::string expected_string = calendar_format.format(result_array[ii], 3);
+      std::string result_string(buffer + ii * width, width);
+      if (expected_string + std::string(width - expected_string.size(), '\0') != result_string) {
+        err() << "TimeFormat<Calendar>::formatArray method stored \"" << result_string.c_str() << "\" in the buffer, not \"" <<
+          expected_string << "\" padded with null characters as expected." << std::endl;
+      }
+    }
+
+    // Test detection of a buffer too narrow to store a formatted string.
+    try {
+      calendar_format.formatArray(&result_array[0], 1, buffer, 16, 3);
+      err() << "TimeFormat<Calendar>::formatArray method did not throw an exception for a string longer than 16 characters." <<
+        std::endl;
+    } catch (const std::exception &) {
+      // That's fine.
+    }
+  }
+
+  // Test round trips of ISO week dates and ordinal dates through a buffer.
+  {
+    const std::size_t width = 24;
+    char buffer[width];
+    IsoWeek result_iso_week_rep(0, 0, 0, 0, 0, 0.);
+    iso_week_format.formatArray(&expected_iso_week, 1, buffer, width, 3);
+    iso_week_format.parseArray(buffer, width, 1, &result_iso_week_rep);
+    result_iso_week_string = iso_week_format.format(result_iso_week_rep, 3);
+    if (std::string(buffer) != "2008-W25-2T12:34:56.789" || result_iso_week_string != "2008-W25-2T12:34:56.789") {
+      err() << "TimeFormat<IsoWeek>::formatArray and parseArray methods converted \"2008-W25-2T12:34:56.789\" into \"" <<
+        buffer << "\" and \"" << result_iso_week_string << "\", not into the same string as expected." << std::endl;
+    }
+
+    Ordinal result_ordinal_rep(0, 0, 0, 0, 0.);
+    ordinal_format.formatArray(&expected_ordinal, 1, buffer, width, 3);
+    ordinal_format.parseArray(buffer, width, 1, &result_ordinal_rep);
+    result_ordinal_string = ordinal_format.format(result_ordinal_rep, 3);
+    if (std::string(buffer) != "2008-169T12:34:56.789" || result_ordinal_string != "2008-169T12:34:56.789") {
+      err() << "TimeFormat<Ordinal>::formatArray and parseArray methods converted \"2008-169T12:34:56.789\" into \"" <<
+        buffer << "\" and \"" << result_ordinal_string << "\", not into the same string as expected." << std::endl;
+    }
+  }
+
   // Test detections of bad times of the day.
   testOneBadDateTime(calendar_format, datetime_type(51910, -0.001), "Calendar", "a time of the day: -0.001");
   testOneBadDateTime(iso_week_format, datetime_type(51910, -0.001), "IsoWeek", "a time of the day: -0.001");
@@ -3006,6 +3429,45 @@ void TimeSystemTestApp::testIntFracUtility() {
       "\" as expected." << std::endl;
   }
 
+  // Test formatting into a character buffer, which must agree with formatting into a string.
+  std::list<std::pair<long, double> > format_pair_list;
+  format_pair_list.push_back(std::make_pair(1234L, .56789567895678956789));
+  format_pair_list.push_back(std::make_pair(-1234L, -.56789567895678956789));
+  format_pair_list.push_back(std::make_pair(0L, -.25));
+  format_pair_list.push_back(std::make_pair(5678L, 0.));
+  format_pair_list.push_back(std::make_pair(5678L, .9999999));
+  for (std::list<std::pair<long, double> >::const_iterator itor = format_pair_list.begin(); itor != format_pair_list.end(); ++itor) {
+    for (std::streamsize precision = 0; precision <= std::numeric_limits<double>::digits10; precision += 5) {
+      char buffer[64];
+      std::size_t length = utility.format(itor->first, itor->second, precision, buffer, sizeof(buffer));
+      expected_string = utility.format(itor->first, itor->second, precision);
+      result_string = std::string(buffer, length);
+      if (expected_string != result_string) {
+        err() << "IntFracUtility::format(" << itor->first << ", " << itor->second << ", " << precision <<
+          ", buffer, buffer_size) stored \"" << result_string << "\" in the buffer, not \"" << expected_string <<
+          "\" as expected." << std::endl;
+      }
+    }
+  }
+  {
+    char buffer[4];
+    std::size_t length = utility.format(1234, .5, 3, buffer, sizeof(buffer));
+    if (0 != length) {
+      err() << "IntFracUtility::format(1234, .5, 3, buffer, " << sizeof(buffer) << ") returned " << length <<
+        ", not 0 as expected." << std::endl;
+    }
+  }
+
+  // Test parsing a character string that is not terminated by a null character, which must agree with parsing a string.
+  sval = "50089.56789567895678956789 99999.9";
+  utility.parse(sval.data(), 26, result_int_part, result_frac_part);
+  utility.parse(sval.substr(0, 26), expected_int_part, expected_frac_part);
+  if (result_int_part != expected_int_part || result_frac_part != expected_frac_part) {
+    err() << "IntFracUtility::parse(\"" << sval << "\", 26, int_part, frac_part) returned (int_part, frac_part) = (" <<
+      result_int_part << ", " << result_frac_part << "), not (" << expected_int_part << ", " << expected_frac_part <<
+      ") as expected." << std::endl;
+  }
+
   // Prepare variables to use in the tests below.
   double dval = 0.;
 
@@ -3339,6 +3801,129 @@ void TimeSystemTestApp::testBaryTimeComputer() {
       ") with tolerance of " << tolerance << "." << std::endl;
   }
 
+  // Test barycentric correction (for a source at an infinate distance), with a fixed-size array for the spacecraft position.
+  result = original;
+  computer405.computeBaryTime(src_pos, glast_pos_array, result);
+  if (!result.equivalentTo(expected_bary, tolerance)) {
+    err() << "BaryTimeComputer::computeBaryTime(SourcePosition(" << ra << ", " << dec << "), glast_pos_array, " << original <<
+      ") returned AbsoluteTime(" << result << "), not equivalent to AbsoluteTime(" << expected_bary <<
+      ") with tolerance of " << tolerance << "." << std::endl;
+  }
+
+  // Test geocentric correction (for a source at an infinate distance), with a fixed-size array for the spacecraft position.
+  result = original;
+  computer405.computeGeoTime(src_pos, glast_pos_array, result);
+  if (!result.equivalentTo(expected_geo, tolerance)) {
+    err() << "BaryTimeComputer::computeGeoTime(SourcePosition(" << ra << ", " << dec << "), glast_pos_array, " << original <<
+      ") returned AbsoluteTime(" << result << "), not equivalent to AbsoluteTime(" << expected_geo <<
+      ") with tolerance of " << tolerance << "." << std::endl;
+  }
+
+  // Test barycentric and geocentric corrections for a block of times.
+  std::vector<AbsoluteTime> result_block(2, original);
+  std::vector<double> glast_pos_block(glast_pos_array, glast_pos_array + 3);
+  glast_pos_block.insert(glast_pos_block.end(), glast_pos_array, glast_pos_array + 3);
+  computer405.computeBaryTime(src_pos, glast_pos_block, result_block);
+  for (std::size_t ii = 0; ii < result_block.size(); ++ii) {
+    if (!result_block[ii].equivalentTo(expected_bary, tolerance)) {
+      err() << "BaryTimeComputer::computeBaryTime(SourcePosition(" << ra << ", " << dec << "), ...)" <<
+        " returned AbsoluteTime(" << result_block[ii] << ") for element " << ii << ", not equivalent to AbsoluteTime(" <<
+        expected_bary << ") with tolerance of " << tolerance << "." << std::endl;
+    }
+  }
+  result_block.assign(2, original);
+  computer405.computeGeoTime(src_pos, glast_pos_block, result_block);
+  for (std::size_t ii = 0; ii < result_block.size(); ++ii) {
+    if (!result_block[ii].equivalentTo(expected_geo, tolerance)) {
+      err() << "BaryTimeComputer::computeGeoTime(SourcePosition(" << ra << ", " << dec << "), ...)" <<
+        " returned AbsoluteTime(" << result_block[ii] << ") for element " << ii << ", not equivalent to AbsoluteTime(" <<
+        expected_geo << ") with tolerance of " << tolerance << "." << std::endl;
+    }
+  }
+
+  // Test computation of time delays for a block of times.
+  Jd original_jd(0, 0.);
+  original.get("TT", original_jd);
+  std::vector<Jd> jd_block(2, original_jd);
+  std::vector<double> delay_block;
+  computer405.computeBaryDelay(src_pos, glast_pos_block, jd_block, delay_block);
+  for (std::size_t ii = 0; ii < delay_block.size(); ++ii) {
+    if (std::fabs(delay_block[ii] - bary_delay) > 1.e-7) {
+      err() << "BaryTimeComputer::computeBaryDelay returned " << delay_block[ii] << " for element " << ii <<
+        ", not equivalent to " << bary_delay << " with tolerance of 1.e-7 seconds." << std::endl;
+    }
+  }
+  computer405.computeGeoDelay(src_pos, glast_pos_block, jd_block, delay_block);
+  for (std::size_t ii = 0; ii < delay_block.size(); ++ii) {
+    if (std::fabs(delay_block[ii] - geo_delay) > 1.e-7) {
+      err() << "BaryTimeComputer::computeGeoDelay returned " << delay_block[ii] << " for element " << ii <<
+        ", not equivalent to " << geo_delay << " with tolerance of 1.e-7 seconds." << std::endl;
+    }
+  }
+
+  // Test consistency of time delays computed for a block of times at various times and positions, with those for single times.
+  std::vector<AbsoluteTime> varied_time;
+  std::vector<double> varied_pos;
+  for (int ii = 0; ii < 7; ++ii) {
+    varied_time.push_back(original + ElapsedTime("TT", Duration::from<Sec>(ii * 12345.678)));
+    varied_pos.push_back(glast_pos_array[(ii + 0) % 3]);
+    varied_pos.push_back(glast_pos_array[(ii + 1) % 3]);
+    varied_pos.push_back(glast_pos_array[(ii + 2) % 3]);
+  }
+  ElapsedTime tolerance_varied("TT", Duration::from<Sec>(1.e-9));
+  for (int bary_flag = 0; bary_flag < 2; ++bary_flag) {
+    result_block = varied_time;
+    if (bary_flag) computer405.computeBaryTime(src_pos, varied_pos, result_block);
+    else computer405.computeGeoTime(src_pos, varied_pos, result_block);
+    for (std::size_t ii = 0; ii < result_block.size(); ++ii) {
+      result = varied_time[ii];
+      if (bary_flag) computer405.computeBaryTime(src_pos, &varied_pos[3 * ii], result);
+      else computer405.computeGeoTime(src_pos, &varied_pos[3 * ii], result);
+      if (!result_block[ii].equivalentTo(result, tolerance_varied)) {
+        err() << "BaryTimeComputer::compute" << (bary_flag ? "Bary" : "Geo") << "Time for a block of times returned AbsoluteTime(" <<
+          result_block[ii] << ") for element " << ii << ", not equivalent to AbsoluteTime(" << result <<
+          ") computed for a single time, with tolerance of " << tolerance_varied << "." << std::endl;
+      }
+    }
+  }
+
+  // Test consistency of time delays computed for more than one source at a time, with those computed for each source.
+  std::vector<SourcePosition> src_pos_cont(1, src_pos);
+  src_pos_cont.push_back(SourcePosition(ra + 30., dec + 40.));
+  std::vector<Jd> varied_jd(varied_time.size(), original_jd);
+  for (std::size_t ii = 0; ii < varied_time.size(); ++ii) varied_time[ii].get("TT", varied_jd[ii]);
+  for (int bary_flag = 0; bary_flag < 2; ++bary_flag) {
+    std::vector<double> delay_multi;
+    if (bary_flag) computer405.computeBaryDelay(src_pos_cont, varied_pos, varied_jd, delay_multi);
+    else computer405.computeGeoDelay(src_pos_cont, varied_pos, varied_jd, delay_multi);
+    if (delay_multi.size() != src_pos_cont.size() * varied_jd.size()) {
+      err() << "BaryTimeComputer::compute" << (bary_flag ? "Bary" : "Geo") << "Delay for " << src_pos_cont.size() <<
+        " sources returned " << delay_multi.size() << " time delays, not " << src_pos_cont.size() * varied_jd.size() << "." << std::endl;
+      continue;
+    }
+    for (std::size_t src_index = 0; src_index < src_pos_cont.size(); ++src_index) {
+      if (bary_flag) computer405.computeBaryDelay(src_pos_cont[src_index], varied_pos, varied_jd, delay_block);
+      else computer405.computeGeoDelay(src_pos_cont[src_index], varied_pos, varied_jd, delay_block);
+      for (std::size_t ii = 0; ii < delay_block.size(); ++ii) {
+        double delay_result = delay_multi[src_index * varied_jd.size() + ii];
+        if (delay_result != delay_block[ii]) {
+          err() << "BaryTimeComputer::compute" << (bary_flag ? "Bary" : "Geo") << "Delay for " << src_pos_cont.size() <<
+            " sources returned " << delay_result << " for element " << ii << " of source " << src_index <<
+            ", not identical to " << delay_block[ii] << " computed for the source alone." << std::endl;
+        }
+      }
+    }
+  }
+
+  // Test error detection for a block of times with too few spacecraft positions.
+  try {
+    result_block.assign(3, original);
+    computer405.computeBaryTime(src_pos, glast_pos_block, result_block);
+    err() << "BaryTimeComputer::computeBaryTime did not throw an exception for three times with two spacecraft positions." <<
+      std::endl;
+  } catch (const std::exception &) {
+  }
+
   // Compute a source position at a finite distance, whose apparent viewing direction at the spacecraft
   // happens to be identical to the one used in the previous test (ra = 85.0482, dec = -69.3319).
   double distance_from_sc = 5000.; // Approximately 10 AU, in order for parallax to stand out.
@@ -3393,13 +3978,72 @@ void TimeSystemTestApp::testBaryTimeComputer() {
       ") with tolerance of " << tolerance << "." << std::endl;
   }
 
-  // Test error detection in getting a BaryTimeComputer object for a different, supported JPL ephemeris.
+  // Test prefetching solar system ephemeris, which must not change the result.
   try {
-    BaryTimeComputer::getComputer("JPL DE200");
-    err() << "BaryTimeComputer::getComputer(\"JPL DE200\") did not throw an exception when it should." << std::endl;
+    computer405.prefetchEphemeris(Jd(2451910, 0.), Jd(2451911, 0.));
+  } catch (const std::exception & x) {
+    err() << "BaryTimeComputer::prefetchEphemeris(Jd(2451910, 0.), Jd(2451911, 0.)) threw an exception when it should not: " <<
+      x.what() << std::endl;
+  }
+  result = original;
+  computer405.computeGeoTime(nearby_src, glast_pos, result);
+  if (!result.equivalentTo(expected_geo_nearby, tolerance)) {
+    err() << "BaryTimeComputer::computeGeoTime(nearby_src, " << original << ") after prefetching ephemeris" <<
+      " returned AbsoluteTime(" << result << "), not equivalent to AbsoluteTime(" << expected_geo_nearby <<
+      ") with tolerance of " << tolerance << "." << std::endl;
+  }
+  try {
+    computer405.prefetchEphemeris(Jd(1000000, 0.), Jd(1000001, 0.));
+    err() << "BaryTimeComputer::prefetchEphemeris(Jd(1000000, 0.), Jd(1000001, 0.)) did not throw an exception when it should." <<
+      std::endl;
   } catch (const std::exception &) {
   }
 
+  // Test inverse barycentric corrections of sorted times, which must give back the arrival times.
+  CircularOrbitComputer orbit_computer(original, 7.e+6, 5700.);
+  std::vector<AbsoluteTime> arrival_time;
+  for (int ii = 0; ii < 5; ++ii) arrival_time.push_back(original + ElapsedTime("TT", Duration(ii * 100., "Sec")));
+  std::vector<double> orbit_position;
+  orbit_computer.computeObsPosition(arrival_time, orbit_position);
+  std::vector<AbsoluteTime> inverse_time(arrival_time);
+  computer405.computeBaryTime(src_pos, orbit_position, inverse_time);
+  computer405.computeInverseBaryTime(src_pos, orbit_computer, inverse_time);
+  ElapsedTime inverse_tolerance("TT", Duration(1.e-8, "Sec"));
+  for (std::size_t ii = 0; ii < arrival_time.size(); ++ii) {
+    if (!inverse_time[ii].equivalentTo(arrival_time[ii], inverse_tolerance)) {
+      err() << "BaryTimeComputer::computeInverseBaryTime returned AbsoluteTime(" << inverse_time[ii] << ") for element " << ii <<
+        ", not equivalent to the original arrival time AbsoluteTime(" << arrival_time[ii] << ") with tolerance of " <<
+        inverse_tolerance << "." << std::endl;
+    }
+  }
+
+  // Test getting a BaryTimeComputer object for a different, supported JPL ephemeris, which must coexist with JPL DE405.
+  try {
+    const BaryTimeComputer & computer200 = BaryTimeComputer::getComputer("JPL DE200");
+
+    // Test barycentric correction with JPL DE200, which must be close to that with JPL DE405.
+    result = original;
+    computer200.computeBaryTime(ra, dec, glast_pos, result);
+    ElapsedTime tolerance_de200("TDB", Duration(1.e-3, "Sec"));
+    if (!result.equivalentTo(expected_bary, tolerance_de200)) {
+      err() << "BaryTimeComputer::computeBaryTime(" << ra << ", " << dec << ", " << original << ") with JPL DE200" <<
+        " returned AbsoluteTime(" << result << "), not equivalent to AbsoluteTime(" << expected_bary <<
+        ") with tolerance of " << tolerance_de200 << "." << std::endl;
+    }
+
+    // Test barycentric correction with JPL DE405 again, which must not be affected by JPL DE200.
+    result = original;
+    computer405.computeBaryTime(ra, dec, glast_pos, result);
+    tolerance = ElapsedTime("TDB", Duration(1.e-7, "Sec"));
+    if (!result.equivalentTo(expected_bary, tolerance)) {
+      err() << "BaryTimeComputer::computeBaryTime(" << ra << ", " << dec << ", " << original << ") with JPL DE405" <<
+        " after using JPL DE200 returned AbsoluteTime(" << result << "), not equivalent to AbsoluteTime(" << expected_bary <<
+        ") with tolerance of " << tolerance << "." << std::endl;
+    }
+  } catch (const std::exception & x) {
+    err() << "BaryTimeComputer::getComputer(\"JPL DE200\") threw an exception when it should not: " << x.what() << std::endl;
+  }
+
   // Test error non-detection in getting a BaryTimeComputer object for JPL DE405 again.
   try {
     BaryTimeComputer::getComputer("JPL DE405");
@@ -3663,6 +4307,111 @@ void TimeSystemTestApp::testglastscorbit() {
     }
   }
 
+  // Test the cursor statistics, which must show that the cursor answers most searches for time-ordered calls.
+  long num_hit = 0;
+  long num_miss = 0;
+  status = glastscorbit_getcursorstat(scptr, &num_hit, &num_miss);
+  if (status) {
+    err() << "Function glastscorbit_getcursorstat returns with non-zero status (" << status << ")." << std::endl;
+  } else if (0 == glastscorbit_getstatus(scptr) && num_hit <= num_miss) {
+    err() << "Function glastscorbit_getcursorstat returns " << num_hit << " hit(s) and " << num_miss <<
+      " miss(es) for time-ordered calls to glastscorbit_calcpos, where more hits than misses are expected." << std::endl;
+  }
+
+  // Test searches for bracketing rows in an order that defeats the cursor, which must give the same intervals as a linear scan.
+  // Every search that the cursor cannot answer must be answered by the table of runs of uniform cadence, without binary search.
+  long num_row = 0;
+  if (0 == glastscorbit_getstatus(scptr) && 0 == glastscorbit_getnumrows(scptr, &num_row)) {
+    std::vector<double> sc_time(num_row);
+    double dummy_position[3];
+    for (long irow = 0; irow < num_row; ++irow) glastscorbit_getrow(scptr, irow, &sc_time[irow], dummy_position);
+    double random_time[] = { 1005., 3115., 2055., 1119., 1500., 3005., 2001., 1060., 2999., 3061. };
+    long num_hit_before = 0;
+    long num_miss_before = 0;
+    long num_run_hit_before = 0;
+    glastscorbit_getcursorstat(scptr, &num_hit_before, &num_miss_before);
+    glastscorbit_getrunstat(scptr, &num_run_hit_before);
+    long previous_interval = scptr->cursor;
+    long num_hit_expected = 0;
+    long num_run_hit_expected = 0;
+    for (std::size_t ii = 0; ii < sizeof(random_time)/sizeof(random_time[0]); ++ii) {
+      long expected_interval = 0;
+      while (expected_interval < num_row - 2 && sc_time[expected_interval + 1] <= random_time[ii]) ++expected_interval;
+      if (expected_interval == previous_interval || expected_interval == previous_interval + 1) ++num_hit_expected;
+      else ++num_run_hit_expected;
+      previous_interval = expected_interval;
+      long result_interval = -1;
+      status = glastscorbit_getinterval(scptr, random_time[ii], &result_interval);
+      if (status || result_interval != expected_interval) {
+        err() << "Function glastscorbit_getinterval returns with status = " << status << " and interval = " <<
+          result_interval << " for MET = " << random_time[ii] << ", not with status = 0 and interval = " <<
+          expected_interval << " as expected." << std::endl;
+      }
+    }
+    long num_run_hit = 0;
+    glastscorbit_getcursorstat(scptr, &num_hit, &num_miss);
+    status = glastscorbit_getrunstat(scptr, &num_run_hit);
+    if (status) {
+      err() << "Function glastscorbit_getrunstat returns with non-zero status (" << status << ")." << std::endl;
+    } else if (num_hit - num_hit_before != num_hit_expected || num_run_hit - num_run_hit_before != num_run_hit_expected ||
+      num_miss != num_miss_before) {
+      err() << "Functions glastscorbit_getcursorstat and glastscorbit_getrunstat return " << num_hit - num_hit_before <<
+        " cursor hit(s), " << num_run_hit - num_run_hit_before << " run table hit(s), and " << num_miss - num_miss_before <<
+        " miss(es) for calls to glastscorbit_getinterval in random order, not " << num_hit_expected << ", " <<
+        num_run_hit_expected << ", and 0 as expected." << std::endl;
+    }
+    if (0 == num_run_hit_expected) {
+      err() << "Calls to glastscorbit_getinterval in random order are all answered by the cursor, and do not test the run" <<
+        " table." << std::endl;
+    }
+  }
+
+  // Test the reentrant functions with a caller-owned cursor, which must give the same results as the others, and must leave
+  // the cursor in the spacecraft file pointer untouched.
+  if (0 == glastscorbit_getstatus(scptr)) {
+    std::size_t num_par = sizeof(par_list)/sizeof(double)/4;
+    std::vector<double> scpos_expected(3 * num_par);
+    std::vector<long> interval_expected(num_par, -1);
+    for (std::size_t ipar = 0; ipar < num_par; ++ipar) {
+      glastscorbit_calcpos(scptr, par_list[ipar][0], &scpos_expected[3 * ipar]);
+      glastscorbit_getinterval(scptr, par_list[ipar][0], &interval_expected[ipar]);
+    }
+    long num_hit_before = 0;
+    long num_miss_before = 0;
+    glastscorbit_getcursorstat(scptr, &num_hit_before, &num_miss_before);
+    GlastScCursor cursor;
+    glastscorbit_initcursor(&cursor);
+    for (std::size_t ipar = 0; ipar < num_par; ++ipar) {
+      double glast_time = par_list[ipar][0];
+      double scpos_result[3];
+      status = glastscorbit_calcpos_r(scptr, &cursor, glast_time, scpos_result);
+      const double * this_expected = &scpos_expected[3 * ipar];
+      if (status || scpos_result[0] != this_expected[0] || scpos_result[1] != this_expected[1] ||
+          scpos_result[2] != this_expected[2]) {
+        err() << "Function glastscorbit_calcpos_r returns with status = " << status << " and (X, Y, Z) = (" << scpos_result[0] <<
+          ", " << scpos_result[1] << ", " << scpos_result[2] << ") for MET = " << glast_time << ", not with status = 0 and (" <<
+          this_expected[0] << ", " << this_expected[1] << ", " << this_expected[2] << ") as expected." << std::endl;
+      }
+      long result_interval = -1;
+      status = glastscorbit_getinterval_r(scptr, &cursor, glast_time, &result_interval);
+      if (status || result_interval != interval_expected[ipar]) {
+        err() << "Function glastscorbit_getinterval_r returns with status = " << status << " and interval = " <<
+          result_interval << " for MET = " << glast_time << ", not with status = 0 and interval = " << interval_expected[ipar] <<
+          " as expected." << std::endl;
+      }
+    }
+    glastscorbit_getcursorstat(scptr, &num_hit, &num_miss);
+    if (num_hit != num_hit_before || num_miss != num_miss_before) {
+      err() << "Function glastscorbit_calcpos_r and glastscorbit_getinterval_r change the cursor statistics of the spacecraft" <<
+        " file pointer, which must be left untouched." << std::endl;
+    }
+    if (cursor.num_hit <= cursor.num_miss) {
+      err() << "Function glastscorbit_calcpos_r and glastscorbit_getinterval_r count " << cursor.num_hit << " hit(s) and " <<
+        cursor.num_miss << " miss(es) in the given cursor for time-ordered calls, where more hits than misses are expected." <<
+        std::endl;
+    }
+  }
+
   // Test clean-up function.
   status = glastscorbit_close(scptr);
   if (status) {
@@ -3958,6 +4707,10 @@ void TimeSystemTestApp::testglastscorbit() {
   GlastScFile test_scfile;
   test_scfile.data = 0;
   test_scfile.status = 0;
+  test_scfile.cursor = -1;
+  test_scfile.num_hit = 0;
+  test_scfile.num_run_hit = 0;
+  test_scfile.num_miss = 0;
   status = glastscorbit_calcpos(&test_scfile, 1001., dummy_array);
   if (!status) {
     err() << "Function glastscorbit_calcpos returns zero (0), given a null pointer to the spacecraft data table." << std::endl;
@@ -4111,6 +4864,33 @@ void TimeSystemTestApp::testGlastTimeHandler() {
     err() << "GlastTimeHandler::createInstance method did not return a GlastBaryTimeHandler object." << std::endl;
   }
 
+  // Test selection of a handler class by header keyword values read only once.
+  GlastTimeHandler::HeaderKeyword keyword_sc = GlastTimeHandler::readHeaderKeyword(event_file, "EVENTS");
+  GlastTimeHandler::HeaderKeyword keyword_geo = GlastTimeHandler::readHeaderKeyword(event_file_geo, "EVENTS");
+  GlastTimeHandler::HeaderKeyword keyword_bary = GlastTimeHandler::readHeaderKeyword(event_file_bary, "EVENTS");
+  if (!GlastScTimeHandler::isSupported(keyword_sc) || GlastScTimeHandler::isSupported(keyword_geo) ||
+    GlastScTimeHandler::isSupported(keyword_bary)) {
+    err() << "GlastScTimeHandler::isSupported method did not accept only the header keywords of a non-corrected file." << std::endl;
+  }
+  if (GlastGeoTimeHandler::isSupported(keyword_sc) || !GlastGeoTimeHandler::isSupported(keyword_geo) ||
+    GlastGeoTimeHandler::isSupported(keyword_bary)) {
+    err() << "GlastGeoTimeHandler::isSupported method did not accept only the header keywords of a geocentered file." << std::endl;
+  }
+  if (GlastBaryTimeHandler::isSupported(keyword_sc) || GlastBaryTimeHandler::isSupported(keyword_geo) ||
+    !GlastBaryTimeHandler::isSupported(keyword_bary)) {
+    err() << "GlastBaryTimeHandler::isSupported method did not accept only the header keywords of a barycentered file." << std::endl;
+  }
+  handler.reset(GlastTimeHandler::createInstance(event_file_geo, "EVENTS", keyword_geo));
+  if (0 == dynamic_cast<GlastGeoTimeHandler *>(handler.get())) {
+    err() << "GlastTimeHandler::createInstance method did not return a GlastGeoTimeHandler object for given header keywords."
+      << std::endl;
+  }
+  handler.reset(GlastBaryTimeHandler::createInstance(event_file_bary, "EVENTS", keyword_geo));
+  if (0 != handler.get()) {
+    err() << "GlastBaryTimeHandler::createInstance method did not return a null pointer (0) for header keywords of a geocentered file."
+      << std::endl;
+  }
+
   // Create a GlastScTimeHandler object for EVENTS extension of an event file.
   handler.reset(GlastScTimeHandler::createInstance(event_file, "EVENTS"));
 
@@ -4282,6 +5062,129 @@ void TimeSystemTestApp::testGlastTimeHandler() {
     }
   }
 
+  // Test approximate barycentric corrections for a block of times, with time delays interpolated between nodes.
+  GlastScTimeHandler * sc_handler = dynamic_cast<GlastScTimeHandler *>(handler.get());
+  if (0 == sc_handler) {
+    err() << "GlastScTimeHandler::createInstance method did not return a GlastScTimeHandler object." << std::endl;
+  } else {
+    // Prepare times in descending order, many of which fall in each interval of the spacecraft data.
+    std::vector<double> glast_time_block;
+    for (int ii = 0; ii < 2000; ++ii) glast_time_block.push_back(2.123393750454886E+08 + (2000 - ii) * .3);
+    std::vector<AbsoluteTime> exact_block;
+    sc_handler->computeCorrectedTime(glast_time_block, true, exact_block);
+    if (0. != sc_handler->getMaxDelayError()) {
+      err() << "GlastScTimeHandler::getMaxDelayError() returned " << sc_handler->getMaxDelayError() <<
+        " before interpolation of time delays is enabled." << std::endl;
+    }
+
+    // Compare interpolated times with exact ones.
+    double delay_tolerance = 1.e-8;
+    ElapsedTime interpolation_tolerance("TT", Duration(delay_tolerance, "Sec"));
+    std::vector<AbsoluteTime> interpolated_block;
+    sc_handler->setDelayTolerance(delay_tolerance);
+    sc_handler->computeCorrectedTime(glast_time_block, true, interpolated_block);
+    double max_delay_error = sc_handler->getMaxDelayError();
+    if (!(max_delay_error > 0. && max_delay_error <= delay_tolerance)) {
+      err() << "GlastScTimeHandler::getMaxDelayError() returned " << max_delay_error << " after interpolation of time delays" <<
+        " with tolerance of " << delay_tolerance << " second(s)." << std::endl;
+    }
+
+    // Test that interpolated times do not depend on how the times are split into calls.
+    std::vector<SourcePosition> split_position(1, SourcePosition(ra, dec));
+    std::vector<double> whole_block;
+    sc_handler->computeCorrectedGlastTime(glast_time_block, split_position, true, whole_block);
+    std::size_t split_size = 7;
+    for (std::size_t first_index = 0; first_index < glast_time_block.size(); first_index += split_size) {
+      std::size_t last_index = std::min(first_index + split_size, glast_time_block.size());
+      std::vector<double> split_time(glast_time_block.begin() + first_index, glast_time_block.begin() + last_index);
+      std::vector<double> split_block;
+      sc_handler->computeCorrectedGlastTime(split_time, split_position, true, split_block);
+      bool match = (split_block.size() == split_time.size());
+      for (std::size_t ii = 0; match && ii < split_block.size(); ++ii) match = (split_block[ii] == whole_block[first_index + ii]);
+      if (!match) {
+        err() << "GlastScTimeHandler::computeCorrectedGlastTime with delay tolerance of " << delay_tolerance <<
+          " second(s) returned different times for elements " << first_index << " to " << last_index - 1 <<
+          " when given in a block of " << split_size << " time(s), than when given all at once." << std::endl;
+        break;
+      }
+    }
+    sc_handler->setDelayTolerance(0.);
+    for (std::size_t ii = 0; ii < exact_block.size(); ++ii) {
+      if (!interpolated_block[ii].equivalentTo(exact_block[ii], interpolation_tolerance)) {
+        err() << "GlastScTimeHandler::computeCorrectedTime with delay tolerance of " << delay_tolerance <<
+          " second(s) returned AbsoluteTime(" << interpolated_block[ii] << ") for element " << ii <<
+          ", not equivalent to AbsoluteTime(" << exact_block[ii] << ") with tolerance of " << interpolation_tolerance << "." << std::endl;
+        break;
+      }
+    }
+
+    // Test computation of barycentric times directly as METs, which must agree with those computed through AbsoluteTime.
+    std::vector<SourcePosition> src_position(1, SourcePosition(ra, dec));
+    std::vector<double> direct_block;
+    std::vector<double> converted_block;
+    sc_handler->computeCorrectedGlastTime(glast_time_block, src_position, true, direct_block);
+    sc_handler->computeGlastTime(exact_block, TimeSystem::getSystem("TDB"), converted_block);
+    double met_tolerance = 1.e-7;
+    if (direct_block.size() != converted_block.size()) {
+      err() << "GlastScTimeHandler::computeCorrectedGlastTime returned " << direct_block.size() << " time(s), not " <<
+        converted_block.size() << "." << std::endl;
+    } else {
+      for (std::size_t ii = 0; ii < direct_block.size(); ++ii) {
+        if (std::fabs(direct_block[ii] - converted_block[ii]) > met_tolerance) {
+          err() << "GlastScTimeHandler::computeCorrectedGlastTime returned " << direct_block[ii] << " for element " << ii <<
+            ", not " << converted_block[ii] << " with tolerance of " << met_tolerance << " second(s)." << std::endl;
+          break;
+        }
+      }
+    }
+
+    // Test arrival time corrections with a list of spacecraft files, which must give the same times as the listed file.
+    std::string sc_list(getMethod() + "_sc.lis");
+    {
+      std::ofstream ofs(sc_list.c_str());
+      ofs << sc_file << std::endl;
+    }
+    sc_handler->initTimeCorrection("@" + sc_list, "SC_DATA", pl_ephem, match_solar_eph, angular_tolerance);
+    std::vector<AbsoluteTime> list_block;
+    sc_handler->computeCorrectedTime(glast_time_block, true, list_block);
+    for (std::size_t ii = 0; ii < exact_block.size(); ++ii) {
+      if (!list_block[ii].equivalentTo(exact_block[ii], time_tolerance)) {
+        err() << "GlastScTimeHandler::computeCorrectedTime with spacecraft file list \"@" << sc_list <<
+          "\" returned AbsoluteTime(" << list_block[ii] << ") for element " << ii << ", not equivalent to AbsoluteTime(" <<
+          exact_block[ii] << ") with tolerance of " << time_tolerance << "." << std::endl;
+        break;
+      }
+    }
+    sc_handler->initTimeCorrection(sc_file, "SC_DATA", pl_ephem, match_solar_eph, angular_tolerance);
+    remove(sc_list.c_str());
+  }
+
+  // Test column-wise access to times through the EventTimeHandler interface, which must agree with record-wise access.
+  {
+    static const tip::Index_t num_rows = 3;
+    double glast_time_array[num_rows];
+    double bary_time_array[num_rows];
+    handler->readTimes("TIME", 0, num_rows, glast_time_array);
+    handler->getBaryTimes("TIME", 0, num_rows, bary_time_array);
+    handler->setFirstRecord();
+    for (tip::Index_t row_index = 0; row_index < num_rows; ++row_index, handler->setNextRecord()) {
+      AbsoluteTime expected_glast = handler->readTime("TIME");
+      AbsoluteTime result_glast = glast_tt_origin + ElapsedTime("TT", Duration(glast_time_array[row_index], "Sec"));
+      if (!result_glast.equivalentTo(expected_glast, time_tolerance)) {
+        err() << "GlastScTimeHandler::readTimes(\"TIME\", 0, " << num_rows << ", ...) returned " << glast_time_array[row_index] <<
+          " for row " << row_index << ", not equivalent to AbsoluteTime(" << expected_glast << ") with tolerance of " <<
+          time_tolerance << "." << std::endl;
+      }
+      AbsoluteTime expected_bary = handler->getBaryTime("TIME");
+      AbsoluteTime result_bary = glast_tdb_origin + ElapsedTime("TDB", Duration(bary_time_array[row_index], "Sec"));
+      if (!result_bary.equivalentTo(expected_bary, time_tolerance)) {
+        err() << "GlastScTimeHandler::getBaryTimes(\"TIME\", 0, " << num_rows << ", ...) returned " << bary_time_array[row_index] <<
+          " for row " << row_index << ", not equivalent to AbsoluteTime(" << expected_bary << ") with tolerance of " <<
+          time_tolerance << "." << std::endl;
+      }
+    }
+  }
+
   // Create a GlastScTimeHandler object for EVENTS extension of a copied event file for write testing.
   handler.reset(GlastScTimeHandler::createInstance(event_file_copy, "EVENTS", false));
 
@@ -4731,6 +5634,116 @@ void TimeSystemTestApp::testGlastTimeHandler() {
   }
 }
 
+void TimeSystemTestApp::testCorrectionService() {
+  setMethod("testCorrectionService");
+
+  // Prepare test parameters in this method.
+  std::string event_file = prependDataPath("testevdata_1day.fits");
+  std::string sc_file = prependDataPath("testscdata_1day.fits");
+  std::string sc_file_copy(getMethod() + "_scdata.fits");
+  double ra = 85.0482;
+  double dec = -69.3319;
+  double angular_tolerance = 1.e-8; // In degrees.
+  std::string pl_ephem = "JPL DE405";
+  bool match_solar_eph = true;
+
+  // Pick a time in the first half of the spacecraft data, and one in the second half.
+  tip::Index_t num_sc_rows = 0;
+  double early_time = 0.;
+  double late_time = 0.;
+  {
+    std::unique_ptr<const tip::Table> sc_table(tip::IFileSvc::instance().readTable(sc_file, "SC_DATA"));
+    num_sc_rows = sc_table->getNumRecords();
+    tip::Table::ConstIterator sc_itor = sc_table->begin();
+    for (tip::Index_t row_index = 0; sc_itor != sc_table->end(); ++sc_itor, ++row_index) {
+      double sc_time = 0.;
+      (*sc_itor)["START"].get(sc_time);
+      if (1 == row_index) early_time = sc_time + 1.;
+      if (num_sc_rows - 3 == row_index) late_time = sc_time + 1.;
+    }
+  }
+
+  // Compute the expected barycentric times at the two times.
+  std::vector<double> glast_time;
+  glast_time.push_back(early_time);
+  glast_time.push_back(late_time);
+  std::vector<double> expected_time;
+  {
+    std::unique_ptr<EventTimeHandler> handler(GlastScTimeHandler::createInstance(event_file, "EVENTS"));
+    GlastScTimeHandler & sc_handler(static_cast<GlastScTimeHandler &>(*handler));
+    sc_handler.initTimeCorrection(sc_file, "SC_DATA", pl_ephem, match_solar_eph, angular_tolerance);
+    std::vector<AbsoluteTime> abs_time;
+    sc_handler.computeCorrectedTime(glast_time, std::vector<SourcePosition>(1, SourcePosition(ra, dec)), true, abs_time);
+    sc_handler.computeGlastTime(abs_time, TimeSystem::getSystem("TDB"), expected_time);
+  }
+
+  // Start the service with a copy of the spacecraft file that covers only the first half of the spacecraft data.
+  tip::IFileSvc::instance().openFile(sc_file).copyFile(sc_file_copy, true);
+  {
+    std::unique_ptr<tip::Table> sc_table(tip::IFileSvc::instance().editTable(sc_file_copy, "SC_DATA"));
+    sc_table->setNumRecords(num_sc_rows / 2);
+  }
+  std::unique_ptr<EventTimeHandler> handler(GlastScTimeHandler::createInstance(event_file, "EVENTS"));
+  CorrectionService service(static_cast<GlastScTimeHandler &>(*handler), sc_file_copy, "SC_DATA", pl_ephem, angular_tolerance,
+    true);
+
+  // Test parsing of requests, error replies, an empty line, and a request to quit, after which no request is served.
+  std::ostringstream oss_request;
+  oss_request.precision(std::numeric_limits<double>::digits10 + 2);
+  oss_request << ra << " " << dec << " " << early_time << std::endl;
+  oss_request << "  " << std::endl;
+  oss_request << "not a request" << std::endl;
+  oss_request << ra << " " << dec << " " << early_time << " no_such_time" << std::endl;
+  oss_request << ra << " " << dec << " " << late_time << std::endl;
+  oss_request << " QUIT " << std::endl;
+  oss_request << ra << " " << dec << " " << early_time << std::endl;
+  std::istringstream iss_request(oss_request.str());
+  std::ostringstream oss_reply;
+  long num_request = service.serve(iss_request, oss_reply);
+  if (4 != num_request) {
+    err() << "CorrectionService::serve method served " << num_request << " request(s), not 4 as expected." << std::endl;
+  }
+  std::vector<std::string> reply_cont;
+  {
+    std::istringstream iss_reply(oss_reply.str());
+    std::string line;
+    while (std::getline(iss_reply, line)) reply_cont.push_back(line);
+  }
+  if (4 != reply_cont.size()) {
+    err() << "CorrectionService::serve method wrote " << reply_cont.size() << " reply line(s), not 4 as expected." << std::endl;
+  } else {
+    double result_time = 0.;
+    std::istringstream iss_time(reply_cont[0]);
+    if (!(iss_time >> result_time) || std::fabs(result_time - expected_time[0]) > 1.e-9) {
+      err() << "CorrectionService::serve method replied \"" << reply_cont[0] << "\" to a request for MET " << early_time <<
+        ", not " << expected_time[0] << " as expected." << std::endl;
+    }
+    for (std::size_t reply_index = 1; reply_index < reply_cont.size(); ++reply_index) {
+      if (0 != reply_cont[reply_index].compare(0, 6, "ERROR ")) {
+        err() << "CorrectionService::serve method replied \"" << reply_cont[reply_index] << "\" to request #" <<
+          reply_index + 1 << ", not an error as expected." << std::endl;
+      }
+    }
+  }
+
+  // Test reloading of the spacecraft file, which now covers the second half of the spacecraft data as well.
+  tip::IFileSvc::instance().openFile(sc_file).copyFile(sc_file_copy, true);
+  std::ostringstream oss_late;
+  oss_late.precision(std::numeric_limits<double>::digits10 + 2);
+  oss_late << ra << " " << dec << " " << early_time << " " << late_time << std::endl;
+  std::istringstream iss_late(oss_late.str());
+  std::ostringstream oss_late_reply;
+  service.serve(iss_late, oss_late_reply);
+  std::istringstream iss_late_reply(oss_late_reply.str());
+  std::vector<double> result_time(2, 0.);
+  if (!(iss_late_reply >> result_time[0] >> result_time[1]) || std::fabs(result_time[0] - expected_time[0]) > 1.e-9 ||
+      std::fabs(result_time[1] - expected_time[1]) > 1.e-9) {
+    err() << "CorrectionService::serve method replied \"" << oss_late_reply.str() << "\" to a request for METs " <<
+      early_time << " and " << late_time << " after the spacecraft file was updated, not " << expected_time[0] << " and " <<
+      expected_time[1] << " as expected." << std::endl;
+  }
+}
+
 void TimeSystemTestApp::testTimeCorrectorApp() {
   setMethod("testTimeCorrectorApp");
 
@@ -4745,6 +5758,16 @@ void TimeSystemTestApp::testTimeCorrectorApp() {
   test_name_cont.push_back("par4");
   test_name_cont.push_back("par5");
   test_name_cont.push_back("par6");
+  test_name_cont.push_back("par7");
+  test_name_cont.push_back("par8");
+  test_name_cont.push_back("par9");
+  test_name_cont.push_back("par10");
+  test_name_cont.push_back("par11");
+  test_name_cont.push_back("par12");
+  test_name_cont.push_back("par13");
+  test_name_cont.push_back("par14");
+  test_name_cont.push_back("par15");
+  test_name_cont.push_back("par16");
 
   // Prepare settings to be used in the tests.
   std::string evfile_0540 = prependDataPath("testevdata_1day_unordered.fits");
@@ -4753,6 +5776,18 @@ void TimeSystemTestApp::testTimeCorrectorApp() {
   double dec_0540 = -69.3319;
   std::string evfile_bary = prependDataPath("testevdata_1day_unordered_bary.fits");
   std::string evfile_geo = prependDataPath("testevdata_1day_unordered_geo.fits");
+  std::string stat_file(getMethod() + "_par9.json");
+  std::string batch_out_file(getMethod() + "_par11_2.fits");
+  std::string multi_src_out_file(getMethod() + "_par12_2.fits");
+  std::string part_ev_file(getMethod() + "_par13_in.fits");
+  std::string incremental_out_file(getMethod() + "_par13.fits");
+  std::string incremental_stat_file(getMethod() + "_par14.json");
+  tip::Index_t num_event_0540 = 0;
+  {
+    std::unique_ptr<const tip::Table> table(tip::IFileSvc::instance().readTable(evfile_0540, "EVENTS"));
+    num_event_0540 = table->getNumRecords();
+  }
+  tip::Index_t num_part_event = num_event_0540 / 2;
 
   // Loop over parameter sets.
   for (std::list<std::string>::const_iterator test_itor = test_name_cont.begin(); test_itor != test_name_cont.end(); ++test_itor) {
@@ -4776,6 +5811,16 @@ void TimeSystemTestApp::testTimeCorrectorApp() {
     pars["timefield"] = "TIME";
     pars["sctable"] = "SC_DATA";
     pars["leapsecfile"] = "DEFAULT";
+    pars["blocksize"] = 10000;
+    pars["nthreads"] = 1;
+    pars["nworkers"] = 1;
+    pars["queuedepth"] = 0;
+    pars["srcfile"] = "NONE";
+    pars["delaytol"] = 0.;
+    pars["streaming"] = "yes";
+    pars["incremental"] = "no";
+    pars["service"] = "no";
+    pars["statfile"] = "NONE";
     pars["chatter"] = 2;
     pars["clobber"] = "yes";
     pars["debug"] = "no";
@@ -4808,7 +5853,8 @@ void TimeSystemTestApp::testTimeCorrectorApp() {
       log_file_ref.erase();
 
     } else if ("par3" == test_name) {
-      // Test refusal of barycentric corrections on a barycentered file.
+      // Test barycentric corrections on a barycentered file, which must leave event times as they are.
+      // Note: The output file is checked against the input file after all the tests.
       pars["evfile"] = evfile_bary;
       pars["scfile"] = scfile_0540;
       pars["outfile"] = out_file;
@@ -4816,15 +5862,10 @@ void TimeSystemTestApp::testTimeCorrectorApp() {
       pars["dec"] = dec_0540;
       pars["tcorrect"] = "BARY";
 
-      remove(log_file_ref.c_str());
-      std::ofstream ofs(log_file_ref.c_str());
-      std::runtime_error error("Unsupported timing extension: HDU 1 (EXTNAME=EVENTS) of input file \"" + evfile_bary + "\"");
-      app_tester.writeException(ofs, error);
-      ofs.close();
-
+      log_file.erase();
+      log_file_ref.erase();
       out_file.erase();
       out_file_ref.erase();
-      ignore_exception = true;
 
     } else if ("par4" == test_name) {
       // Test refusal of geocentric corrections on a barycentered file.
@@ -4865,7 +5906,8 @@ void TimeSystemTestApp::testTimeCorrectorApp() {
       ignore_exception = true;
 
     } else if ("par6" == test_name) {
-      // Test refusal of geocentric corrections on a geocentered file.
+      // Test geocentric corrections on a geocentered file, which must leave event times as they are.
+      // Note: The output file is checked against the input file after all the tests.
       pars["evfile"] = evfile_geo;
       pars["scfile"] = scfile_0540;
       pars["outfile"] = out_file;
@@ -4873,15 +5915,183 @@ void TimeSystemTestApp::testTimeCorrectorApp() {
       pars["dec"] = dec_0540;
       pars["tcorrect"] = "GEO";
 
-      remove(log_file_ref.c_str());
-      std::ofstream ofs(log_file_ref.c_str());
-      std::runtime_error error("Unsupported timing extension: HDU 0 (primary HDU) of input file \"" + evfile_geo + "\"");
-      app_tester.writeException(ofs, error);
-      ofs.close();
-
+      log_file.erase();
+      log_file_ref.erase();
       out_file.erase();
       out_file_ref.erase();
-      ignore_exception = true;
+
+    } else if ("par7" == test_name) {
+      // Test barycentric corrections row by row, which must produce the same output as block-wise corrections.
+      pars["evfile"] = evfile_0540;
+      pars["scfile"] = scfile_0540;
+      pars["outfile"] = out_file;
+      pars["ra"] = ra_0540;
+      pars["dec"] = dec_0540;
+      pars["tcorrect"] = "BARY";
+      pars["blocksize"] = 0;
+
+      log_file.erase();
+      log_file_ref.erase();
+      out_file_ref = prependOutrefPath(getMethod() + "_par1.fits");
+
+    } else if ("par8" == test_name) {
+      // Test barycentric corrections with multiple threads, which must produce the same output as a single thread.
+      pars["evfile"] = evfile_0540;
+      pars["scfile"] = scfile_0540;
+      pars["outfile"] = out_file;
+      pars["ra"] = ra_0540;
+      pars["dec"] = dec_0540;
+      pars["tcorrect"] = "BARY";
+      pars["blocksize"] = 1000;
+      pars["nthreads"] = 4;
+
+      log_file.erase();
+      log_file_ref.erase();
+      out_file_ref = prependOutrefPath(getMethod() + "_par1.fits");
+
+    } else if ("par9" == test_name) {
+      // Test barycentric corrections with performance statistics collected, which must not change the output.
+      pars["evfile"] = evfile_0540;
+      pars["scfile"] = scfile_0540;
+      pars["outfile"] = out_file;
+      pars["ra"] = ra_0540;
+      pars["dec"] = dec_0540;
+      pars["tcorrect"] = "BARY";
+      pars["statfile"] = stat_file;
+      remove(stat_file.c_str());
+
+      log_file.erase();
+      log_file_ref.erase();
+      out_file_ref = prependOutrefPath(getMethod() + "_par1.fits");
+
+    } else if ("par10" == test_name) {
+      // Test barycentric corrections without streaming the output, which must produce the same output as streaming.
+      pars["evfile"] = evfile_0540;
+      pars["scfile"] = scfile_0540;
+      pars["outfile"] = out_file;
+      pars["ra"] = ra_0540;
+      pars["dec"] = dec_0540;
+      pars["tcorrect"] = "BARY";
+      pars["streaming"] = "no";
+
+      log_file.erase();
+      log_file_ref.erase();
+      out_file_ref = prependOutrefPath(getMethod() + "_par1.fits");
+
+    } else if ("par11" == test_name) {
+      // Test barycentric corrections in batch mode, correcting two files concurrently if cfitsio is built reentrant.
+      std::string in_list(getMethod() + "_par11_in.lis");
+      std::string out_list(getMethod() + "_par11_out.lis");
+      std::ofstream ofs_in(in_list.c_str());
+      ofs_in << evfile_0540 << std::endl << evfile_0540 << std::endl;
+      std::ofstream ofs_out(out_list.c_str());
+      ofs_out << out_file << std::endl << batch_out_file << std::endl;
+      pars["evfile"] = "@" + in_list;
+      pars["scfile"] = scfile_0540;
+      pars["outfile"] = "@" + out_list;
+      pars["ra"] = ra_0540;
+      pars["dec"] = dec_0540;
+      pars["tcorrect"] = "BARY";
+      pars["nworkers"] = fits_is_reentrant() ? 2 : 1;
+      remove(batch_out_file.c_str());
+
+      log_file.erase();
+      log_file_ref.erase();
+      out_file_ref = prependOutrefPath(getMethod() + "_par1.fits");
+
+    } else if ("par12" == test_name) {
+      // Test barycentric corrections for two sources in a single pass over the input file.
+      std::string src_list(getMethod() + "_par12_src.lis");
+      std::ofstream ofs_src(src_list.c_str());
+      ofs_src.precision(std::numeric_limits<double>::digits10);
+      ofs_src << "# RA Dec outfile" << std::endl;
+      ofs_src << ra_0540 << " " << dec_0540 << " " << out_file << std::endl;
+      ofs_src << ra_0540 << " " << dec_0540 << " " << multi_src_out_file << std::endl;
+      pars["evfile"] = evfile_0540;
+      pars["scfile"] = scfile_0540;
+      pars["outfile"] = "";
+      pars["srcfile"] = src_list;
+      pars["tcorrect"] = "BARY";
+      remove(multi_src_out_file.c_str());
+
+      log_file.erase();
+      log_file_ref.erase();
+      out_file_ref = prependOutrefPath(getMethod() + "_par1.fits");
+
+    } else if ("par13" == test_name) {
+      // Test barycentric corrections in incremental mode, for the first half of the events in the input file.
+      tip::IFileSvc::instance().openFile(evfile_0540).copyFile(part_ev_file, true);
+      {
+        std::unique_ptr<tip::Table> table(tip::IFileSvc::instance().editTable(part_ev_file, "EVENTS"));
+        table->setNumRecords(num_part_event);
+      }
+      pars["evfile"] = part_ev_file;
+      pars["scfile"] = scfile_0540;
+      pars["outfile"] = incremental_out_file;
+      pars["ra"] = ra_0540;
+      pars["dec"] = dec_0540;
+      pars["tcorrect"] = "BARY";
+      pars["incremental"] = "yes";
+      remove(incremental_out_file.c_str());
+
+      log_file.erase();
+      log_file_ref.erase();
+      out_file.erase();
+
+    } else if ("par14" == test_name) {
+      // Test barycentric corrections in incremental mode, for the rest of the events appended to the input file of "par13".
+      // Note: The output file of "par13" must be appended to even though clobber parameter is set to no.
+      pars["evfile"] = evfile_0540;
+      pars["scfile"] = scfile_0540;
+      pars["outfile"] = incremental_out_file;
+      pars["ra"] = ra_0540;
+      pars["dec"] = dec_0540;
+      pars["tcorrect"] = "BARY";
+      pars["incremental"] = "yes";
+      pars["statfile"] = incremental_stat_file;
+      pars["clobber"] = "no";
+      remove(incremental_stat_file.c_str());
+
+      log_file.erase();
+      log_file_ref.erase();
+      out_file.erase();
+
+    } else if ("par15" == test_name) {
+      // Test barycentric corrections with blocks of rows pipelined between reading, correcting, and writing threads, which
+      // must produce the same output as a serial processing.
+      pars["evfile"] = evfile_0540;
+      pars["scfile"] = scfile_0540;
+      pars["outfile"] = out_file;
+      pars["ra"] = ra_0540;
+      pars["dec"] = dec_0540;
+      pars["tcorrect"] = "BARY";
+      pars["blocksize"] = 1000;
+      pars["nthreads"] = 2;
+      pars["queuedepth"] = 2;
+
+      log_file.erase();
+      log_file_ref.erase();
+      out_file_ref = prependOutrefPath(getMethod() + "_par1.fits");
+
+    } else if ("par16" == test_name) {
+      // Test barycentric corrections with pipelining requested and a spacecraft file list, for which the correcting thread
+      // opens spacecraft files while the other threads access FITS files. Pipelining must fall back on a serial processing
+      // unless cfitsio is built reentrant, and either way must produce the same output as a serial processing.
+      std::string sc_list(getMethod() + "_par16_sc.lis");
+      std::ofstream ofs_sc(sc_list.c_str());
+      ofs_sc << scfile_0540 << std::endl;
+      pars["evfile"] = evfile_0540;
+      pars["scfile"] = "@" + sc_list;
+      pars["outfile"] = out_file;
+      pars["ra"] = ra_0540;
+      pars["dec"] = dec_0540;
+      pars["tcorrect"] = "BARY";
+      pars["blocksize"] = 1000;
+      pars["queuedepth"] = 2;
+
+      log_file.erase();
+      log_file_ref.erase();
+      out_file_ref = prependOutrefPath(getMethod() + "_par1.fits");
 
     } else {
       // Skip this iteration.
@@ -4894,6 +6104,101 @@ void TimeSystemTestApp::testTimeCorrectorApp() {
     // Test the application.
     app_tester.test(pars, log_file, log_file_ref, out_file, out_file_ref, ignore_exception);
   }
+
+  // Check the event times in the output files written by the tests "par3" and "par6", which must be identical to the input.
+  std::vector<std::pair<std::string, std::string> > identity_file_cont;
+  identity_file_cont.push_back(std::make_pair(getMethod() + "_par3.fits", evfile_bary));
+  identity_file_cont.push_back(std::make_pair(getMethod() + "_par6.fits", evfile_geo));
+  for (std::size_t ii = 0; ii < identity_file_cont.size(); ++ii) {
+    const std::string & out_file = identity_file_cont[ii].first;
+    const std::string & in_file = identity_file_cont[ii].second;
+    std::unique_ptr<const tip::Table> out_table(tip::IFileSvc::instance().readTable(out_file, "EVENTS"));
+    std::unique_ptr<const tip::Table> in_table(tip::IFileSvc::instance().readTable(in_file, "EVENTS"));
+    if (out_table->getNumRecords() != in_table->getNumRecords()) {
+      err() << "File " << out_file << " contains " << out_table->getNumRecords() << " event(s), not " <<
+        in_table->getNumRecords() << " as in input file " << in_file << "." << std::endl;
+      continue;
+    }
+    tip::Table::ConstIterator out_itor = out_table->begin();
+    tip::Table::ConstIterator in_itor = in_table->begin();
+    for (tip::Index_t row_index = 1; out_itor != out_table->end(); ++out_itor, ++in_itor, ++row_index) {
+      double out_time = 0.;
+      double in_time = 0.;
+      (*out_itor)["TIME"].get(out_time);
+      (*in_itor)["TIME"].get(in_time);
+      if (out_time != in_time) {
+        err() << "Row #" << row_index << " of file " << out_file << " has TIME of " << out_time << ", not " << in_time <<
+          " as in input file " << in_file << "." << std::endl;
+        break;
+      }
+    }
+  }
+
+  // Check the second output file written by the test "par11".
+  app_tester.checkOutputFits(batch_out_file, prependOutrefPath(getMethod() + "_par1.fits"));
+
+  // Check the second output file written by the test "par12".
+  app_tester.checkOutputFits(multi_src_out_file, prependOutrefPath(getMethod() + "_par1.fits"));
+
+  // Check the output file extended by the test "par14", whose event times must be identical to those written by the test "par1",
+  // and check that only the appended events were corrected by the test "par14".
+  {
+    std::string full_out_file(getMethod() + "_par1.fits");
+    std::unique_ptr<const tip::Table> out_table(tip::IFileSvc::instance().readTable(incremental_out_file, "EVENTS"));
+    std::unique_ptr<const tip::Table> full_table(tip::IFileSvc::instance().readTable(full_out_file, "EVENTS"));
+    if (out_table->getNumRecords() != num_event_0540 || full_table->getNumRecords() != num_event_0540) {
+      err() << "File " << incremental_out_file << " or " << full_out_file << " does not contain " << num_event_0540 <<
+        " event(s) as in input file " << evfile_0540 << "." << std::endl;
+    } else {
+      tip::Table::ConstIterator out_itor = out_table->begin();
+      tip::Table::ConstIterator full_itor = full_table->begin();
+      for (tip::Index_t row_index = 1; out_itor != out_table->end(); ++out_itor, ++full_itor, ++row_index) {
+        double out_time = 0.;
+        double full_time = 0.;
+        (*out_itor)["TIME"].get(out_time);
+        (*full_itor)["TIME"].get(full_time);
+        if (std::fabs(out_time - full_time) > 1.e-9) {
+          err() << "Row #" << row_index << " of file " << incremental_out_file << " has TIME of " << out_time << ", not " <<
+            full_time << " as in file " << full_out_file << "." << std::endl;
+          break;
+        }
+      }
+    }
+    int num_history_block = 0;
+    const tip::Header & out_header(out_table->getHeader());
+    for (tip::Header::ConstIterator key_itor = out_header.begin(); key_itor != out_header.end(); ++key_itor) {
+      if ("HISTORY" == key_itor->getName() && key_itor->get().find("File created or modified by gtbary ") != std::string::npos) {
+        ++num_history_block;
+      }
+    }
+    if (1 != num_history_block) {
+      err() << "EVENTS extension of file " << incremental_out_file << " contains " << num_history_block <<
+        " HISTORY block(s) written by gtbary, not one (1) as expected." << std::endl;
+    }
+    std::ifstream ifs_incremental(incremental_stat_file.c_str());
+    std::string incremental_content((std::istreambuf_iterator<char>(ifs_incremental)), std::istreambuf_iterator<char>());
+    std::ostringstream oss_rows;
+    oss_rows << "\"rows_processed\": " << num_event_0540 - num_part_event << ",";
+    if (incremental_content.find(oss_rows.str()) == std::string::npos) {
+      err() << "File " << incremental_stat_file << " does not report " << num_event_0540 - num_part_event <<
+        " row(s) processed for the events appended to input file " << part_ev_file << "." << std::endl;
+    }
+  }
+
+  // Check the performance statistics written by the test "par9".
+  std::ifstream ifs_stat(stat_file.c_str());
+  std::string stat_content((std::istreambuf_iterator<char>(ifs_stat)), std::istreambuf_iterator<char>());
+  if (stat_content.find("\"rows_processed\": ") == std::string::npos) {
+    err() << "File " << stat_file << " does not contain the number of rows processed." << std::endl;
+  } else if (stat_content.find("\"rows_processed\": 0") != std::string::npos) {
+    err() << "File " << stat_file << " reports no rows processed." << std::endl;
+  }
+  if (stat_content.find("\"ephemeris_interpolation\": ") == std::string::npos) {
+    err() << "File " << stat_file << " does not contain the time for ephemeris interpolation." << std::endl;
+  }
+  if (PerformanceMonitor::isEnabled()) {
+    err() << "Collection of performance statistics is left enabled after gtbary finished." << std::endl;
+  }
 }
 
 StAppFactory<TimeSystemTestApp> g_factory("test_timeSystem");
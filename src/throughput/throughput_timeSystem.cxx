@@ -0,0 +1,358 @@
+/** \file throughput_timeSystem.cxx
+    \brief End-to-end throughput benchmark of gtbary on synthetic event and spacecraft files.
+
+    A pair of event (FT1) and spacecraft (FT2) files of a given size is generated from the headers of the test data files
+    distributed with this package (testevdata_1day.fits and testscdata_1day.fits), and gtbary is run over them. The number
+    of events corrected per second, the peak resident set size, and the number of bytes read and written by gtbary are
+    reported. If a baseline file is given, the results are compared with those stored in it, and the program fails when
+    they are worse than the baseline by more than a given fraction. If the baseline file does not exist, it is created.
+
+    Arguments are given in the form of <name>=<value>:
+      numevents  The number of events to generate (default: 100000).
+      numdays    The number of days the events span (default: 1).
+      baseline   Name of the baseline file (default: none).
+      threshold  Fraction of a result worse than the baseline to allow (default: 0.2).
+      gtbary     Command to run gtbary (default: gtbary).
+      datadir    Directory of the test data files (default: the data directory of this package).
+      workdir    Directory to write the synthetic files in (default: the current directory).
+      gtbarypar  Additional parameters to pass to gtbary, e.g., "nthreads=4 queuedepth=2" (default: none).
+*/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include <fitsio.h>
+
+#include "facilities/commonUtilities.h"
+
+namespace {
+
+  /// \brief Number of seconds in a day.
+  const double s_sec_per_day = 86400.;
+
+  /// \brief Start time of synthetic data, as a Mission Elapsed Time. This is the start time of testscdata_1day.fits.
+  const double s_start_time = 212322400.;
+
+  /// \brief Interval of spacecraft data, in seconds.
+  const double s_sc_interval = 30.;
+
+  /// \brief The number of rows to write to a file at a time.
+  const long s_chunk_size = 1000000;
+
+  /** \class Measurement
+      \brief Class to hold the results of one run of gtbary.
+  */
+  struct Measurement {
+    Measurement(): m_event_per_sec(0.), m_peak_rss_kb(0.), m_io_bytes(0.) {}
+
+    double m_event_per_sec;
+    double m_peak_rss_kb;
+    double m_io_bytes;
+  };
+
+  /** \brief Throw an exception if a given cfitsio status is not zero (0).
+      \param status Status returned by cfitsio functions.
+      \param action Description of the action that returned the status, to be included in the error message.
+  */
+  void checkFitsStatus(int status, const std::string & action) {
+    if (status) {
+      char err_text[FLEN_STATUS];
+      fits_get_errstatus(status, err_text);
+      std::ostringstream os;
+      os << "Could not " << action << " (cfitsio status " << status << ": " << err_text << ")";
+      throw std::runtime_error(os.str());
+    }
+  }
+
+  /** \brief Create a FITS file with the same headers as a given template file, with no rows in tables.
+      \param file_name Name of the file to create. An existing file will be overwritten.
+      \param template_name Name of the FITS file to copy headers from.
+  */
+  fitsfile * createFromTemplate(const std::string & file_name, const std::string & template_name) {
+    fitsfile * fptr = 0;
+    int status = 0;
+    std::string create_name = "!" + file_name + "(" + template_name + ")";
+    fits_create_file(&fptr, const_cast<char *>(create_name.c_str()), &status);
+    checkFitsStatus(status, "create " + file_name + " from " + template_name);
+    return fptr;
+  }
+
+  /** \brief Write the start and the stop times of data to the current HDU of a given file.
+      \param fptr File to write the times to.
+      \param start_time Start time of data.
+      \param stop_time Stop time of data.
+  */
+  void writeTimeRange(fitsfile * fptr, double start_time, double stop_time) {
+    int status = 0;
+    fits_update_key(fptr, TDOUBLE, const_cast<char *>("TSTART"), &start_time, 0, &status);
+    fits_update_key(fptr, TDOUBLE, const_cast<char *>("TSTOP"), &stop_time, 0, &status);
+    checkFitsStatus(status, "write TSTART and TSTOP keywords");
+  }
+
+  /** \brief Generate a synthetic event file, with event times distributed uniformly in a given time range.
+      \param file_name Name of the event file to generate.
+      \param template_name Name of the event file to copy headers from.
+      \param num_event The number of events to generate.
+      \param start_time Start time of the events.
+      \param stop_time Stop time of the events.
+  */
+  void generateEventFile(const std::string & file_name, const std::string & template_name, long num_event, double start_time,
+    double stop_time) {
+    fitsfile * fptr = createFromTemplate(file_name, template_name);
+    int status = 0;
+
+    // Write the time range to the primary header.
+    writeTimeRange(fptr, start_time, stop_time);
+
+    // Write event times in chunks, each of which falls at a random position in its own slot, so that they are sorted.
+    char time_column[] = "TIME";
+    int colnum = 0;
+    fits_movnam_hdu(fptr, BINARY_TBL, const_cast<char *>("EVENTS"), 0, &status);
+    fits_get_colnum(fptr, CASEINSEN, time_column, &colnum, &status);
+    checkFitsStatus(status, "find TIME column in EVENTS extension of " + file_name);
+    writeTimeRange(fptr, start_time, stop_time);
+    std::srand(1);
+    double slot_width = (stop_time - start_time) / num_event;
+    std::vector<double> event_time;
+    for (long first_row = 0; first_row < num_event; first_row += s_chunk_size) {
+      long num_row = std::min(s_chunk_size, num_event - first_row);
+      event_time.resize(num_row);
+      for (long row_index = 0; row_index < num_row; ++row_index) {
+        double offset = static_cast<double>(std::rand()) / (static_cast<double>(RAND_MAX) + 1.);
+        event_time[row_index] = start_time + (first_row + row_index + offset) * slot_width;
+      }
+      fits_write_col(fptr, TDOUBLE, colnum, first_row + 1, 1, num_row, &event_time[0], &status);
+      checkFitsStatus(status, "write event times to " + file_name);
+    }
+
+    // Write a single good time interval that covers all the events.
+    fits_movnam_hdu(fptr, BINARY_TBL, const_cast<char *>("GTI"), 0, &status);
+    int colnum_start = 0;
+    int colnum_stop = 0;
+    fits_get_colnum(fptr, CASEINSEN, const_cast<char *>("START"), &colnum_start, &status);
+    fits_get_colnum(fptr, CASEINSEN, const_cast<char *>("STOP"), &colnum_stop, &status);
+    fits_write_col(fptr, TDOUBLE, colnum_start, 1, 1, 1, &start_time, &status);
+    fits_write_col(fptr, TDOUBLE, colnum_stop, 1, 1, 1, &stop_time, &status);
+    checkFitsStatus(status, "write GTI extension of " + file_name);
+    writeTimeRange(fptr, start_time, stop_time);
+
+    fits_close_file(fptr, &status);
+    checkFitsStatus(status, "close " + file_name);
+  }
+
+  /** \brief Generate a synthetic spacecraft file, with spacecraft positions on a circular orbit similar to that of Fermi.
+      \param file_name Name of the spacecraft file to generate.
+      \param template_name Name of the spacecraft file to copy headers from.
+      \param start_time Start time of the spacecraft data.
+      \param stop_time Stop time of the spacecraft data.
+  */
+  void generateScFile(const std::string & file_name, const std::string & template_name, double start_time, double stop_time) {
+    // Orbital parameters: radius in meters, period in seconds, and inclination in radians.
+    const double orbit_radius = 6.93e+6;
+    const double orbit_period = 5730.;
+    const double inclination = 25.6 * M_PI / 180.;
+
+    fitsfile * fptr = createFromTemplate(file_name, template_name);
+    int status = 0;
+    writeTimeRange(fptr, start_time, stop_time);
+
+    // Write spacecraft data in chunks.
+    int colnum_start = 0;
+    int colnum_position = 0;
+    fits_movnam_hdu(fptr, BINARY_TBL, const_cast<char *>("SC_DATA"), 0, &status);
+    fits_get_colnum(fptr, CASEINSEN, const_cast<char *>("START"), &colnum_start, &status);
+    fits_get_colnum(fptr, CASEINSEN, const_cast<char *>("SC_POSITION"), &colnum_position, &status);
+    checkFitsStatus(status, "find columns in SC_DATA extension of " + file_name);
+    writeTimeRange(fptr, start_time, stop_time);
+    long num_sc_row = static_cast<long>(std::ceil((stop_time - start_time) / s_sc_interval)) + 1;
+    std::vector<double> sc_time;
+    std::vector<double> sc_position;
+    for (long first_row = 0; first_row < num_sc_row; first_row += s_chunk_size) {
+      long num_row = std::min(s_chunk_size, num_sc_row - first_row);
+      sc_time.resize(num_row);
+      sc_position.resize(3 * num_row);
+      for (long row_index = 0; row_index < num_row; ++row_index) {
+        double time_value = start_time + (first_row + row_index) * s_sc_interval;
+        double phase = 2. * M_PI * std::fmod(time_value - start_time, orbit_period) / orbit_period;
+        sc_time[row_index] = time_value;
+        sc_position[3 * row_index] = orbit_radius * std::cos(phase);
+        sc_position[3 * row_index + 1] = orbit_radius * std::sin(phase) * std::cos(inclination);
+        sc_position[3 * row_index + 2] = orbit_radius * std::sin(phase) * std::sin(inclination);
+      }
+      fits_write_col(fptr, TDOUBLE, colnum_start, first_row + 1, 1, num_row, &sc_time[0], &status);
+      fits_write_col(fptr, TDOUBLE, colnum_position, first_row + 1, 1, 3 * num_row, &sc_position[0], &status);
+      checkFitsStatus(status, "write spacecraft data to " + file_name);
+    }
+
+    fits_close_file(fptr, &status);
+    checkFitsStatus(status, "close " + file_name);
+  }
+
+  /** \brief Run gtbary, and return the measured results.
+      \param command Command line to run gtbary with.
+      \param num_event The number of events in the input file.
+  */
+  Measurement runGtbary(const std::string & command, long num_event) {
+    typedef std::chrono::steady_clock clock_type;
+    clock_type::time_point time_start = clock_type::now();
+    int status = std::system(command.c_str());
+    double run_time = std::chrono::duration_cast<std::chrono::duration<double> >(clock_type::now() - time_start).count();
+    if (status) {
+      std::ostringstream os;
+      os << "Command \"" << command << "\" failed with status " << status;
+      throw std::runtime_error(os.str());
+    }
+
+    // Collect resource usage of gtbary, the only child process waited for.
+    // Note: Linux reports the maximum resident set size in kilobytes, and block I/O in units of 512 bytes.
+    struct rusage usage;
+    if (getrusage(RUSAGE_CHILDREN, &usage)) throw std::runtime_error("Could not get resource usage of gtbary");
+    Measurement result;
+    result.m_event_per_sec = run_time > 0. ? num_event / run_time : 0.;
+    result.m_peak_rss_kb = static_cast<double>(usage.ru_maxrss);
+    result.m_io_bytes = 512. * (static_cast<double>(usage.ru_inblock) + static_cast<double>(usage.ru_oublock));
+    return result;
+  }
+
+  /** \brief Read a baseline file, and return true if it exists. The file consists of lines of a name and a value.
+      \param file_name Name of the baseline file.
+      \param baseline Contents of the baseline file are set to this argument.
+  */
+  bool readBaseline(const std::string & file_name, std::map<std::string, double> & baseline) {
+    std::ifstream ifs(file_name.c_str());
+    if (!ifs) return false;
+    std::string name;
+    double value = 0.;
+    while (ifs >> name >> value) baseline[name] = value;
+    return true;
+  }
+
+  /** \brief Write a baseline file.
+      \param file_name Name of the baseline file.
+      \param num_event The number of events in the dataset.
+      \param num_day The number of days the dataset spans.
+      \param result Results to write.
+  */
+  void writeBaseline(const std::string & file_name, long num_event, double num_day, const Measurement & result) {
+    std::ofstream ofs(file_name.c_str());
+    ofs << std::setprecision(10);
+    ofs << "numevents " << num_event << std::endl;
+    ofs << "numdays " << num_day << std::endl;
+    ofs << "events_per_sec " << result.m_event_per_sec << std::endl;
+    ofs << "peak_rss_kb " << result.m_peak_rss_kb << std::endl;
+    ofs << "io_bytes " << result.m_io_bytes << std::endl;
+    if (!ofs) throw std::runtime_error("Could not write baseline file " + file_name);
+  }
+
+  /** \brief Compare a result with its baseline, and return true if it is worse than the baseline by more than a threshold.
+      \param name Name of the result to report.
+      \param value Measured value.
+      \param baseline_value Value stored in the baseline.
+      \param threshold Fraction of a value worse than the baseline to allow.
+      \param higher_is_better Set to true if a higher value is better. Set to false if a lower value is better.
+  */
+  bool isRegressed(const std::string & name, double value, double baseline_value, double threshold, bool higher_is_better) {
+    bool regressed = higher_is_better ? value < baseline_value * (1. - threshold) : value > baseline_value * (1. + threshold);
+    std::cout << std::left << std::setw(16) << name << std::right << std::setw(16) << value << " (baseline " <<
+      baseline_value << ")" << (regressed ? " REGRESSED" : "") << std::endl;
+    return regressed;
+  }
+
+  /** \brief Run the benchmark, and return the exit status.
+      \param arg_value Arguments given to the program.
+  */
+  int runThroughputBenchmark(const std::map<std::string, std::string> & arg_value) {
+    // Interpret arguments.
+    std::map<std::string, std::string> arg(arg_value);
+    long num_event = std::atol(arg.count("numevents") ? arg["numevents"].c_str() : "100000");
+    double num_day = std::atof(arg.count("numdays") ? arg["numdays"].c_str() : "1");
+    double threshold = std::atof(arg.count("threshold") ? arg["threshold"].c_str() : "0.2");
+    std::string gtbary_command(arg.count("gtbary") ? arg["gtbary"] : "gtbary");
+    std::string data_dir(arg.count("datadir") ? arg["datadir"] : facilities::commonUtilities::getDataPath("timeSystem"));
+    std::string work_dir(arg.count("workdir") ? arg["workdir"] : ".");
+    if (num_event <= 0 || num_day <= 0.) throw std::runtime_error("numevents and numdays must be positive");
+
+    // Generate synthetic files.
+    std::ostringstream os;
+    os << "throughput_" << num_event << "_" << num_day;
+    std::string base_name = facilities::commonUtilities::joinPath(work_dir, os.str());
+    std::string event_file = base_name + "_ev.fits";
+    std::string sc_file = base_name + "_sc.fits";
+    std::string out_file = base_name + "_bary.fits";
+    double stop_time = s_start_time + num_day * s_sec_per_day;
+    std::cout << "Generating " << num_event << " events over " << num_day << " day(s) in " << event_file << std::endl;
+    generateEventFile(event_file, facilities::commonUtilities::joinPath(data_dir, "testevdata_1day.fits"), num_event,
+      s_start_time + s_sc_interval, stop_time - s_sc_interval);
+    generateScFile(sc_file, facilities::commonUtilities::joinPath(data_dir, "testscdata_1day.fits"), s_start_time, stop_time);
+
+    // Run gtbary over the synthetic files.
+    std::string command = gtbary_command + " evfile=" + event_file + " scfile=" + sc_file + " outfile=" + out_file +
+      " ra=83.6331 dec=22.0145 chatter=0 clobber=yes " + (arg.count("gtbarypar") ? arg["gtbarypar"] : "");
+    std::cout << "Running " << command << std::endl;
+    Measurement result = runGtbary(command, num_event);
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "events_per_sec " << result.m_event_per_sec << std::endl;
+    std::cout << "peak_rss_kb    " << result.m_peak_rss_kb << std::endl;
+    std::cout << "io_bytes       " << result.m_io_bytes << std::endl;
+    std::remove(event_file.c_str());
+    std::remove(sc_file.c_str());
+    std::remove(out_file.c_str());
+
+    // Compare the results with the baseline, or create the baseline if it does not exist.
+    if (!arg.count("baseline")) return 0;
+    std::string baseline_file(arg["baseline"]);
+    std::map<std::string, double> baseline;
+    if (!readBaseline(baseline_file, baseline)) {
+      writeBaseline(baseline_file, num_event, num_day, result);
+      std::cout << "Created baseline file " << baseline_file << std::endl;
+      return 0;
+    }
+    if (baseline["numevents"] != num_event || baseline["numdays"] != num_day) {
+      throw std::runtime_error("Baseline file " + baseline_file + " was created for a different dataset");
+    }
+    bool regressed = isRegressed("events_per_sec", result.m_event_per_sec, baseline["events_per_sec"], threshold, true);
+    regressed = isRegressed("peak_rss_kb", result.m_peak_rss_kb, baseline["peak_rss_kb"], threshold, false) || regressed;
+    // Note: Block I/O may be zero (0) when files are served from the page cache, in which case it is not compared.
+    if (baseline["io_bytes"] > 0.) {
+      regressed = isRegressed("io_bytes", result.m_io_bytes, baseline["io_bytes"], threshold, false) || regressed;
+    }
+    return regressed ? 1 : 0;
+  }
+
+}
+
+int main(int argc, char ** argv) {
+  int status = 0;
+  try {
+    // Collect arguments in the form of <name>=<value>.
+    facilities::commonUtilities::setupEnvironment();
+    std::map<std::string, std::string> arg_value;
+    for (int arg_index = 1; arg_index < argc; ++arg_index) {
+      std::string arg_string(argv[arg_index]);
+      std::string::size_type pos = arg_string.find('=');
+      if (std::string::npos == pos) throw std::runtime_error("Argument not in the form of <name>=<value>: " + arg_string);
+      arg_value[arg_string.substr(0, pos)] = arg_string.substr(pos + 1);
+    }
+
+    // Run the benchmark.
+    status = runThroughputBenchmark(arg_value);
+
+  } catch (const std::exception & x) {
+    std::cerr << "throughput_timeSystem: " << x.what() << std::endl;
+    status = 1;
+  }
+  return status;
+}
@@ -21,6 +21,7 @@ namespace timeSystem {
 
   class ElapsedTime;
   class TimeInterval;
+  template <typename TimeSystemType> class AbsoluteTimeIn;
 
   /** \class AbsoluteTime
       \brief Class which represents an absolute moment in time, expressed as a time elapsed from a specific MJD time, in
@@ -37,6 +38,14 @@ namespace timeSystem {
       */
       AbsoluteTime(const std::string & time_system_name, long origin_mjd, const Duration & elapsed_time);
 
+      /** \brief Construct a AbsoluteTime object from a pair of a time origin and an elapsed time, without looking up
+                 a time system by name.
+          \param time_system Time system in which this object is defined.
+          \param origin_mjd MJD number of the time origin of this object in the given time system.
+          \param elapsed_time Duration object that represents an elapsed time from the time origin (above) in the given time system.
+      */
+      AbsoluteTime(const TimeSystem & time_system, long origin_mjd, const Duration & elapsed_time);
+
       /** \brief Construct a AbsoluteTime object from a fractional MJD number.
           \param time_system_name Name of time system in which this object is defined.
           \param mjd_day Day part of an MJD number.
@@ -68,6 +77,14 @@ namespace timeSystem {
       template <typename TimeRepType>
       void get(const std::string & time_system_name, TimeRepType & time_rep) const;
 
+      /** \brief Compute a specified time representation of the stored absolute time in a given time system, and set it to
+                 the argument of this method.
+          \param time_system Time system in which the stored absolute time is evaluated.
+          \param time_rep Time representation of the stored absolute time is to be set to this argument.
+      */
+      template <typename TimeRepType>
+      void get(const TimeSystem & time_system, TimeRepType & time_rep) const;
+
       /** \brief Set an absolute moment in time to this object, specified by a time representation.
           \param time_system_name Name of time system in which this object is defined.
           \param time_rep Time representation that points to an absolute moment in time to be set to this object.
@@ -152,6 +169,12 @@ namespace timeSystem {
       */
       AbsoluteTime computeAbsoluteTime(const std::string & time_system_name, const Duration & delta_t) const;
 
+      /** \brief Create an AbsoluteTime object that represents a sum of the stored absolute time and a specified elapsed time.
+          \param time_system Time system in which an elapsed time to be added is defined.
+          \param delta_t Time duration of an elapsed time to be added.
+      */
+      AbsoluteTime computeAbsoluteTime(const TimeSystem & time_system, const Duration & delta_t) const;
+
       /** \brief Create an ElapsedTime object that represents an elapsed time between the stored absolute time and a given
                  absolute time in a given time system.
           \param time_system_name Name of time system in which an elapsed time is to be computed.
@@ -159,6 +182,23 @@ namespace timeSystem {
       */
       ElapsedTime computeElapsedTime(const std::string & time_system_name, const AbsoluteTime & since) const;
 
+      /** \brief Create an ElapsedTime object that represents an elapsed time between the stored absolute time and a given
+                 absolute time in a given time system.
+          \param time_system Time system in which an elapsed time is to be computed.
+          \param since Absolute time to be subtracted from the stored absolute time.
+      */
+      ElapsedTime computeElapsedTime(const TimeSystem & time_system, const AbsoluteTime & since) const;
+
+      /** \brief Compute an elapsed time in seconds between the stored absolute time and a given time moment in a given time
+                 system, and return it. The result is the same as computeElapsedTime(time_system, AbsoluteTime(time_system,
+                 since.first, since.second)).getDuration().get<Sec>() up to a rounding error, but no intermediate object is
+                 created, so that this method is suited to repeated computations of elapsed times since a fixed moment,
+                 such as mission elapsed times.
+          \param time_system Time system in which an elapsed time is to be computed.
+          \param since Time moment in the given time system to be subtracted from the stored absolute time.
+      */
+      double computeElapsedSec(const TimeSystem & time_system, const moment_type & since) const;
+
       /** \brief Write a text representation of the stored absolute time to an output stream.
           \param os Output stream to write a text representation of the stored absolute time to.
       */
@@ -169,6 +209,8 @@ namespace timeSystem {
       std::string describe() const;
 
     private:
+      template <typename TimeSystemType> friend class AbsoluteTimeIn;
+
       // Prohibited operations:
       // These are not physical because TimeInterval is "anchored" to its endpoints, which are absolute moments in time.
       // In general, neither endpoint of the TimeInterval is the same as "this" AbsoluteTime. Note that similar operators
@@ -181,8 +223,12 @@ namespace timeSystem {
 
   template <typename TimeRepType>
   inline void AbsoluteTime::get(const std::string & time_system_name, TimeRepType & time_rep) const {
+    get(TimeSystem::getSystem(time_system_name), time_rep);
+  }
+
+  template <typename TimeRepType>
+  inline void AbsoluteTime::get(const TimeSystem & time_system, TimeRepType & time_rep) const {
     // Convert time systems.
-    const TimeSystem & time_system(TimeSystem::getSystem(time_system_name));
     moment_type moment = time_system.convertFrom(*m_time_system, m_moment);
 
     // Convert time formats.
@@ -0,0 +1,203 @@
+/** \file AbsoluteTimeIn.h
+    \brief Declaration of AbsoluteTimeIn class.
+    \authors Masaharu Hirayama, GSSC
+             James Peachey, HEASARC/GSSC
+*/
+#ifndef timeSystem_AbsoluteTimeIn_h
+#define timeSystem_AbsoluteTimeIn_h
+
+#include "timeSystem/AbsoluteTime.h"
+#include "timeSystem/Duration.h"
+#include "timeSystem/TimeSystem.h"
+
+#include <cstddef>
+#include <iostream>
+
+namespace timeSystem {
+
+  /** \class Tai
+      \brief Tag class to specify TAI time system at compile time, for use with AbsoluteTimeIn.
+  */
+  struct Tai {
+    static const TimeSystem & getSystem() {
+      static const TimeSystem & s_system(TimeSystem::getSystem("TAI"));
+      return s_system;
+    }
+  };
+
+  /** \class Tdb
+      \brief Tag class to specify TDB time system at compile time, for use with AbsoluteTimeIn.
+  */
+  struct Tdb {
+    static const TimeSystem & getSystem() {
+      static const TimeSystem & s_system(TimeSystem::getSystem("TDB"));
+      return s_system;
+    }
+  };
+
+  /** \class Tt
+      \brief Tag class to specify TT time system at compile time, for use with AbsoluteTimeIn.
+  */
+  struct Tt {
+    static const TimeSystem & getSystem() {
+      static const TimeSystem & s_system(TimeSystem::getSystem("TT"));
+      return s_system;
+    }
+  };
+
+  /** \class AbsoluteTimeIn
+      \brief Class which represents an absolute moment in time in a time system given as a template parameter (Tai, Tdb,
+             or Tt), expressed as a time elapsed from a specific MJD time. Unlike AbsoluteTime, the time system is not held
+             by an object of this class, so that additions, subtractions, and comparisons of objects in the same time system
+             are computed directly with Duration objects, without converting time systems or calling virtual methods.
+             Objects of this class are converted to and from AbsoluteTime objects for any other computations.
+             Note: No tag class is provided for UTC, because a time difference in UTC depends on leap seconds.
+  */
+  template <typename TimeSystemType>
+  class AbsoluteTimeIn {
+    public:
+      /// \brief Construct an AbsoluteTimeIn object that represents 0.0 MJD, so that objects can be held in containers.
+      AbsoluteTimeIn(): m_moment(0, Duration::zero()) {}
+
+      /** \brief Construct an AbsoluteTimeIn object from a pair of a time origin and an elapsed time.
+          \param origin_mjd MJD number of the time origin of this object.
+          \param elapsed_time Duration object that represents an elapsed time from the time origin (above).
+      */
+      AbsoluteTimeIn(long origin_mjd, const Duration & elapsed_time): m_moment(origin_mjd, elapsed_time) {}
+
+      /** \brief Construct an AbsoluteTimeIn object from an AbsoluteTime object, converting its time system.
+          \param abs_time Absolute time to convert.
+      */
+      explicit AbsoluteTimeIn(const AbsoluteTime & abs_time):
+        m_moment(TimeSystemType::getSystem().convertFrom(*abs_time.m_time_system, abs_time.m_moment)) {}
+
+      /// \brief Create an AbsoluteTime object that represents the same absolute moment in time as this object.
+      operator AbsoluteTime() const { return AbsoluteTime(TimeSystemType::getSystem(), m_moment.first, m_moment.second); }
+
+      /// \brief Return the time system in which this object is defined.
+      static const TimeSystem & getSystem() { return TimeSystemType::getSystem(); }
+
+      /// \brief Return the time moment of this object, i.e., a pair of the MJD number of its time origin and an elapsed time.
+      const moment_type & getMoment() const { return m_moment; }
+
+      /** \brief Create an AbsoluteTimeIn object that represents a sum of the stored absolute time and a given elapsed time
+                 in the time system of this object.
+          \param elapsed_time Elapsed time to be added.
+      */
+      AbsoluteTimeIn operator +(const Duration & elapsed_time) const {
+        return AbsoluteTimeIn(m_moment.first, m_moment.second + elapsed_time);
+      }
+
+      /** \brief Create an AbsoluteTimeIn object that represents the stored absolute time subtracted by a given elapsed time
+                 in the time system of this object.
+          \param elapsed_time Elapsed time to subtract.
+      */
+      AbsoluteTimeIn operator -(const Duration & elapsed_time) const {
+        return AbsoluteTimeIn(m_moment.first, m_moment.second - elapsed_time);
+      }
+
+      /** \brief Add an elapsed time in the time system of this object to the stored absolute time and set it to this object.
+          \param elapsed_time Elapsed time to be added.
+      */
+      AbsoluteTimeIn & operator +=(const Duration & elapsed_time) {
+        m_moment.second += elapsed_time;
+        return *this;
+      }
+
+      /** \brief Subtract an elapsed time in the time system of this object from the stored absolute time and set it to this
+                 object.
+          \param elapsed_time Elapsed time to subtract.
+      */
+      AbsoluteTimeIn & operator -=(const Duration & elapsed_time) {
+        m_moment.second -= elapsed_time;
+        return *this;
+      }
+
+      /** \brief Compute an elapsed time between the stored absolute time and a given absolute time in the time system of
+                 this object, and return it.
+          \param since Absolute time to be subtracted from the stored absolute time.
+      */
+      Duration operator -(const AbsoluteTimeIn & since) const;
+
+      /** \brief Compute an elapsed time in seconds between the stored absolute time and a given absolute time in the time
+                 system of this object, and return it. The result is the same as (*this - since).get<Sec>() up to a rounding
+                 error, but rounded only once.
+          \param since Absolute time to be subtracted from the stored absolute time.
+      */
+      double computeElapsedSec(const AbsoluteTimeIn & since) const {
+        return (m_moment.second - since.m_moment.second).computeSec(m_moment.first - since.m_moment.first);
+      }
+
+      /** \brief Return true if the stored absolute time is later than a given absolute time, and return false otherwise.
+          \param other Absolute time to compare.
+      */
+      bool operator >(const AbsoluteTimeIn & other) const { return other < *this; }
+
+      /** \brief Return true if the stored absolute time is later than or equal to a given absolute time,
+                 and return false otherwise.
+          \param other Absolute time to compare.
+      */
+      bool operator >=(const AbsoluteTimeIn & other) const { return !(*this < other); }
+
+      /** \brief Return true if the stored absolute time is earlier than a given absolute time, and return false otherwise.
+          \param other Absolute time to compare.
+      */
+      bool operator <(const AbsoluteTimeIn & other) const;
+
+      /** \brief Return true if the stored absolute time is earlier than or equal to a given absolute time,
+                 and return false otherwise.
+          \param other Absolute time to compare.
+      */
+      bool operator <=(const AbsoluteTimeIn & other) const { return !(other < *this); }
+
+      /** \brief Return true if time difference between the stored absolute time and a given absolute time is smaller than
+                 or equal to a given elapsed time, and return false otherwise.
+          \param other Absolute time to compare.
+          \param tolerance Maximum allowed elapsed time in comparison.
+      */
+      bool equivalentTo(const AbsoluteTimeIn & other, const Duration & tolerance) const {
+        return (*this - other).equivalentTo(Duration::zero(), tolerance);
+      }
+
+    private:
+      moment_type m_moment;
+  };
+
+  template <typename TimeSystemType>
+  inline Duration AbsoluteTimeIn<TimeSystemType>::operator -(const AbsoluteTimeIn & since) const {
+    // Subtract the elapsed times alone if the time origins are the same, as is often the case for mission elapsed times.
+    Duration difference = m_moment.second - since.m_moment.second;
+    if (m_moment.first != since.m_moment.first) difference += Duration(m_moment.first - since.m_moment.first, 0.);
+    return difference;
+  }
+
+  template <typename TimeSystemType>
+  inline bool AbsoluteTimeIn<TimeSystemType>::operator <(const AbsoluteTimeIn & other) const {
+    // Compare the elapsed times alone if the time origins are the same.
+    if (m_moment.first == other.m_moment.first) return m_moment.second < other.m_moment.second;
+    return *this - other < Duration::zero();
+  }
+
+  /** \brief Compute elapsed times in seconds between absolute times in a given range and a given absolute time, in the same
+             time system, and set them to a caller-provided array. The result is the same as calling computeElapsedSec method
+             for each absolute time, but without a function call through a time system for any of them, so that the loop
+             is suited to batch computations, such as of mission elapsed times of many events.
+      \param first Pointer to the first absolute time in the range.
+      \param last Pointer to one past the last absolute time in the range.
+      \param since Absolute time to be subtracted from each of the absolute times in the range.
+      \param elapsed_sec Array of at least (last - first) elements, to which the elapsed times are set.
+  */
+  template <typename TimeSystemType>
+  inline void computeElapsedSec(const AbsoluteTimeIn<TimeSystemType> * first, const AbsoluteTimeIn<TimeSystemType> * last,
+    const AbsoluteTimeIn<TimeSystemType> & since, double * elapsed_sec) {
+    for (std::ptrdiff_t ii = 0; ii < last - first; ++ii) elapsed_sec[ii] = first[ii].computeElapsedSec(since);
+  }
+
+  template <typename TimeSystemType>
+  inline std::ostream & operator <<(std::ostream & os, const AbsoluteTimeIn<TimeSystemType> & time) {
+    return os << AbsoluteTime(time);
+  }
+
+}
+
+#endif
@@ -6,6 +6,7 @@
 #ifndef timeSystem_BaryTimeComputer_h
 #define timeSystem_BaryTimeComputer_h
 
+#include <atomic>
 #include <map>
 #include <string>
 #include <vector>
@@ -13,8 +14,27 @@
 namespace timeSystem {
 
   class AbsoluteTime;
+  struct Jd;
   class SourcePosition;
 
+  /** \class IObservatoryPositionComputer
+      \brief Abstract interface to compute observatory positions at given times, to be used for inverse barycentric
+             corrections, for which the observatory positions are needed at times not known in advance.
+  */
+  class IObservatoryPositionComputer {
+    public:
+      /// \brief Destruct this IObservatoryPositionComputer object.
+      virtual ~IObservatoryPositionComputer() {}
+
+      /** \brief Compute observatory positions at given times, and set them to the last argument.
+          \param abs_time Times at which observatory positions are to be computed.
+          \param obs_position Observatory positions at the given times, three elements (X, Y, and Z) per time, in the same order
+                 as abs_time. The positions must be given in the form of Cartesian coordinates in meters in the equatorial
+                 coordinate system with the origin at the center of the Earth.
+      */
+      virtual void computeObsPosition(const std::vector<AbsoluteTime> & abs_time, std::vector<double> & obs_position) const = 0;
+  };
+
   /** \class BaryTimeComputer
       \brief Class which performs barycentric correction on photon arrival times, typically recorded at a space craft.
   */
@@ -73,6 +93,117 @@ namespace timeSystem {
       virtual void computeGeoTime(const SourcePosition & src_position, const std::vector<double> & obs_position,
         AbsoluteTime & abs_time) const = 0;
 
+      /** \brief Compute a barycentric time for a given time, and update the time with a computed time. This method
+                 takes a fixed-size array for the observatory position, so that no memory is allocated for a call.
+          \param src_position Position of the celestial object for which a barycentric time is computed.
+          \param obs_position Observatory position at the time for which a barycentric time is computed. The position must be
+                 given in the form of Cartesian coordinates in meters in the equatorial coordinate system with the origin at
+                 the center of the Earth.
+          \param abs_time Photon arrival time at the spacecraft. This argument is updated to a barycentric time for it.
+      */
+      virtual void computeBaryTime(const SourcePosition & src_position, const double obs_position[3],
+        AbsoluteTime & abs_time) const = 0;
+
+      /** \brief Compute a geocentric time for a given time, and update the time with a computed time. This method
+                 takes a fixed-size array for the observatory position, so that no memory is allocated for a call.
+          \param src_position Position of the celestial object for which a geocentric time is computed.
+          \param obs_position Observatory position at the time for which a geocentric time is computed. The position must be
+                 given in the form of Cartesian coordinates in meters in the equatorial coordinate system with the origin at
+                 the center of the Earth.
+          \param abs_time Photon arrival time at the spacecraft. This argument is updated to a geocentric time for it.
+      */
+      virtual void computeGeoTime(const SourcePosition & src_position, const double obs_position[3],
+        AbsoluteTime & abs_time) const = 0;
+
+      /** \brief Compute barycentric times for a block of given times, and update the times with computed times.
+          \param src_position Position of the celestial object for which barycentric times are computed.
+          \param obs_position Observatory positions at the times for which barycentric times are computed, three elements
+                 (X, Y, and Z) per time, in the same order as abs_time. The positions must be given in the form of Cartesian
+                 coordinates in meters in the equatorial coordinate system with the origin at the center of the Earth.
+          \param abs_time Photon arrival times at the spacecraft. Each element is updated to a barycentric time for it.
+      */
+      virtual void computeBaryTime(const SourcePosition & src_position, const std::vector<double> & obs_position,
+        std::vector<AbsoluteTime> & abs_time) const;
+
+      /** \brief Compute geocentric times for a block of given times, and update the times with computed times.
+          \param src_position Position of the celestial object for which geocentric times are computed.
+          \param obs_position Observatory positions at the times for which geocentric times are computed, three elements
+                 (X, Y, and Z) per time, in the same order as abs_time. The positions must be given in the form of Cartesian
+                 coordinates in meters in the equatorial coordinate system with the origin at the center of the Earth.
+          \param abs_time Photon arrival times at the spacecraft. Each element is updated to a geocentric time for it.
+      */
+      virtual void computeGeoTime(const SourcePosition & src_position, const std::vector<double> & obs_position,
+        std::vector<AbsoluteTime> & abs_time) const;
+
+      /** \brief Compute time delays for barycentric corrections for a block of given times, and set them to the last argument.
+          \param src_position Position of the celestial object for which barycentric times are computed.
+          \param obs_position Observatory positions at the times for which barycentric times are computed, three elements
+                 (X, Y, and Z) per time, in the same order as tt_time. The positions must be given in the form of Cartesian
+                 coordinates in meters in the equatorial coordinate system with the origin at the center of the Earth.
+          \param tt_time Photon arrival times at the spacecraft, given as Julian Dates in TT system.
+          \param delay Time delays in seconds to be added to the arrival times in TDB system, in the same order as tt_time.
+      */
+      virtual void computeBaryDelay(const SourcePosition & src_position, const std::vector<double> & obs_position,
+        const std::vector<Jd> & tt_time, std::vector<double> & delay) const = 0;
+
+      /** \brief Compute time delays for geocentric corrections for a block of given times, and set them to the last argument.
+          \param src_position Position of the celestial object for which geocentric times are computed.
+          \param obs_position Observatory positions at the times for which geocentric times are computed, three elements
+                 (X, Y, and Z) per time, in the same order as tt_time. The positions must be given in the form of Cartesian
+                 coordinates in meters in the equatorial coordinate system with the origin at the center of the Earth.
+          \param tt_time Photon arrival times at the spacecraft, given as Julian Dates in TT system.
+          \param delay Time delays in seconds to be added to the arrival times in TT system, in the same order as tt_time.
+      */
+      virtual void computeGeoDelay(const SourcePosition & src_position, const std::vector<double> & obs_position,
+        const std::vector<Jd> & tt_time, std::vector<double> & delay) const = 0;
+
+      /** \brief Compute time delays for barycentric corrections for a block of given times, for each of given sources at once,
+                 and set them to the last argument. Solar system ephemeris and the source-independent terms of the delays are
+                 computed only once per time, and only the source-dependent terms are computed for each source.
+          \param src_position Positions of the celestial objects for which barycentric times are computed.
+          \param obs_position Observatory positions at the times for which barycentric times are computed, three elements
+                 (X, Y, and Z) per time, in the same order as tt_time. The positions must be given in the form of Cartesian
+                 coordinates in meters in the equatorial coordinate system with the origin at the center of the Earth.
+          \param tt_time Photon arrival times at the spacecraft, given as Julian Dates in TT system.
+          \param delay Time delays in seconds to be added to the arrival times in TDB system. The delays for the first source
+                 come first in the same order as tt_time, followed by those for the second source, and so on.
+      */
+      virtual void computeBaryDelay(const std::vector<SourcePosition> & src_position, const std::vector<double> & obs_position,
+        const std::vector<Jd> & tt_time, std::vector<double> & delay) const = 0;
+
+      /** \brief Compute time delays for geocentric corrections for a block of given times, for each of given sources at once,
+                 and set them to the last argument.
+          \param src_position Positions of the celestial objects for which geocentric times are computed.
+          \param obs_position Observatory positions at the times for which geocentric times are computed, three elements
+                 (X, Y, and Z) per time, in the same order as tt_time. The positions must be given in the form of Cartesian
+                 coordinates in meters in the equatorial coordinate system with the origin at the center of the Earth.
+          \param tt_time Photon arrival times at the spacecraft, given as Julian Dates in TT system.
+          \param delay Time delays in seconds to be added to the arrival times in TT system. The delays for the first source
+                 come first in the same order as tt_time, followed by those for the second source, and so on.
+      */
+      virtual void computeGeoDelay(const std::vector<SourcePosition> & src_position, const std::vector<double> & obs_position,
+        const std::vector<Jd> & tt_time, std::vector<double> & delay) const = 0;
+
+      /** \brief Compute photon arrival times at the observatory for a block of given barycentric times, i.e., perform
+                 the inverse of barycentric corrections, and update the times with computed times. For each time, the time
+                 delay for the barycentric correction is solved for by Newton's method, with the derivative of the delay
+                 estimated from successive iterations. The first time is solved for first, and its solution is used as
+                 the initial guess for the others, so that only a couple of iterations are needed for sorted times.
+          \param src_position Position of the celestial object for which barycentric times are given.
+          \param obs_computer Object to compute observatory positions at trial arrival times with.
+          \param abs_time Barycentric times. Each element is updated to the photon arrival time at the observatory for it.
+      */
+      virtual void computeInverseBaryTime(const SourcePosition & src_position, const IObservatoryPositionComputer & obs_computer,
+        std::vector<AbsoluteTime> & abs_time) const;
+
+      /** \brief Make solar system ephemeris for a given time span available in memory before times in the span are corrected,
+                 and throw an exception if it is not available for any part of the span. This default implementation does
+                 nothing.
+          \param tt_start Start of the time span, given as a Julian Date in TT system.
+          \param tt_stop End of the time span, given as a Julian Date in TT system.
+      */
+      virtual void prefetchEphemeris(const Jd & tt_start, const Jd & tt_stop) const;
+
     protected:
       /** \brief Construct a BaryTimeComputer object.
           \param pl_ephem Name of solar system ephemeris to use. The name of this argument comes from a "planetary ephemeris".
@@ -86,6 +217,7 @@ namespace timeSystem {
       typedef std::map<std::string, BaryTimeComputer *> container_type;
 
       std::string m_pl_ephem;
+      std::atomic<bool> m_initialized;
 
       /// \brief Return a container of registered barycentic time computers.
       static container_type & getContainer();
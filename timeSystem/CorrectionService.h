@@ -0,0 +1,71 @@
+/** \file CorrectionService.h
+    \brief Declaration of CorrectionService class.
+    \authors Masaharu Hirayama, GSSC
+             James Peachey, HEASARC/GSSC
+*/
+#ifndef timeSystem_CorrectionService_h
+#define timeSystem_CorrectionService_h
+
+#include <ctime>
+#include <iostream>
+#include <string>
+
+namespace timeSystem {
+
+  class GlastScTimeHandler;
+  class TimeSystem;
+
+  /** \class CorrectionService
+      \brief Class to serve arrival time corrections of Fermi (formerly GLAST) METs requested through a text stream, keeping
+             solar system ephemeris, spacecraft data, and leap seconds loaded between requests. Each request is a line of
+             the Right Ascension and the Declination of a source in degrees, followed by METs to correct, all separated by
+             white spaces. The reply to a request is a line of the corrected METs, measured in the time system of the
+             correction (TDB for barycentric corrections, TT for geocentric corrections), or a line starting with "ERROR"
+             followed by an error message. An empty line is ignored, and a line of "QUIT" ends the service.
+  */
+  class CorrectionService {
+    public:
+      /** \brief Construct a CorrectionService object.
+          \param handler Event time handler to compute geocentric or barycentric times with, whose header determines the
+                 interpretation of the METs, i.e., MJDREF and TIMESYS.
+          \param sc_file_name Name of the spacecraft file to use, which is reloaded when it is updated.
+          \param sc_extension_name Name of the extension of the spacecraft file that contains the spacecraft data.
+          \param solar_eph Name of the solar system ephemeris to use.
+          \param ang_tolerance Angular tolerance in degrees, to be passed to the handler.
+          \param compute_bary Set to true to serve barycentric corrections. Set to false to serve geocentric corrections.
+      */
+      CorrectionService(GlastScTimeHandler & handler, const std::string & sc_file_name, const std::string & sc_extension_name,
+        const std::string & solar_eph, double ang_tolerance, bool compute_bary);
+
+      /** \brief Serve requests read from a given input stream until the end of the stream or a request to quit, writing
+                 replies to a given output stream. Return the number of requests served.
+          \param is Input stream to read requests from.
+          \param os Output stream to write replies to.
+      */
+      long serve(std::istream & is, std::ostream & os);
+
+    private:
+      GlastScTimeHandler & m_handler;
+      std::string m_sc_file_name;
+      std::string m_sc_extension_name;
+      std::string m_solar_eph;
+      double m_ang_tolerance;
+      bool m_compute_bary;
+      const TimeSystem & m_time_system;
+      std::time_t m_sc_file_time;
+      long long m_sc_file_size;
+
+      /** \brief Reload the spacecraft file if it is updated since it was loaded last time.
+          \param force_load Set to true to load the spacecraft file even if it is not updated.
+      */
+      void loadScFile(bool force_load);
+
+      /** \brief Compute the corrected times for a given request, and return a reply to it.
+          \param request Request to reply to.
+      */
+      std::string reply(const std::string & request);
+  };
+
+}
+
+#endif
@@ -6,6 +6,7 @@
 #ifndef timeSystem_Duration_h
 #define timeSystem_Duration_h
 
+#include <cmath>
 #include <iostream>
 #include <limits>
 
@@ -17,9 +18,49 @@ namespace st_stream {
 
 namespace timeSystem {
 
+  /** \class Day
+      \brief Tag class to specify a time unit of day at compile time, for use with Duration::from and Duration::get.
+  */
+  struct Day {
+    static long getUnitPerDay() { return 1l; }
+    static long getSecPerUnit() { return 86400l; }
+    static const char * getUnitString() { return "days"; }
+  };
+
+  /** \class Hour
+      \brief Tag class to specify a time unit of hour at compile time, for use with Duration::from and Duration::get.
+  */
+  struct Hour {
+    static long getUnitPerDay() { return 24l; }
+    static long getSecPerUnit() { return 3600l; }
+    static const char * getUnitString() { return "hours"; }
+  };
+
+  /** \class Min
+      \brief Tag class to specify a time unit of minute at compile time, for use with Duration::from and Duration::get.
+  */
+  struct Min {
+    static long getUnitPerDay() { return 1440l; }
+    static long getSecPerUnit() { return 60l; }
+    static const char * getUnitString() { return "minutes"; }
+  };
+
+  /** \class Sec
+      \brief Tag class to specify a time unit of second at compile time, for use with Duration::from and Duration::get.
+  */
+  struct Sec {
+    static long getUnitPerDay() { return 86400l; }
+    static long getSecPerUnit() { return 1l; }
+    static const char * getUnitString() { return "seconds"; }
+  };
+
   /** \class Duration
       \brief Low level class used to represent an amount of time duration together with its nominal unit of measurement.
              Objects of this type represent physical lengths of time only if used together with a time system.
+
+             Internally, a time duration is held as a whole number of days and a whole number of picoseconds within
+             the day, so that additions, subtractions, and comparisons are exact integer operations whose results
+             are reproducible regardless of the order of operations.
   */
   class Duration {
     public:
@@ -46,6 +87,25 @@ namespace timeSystem {
       */
       Duration(double time_value, const std::string & time_unit_name);
 
+      /** \brief Create a Duration object from a time value in a time unit given as a template parameter (Day, Hour, Min,
+                 or Sec), without looking up the time unit by name.
+          \param time_value Time value.
+      */
+      template <typename TimeUnitType>
+      static Duration from(double time_value) { return Duration(0, time_value * TimeUnitType::getSecPerUnit()); }
+
+      /** \brief Create a Duration object from a time value in a time unit given as a template parameter (Day, Hour, Min,
+                 or Sec), without looking up the time unit by name.
+          \param time_value_int Integer part of a time value.
+          \param time_value_frac Fractional part of a time value.
+      */
+      template <typename TimeUnitType>
+      static Duration from(long time_value_int, double time_value_frac) {
+        Duration time_duration;
+        time_duration.set(time_value_int, time_value_frac, TimeUnitType::getUnitPerDay(), TimeUnitType::getSecPerUnit());
+        return time_duration;
+      }
+
       /// \brief Return a Duration object representing a zero-length time duration.
       static const Duration & zero();
 
@@ -67,6 +127,29 @@ namespace timeSystem {
       */
       double get(const std::string & time_unit_name) const;
 
+      /** \brief Compute the length of time duration in a time unit given as a template parameter (Day, Hour, Min, or Sec),
+                 and set the result to the arguments of this method.
+          \param time_value_int Integer part of the result is set to this argument.
+          \param time_value_frac Fractional part of the result is set to this argument.
+      */
+      template <typename TimeUnitType>
+      void get(long & time_value_int, double & time_value_frac) const {
+        get(TimeUnitType::getUnitPerDay(), TimeUnitType::getSecPerUnit(), TimeUnitType::getUnitString(), time_value_int,
+          time_value_frac);
+      }
+
+      /// \brief Compute the length of time duration in a time unit given as a template parameter (Day, Hour, Min, or Sec),
+      ///        and return the result.
+      template <typename TimeUnitType>
+      double get() const { return get(TimeUnitType::getUnitPerDay(), TimeUnitType::getSecPerUnit()); }
+
+      /** \brief Compute the length of time duration in seconds with a given number of days added, and return the result.
+                 The whole number of seconds is summed exactly in integer arithmetic before the fractional part is added,
+                 so that the result is rounded only once.
+          \param day The number of days to add to this time duration.
+      */
+      double computeSec(long day) const;
+
       /** \brief Create a Duration object that represents a sum of a given Duration object and this object.
           \param other Duration object to be added.
       */
@@ -148,9 +231,23 @@ namespace timeSystem {
       std::string describe() const;
 
     private:
-      typedef std::pair<long, double> duration_type;
+      typedef std::pair<long, long long> duration_type;
 
-      /** \brief Construct a Duration object from a pair of an integer variable and a double variable.
+      /// \brief Return the number of picoseconds in a second, i.e., the resolution of the internal representation.
+      static long long getPicosecPerSec() { return 1000000000000ll; }
+
+      /// \brief Return the number of picoseconds in a day.
+      static long long getPicosecPerDay() { return 86400000000000000ll; }
+
+      /** \brief Convert a number of picoseconds, no longer than a day, into a number of seconds.
+          \param picosec The number of picoseconds to convert.
+      */
+      static double convertToSec(long long picosec) {
+        return static_cast<double>(picosec / getPicosecPerSec()) +
+          static_cast<double>(picosec % getPicosecPerSec()) / static_cast<double>(getPicosecPerSec());
+      }
+
+      /** \brief Construct a Duration object from a pair of the numbers of days and picoseconds.
           \param new_duration Time duration represented in a form of the internal representation.
       */
       Duration(const duration_type & new_duration): m_duration(new_duration) {}
@@ -162,6 +259,32 @@ namespace timeSystem {
       */
       void set(long day, double sec);
 
+      /** \brief Convert a time value in a given time unit into the type of the internal variable, and set the result to
+                 the internal variable.
+          \param time_value_int Integer part of a time value.
+          \param time_value_frac Fractional part of a time value.
+          \param unit_per_day Ratio of the time unit over a day.
+          \param sec_per_unit Ratio of a second over the time unit.
+      */
+      void set(long time_value_int, double time_value_frac, long unit_per_day, long sec_per_unit);
+
+      /** \brief Compute the length of time duration in a given time unit, and set the result to the arguments of this method.
+          \param unit_per_day Ratio of the time unit over a day.
+          \param sec_per_unit Ratio of a second over the time unit.
+          \param unit_string Character string that represents the time unit, used in error messages.
+          \param time_value_int Integer part of the result is set to this argument.
+          \param time_value_frac Fractional part of the result is set to this argument.
+      */
+      void get(long unit_per_day, long sec_per_unit, const char * unit_string, long & time_value_int, double & time_value_frac) const;
+
+      /** \brief Compute the length of time duration in a given time unit, and return the result.
+          \param unit_per_day Ratio of the time unit over a day.
+          \param sec_per_unit Ratio of a second over the time unit.
+      */
+      double get(long unit_per_day, long sec_per_unit) const {
+        return std::floor(static_cast<double>(m_duration.first) * unit_per_day) + convertToSec(m_duration.second) / sec_per_unit;
+      }
+
       /** \brief Add two integer numbers.  An exception is thrown if the sum is larger than the maximum integer
                  number for "long int" type, or smaller than the minimum.
           \param int1 The first integer value being added.
@@ -169,15 +292,15 @@ namespace timeSystem {
       */
       long add(long t1, long t2) const;
 
-      /** \brief Add two time durations which are represented by long day and double second fields. Seconds
-                 part of the result is guaranteed to be in the range [0., SecPerDay())
+      /** \brief Add two time durations which are represented by long day and long long picosecond fields. Picoseconds
+                 part of the result is guaranteed to be in the range [0, getPicosecPerDay())
           \param t1 The first time duration being added.
           \param t2 The second time duration being added.
       */
       duration_type add(duration_type t1, duration_type t2) const;
 
-      /** \brief Multiply by -1 a time duration represented by long day and double second fields. Seconds
-            part of the result is guaranteed to be in the range [0., SecPerDay())
+      /** \brief Multiply by -1 a time duration represented by long day and long long picosecond fields. Picoseconds
+            part of the result is guaranteed to be in the range [0, getPicosecPerDay())
           \param t1 The first time duration being negated.
       */
       duration_type negate(duration_type t1) const;
@@ -189,11 +312,12 @@ namespace timeSystem {
   inline void Duration::write(StreamType & os) const {
     // Make the printed duration human-friendly, e.g, "-1 seconds" instead of "-1 day 86399 seconds".
     long print_day = m_duration.first;
-    double print_sec = m_duration.second;
+    long long print_picosec = m_duration.second;
     if (m_duration.first < 0) {
       ++print_day;
-      print_sec -= SecPerDay();
+      print_picosec -= getPicosecPerDay();
     }
+    double print_sec = convertToSec(print_picosec);
 
     // Print the number of days, if not zero.
     if (print_day != 0) {
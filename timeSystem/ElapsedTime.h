@@ -33,6 +33,12 @@ namespace timeSystem {
       */
       ElapsedTime(const std::string & time_system_name, const Duration & time_duration);
 
+      /** \brief Construct an ElapsedTime object without looking up a time system by name.
+          \param time_system Time system in which an elapsed time is defined.
+          \param time_duration Time duration of an elapsed time to be created.
+      */
+      ElapsedTime(const TimeSystem & time_system, const Duration & time_duration);
+
       /** \brief Add this elapsed time to a given absolute time, and return the result.
           \param absolute_time Absolute time to add this elapsed time to.
       */
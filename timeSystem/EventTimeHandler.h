@@ -160,6 +160,52 @@ namespace timeSystem {
       */
       virtual AbsoluteTime parseTimeString(const std::string & time_string, const std::string & time_system = "FILE") const = 0;
 
+      /** \brief Read times from a given column of the opened FITS table for a contiguous block of rows at a time, and set them
+                 to a given array as they are represented in the column, e.g., as mission elapsed times. This method throws
+                 an exception unless a derived class supports column-wise access to times.
+          \param column_name Name of column from which times are to be read.
+          \param first_row Index of the first row to read, with 0 (zero) for the first row of the table.
+          \param num_rows The number of rows to read.
+          \param time_value Array of at least num_rows elements to which the times are set, in the order of rows.
+      */
+      virtual void readTimes(const std::string & column_name, tip::Index_t first_row, tip::Index_t num_rows,
+        double * time_value) const;
+
+      /** \brief Write times given as they are represented in the opened FITS table, e.g., as mission elapsed times, to a given
+                 column of the table for a contiguous block of rows at a time. This method throws an exception unless
+                 a derived class supports column-wise access to times.
+          \param column_name Name of column to which times are to be written.
+          \param first_row Index of the first row to write, with 0 (zero) for the first row of the table.
+          \param num_rows The number of rows to write.
+          \param time_value Array of at least num_rows elements holding the times to write, in the order of rows.
+      */
+      virtual void writeTimes(const std::string & column_name, tip::Index_t first_row, tip::Index_t num_rows,
+        const double * time_value);
+
+      /** \brief Read times from a given column of the opened FITS table for a contiguous block of rows at a time, compute
+                 geocentric times for them, and set them to a given array in the same representation as in the column, but
+                 measured in TT system. This method throws an exception unless a derived class supports column-wise access
+                 to times.
+          \param column_name Name of column from which times are to be read.
+          \param first_row Index of the first row to read, with 0 (zero) for the first row of the table.
+          \param num_rows The number of rows to read.
+          \param time_value Array of at least num_rows elements to which the geocentric times are set, in the order of rows.
+      */
+      virtual void getGeoTimes(const std::string & column_name, tip::Index_t first_row, tip::Index_t num_rows,
+        double * time_value) const;
+
+      /** \brief Read times from a given column of the opened FITS table for a contiguous block of rows at a time, compute
+                 barycentric times for them, and set them to a given array in the same representation as in the column, but
+                 measured in TDB system. This method throws an exception unless a derived class supports column-wise access
+                 to times.
+          \param column_name Name of column from which times are to be read.
+          \param first_row Index of the first row to read, with 0 (zero) for the first row of the table.
+          \param num_rows The number of rows to read.
+          \param time_value Array of at least num_rows elements to which the barycentric times are set, in the order of rows.
+      */
+      virtual void getBaryTimes(const std::string & column_name, tip::Index_t first_row, tip::Index_t num_rows,
+        double * time_value) const;
+
       /// \brief Set the internal record iterator to point to the first record in the opened FITS file.
       void setFirstRecord();
 
@@ -9,12 +9,16 @@
 #include "timeSystem/EventTimeHandler.h"
 #include "timeSystem/MjdFormat.h"
 #include "timeSystem/SourcePosition.h"
+#include "timeSystem/TimeSystem.h"
 
 extern "C" {
 #include "timeSystem/glastscorbit.h"
 }
 
+#include <atomic>
+#include <cstddef>
 #include <string>
+#include <vector>
 
 namespace tip {
   class Header;
@@ -33,6 +37,31 @@ namespace timeSystem {
   */
   class GlastTimeHandler: public EventTimeHandler {
     public:
+      /** \class HeaderKeyword
+          \brief Class which holds the values of the header keywords that determine which GlastTimeHandler subclass can handle
+                 a FITS extension, so that the header is read only once while a handler class is selected.
+      */
+      class HeaderKeyword {
+        public:
+          /** \brief Construct a HeaderKeyword object from a given FITS header.
+              \param header FITS header from which TELESCOP, INSTRUME, TIMEREF, and TIMESYS header keywords are read.
+          */
+          explicit HeaderKeyword(const tip::Header & header);
+
+          /** \brief Return a logical true if the header is of a Fermi (formerly GLAST) LAT file with given TIMEREF and TIMESYS
+                     keyword values, and a logical false otherwise.
+              \param time_ref_value Value of TIMEREF header keyword to accept.
+              \param time_sys_value Value of TIMESYS header keyword to accept.
+          */
+          bool match(const std::string & time_ref_value, const std::string & time_sys_value) const;
+
+        private:
+          std::string m_telescope;
+          std::string m_instrument;
+          std::string m_time_ref;
+          std::string m_time_sys;
+      };
+
       /// Destruct this GlastTimeHandler object.
       virtual ~GlastTimeHandler();
 
@@ -44,6 +73,22 @@ namespace timeSystem {
       */
       static EventTimeHandler * createInstance(const std::string & file_name, const std::string & extension_name, bool read_only = true);
 
+      /** \brief Create an instance of a concrete GlastTimeHandler subclass selected by given header keyword values,
+                 and return the pointer to the instance. If no subclass can handle the extension, this method returns 0 (null pointer).
+          \param file_name Name of FITS file to open.
+          \param extension_name Name of FITS extension to open.
+          \param header_keyword Header keyword values of the FITS extension to open.
+          \param read_only Set to true to open the file in a read-only mode. Set to false to open it in a read-write mode.
+      */
+      static EventTimeHandler * createInstance(const std::string & file_name, const std::string & extension_name,
+        const HeaderKeyword & header_keyword, bool read_only = true);
+
+      /** \brief Read the header keywords that determine which GlastTimeHandler subclass can handle a given FITS extension.
+          \param file_name Name of FITS file to read.
+          \param extension_name Name of FITS extension to read.
+      */
+      static HeaderKeyword readHeaderKeyword(const std::string & file_name, const std::string & extension_name);
+
       /** \brief Initialize arrival time corrections.
           \param sc_file_name Name of spacecraft file to be used for arrival time corrections.
           \param sc_extension_name Name of FITS table that contains spacecraft data in the above file.
@@ -100,6 +145,76 @@ namespace timeSystem {
       */
       virtual AbsoluteTime parseTimeString(const std::string & time_string, const std::string & time_system = "FILE") const;
 
+      /** \brief Read Fermi (formerly GLAST) Mission Elapsed Times (METs) from a given column of the opened FITS table
+                 for a contiguous block of rows at a time, and set them to a given array.
+          \param column_name Name of column from which Fermi (formerly GLAST) METs are to be read.
+          \param first_row Index of the first row to read, with 0 (zero) for the first row of the table.
+          \param num_rows The number of rows to read.
+          \param time_value Array of at least num_rows elements to which the METs are set, in the order of rows.
+      */
+      virtual void readTimes(const std::string & column_name, tip::Index_t first_row, tip::Index_t num_rows,
+        double * time_value) const;
+
+      /** \brief Write Fermi (formerly GLAST) Mission Elapsed Times (METs) to a given column of the opened FITS table
+                 for a contiguous block of rows at a time.
+          \param column_name Name of column to which Fermi (formerly GLAST) METs are to be written.
+          \param first_row Index of the first row to write, with 0 (zero) for the first row of the table.
+          \param num_rows The number of rows to write.
+          \param time_value Array of at least num_rows elements holding the METs to write, in the order of rows.
+      */
+      virtual void writeTimes(const std::string & column_name, tip::Index_t first_row, tip::Index_t num_rows,
+        const double * time_value);
+
+      /** \brief Read Fermi (formerly GLAST) Mission Elapsed Times (METs) from a given column of the opened FITS table
+                 for a contiguous block of rows at a time, and set them to the last argument.
+          \param column_name Name of column from which Fermi (formerly GLAST) METs are to be read.
+          \param first_row Index of the first row to read, with 0 (zero) for the first row of the table.
+          \param num_rows The number of rows to read.
+          \param glast_time Fermi (formerly GLAST) METs read from the column, in the order of rows.
+      */
+      void readGlastTimeColumn(const std::string & column_name, tip::Index_t first_row, tip::Index_t num_rows,
+        std::vector<double> & glast_time) const;
+
+      /** \brief Write Fermi (formerly GLAST) Mission Elapsed Times (METs) to a given column of the opened FITS table
+                 for a contiguous block of rows at a time.
+          \param column_name Name of column to which Fermi (formerly GLAST) METs are to be written.
+          \param first_row Index of the first row to write, with 0 (zero) for the first row of the table.
+          \param glast_time Fermi (formerly GLAST) METs to write to the column, in the order of rows.
+      */
+      void writeGlastTimeColumn(const std::string & column_name, tip::Index_t first_row, const std::vector<double> & glast_time);
+
+      /** \brief Write absolute times to a given column of the opened FITS table for a contiguous block of rows at a time.
+          \param column_name Name of column to which given times are written.
+          \param first_row Index of the first row to write, with 0 (zero) for the first row of the table.
+          \param abs_time Absolute times to write to the column, in the order of rows.
+      */
+      void writeTimeColumn(const std::string & column_name, tip::Index_t first_row, const std::vector<AbsoluteTime> & abs_time);
+
+      /** \brief Compute Fermi (formerly GLAST) Mission Elapsed Times (METs) corresponding to given absolute times.
+          \param abs_time AbsoluteTime objects to be converted into Fermi (formerly GLAST) METs.
+          \param glast_time Fermi (formerly GLAST) METs for the given absolute times, in the same order as abs_time.
+      */
+      void computeGlastTime(const std::vector<AbsoluteTime> & abs_time, std::vector<double> & glast_time) const;
+
+      /** \brief Compute Fermi (formerly GLAST) Mission Elapsed Times (METs) measured in a given time system, with the same
+                 MJDREF as the opened FITS table, corresponding to given absolute times. These are the METs that would be
+                 written to a copy of the table whose TIMESYS keyword is changed to the given time system.
+          \param abs_time AbsoluteTime objects to be converted into Fermi (formerly GLAST) METs.
+          \param time_system Time system in which the METs are measured.
+          \param glast_time Fermi (formerly GLAST) METs for the given absolute times, in the same order as abs_time.
+      */
+      void computeGlastTime(const std::vector<AbsoluteTime> & abs_time, const TimeSystem & time_system,
+        std::vector<double> & glast_time) const;
+
+      /// \brief Return the time system in which Fermi (formerly GLAST) METs in the opened FITS table are measured.
+      const TimeSystem & getTimeSystem() const;
+
+      /** \brief Return a logical true if Fermi (formerly GLAST) METs in the opened FITS table are measured from the same MJD
+                 as those in the FITS table opened by a given handler, i.e., MJDREF is the same, and a logical false otherwise.
+          \param other Handler to compare MJDREF with.
+      */
+      bool hasSameMjdRef(const GlastTimeHandler & other) const;
+
     protected:
       /** \brief Construct a GlastTimeHandler object.
           \param file_name Name of FITS file to open.
@@ -151,9 +266,25 @@ namespace timeSystem {
       */
       double computeGlastTime(const AbsoluteTime & abs_time) const;
 
+      /** \brief Compute a Julian Date in TT system corresponding to a given Fermi (formerly GLAST) Mission Elapsed Time (MET).
+          \param glast_time Fermi (formerly GLAST) MET to convert to a Julian Date.
+      */
+      Jd computeTtJd(double glast_time) const;
+
     private:
       const TimeSystem * m_time_system;
       Mjd m_mjd_ref;
+      moment_type m_moment_ref;
+      std::string m_fits_name;
+      bool m_read_only;
+      mutable fitsfile * m_fits_ptr;
+
+      /** \brief Helper method for column-wise methods to return a cfitsio pointer to the opened FITS table, opening it
+                 on the first call, and to look up the column number of a given column.
+          \param column_name Name of column to look up.
+          \param column_number Column number of the given column, with 1 (one) for the first column.
+      */
+      fitsfile * getFitsPointer(const std::string & column_name, int & column_number) const;
   };
 
   /** \class GlastScTimeHandler
@@ -163,6 +294,31 @@ namespace timeSystem {
   */
   class GlastScTimeHandler: public GlastTimeHandler {
     public:
+      /** \class ScFileHolder
+          \brief Class which keeps a spacecraft file loaded during the lifetime of an object of this class, so that
+                 GlastScTimeHandler objects created in the meantime share the spacecraft data without reading the file again.
+                 An error in loading the file is ignored here, and is reported when a GlastScTimeHandler object uses the file.
+                 A list of spacecraft files, given as '@' followed by the name of a list file, is not loaded here, because
+                 GlastScTimeHandler objects load only those listed files that are needed for event times.
+      */
+      class ScFileHolder {
+        public:
+          /** \brief Construct a ScFileHolder object, loading a given spacecraft file.
+              \param sc_file_name Name of spacecraft file to keep loaded.
+              \param sc_extension_name Name of FITS table that contains spacecraft data in the above file.
+          */
+          ScFileHolder(const std::string & sc_file_name, const std::string & sc_extension_name);
+
+          /// \brief Destruct this ScFileHolder object, releasing the spacecraft file.
+          ~ScFileHolder();
+
+        private:
+          GlastScFile * m_sc_ptr;
+
+          ScFileHolder(const ScFileHolder &);
+          ScFileHolder & operator =(const ScFileHolder &);
+      };
+
       /// Destruct this GlastScTimeHandler object.
       virtual ~GlastScTimeHandler();
 
@@ -174,8 +330,28 @@ namespace timeSystem {
       */
       static EventTimeHandler * createInstance(const std::string & file_name, const std::string & extension_name, bool read_only = true);
 
+      /** \brief Create an instance of a GlastScTimeHandler subclass if given header keyword values are supported by this class,
+                 and return the pointer to the instance. Otherwise, this method returns 0 (null pointer).
+          \param file_name Name of FITS file to open.
+          \param extension_name Name of FITS extension to open.
+          \param header_keyword Header keyword values of the FITS extension to open.
+          \param read_only Set to true to open the file in a read-only mode. Set to false to open it in a read-write mode.
+      */
+      static EventTimeHandler * createInstance(const std::string & file_name, const std::string & extension_name,
+        const HeaderKeyword & header_keyword, bool read_only = true);
+
+      /** \brief Return a logical true if a FITS extension with given header keyword values can be handled by this class,
+                 and a logical false otherwise.
+          \param header_keyword Header keyword values of a FITS extension.
+      */
+      static bool isSupported(const HeaderKeyword & header_keyword);
+
       /** \brief Initialize arrival time corrections.
-          \param sc_file_name Name of spacecraft file to be used for arrival time corrections.
+          \param sc_file_name Name of spacecraft file to be used for arrival time corrections. If the name starts with '@',
+                 the rest of the name is taken as the name of a text file that lists spacecraft files, one per line.
+                 In that case, only the headers of the listed files are read here, and each file is loaded when the first
+                 event time in the time range given by its TSTART and TSTOP header keywords is corrected. Event times
+                 between the last row of a listed file and the first row of the next one are interpolated across the files.
           \param sc_extension_name Name of FITS table that contains spacecraft data in the above file.
           \param solar_eph Name of solar system ephemeris to use for arrival time corrections.
           \param match_solar_eph Set to true if the above solar system ephemeris must match the one written in the opened file.
@@ -206,12 +382,110 @@ namespace timeSystem {
       */
       virtual AbsoluteTime getBaryTime(const std::string & field_name, bool from_header = false) const;
 
+      /** \brief Read Fermi (formerly GLAST) Mission Elapsed Times (METs) from a given column of the opened FITS table
+                 for a contiguous block of rows at a time, compute geocentric times for them, and set them to a given array
+                 as METs measured in TT system.
+          \param column_name Name of column from which Fermi (formerly GLAST) METs are to be read.
+          \param first_row Index of the first row to read, with 0 (zero) for the first row of the table.
+          \param num_rows The number of rows to read.
+          \param time_value Array of at least num_rows elements to which the geocentric times are set, in the order of rows.
+      */
+      virtual void getGeoTimes(const std::string & column_name, tip::Index_t first_row, tip::Index_t num_rows,
+        double * time_value) const;
+
+      /** \brief Read Fermi (formerly GLAST) Mission Elapsed Times (METs) from a given column of the opened FITS table
+                 for a contiguous block of rows at a time, compute barycentric times for them, and set them to a given array
+                 as METs measured in TDB system.
+          \param column_name Name of column from which Fermi (formerly GLAST) METs are to be read.
+          \param first_row Index of the first row to read, with 0 (zero) for the first row of the table.
+          \param num_rows The number of rows to read.
+          \param time_value Array of at least num_rows elements to which the barycentric times are set, in the order of rows.
+      */
+      virtual void getBaryTimes(const std::string & column_name, tip::Index_t first_row, tip::Index_t num_rows,
+        double * time_value) const;
+
+      /** \brief Compute geocentric or barycentric times for a block of Fermi (formerly GLAST) Mission Elapsed Times (METs)
+                 at a time, and set them to the last argument.
+          \param glast_time Fermi (formerly GLAST) METs to compute geocentric or barycentric times for.
+          \param compute_bary Set to true to compute barycentric times. Set to false to compute geocentric times.
+          \param abs_time Computed geocentric or barycentric times, in the same order as glast_time.
+      */
+      void computeCorrectedTime(const std::vector<double> & glast_time, bool compute_bary,
+        std::vector<AbsoluteTime> & abs_time) const;
+
+      /** \brief Compute geocentric or barycentric times for a block of Fermi (formerly GLAST) Mission Elapsed Times (METs)
+                 for each of given sources at a time, and set them to the last argument. Spacecraft positions and solar system
+                 ephemeris are computed only once per time for all the sources.
+          \param glast_time Fermi (formerly GLAST) METs to compute geocentric or barycentric times for.
+          \param src_position Positions of the celestial objects to be used for arrival time corrections. The source position
+                 given to setSourcePosition method is not used.
+          \param compute_bary Set to true to compute barycentric times. Set to false to compute geocentric times.
+          \param abs_time Computed geocentric or barycentric times for the first source in the same order as glast_time,
+                 followed by those for the second source, and so on.
+      */
+      void computeCorrectedTime(const std::vector<double> & glast_time, const std::vector<SourcePosition> & src_position,
+        bool compute_bary, std::vector<AbsoluteTime> & abs_time) const;
+
+      /** \brief Compute geocentric or barycentric times for a block of Fermi (formerly GLAST) Mission Elapsed Times (METs)
+                 for each of given sources at a time, and set them to the last argument as METs measured in TT system for
+                 geocentric times, or in TDB system for barycentric times, from the same MJDREF as the opened FITS table.
+                 The results are the same as those of computeCorrectedTime method, converted by computeGlastTime method,
+                 but a Julian Date in TT system is computed only once per time, and used both for the time delays and for
+                 the time difference between TDB and TT, without creating AbsoluteTime objects.
+          \param glast_time Fermi (formerly GLAST) METs to compute geocentric or barycentric times for.
+          \param src_position Positions of the celestial objects to be used for arrival time corrections. The source position
+                 given to setSourcePosition method is not used.
+          \param compute_bary Set to true to compute barycentric times. Set to false to compute geocentric times.
+          \param corrected_time Computed geocentric or barycentric times as METs for the first source in the same order as
+                 glast_time, followed by those for the second source, and so on.
+      */
+      void computeCorrectedGlastTime(const std::vector<double> & glast_time, const std::vector<SourcePosition> & src_position,
+        bool compute_bary, std::vector<double> & corrected_time) const;
+
+      /** \brief Enable or disable approximate arrival time corrections in computeCorrectedTime methods. When enabled, time
+                 delays are computed exactly only at nodes placed within each interval of the spacecraft data, where spacecraft
+                 positions change smoothly, and are interpolated for other times. Nodes are added until the interpolation error,
+                 estimated at the nodes, is within a given tolerance. The nodes are placed at fixed fractions of each interval,
+                 so that corrected times do not depend on how times are split into calls of computeCorrectedTime methods.
+          \param delay_tolerance Maximum error in seconds allowed for interpolated time delays. Set to zero (0) or a negative
+                 value to compute time delays exactly for all times, which is the default.
+      */
+      void setDelayTolerance(double delay_tolerance);
+
+      /** \brief Return the maximum estimated error in seconds of the time delays interpolated since the last call to
+                 setDelayTolerance method, or zero (0) if no time delay has been interpolated.
+      */
+      double getMaxDelayError() const;
+
     private:
+      /** \class ScFileEntry
+          \brief Class which holds the name and the time range of one of the spacecraft files to be used for arrival time
+                 corrections, and the spacecraft file pointer once the file is loaded.
+      */
+      struct ScFileEntry {
+        std::string m_file_name;
+        double m_start_time;     // The value of TSTART header keyword.
+        long m_first_interval;   // Index of the first interval of this file among the intervals of all the files.
+        GlastScFile * m_sc_ptr;  // Null pointer (0) until this file is loaded.
+      };
+
+      /** \class ScCursor
+          \brief Class which holds the state of searches in the spacecraft files for a range of times, owned by the caller
+                 of the search, so that threads may search the loaded spacecraft files concurrently without the lock for
+                 glastscorbit C-functions.
+      */
+      struct ScCursor {
+        std::size_t m_entry_index;                // Index to m_sc_entry of the file used by the last search.
+        std::vector<GlastScCursor> m_file_cursor; // Cursor for glastscorbit C-functions in each of the files.
+      };
+
       std::string m_sc_file;
       std::string m_sc_table;
-      GlastScFile * m_sc_ptr;
+      mutable std::vector<ScFileEntry> m_sc_entry; // Spacecraft files, sorted by the start time.
       SourcePosition m_pos_bary;   // The source position for barycentering.
       const BaryTimeComputer * m_computer;
+      double m_delay_tolerance;
+      mutable std::atomic<double> m_max_delay_error;
 
       /** Construct a GlastScTimeHandler object.
           \param file_name Name of FITS file to open.
@@ -220,6 +494,133 @@ namespace timeSystem {
       */
       GlastScTimeHandler(const std::string & file_name, const std::string & extension_name, bool read_only = true);
 
+      /** \brief Helper method to close all the opened spacecraft files, and to return the error code of the first error
+                 in closing them, or zero (0) if none. The caller must hold the lock for glastscorbit C-functions.
+      */
+      int closeScFile();
+
+      /** \brief Helper method to return the spacecraft file pointer of a given spacecraft file, loading the file if not yet.
+                 The caller must hold the lock for glastscorbit C-functions.
+          \param entry_index Index to the list of spacecraft files of the file to return.
+      */
+      GlastScFile * loadScFile(std::size_t entry_index) const;
+
+      /** \brief Helper method to load all the spacecraft files that may be searched for given times, taking the lock for
+                 glastscorbit C-functions only once, and only if a list of spacecraft files is given. Once loaded, the files
+                 are not modified until initTimeCorrection method or the destructor is called, so that they can be searched
+                 without the lock thereafter.
+          \param glast_time Fermi (formerly GLAST) METs to be searched for.
+      */
+      void prepareScFile(const std::vector<double> & glast_time) const;
+
+      /** \brief Helper method to initialize a cursor for searches in the spacecraft files.
+          \param sc_cursor Cursor to initialize.
+      */
+      void initScCursor(ScCursor & sc_cursor) const;
+
+      /** \brief Helper method to add the numbers of searches with a given cursor to the process-wide counters of
+                 PerformanceMonitor, if collection is enabled.
+          \param sc_cursor Cursor whose numbers of searches are to be added.
+      */
+      void recordScCursorStatistics(const ScCursor & sc_cursor) const;
+
+      /** \brief Helper method to return the index to the list of spacecraft files of the last file that starts at or before
+                 a given time, or of the first file if none, trying the file used by the last search with a given cursor
+                 first. The cursor is updated with the selected file.
+          \param glast_time Fermi (formerly GLAST) MET to select a spacecraft file for.
+          \param sc_cursor Cursor for searches in the spacecraft files.
+      */
+      std::size_t selectScFile(double glast_time, ScCursor & sc_cursor) const;
+
+      /** \brief Helper method to find the spacecraft file and the interval in it that contain a given time. The function
+                 returns 0 if successful, and a non-zero error code if otherwise, in the same manner as glastscorbit_calcpos.
+                 The spacecraft files that may be searched must be loaded by prepareScFile method beforehand.
+          \param glast_time Fermi (formerly GLAST) MET to search for.
+          \param sc_cursor Cursor for searches in the spacecraft files.
+          \param entry_index Index to the list of spacecraft files of the file that contains the given time, or of the file
+                 that precedes the given time if it falls between two listed files.
+          \param interval Index of the interval in the file that contains the given time, starting from zero (0), or -1 if
+                 the given time falls between the last row of the file and the first row of the next file.
+      */
+      int searchScFile(double glast_time, ScCursor & sc_cursor, std::size_t & entry_index, long & interval) const;
+
+      /** \brief Helper method to compute a spacecraft position at a given time from the spacecraft files, in the same
+                 manner as glastscorbit_calcpos. The spacecraft files that may be searched must be loaded by prepareScFile
+                 method beforehand.
+          \param glast_time Fermi (formerly GLAST) MET at which the spacecraft position is to be computed.
+          \param sc_cursor Cursor for searches in the spacecraft files.
+          \param sc_position Array to which the computed spacecraft position is to be set.
+      */
+      int calcScPosition(double glast_time, ScCursor & sc_cursor, double sc_position[]) const;
+
+      /** \brief Helper method to find the interval that contains a given time among the intervals of all the spacecraft
+                 files, in the same manner as glastscorbit_getinterval. An interval between two listed files also counts.
+                 The spacecraft files that may be searched must be loaded by prepareScFile method beforehand.
+          \param glast_time Fermi (formerly GLAST) MET to search for.
+          \param sc_cursor Cursor for searches in the spacecraft files.
+          \param interval Index of the interval that contains the given time.
+          \param begin_time Time of the row at the beginning of the interval.
+          \param end_time Time of the row at the end of the interval.
+      */
+      int searchScInterval(double glast_time, ScCursor & sc_cursor, long & interval, double & begin_time, double & end_time) const;
+
+      /** \brief Helper method to throw an exception for an error in computing a spacecraft position at a given time.
+          \param glast_time Fermi (formerly GLAST) MET at which the error occurred.
+          \param calc_status Error code returned by a glastscorbit C-function.
+      */
+      void throwScPositionError(double glast_time, int calc_status) const;
+
+      /** \brief Helper method to compute time delays exactly for a block of times for each of given sources.
+          \param glast_time Fermi (formerly GLAST) METs to compute time delays for.
+          \param src_position Positions of the celestial objects to be used for arrival time corrections.
+          \param compute_bary Set to true to compute barycentric time delays. Set to false to compute geocentric ones.
+          \param delay Computed time delays in seconds for the first source in the same order as glast_time, followed by
+                 those for the second source, and so on.
+      */
+      void computeTimeDelay(const std::vector<double> & glast_time, const std::vector<SourcePosition> & src_position,
+        bool compute_bary, std::vector<double> & delay) const;
+
+      /** \brief Helper method to compute time delays exactly for a block of times for each of given sources, for which
+                 Julian Dates in TT system are already computed.
+          \param glast_time Fermi (formerly GLAST) METs to compute time delays for.
+          \param tt_time Julian Dates in TT system for the METs, in the same order as glast_time.
+          \param src_position Positions of the celestial objects to be used for arrival time corrections.
+          \param compute_bary Set to true to compute barycentric time delays. Set to false to compute geocentric ones.
+          \param delay Computed time delays, laid out in the same manner as the other computeTimeDelay method.
+      */
+      void computeTimeDelay(const std::vector<double> & glast_time, const std::vector<Jd> & tt_time,
+        const std::vector<SourcePosition> & src_position, bool compute_bary, std::vector<double> & delay) const;
+
+      /** \brief Helper method to compute time delays approximately for a block of times for each of given sources, by
+                 interpolation within each interval of the spacecraft data. Arguments are the same as computeTimeDelay method.
+      */
+      void interpolateTimeDelay(const std::vector<double> & glast_time, const std::vector<SourcePosition> & src_position,
+        bool compute_bary, std::vector<double> & delay) const;
+
+      /** \brief Helper method for interpolateTimeDelay method, which interpolates time delays for times in a segment of time,
+                 splitting the segment into halves recursively until the interpolation error is within the tolerance. Whether
+                 the segment is split depends only on the beginning and the end of it, not on the times in it, so that the nodes
+                 and the interpolated time delays do not depend on which other times are given together.
+          \param glast_time Fermi (formerly GLAST) METs to compute time delays for.
+          \param src_position Positions of the celestial objects to be used for arrival time corrections.
+          \param compute_bary Set to true to compute barycentric time delays. Set to false to compute geocentric ones.
+          \param time_order Indices to glast_time, sorted in ascending order of time within the segment.
+          \param first_index Index to time_order of the first time in the segment.
+          \param last_index Index to time_order of one past the last time in the segment.
+          \param begin_time Beginning of the segment.
+          \param end_time End of the segment.
+          \param node_delay Time delays at the beginning, the middle, and the end of the segment, in this order, for the
+                 first source, followed by those for the second source, and so on.
+          \param depth The number of times the segment has been split in halves.
+          \param exact_index Indices to glast_time for which time delays must be computed exactly, to be appended to.
+          \param delay Interpolated time delays, laid out in the same manner as computeTimeDelay method. Only elements for
+                 the times in the segment are set.
+      */
+      void interpolateSegment(const std::vector<double> & glast_time, const std::vector<SourcePosition> & src_position,
+        bool compute_bary, const std::vector<std::size_t> & time_order, std::size_t first_index, std::size_t last_index,
+        double begin_time, double end_time, const std::vector<double> & node_delay, int depth,
+        std::vector<std::size_t> & exact_index, std::vector<double> & delay) const;
+
       /** \brief Helper method for getGeoTime and getBaryTime methods. This method performs the actual computations of
                  arrival time corrections, and returns an AbsoluteTime object that represents a corrected time.
           \param field_name Name of field from which a time is to be read.
@@ -228,6 +629,17 @@ namespace timeSystem {
           \param compute_bary Set to true to compute a barycentric time. Set to false to compute a geocentric time.
       */
       AbsoluteTime getCorrectedTime(const std::string & field_name, bool from_header, bool compute_bary) const;
+
+      /** \brief Read Fermi (formerly GLAST) Mission Elapsed Times (METs) from a given column for a contiguous block of rows,
+                 perform geocentric or barycentric corrections on them, and set the corrected METs to a given array.
+          \param column_name Name of column from which Fermi (formerly GLAST) METs are to be read.
+          \param first_row Index of the first row to read, with 0 (zero) for the first row of the table.
+          \param num_rows The number of rows to read.
+          \param compute_bary Set to true to compute barycentric times. Set to false to compute geocentric times.
+          \param time_value Array of at least num_rows elements to which the corrected METs are set, in the order of rows.
+      */
+      void getCorrectedTimes(const std::string & column_name, tip::Index_t first_row, tip::Index_t num_rows, bool compute_bary,
+        double * time_value) const;
   };
 
   /** \class GlastGeoTimeHandler
@@ -249,8 +661,28 @@ namespace timeSystem {
       */
       static EventTimeHandler * createInstance(const std::string & file_name, const std::string & extension_name, bool read_only = true);
 
+      /** \brief Create an instance of a GlastGeoTimeHandler subclass if given header keyword values are supported by this class,
+                 and return the pointer to the instance. Otherwise, this method returns 0 (null pointer).
+          \param file_name Name of FITS file to open.
+          \param extension_name Name of FITS extension to open.
+          \param header_keyword Header keyword values of the FITS extension to open.
+          \param read_only Set to true to open the file in a read-only mode. Set to false to open it in a read-write mode.
+      */
+      static EventTimeHandler * createInstance(const std::string & file_name, const std::string & extension_name,
+        const HeaderKeyword & header_keyword, bool read_only = true);
+
+      /** \brief Return a logical true if a FITS extension with given header keyword values can be handled by this class,
+                 and a logical false otherwise.
+          \param header_keyword Header keyword values of a FITS extension.
+      */
+      static bool isSupported(const HeaderKeyword & header_keyword);
+
       /** \brief Initialize arrival time corrections.
-          \param sc_file_name Name of spacecraft file to be used for arrival time corrections.
+          \param sc_file_name Name of spacecraft file to be used for arrival time corrections. If the name starts with '@',
+                 the rest of the name is taken as the name of a text file that lists spacecraft files, one per line.
+                 In that case, only the headers of the listed files are read here, and each file is loaded when the first
+                 event time in the time range given by its TSTART and TSTOP header keywords is corrected. Event times
+                 between the last row of a listed file and the first row of the next one are interpolated across the files.
           \param sc_extension_name Name of FITS table that contains spacecraft data in the above file.
           \param solar_eph Name of solar system ephemeris to use for arrival time corrections.
           \param match_solar_eph Set to true if the above solar system ephemeris must match the one written in the opened file.
@@ -281,6 +713,26 @@ namespace timeSystem {
       */
       virtual AbsoluteTime getBaryTime(const std::string & field_name, bool from_header = false) const;
 
+      /** \brief Read Fermi (formerly GLAST) Mission Elapsed Times (METs) from a given column of the opened FITS table
+                 for a contiguous block of rows at a time, and set them to a given array, which are already geocentric
+                 times in TT system.
+          \param column_name Name of column from which Fermi (formerly GLAST) METs are to be read.
+          \param first_row Index of the first row to read, with 0 (zero) for the first row of the table.
+          \param num_rows The number of rows to read.
+          \param time_value Array of at least num_rows elements to which the geocentric times are set, in the order of rows.
+      */
+      virtual void getGeoTimes(const std::string & column_name, tip::Index_t first_row, tip::Index_t num_rows,
+        double * time_value) const;
+
+      /** \brief Throw an exception, because computation of barycentric times is not supported.
+          \param column_name Name of column from which times are to be read (not used).
+          \param first_row Index of the first row to read (not used).
+          \param num_rows The number of rows to read (not used).
+          \param time_value Array to which times are set (not used).
+      */
+      virtual void getBaryTimes(const std::string & column_name, tip::Index_t first_row, tip::Index_t num_rows,
+        double * time_value) const;
+
     private:
       std::string m_file_name;
       std::string m_ext_name;
@@ -311,8 +763,28 @@ namespace timeSystem {
       */
       static EventTimeHandler * createInstance(const std::string & file_name, const std::string & extension_name, bool read_only = true);
 
+      /** \brief Create an instance of a GlastBaryTimeHandler subclass if given header keyword values are supported by this class,
+                 and return the pointer to the instance. Otherwise, this method returns 0 (null pointer).
+          \param file_name Name of FITS file to open.
+          \param extension_name Name of FITS extension to open.
+          \param header_keyword Header keyword values of the FITS extension to open.
+          \param read_only Set to true to open the file in a read-only mode. Set to false to open it in a read-write mode.
+      */
+      static EventTimeHandler * createInstance(const std::string & file_name, const std::string & extension_name,
+        const HeaderKeyword & header_keyword, bool read_only = true);
+
+      /** \brief Return a logical true if a FITS extension with given header keyword values can be handled by this class,
+                 and a logical false otherwise.
+          \param header_keyword Header keyword values of a FITS extension.
+      */
+      static bool isSupported(const HeaderKeyword & header_keyword);
+
       /** \brief Initialize arrival time corrections.
-          \param sc_file_name Name of spacecraft file to be used for arrival time corrections.
+          \param sc_file_name Name of spacecraft file to be used for arrival time corrections. If the name starts with '@',
+                 the rest of the name is taken as the name of a text file that lists spacecraft files, one per line.
+                 In that case, only the headers of the listed files are read here, and each file is loaded when the first
+                 event time in the time range given by its TSTART and TSTOP header keywords is corrected. Event times
+                 between the last row of a listed file and the first row of the next one are interpolated across the files.
           \param sc_extension_name Name of FITS table that contains spacecraft data in the above file.
           \param solar_eph Name of solar system ephemeris to use for arrival time corrections.
           \param match_solar_eph Set to true if the above solar system ephemeris must match the one written in the opened file.
@@ -343,6 +815,26 @@ namespace timeSystem {
       */
       virtual AbsoluteTime getBaryTime(const std::string & field_name, bool from_header = false) const;
 
+      /** \brief Throw an exception, because computation of geocentric times is not supported.
+          \param column_name Name of column from which times are to be read (not used).
+          \param first_row Index of the first row to read (not used).
+          \param num_rows The number of rows to read (not used).
+          \param time_value Array to which times are set (not used).
+      */
+      virtual void getGeoTimes(const std::string & column_name, tip::Index_t first_row, tip::Index_t num_rows,
+        double * time_value) const;
+
+      /** \brief Read Fermi (formerly GLAST) Mission Elapsed Times (METs) from a given column of the opened FITS table
+                 for a contiguous block of rows at a time, and set them to a given array, which are already barycentric
+                 times in TDB system.
+          \param column_name Name of column from which Fermi (formerly GLAST) METs are to be read.
+          \param first_row Index of the first row to read, with 0 (zero) for the first row of the table.
+          \param num_rows The number of rows to read.
+          \param time_value Array of at least num_rows elements to which the barycentric times are set, in the order of rows.
+      */
+      virtual void getBaryTimes(const std::string & column_name, tip::Index_t first_row, tip::Index_t num_rows,
+        double * time_value) const;
+
     private:
       std::string m_file_name;
       std::string m_ext_name;
@@ -0,0 +1,136 @@
+/** \file PerformanceMonitor.h
+    \brief Declaration of PerformanceMonitor class.
+    \authors Masaharu Hirayama, GSSC
+             James Peachey, HEASARC/GSSC
+*/
+#ifndef timeSystem_PerformanceMonitor_h
+#define timeSystem_PerformanceMonitor_h
+
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <string>
+
+namespace timeSystem {
+
+  /** \class PerformanceMonitor
+      \brief Class to collect process-wide timing and counters for stages of arrival time corrections. Collection is
+             disabled by default, in which case each instrumentation point costs only a test of a flag.
+             Times are accumulated over all threads, so that the time for a stage may exceed the wall-clock time
+             when the stage is processed in parallel.
+  */
+  class PerformanceMonitor {
+    public:
+      /// \brief Stages of arrival time corrections to accumulate times for.
+      enum StageType {
+        FILE_READ,               ///< Reading times from an input file.
+        ORBIT_INTERPOLATION,     ///< Interpolating spacecraft positions.
+        TIME_DELAY,              ///< Computing time delays, including EPHEMERIS_INTERPOLATION.
+        EPHEMERIS_INTERPOLATION, ///< Interpolating solar system ephemeris.
+        TIME_CONVERSION,         ///< Converting times between time systems and representations.
+        FILE_WRITE,              ///< Writing times to an output file.
+        NUM_STAGE
+      };
+
+      /// \brief Events to count.
+      enum CounterType {
+        ROW_PROCESSED,           ///< Table rows processed.
+        EPHEMERIS_RECORD_SWITCH, ///< Switches of the record of solar system ephemeris to interpolate.
+        SC_FILE_HIT,             ///< Spacecraft file searches answered by the last bracketing interval.
+        SC_FILE_RUN_HIT,         ///< Spacecraft file searches answered by a run of uniform cadence after the cursor missed.
+        SC_FILE_MISS,            ///< Spacecraft file searches that fell back on a binary search.
+        TDB_TO_TT_ITERATION,     ///< Iterations in conversions from TDB to TT.
+        DELAY_NODE,              ///< Time delays computed exactly at nodes for interpolation.
+        DELAY_INTERPOLATED,      ///< Time delays interpolated between nodes.
+        EPHEMERIS_BYTES_PRELOADED, ///< Bytes of solar system ephemeris records read into memory before interpolation.
+        ROW_REORDERED,           ///< Rows of unordered blocks corrected in sorted-time order.
+        NUM_COUNTER
+      };
+
+      /** \class StageTimer
+          \brief Class to add the time elapsed during the lifetime of an object of this class to a given stage.
+                 No clock is read while collection is disabled.
+      */
+      class StageTimer {
+        public:
+          /** \brief Construct a StageTimer object, and start timing if collection is enabled.
+              \param stage Stage to add the elapsed time to.
+          */
+          explicit StageTimer(StageType stage): m_stage(stage), m_enabled(isEnabled()), m_start() {
+            if (m_enabled) m_start = clock_type::now();
+          }
+
+          /// \brief Destruct this StageTimer object, adding the elapsed time to the stage.
+          ~StageTimer() {
+            if (m_enabled) addTime(m_stage, std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - m_start).count());
+          }
+
+        private:
+          typedef std::chrono::steady_clock clock_type;
+          StageType m_stage;
+          bool m_enabled;
+          clock_type::time_point m_start;
+
+          StageTimer(const StageTimer &);
+          StageTimer & operator =(const StageTimer &);
+      };
+
+      /** \brief Enable or disable collection.
+          \param enabled Set to true to enable collection. Set to false to disable it.
+      */
+      static void enable(bool enabled) { s_enabled.store(enabled, std::memory_order_relaxed); }
+
+      /// \brief Return a logical true if collection is enabled, and a logical false otherwise.
+      static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+      /// \brief Reset all the times and counters to zero (0).
+      static void reset();
+
+      /** \brief Add a given time to a given stage, regardless of whether collection is enabled.
+          \param stage Stage to add the time to.
+          \param nanosec Time to add, in nanoseconds.
+      */
+      static void addTime(StageType stage, long long nanosec);
+
+      /** \brief Add a given count to a given counter if collection is enabled.
+          \param counter Counter to add the count to.
+          \param count Count to add.
+      */
+      static void addCount(CounterType counter, long long count) {
+        if (isEnabled()) s_count[counter].fetch_add(count, std::memory_order_relaxed);
+      }
+
+      /** \brief Return the time accumulated for a given stage, in nanoseconds.
+          \param stage Stage to return the time for.
+      */
+      static long long getTime(StageType stage);
+
+      /** \brief Return the count accumulated for a given counter.
+          \param counter Counter to return the count for.
+      */
+      static long long getCount(CounterType counter);
+
+      /** \brief Write a human-readable summary of the times and counters.
+          \param os Output stream to write the summary to.
+      */
+      static void report(std::ostream & os);
+
+      /** \brief Write a summary of the times and counters in JSON format.
+          \param os Output stream to write the summary to.
+      */
+      static void writeJson(std::ostream & os);
+
+      /** \brief Write a summary of the times and counters in JSON format to a file.
+          \param file_name Name of the file to write the summary to.
+      */
+      static void writeJson(const std::string & file_name);
+
+    private:
+      static std::atomic<bool> s_enabled;
+      static std::atomic<long long> s_time[NUM_STAGE];
+      static std::atomic<long long> s_count[NUM_COUNTER];
+  };
+
+}
+
+#endif
@@ -107,6 +107,12 @@ namespace timeSystem {
       */
       void checkOutputFits(const std::string & out_file, const std::string & ref_file);
 
+      /** \brief Set the maximum number of mismatches to report for each column compared numerically by checkOutputFits
+                 method. Mismatches beyond the maximum are counted, but not reported one by one.
+          \param max_mismatch The maximum number of mismatches to report.
+      */
+      void setMaxMismatch(long max_mismatch);
+
       /** \brief Compare an output text file with a given reference file.
           \param out_file Name of an output text file to be compared with a given reference.
           \param ref_file Name of a reference file to check a given output text file against.
@@ -135,6 +141,26 @@ namespace timeSystem {
         const std::string & out_file, const std::string & out_file_ref, bool ignore_exception = false);
 
     protected:
+      /// \brief Ways to compare a column of an output FITS file with its reference.
+      enum ColumnComparisonType {
+        CELL_COMPARISON,    ///< Compare cell by cell with verify method for table cells.
+        NUMERIC_COMPARISON, ///< Compare whole columns at a time as floating-point numbers, with tolerances.
+        NO_COMPARISON       ///< Do not compare.
+      };
+
+      /** \brief Return how to compare a given column of an output FITS file with its reference. If NUMERIC_COMPARISON is
+                 returned, tolerances are set to the arguments, and two numbers are considered equivalent unless the
+                 difference between the two exceeds tolerance_abs + tolerance_rel * reference, where reference is the
+                 absolute value of the number in the reference file. Columns of character strings and logical values
+                 are compared cell by cell, even if NUMERIC_COMPARISON is returned. This method returns CELL_COMPARISON
+                 for all columns, unless overridden.
+          \param column_name Name of the FITS column to compare.
+          \param tolerance_abs Absolute tolerance in numeric comparison is set to this argument.
+          \param tolerance_rel Relative tolerance in numeric comparison is set to this argument.
+      */
+      virtual ColumnComparisonType getColumnComparison(const std::string & column_name, double & tolerance_abs,
+        double & tolerance_rel) const;
+
       /** \brief Return a logical true if the two character strings are determined equivalent to each other,
                  and a logical false otherwise. This method compares a character string with a reference string,
                  with a tolerance for numerical expressions in the character strings. For example, string
@@ -178,6 +204,20 @@ namespace timeSystem {
     private:
       std::string m_app_name;
       PulsarTestApp * m_test_app;
+      long m_max_mismatch;
+
+      /** \brief Helper method to compare a column of an output FITS table with its reference as floating-point numbers,
+                 reading the whole column at a time, and return a logical true if the column is numeric, and a logical
+                 false if the column must be compared cell by cell.
+          \param out_file Name of the output FITS file to be compared with its reference.
+          \param ref_file Name of the reference file to check the output FITS file against.
+          \param ext_number Number of the HDU to compare, starting from zero (0) for the primary HDU.
+          \param column_name Name of the column to compare.
+          \param tolerance_abs Absolute tolerance in comparison of floating-point numbers.
+          \param tolerance_rel Relative tolerance in comparison of floating-point numbers.
+      */
+      bool checkNumericColumn(const std::string & out_file, const std::string & ref_file, int ext_number,
+        const std::string & column_name, double tolerance_abs, double tolerance_rel);
   };
 
   template <typename StreamType>
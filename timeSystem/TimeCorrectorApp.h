@@ -7,9 +7,12 @@
 #define timeSystem_TimeCorrectorApp_h
 
 #include <string>
+#include <vector>
 
 #include "st_app/StApp.h"
 
+#include "st_stream/StreamFormatter.h"
+
 namespace timeSystem {
 
   /** \class TimeCorrectorApp
@@ -17,6 +20,23 @@ namespace timeSystem {
   */
   class TimeCorrectorApp : public st_app::StApp {
     public:
+      /** \class CorrectionTarget
+          \brief Class which holds a source position to be used for arrival time corrections, and the name of the output file
+                 to which times corrected for the source are written.
+      */
+      struct CorrectionTarget {
+        /** \brief Construct a CorrectionTarget object.
+            \param ra Right Ascension of the source in degrees.
+            \param dec Declination of the source in degrees.
+            \param out_file Name of the output file for the source.
+        */
+        CorrectionTarget(double ra, double dec, const std::string & out_file): m_ra(ra), m_dec(dec), m_out_file(out_file) {}
+
+        double m_ra;
+        double m_dec;
+        std::string m_out_file;
+      };
+
       /// \brief Construct a TimeCorrectorApp object.
       TimeCorrectorApp();
 
@@ -27,6 +47,20 @@ namespace timeSystem {
       virtual void run();
 
     private:
+      struct CorrectionSetting;
+
+      st_stream::StreamFormatter m_os;
+
+      /** \brief Correct arrival times in one input file, and write them to one output file per source. This method may be
+                 called concurrently for different input files.
+          \param setting Settings of arrival time corrections common to all the input files.
+          \param inFile_s Name of the input file.
+          \param target_cont Source positions to be used for arrival time corrections, and the names of the output files,
+                 one per source.
+      */
+      void correctFile(const CorrectionSetting & setting, const std::string & inFile_s,
+        const std::vector<CorrectionTarget> & target_cont);
+
       /** \brief Create a temporary file name.
           \param file_name Name of file based on which a temorary file name is created.
       */
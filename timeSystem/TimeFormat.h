@@ -8,8 +8,10 @@
 
 #include "timeSystem/TimeSystem.h"
 
+#include <cstddef>
 #include <limits>
 #include <map>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 
@@ -46,6 +48,70 @@ namespace timeSystem {
       */
       virtual std::string format(const TimeRepType & time_rep, std::streamsize precision = std::numeric_limits<double>::digits10)
         const = 0;
+
+      /** \brief Interpret character strings stored in a caller-provided buffer as a specific time representation, and set them
+                 to a caller-provided array. Each character string occupies a fixed number of characters in the buffer, and ends
+                 at the first null character in them, if any. Trailing blanks of each character string are ignored.
+          \param buffer Buffer holding character strings to interpret, one after another.
+          \param width Number of characters occupied by each character string in the buffer.
+          \param num_string Number of character strings to interpret.
+          \param time_rep Array of at least num_string time representations, to which the interpreted ones are set.
+      */
+      virtual void parseArray(const char * buffer, std::size_t width, std::size_t num_string, TimeRepType * time_rep) const {
+        for (std::size_t ii = 0; ii < num_string; ++ii) {
+          const char * time_string = buffer + ii * width;
+          time_rep[ii] = parse(std::string(time_string, getStringLength(time_string, width)));
+        }
+      }
+
+      /** \brief Create character strings representing time moments in a specific time representation, and store them in
+                 a caller-provided buffer. Each character string occupies a fixed number of characters in the buffer, and is
+                 padded with null characters if it is shorter than that. An exception is thrown if it is longer than that.
+          \param time_rep Array of time representations to create character strings for.
+          \param num_rep Number of time representations to create character strings for.
+          \param buffer Buffer of at least num_rep * width characters, to which character strings are stored one after another.
+          \param width Number of characters occupied by each character string in the buffer.
+          \param precision Number of digits of a floating-point number in the character strings. Precise interpretation
+                           of this argument is the same as format method.
+      */
+      virtual void formatArray(const TimeRepType * time_rep, std::size_t num_rep, char * buffer, std::size_t width,
+        std::streamsize precision = std::numeric_limits<double>::digits10) const {
+        for (std::size_t ii = 0; ii < num_rep; ++ii) {
+          std::string time_string = format(time_rep[ii], precision);
+          storeString(time_string.data(), time_string.size(), buffer + ii * width, width);
+        }
+      }
+
+    protected:
+      /** \brief Return the length of a character string that occupies a given number of characters in a buffer, up to the first
+                 null character in them, and excluding trailing blanks.
+          \param time_string Pointer to the first character of the character string.
+          \param width Number of characters occupied by the character string.
+      */
+      static std::size_t getStringLength(const char * time_string, std::size_t width) {
+        std::size_t length = 0;
+        while (length < width && '\0' != time_string[length]) ++length;
+        while (length > 0 && ' ' == time_string[length - 1]) --length;
+        return length;
+      }
+
+      /** \brief Store a character string in a given number of characters of a buffer, padding it with null characters,
+                 and throw an exception if it is longer than that.
+          \param time_string Pointer to the first character of the character string to store.
+          \param length Length of the character string to store.
+          \param buffer Pointer to the first character in the buffer to store the character string in.
+          \param width Number of characters to store the character string in.
+      */
+      static void storeString(const char * time_string, std::size_t length, char * buffer, std::size_t width) {
+        if (length > width) {
+          std::ostringstream os;
+          os << "Time string \"" << std::string(time_string, length) << "\" does not fit in " << width << " characters";
+          throw std::runtime_error(os.str());
+        }
+        std::size_t ii = 0;
+        for (; ii < length; ++ii) buffer[ii] = time_string[ii];
+        for (; ii < width; ++ii) buffer[ii] = '\0';
+      }
   };
 
   /** \class TimeFormatFactory
@@ -10,6 +10,7 @@
 
 #include "timeSystem/Duration.h"
 
+#include <cstddef>
 #include <map>
 #include <string>
 
@@ -29,21 +30,53 @@ namespace timeSystem {
       */
       static const TimeSystem & getSystem(const std::string & system_name);
 
-      /** \brief Load leap-second data from a given file.
-          \param leap_sec_file_name Name of a leap-second file in the FITS format.
+      /** \brief Load leap-second data from a given file. The leap-second table in use is replaced only after the new one is
+                 loaded successfully, and time conversions in progress in other threads keep using the table they started with.
+          \param leap_sec_file_name Name of a leap-second file in the FITS format. If empty or "DEFAULT", the default
+                 leap-second file is loaded, or the leap-second table built into this library if no default file is set.
           \param force_load Set to true to load new leap-second data even if already loaded.
                             Set to false not to load them in case leap-second data have already been loaded.
       */
       static void loadLeapSeconds(std::string leap_sec_file_name = "", bool force_load = true);
 
-      /// \brief Return the name of a default leap-second file currently set.
+      /** \brief Return the name of a default leap-second file currently set, or an empty string if none is set, in which case
+                 the leap-second table built into this library is used by default.
+      */
       static std::string getDefaultLeapSecFileName();
 
       /** \brief Set the name of a default leap-second file.
-          \param leap_sec_file_name Name of the default leap-second file.
+          \param leap_sec_file_name Name of the default leap-second file. If empty or "DEFAULT", the leap-second table built
+                 into this library is used by default.
       */
       static void setDefaultLeapSecFileName(const std::string & leap_sec_file_name);
 
+      /** \brief Set the name of a file to cache a snapshot of leap-second data in, so that leap-second data are read from
+                 the snapshot, instead of a leap-second file in the FITS format, while the leap-second file is unchanged.
+                 The snapshot is written whenever a leap-second file is read, and is not used for the built-in table.
+          \param cache_file_name Name of the snapshot file. If empty, no snapshot is read or written, which is the default.
+      */
+      static void setLeapSecCacheFileName(const std::string & cache_file_name);
+
+      /** \brief Precompute the time difference between TDB and TT for a given span of time, so that conversions between
+                 TDB and TT within the span are computed from Chebyshev polynomials, instead of the full series expansion of
+                 the time difference, and without iterations for conversions from TDB to TT. Conversions outside the span are
+                 computed as before. The precomputed values agree with the series expansion far better than its accuracy of
+                 100 nanoseconds. Note: Call this method before, not during, time conversions in other threads.
+          \param first_mjd The first MJD number (in TT system) of the span, at the beginning of which the span starts.
+          \param last_mjd The last MJD number (in TT system) of the span, at the end of which the span ends.
+      */
+      static void precomputeTdbMinusTt(long first_mjd, long last_mjd);
+
+      /// \brief Discard the precomputed time difference between TDB and TT, if any.
+      static void clearTdbMinusTt();
+
+      /** \brief Compute the time difference between TDB and TT in seconds at a given date and time in TT system, in the same
+                 way as in conversions from TT to TDB, and return it. This method is intended for computing many TDB times
+                 from TT times without constructing AbsoluteTime objects.
+          \param tt_datetime Date and time in TT system, given as an MJD number and the number of seconds in the day.
+      */
+      static double computeTdbMinusTtInSec(const datetime_type & tt_datetime);
+
       /// \brief Destruct this TimeSystem object.
       virtual ~TimeSystem();
 
@@ -53,12 +86,32 @@ namespace timeSystem {
       */
       virtual moment_type convertFrom(const TimeSystem & time_system, const moment_type & moment) const = 0;
 
+      /** \brief Convert time moments expressed in a different time system to the ones in this time system, and set them to
+                 a caller-provided array. The result is the same as calling convertFrom method for each time moment, but
+                 conversions of many time moments in a row, especially those sorted in time order, are faster.
+          \param time_system Time system to conver time moments from.
+          \param moment Array of time moments to convert.
+          \param num_moment Number of time moments to convert.
+          \param result Array of at least num_moment time moments, to which the converted ones are set. It may be the same
+                        array as the one given as the second argument, in which case the time moments are converted in place.
+      */
+      virtual void convertArrayFrom(const TimeSystem & time_system, const moment_type * moment, std::size_t num_moment,
+        moment_type * result) const;
+
       /** \brief Compute time difference between two moments of time, and return it.
           \param moment1 Time moment from which the other time moment is to be subtracted.
           \param moment2 Time moment which is subtracted from the other time moment.
       */
       virtual Duration computeTimeDifference(const moment_type & moment1, const moment_type & moment2) const;
 
+      /** \brief Compute time difference between two moments of time in seconds, and return it. The result is the same as
+                 computeTimeDifference(moment1, moment2).get<Sec>() up to a rounding error, but computed directly from
+                 the numbers of days and seconds of the moments.
+          \param moment1 Time moment from which the other time moment is to be subtracted.
+          \param moment2 Time moment which is subtracted from the other time moment.
+      */
+      virtual double computeTimeDifferenceInSec(const moment_type & moment1, const moment_type & moment2) const;
+
       /** \brief Compute date and time of a given time moment, and return it.
           \param moment Time moment to compute date and time for.
       */
@@ -90,6 +143,7 @@ namespace timeSystem {
       static container_type & getContainer();
 
       static std::string s_default_leap_sec_file;
+      static std::string s_leap_sec_cache_file;
 
       /** \brief Construct a TimeSystem object.
           \param system_name Name of the time system to construct.
@@ -12,16 +12,33 @@
 /* Note: The value must be different from any of the existing FITS error codes. */
 #define TIME_OUT_BOUNDS -2
 
+/* Structure to hold a run of intervals of uniform length in spacecraft data */
+typedef struct {
+  long first_interval;        /* Index of the first interval of the run, i.e., the index of its first row */
+  long num_intervals;         /* The number of intervals in the run */
+  double start_time;          /* Time in the first row of the run */
+  double step;                /* Length of each interval in the run */
+} GlastScRun;
+
 /* Structure to hold information of an opened spacecraft file */
 typedef struct {
-  fitsfile * fits_ptr;    /* Pointer to an opened spacecraft file */
-  long num_rows;          /* The number of rows in the file */
-  int colnum_scposn;      /* Column number of "SC_POSITION" column */
-  double * sctime_array;  /* Copy of the "START" column contents */
-  long sctime_array_size; /* Size of the above array */
-  char * filename;        /* Name of the opened spacecraft file */
-  char * extname;         /* Name of the spacecraft data extension */
-  int open_count;         /* The number of requests to open this file */
+  fitsfile * fits_ptr;        /* Pointer to an opened spacecraft file */
+  long num_rows;              /* The number of rows in the file */
+  int colnum_scposn;          /* Column number of "SC_POSITION" column */
+  double * sctime_array;      /* Copy of the "START" column contents */
+  long sctime_array_size;     /* Size of the above array */
+  double * scposn_array;      /* Copy of the "SC_POSITION" column contents, three elements (X, Y, Z) per row */
+  long scposn_array_size;     /* Size of the above array */
+  double * orbit_table;       /* Memory block for the per-row and per-interval arrays below (NULL if not computed) */
+  double * sclength_array;    /* Length of the spacecraft position vector in each row */
+  double * scangle_array;     /* Angle between the spacecraft position vectors at both ends of each interval */
+  double * scbasis1_array[3]; /* X, Y, Z components of the first base vector of interpolation in each interval */
+  double * scbasis2_array[3]; /* X, Y, Z components of the second base vector of interpolation in each interval */
+  GlastScRun * run_array;     /* Runs of intervals of uniform length, in time order (NULL if not computed) */
+  long num_runs;              /* The number of runs in the above array */
+  char * filename;            /* Name of the opened spacecraft file */
+  char * extname;             /* Name of the spacecraft data extension */
+  int open_count;             /* The number of requests to open this file */
 } GlastScData;
 
 /* Structure to be given to the requester to open a spacecraft file */
@@ -30,14 +47,37 @@ typedef struct {
 typedef struct {
   GlastScData ** data; /* Pointer to an internal spacecraft data table */
   int status;          /* File I/O status (0 if normal) */
+  long cursor;         /* Index of the interval found by the last search (-1 if none) */
+  long num_hit;        /* The number of searches answered by the cursor */
+  long num_run_hit;    /* The number of searches answered by the run table after the cursor missed */
+  long num_miss;       /* The number of searches that fell back on binary search */
 } GlastScFile;
 
+/* Structure to hold the state of searches for bracketing rows, owned by a caller of the reentrant functions */
+/* Note: Unlike the cursor in GlastScFile, a cursor of this type is not shared with others
+   who open the same spacecraft file, so that threads may search the same file concurrently. */
+typedef struct {
+  long interval;       /* Index of the interval found by the last search (-1 if none) */
+  long num_hit;        /* The number of searches answered by the cursor */
+  long num_run_hit;    /* The number of searches answered by the run table after the cursor missed */
+  long num_miss;       /* The number of searches that fell back on binary search */
+} GlastScCursor;
+
 /* Function prototypes for GLAST spacecraft file access */
 GlastScFile * glastscorbit_open(char *, char *);
 int glastscorbit_calcpos(GlastScFile *, double, double []);
+int glastscorbit_getinterval(GlastScFile *, double, long *);
+void glastscorbit_initcursor(GlastScCursor *);
+int glastscorbit_calcpos_r(GlastScFile *, GlastScCursor *, double, double []);
+int glastscorbit_getinterval_r(GlastScFile *, GlastScCursor *, double, long *);
 int glastscorbit_close(GlastScFile *);
 double * glastscorbit(char *, double, int *);
 int glastscorbit_getstatus(GlastScFile *);
 void glastscorbit_clearerr(GlastScFile *);
+int glastscorbit_getcursorstat(GlastScFile *, long *, long *);
+int glastscorbit_getrunstat(GlastScFile *, long *);
+int glastscorbit_getnumrows(GlastScFile *, long *);
+int glastscorbit_getrow(GlastScFile *, long, double *, double []);
+void glastscorbit_interpolate(double, double, double [], double, double [], double []);
 
 #endif
@@ -7,6 +7,8 @@ def generate(env, **kw):
     env.Tool('tipLib')
     env.Tool('st_appLib')
     env.Tool('addLibrary', library = env['cfitsioLibs'])
+    if env['PLATFORM'] != 'win32':
+        env.AppendUnique(LIBS = ['pthread'])
 
 def exists(env):
     return 1